@@ -768,7 +768,12 @@ typedef enum {
     Magma_VBJACOBI     = 508,
     Magma_PARDISO      = 509,
     Magma_SYNCFREESOLVE= 510,
-    Magma_ILUT         = 511
+    Magma_ILUT         = 511,
+    Magma_PIPECG       = 512,
+    Magma_SSTEPCG      = 513,
+    Magma_MCILU        = 514,
+    Magma_MCSGS        = 515,
+    Magma_PARILUB      = 516
 } magma_solver_type;
 
 typedef enum {
@@ -791,7 +796,8 @@ typedef enum {
     Magma_ORDERED      = 591,
     Magma_DIAGFIRST    = 592,
     Magma_UNITY        = 593,
-    Magma_VALUE        = 594
+    Magma_VALUE        = 594,
+    Magma_NODIAG       = 595
 } magma_diagorder_t;
 
 typedef enum {
@@ -0,0 +1,728 @@
+/*
+    -- MAGMA (version 2.6.2) --
+       Univ. of Tennessee, Knoxville
+       Univ. of California, Berkeley
+       Univ. of Colorado, Denver
+       @date April 2022
+
+       @generated from sparse/blas/zmerge_cpu.cpp, normal z -> c, Sun Oct 18 19:36:20 2026
+       @author Hartwig Anzt
+
+*/
+#include "magmasparse_internal.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#define PRECISION_c
+
+
+/*
+    Fused host kernels for the merged CG and BiCGSTAB solvers.
+
+    Every kernel performs one sweep over the vectors. The index range is
+    split into one contiguous block per OpenMP thread (essentially the
+    partition schedule(static) uses when magma_cvinit touches the vectors
+    first), so a thread mostly streams through memory local to its NUMA node.
+    Each thread reduces its block with SIMD instructions; the partial sums are
+    then combined in thread order, so the results are bitwise reproducible
+    for a fixed number of threads.
+*/
+
+// contiguous block [start, end) of thread tid out of nthreads
+static inline void
+cmerge_range(
+    magma_int_t n,
+    magma_int_t *start,
+    magma_int_t *end )
+{
+#ifdef _OPENMP
+    magma_int_t nthreads = omp_get_num_threads();
+    magma_int_t tid = omp_get_thread_num();
+#else
+    magma_int_t nthreads = 1;
+    magma_int_t tid = 0;
+#endif
+    magma_int_t chunk = magma_ceildiv( n, nthreads );
+    *start = min( n, tid*chunk );
+    *end = min( n, *start + chunk );
+}
+
+
+static inline magma_int_t
+cmerge_nthreads()
+{
+#ifdef _OPENMP
+    return omp_get_num_threads();
+#else
+    return 1;
+#endif
+}
+
+
+// y = A x on the CPU with reductions wy = w^H y and (if yy != NULL)
+// yy = y^H y fused into the same sweep.
+static magma_int_t
+cmerge_spmv_dot(
+    magma_c_matrix A,
+    magmaFloatComplex *x,
+    magmaFloatComplex *y,
+    magmaFloatComplex *w,
+    magmaFloatComplex *wy,
+    float *yy,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+    float wy_re = 0.0, wy_im = 0.0, yy_re = 0.0;
+
+    if ( A.storage_type == Magma_CSR || A.storage_type == Magma_CUCSR ) {
+        #pragma omp parallel
+        {
+            magma_int_t start, end;
+            float lwy_re = 0.0, lwy_im = 0.0, lyy_re = 0.0;
+            cmerge_range( A.num_rows, &start, &end );
+            for( magma_int_t i=start; i<end; i++ ){
+                magmaFloatComplex dot = MAGMA_C_ZERO;
+                for( magma_int_t j=A.row[i]; j<A.row[i+1]; j++ ){
+                    dot += A.val[j] * x[ A.col[j] ];
+                }
+                y[i] = dot;
+                magmaFloatComplex tmp = MAGMA_C_CONJ( w[i] ) * dot;
+                lwy_re += MAGMA_C_REAL( tmp );
+                lwy_im += MAGMA_C_IMAG( tmp );
+                lyy_re += MAGMA_C_REAL( dot ) * MAGMA_C_REAL( dot )
+                        + MAGMA_C_IMAG( dot ) * MAGMA_C_IMAG( dot );
+            }
+            #pragma omp for ordered schedule(static,1)
+            for( magma_int_t tid=0; tid<cmerge_nthreads(); tid++ ){
+                #pragma omp ordered
+                {
+                    wy_re += lwy_re;
+                    wy_im += lwy_im;
+                    yy_re += lyy_re;
+                }
+            }
+        }
+        *wy = MAGMA_C_MAKE( wy_re, wy_im );
+        if ( yy != NULL ) {
+            *yy = yy_re;
+        }
+    }
+    else {
+        // other formats: SpMV and reduction in separate sweeps
+        magma_c_matrix xv={Magma_CSR}, yv={Magma_CSR};
+        CHECK( magma_cvset( A.num_cols, 1, x, &xv, queue ));
+        CHECK( magma_cvset( A.num_rows, 1, y, &yv, queue ));
+        CHECK( magma_c_spmv( MAGMA_C_ONE, A, xv, MAGMA_C_ZERO, yv, queue ));
+        *wy = magma_cdotc_cpu( A.num_rows, w, 1, y, 1, queue );
+        if ( yy != NULL ) {
+            float nrm = magma_scnrm2_cpu( A.num_rows, y, 1, queue );
+            *yy = nrm * nrm;
+        }
+    }
+
+cleanup:
+    return info;
+}
+
+
+/**
+    Purpose
+    -------
+
+    Merges the SpMV z = A d with the dot product den = d^H z of the CG
+    iteration into one sweep. A is expected in CSR format in CPU memory;
+    other formats fall back to a separate SpMV and dot product.
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_c_matrix
+                system matrix
+
+    @param[in]
+    d           magmaFloatComplex*
+                search direction
+
+    @param[out]
+    z           magmaFloatComplex*
+                z = A d
+
+    @param[out]
+    den         magmaFloatComplex*
+                den = d^H z
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_cgegpuk
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_ccgmerge_spmv1_cpu(
+    magma_c_matrix A,
+    magmaFloatComplex *d,
+    magmaFloatComplex *z,
+    magmaFloatComplex *den,
+    magma_queue_t queue )
+{
+    return cmerge_spmv_dot( A, d, z, d, den, NULL, queue );
+}
+
+
+/**
+    Purpose
+    -------
+
+    Merges the updates of the CG iterate and residual with the computation
+    of the new residual norm:
+
+    x = x + alpha d
+    r = r - alpha z
+    nrm2 = r^H r
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                vector length
+
+    @param[in]
+    alpha       magmaFloatComplex
+                step length
+
+    @param[in]
+    d           magmaFloatComplex*
+                search direction
+
+    @param[in]
+    z           magmaFloatComplex*
+                z = A d
+
+    @param[in,out]
+    x           magmaFloatComplex*
+                iterate
+
+    @param[in,out]
+    r           magmaFloatComplex*
+                residual
+
+    @param[out]
+    nrm2        float*
+                squared residual norm
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_cgegpuk
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_ccgmerge_xr_cpu(
+    magma_int_t n,
+    magmaFloatComplex alpha,
+    magmaFloatComplex *d,
+    magmaFloatComplex *z,
+    magmaFloatComplex *x,
+    magmaFloatComplex *r,
+    float *nrm2,
+    magma_queue_t queue )
+{
+    float sum = 0.0;
+
+    #pragma omp parallel
+    {
+        magma_int_t start, end;
+        float loc = 0.0;
+        cmerge_range( n, &start, &end );
+        #pragma omp simd reduction(+:loc)
+        for( magma_int_t i=start; i<end; i++ ){
+            x[i] = x[i] + alpha * d[i];
+            magmaFloatComplex ri = r[i] - alpha * z[i];
+            r[i] = ri;
+            loc += MAGMA_C_REAL( ri ) * MAGMA_C_REAL( ri )
+                 + MAGMA_C_IMAG( ri ) * MAGMA_C_IMAG( ri );
+        }
+        #pragma omp for ordered schedule(static,1)
+        for( magma_int_t tid=0; tid<cmerge_nthreads(); tid++ ){
+            #pragma omp ordered
+            sum += loc;
+        }
+    }
+    *nrm2 = sum;
+
+    return MAGMA_SUCCESS;
+}
+
+
+/**
+    Purpose
+    -------
+
+    Updates the CG search direction: d = h + beta d
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                vector length
+
+    @param[in]
+    beta        magmaFloatComplex
+                scalar beta
+
+    @param[in]
+    h           magmaFloatComplex*
+                (preconditioned) residual
+
+    @param[in,out]
+    d           magmaFloatComplex*
+                search direction
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_cgegpuk
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_ccgmerge_d_cpu(
+    magma_int_t n,
+    magmaFloatComplex beta,
+    magmaFloatComplex *h,
+    magmaFloatComplex *d,
+    magma_queue_t queue )
+{
+    #pragma omp parallel
+    {
+        magma_int_t start, end;
+        cmerge_range( n, &start, &end );
+        #pragma omp simd
+        for( magma_int_t i=start; i<end; i++ ){
+            d[i] = h[i] + beta * d[i];
+        }
+    }
+
+    return MAGMA_SUCCESS;
+}
+
+
+/**
+    Purpose
+    -------
+
+    Computes the inner product r^H h of the preconditioned CG with the
+    same partition and reduction order as the other fused kernels.
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                vector length
+
+    @param[in]
+    r           magmaFloatComplex*
+                residual
+
+    @param[in]
+    h           magmaFloatComplex*
+                preconditioned residual
+
+    @param[out]
+    rh          magmaFloatComplex*
+                rh = r^H h
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_cgegpuk
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_ccgmerge_rh_cpu(
+    magma_int_t n,
+    magmaFloatComplex *r,
+    magmaFloatComplex *h,
+    magmaFloatComplex *rh,
+    magma_queue_t queue )
+{
+    float sum_re = 0.0, sum_im = 0.0;
+
+    #pragma omp parallel
+    {
+        magma_int_t start, end;
+        float loc_re = 0.0, loc_im = 0.0;
+        cmerge_range( n, &start, &end );
+        #pragma omp simd reduction(+:loc_re,loc_im)
+        for( magma_int_t i=start; i<end; i++ ){
+            magmaFloatComplex tmp = MAGMA_C_CONJ( r[i] ) * h[i];
+            loc_re += MAGMA_C_REAL( tmp );
+            loc_im += MAGMA_C_IMAG( tmp );
+        }
+        #pragma omp for ordered schedule(static,1)
+        for( magma_int_t tid=0; tid<cmerge_nthreads(); tid++ ){
+            #pragma omp ordered
+            {
+                sum_re += loc_re;
+                sum_im += loc_im;
+            }
+        }
+    }
+    *rh = MAGMA_C_MAKE( sum_re, sum_im );
+
+    return MAGMA_SUCCESS;
+}
+
+
+/**
+    Purpose
+    -------
+
+    First BiCGSTAB update: p = r + beta * ( p - omega * v )
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                vector length
+
+    @param[in]
+    beta        magmaFloatComplex
+                scalar beta
+
+    @param[in]
+    omega       magmaFloatComplex
+                scalar omega
+
+    @param[in]
+    r           magmaFloatComplex*
+                residual
+
+    @param[in]
+    v           magmaFloatComplex*
+                v = A p of the previous iteration
+
+    @param[in,out]
+    p           magmaFloatComplex*
+                search direction
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_cgegpuk
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_cbicgmerge1_cpu(
+    magma_int_t n,
+    magmaFloatComplex beta,
+    magmaFloatComplex omega,
+    magmaFloatComplex *r,
+    magmaFloatComplex *v,
+    magmaFloatComplex *p,
+    magma_queue_t queue )
+{
+    #pragma omp parallel
+    {
+        magma_int_t start, end;
+        cmerge_range( n, &start, &end );
+        #pragma omp simd
+        for( magma_int_t i=start; i<end; i++ ){
+            p[i] = r[i] + beta * ( p[i] - omega * v[i] );
+        }
+    }
+
+    return MAGMA_SUCCESS;
+}
+
+
+/**
+    Purpose
+    -------
+
+    Merges the first BiCGSTAB SpMV v = A p with the dot product
+    rrv = rr^H v into one sweep.
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_c_matrix
+                system matrix
+
+    @param[in]
+    rr          magmaFloatComplex*
+                shadow residual
+
+    @param[in]
+    p           magmaFloatComplex*
+                search direction
+
+    @param[out]
+    v           magmaFloatComplex*
+                v = A p
+
+    @param[out]
+    rrv         magmaFloatComplex*
+                rrv = rr^H v
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_cgegpuk
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_cbicgmerge_spmv1_cpu(
+    magma_c_matrix A,
+    magmaFloatComplex *rr,
+    magmaFloatComplex *p,
+    magmaFloatComplex *v,
+    magmaFloatComplex *rrv,
+    magma_queue_t queue )
+{
+    return cmerge_spmv_dot( A, p, v, rr, rrv, NULL, queue );
+}
+
+
+/**
+    Purpose
+    -------
+
+    Second BiCGSTAB update: s = r - alpha v
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                vector length
+
+    @param[in]
+    alpha       magmaFloatComplex
+                scalar alpha
+
+    @param[in]
+    r           magmaFloatComplex*
+                residual
+
+    @param[in]
+    v           magmaFloatComplex*
+                v = A p
+
+    @param[out]
+    s           magmaFloatComplex*
+                s = r - alpha v
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_cgegpuk
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_cbicgmerge2_cpu(
+    magma_int_t n,
+    magmaFloatComplex alpha,
+    magmaFloatComplex *r,
+    magmaFloatComplex *v,
+    magmaFloatComplex *s,
+    magma_queue_t queue )
+{
+    #pragma omp parallel
+    {
+        magma_int_t start, end;
+        cmerge_range( n, &start, &end );
+        #pragma omp simd
+        for( magma_int_t i=start; i<end; i++ ){
+            s[i] = r[i] - alpha * v[i];
+        }
+    }
+
+    return MAGMA_SUCCESS;
+}
+
+
+/**
+    Purpose
+    -------
+
+    Merges the second BiCGSTAB SpMV t = A s with the dot products
+    ts = t^H s and tt = t^H t into one sweep.
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_c_matrix
+                system matrix
+
+    @param[in]
+    s           magmaFloatComplex*
+                s = r - alpha v
+
+    @param[out]
+    t           magmaFloatComplex*
+                t = A s
+
+    @param[out]
+    ts          magmaFloatComplex*
+                ts = t^H s
+
+    @param[out]
+    tt          float*
+                tt = t^H t
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_cgegpuk
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_cbicgmerge_spmv2_cpu(
+    magma_c_matrix A,
+    magmaFloatComplex *s,
+    magmaFloatComplex *t,
+    magmaFloatComplex *ts,
+    float *tt,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+    magmaFloatComplex st;
+
+    CHECK( cmerge_spmv_dot( A, s, t, s, &st, tt, queue ));
+    *ts = MAGMA_C_CONJ( st );
+
+cleanup:
+    return info;
+}
+
+
+/**
+    Purpose
+    -------
+
+    Merges the last BiCGSTAB updates with the reductions needed for the
+    convergence check and the next iteration:
+
+    x = x + alpha p + omega s
+    r = s - omega t
+    rho = rr^H r
+    nrm2 = r^H r
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                vector length
+
+    @param[in]
+    alpha       magmaFloatComplex
+                scalar alpha
+
+    @param[in]
+    omega       magmaFloatComplex
+                scalar omega
+
+    @param[in]
+    rr          magmaFloatComplex*
+                shadow residual
+
+    @param[in]
+    p           magmaFloatComplex*
+                search direction
+
+    @param[in]
+    s           magmaFloatComplex*
+                s = r - alpha v
+
+    @param[in]
+    t           magmaFloatComplex*
+                t = A s
+
+    @param[in,out]
+    x           magmaFloatComplex*
+                iterate
+
+    @param[out]
+    r           magmaFloatComplex*
+                residual
+
+    @param[out]
+    rho         magmaFloatComplex*
+                rho = rr^H r
+
+    @param[out]
+    nrm2        float*
+                squared residual norm
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_cgegpuk
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_cbicgmerge_xrbeta_cpu(
+    magma_int_t n,
+    magmaFloatComplex alpha,
+    magmaFloatComplex omega,
+    magmaFloatComplex *rr,
+    magmaFloatComplex *p,
+    magmaFloatComplex *s,
+    magmaFloatComplex *t,
+    magmaFloatComplex *x,
+    magmaFloatComplex *r,
+    magmaFloatComplex *rho,
+    float *nrm2,
+    magma_queue_t queue )
+{
+    float rho_re = 0.0, rho_im = 0.0, nrm = 0.0;
+
+    #pragma omp parallel
+    {
+        magma_int_t start, end;
+        float lrho_re = 0.0, lrho_im = 0.0, lnrm = 0.0;
+        cmerge_range( n, &start, &end );
+        #pragma omp simd reduction(+:lrho_re,lrho_im,lnrm)
+        for( magma_int_t i=start; i<end; i++ ){
+            x[i] = x[i] + alpha * p[i] + omega * s[i];
+            magmaFloatComplex ri = s[i] - omega * t[i];
+            r[i] = ri;
+            magmaFloatComplex tmp = MAGMA_C_CONJ( rr[i] ) * ri;
+            lrho_re += MAGMA_C_REAL( tmp );
+            lrho_im += MAGMA_C_IMAG( tmp );
+            lnrm += MAGMA_C_REAL( ri ) * MAGMA_C_REAL( ri )
+                  + MAGMA_C_IMAG( ri ) * MAGMA_C_IMAG( ri );
+        }
+        #pragma omp for ordered schedule(static,1)
+        for( magma_int_t tid=0; tid<cmerge_nthreads(); tid++ ){
+            #pragma omp ordered
+            {
+                rho_re += lrho_re;
+                rho_im += lrho_im;
+                nrm += lnrm;
+            }
+        }
+    }
+    *rho = MAGMA_C_MAKE( rho_re, rho_im );
+    *nrm2 = nrm;
+
+    return MAGMA_SUCCESS;
+}
@@ -0,0 +1,728 @@
+/*
+    -- MAGMA (version 2.6.2) --
+       Univ. of Tennessee, Knoxville
+       Univ. of California, Berkeley
+       Univ. of Colorado, Denver
+       @date April 2022
+
+       @generated from sparse/blas/zmerge_cpu.cpp, normal z -> d, Sun Oct 18 19:36:20 2026
+       @author Hartwig Anzt
+
+*/
+#include "magmasparse_internal.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#define PRECISION_d
+
+
+/*
+    Fused host kernels for the merged CG and BiCGSTAB solvers.
+
+    Every kernel performs one sweep over the vectors. The index range is
+    split into one contiguous block per OpenMP thread (essentially the
+    partition schedule(static) uses when magma_dvinit touches the vectors
+    first), so a thread mostly streams through memory local to its NUMA node.
+    Each thread reduces its block with SIMD instructions; the partial sums are
+    then combined in thread order, so the results are bitwise reproducible
+    for a fixed number of threads.
+*/
+
+// contiguous block [start, end) of thread tid out of nthreads
+static inline void
+dmerge_range(
+    magma_int_t n,
+    magma_int_t *start,
+    magma_int_t *end )
+{
+#ifdef _OPENMP
+    magma_int_t nthreads = omp_get_num_threads();
+    magma_int_t tid = omp_get_thread_num();
+#else
+    magma_int_t nthreads = 1;
+    magma_int_t tid = 0;
+#endif
+    magma_int_t chunk = magma_ceildiv( n, nthreads );
+    *start = min( n, tid*chunk );
+    *end = min( n, *start + chunk );
+}
+
+
+static inline magma_int_t
+dmerge_nthreads()
+{
+#ifdef _OPENMP
+    return omp_get_num_threads();
+#else
+    return 1;
+#endif
+}
+
+
+// y = A x on the CPU with reductions wy = w^H y and (if yy != NULL)
+// yy = y^H y fused into the same sweep.
+static magma_int_t
+dmerge_spmv_dot(
+    magma_d_matrix A,
+    double *x,
+    double *y,
+    double *w,
+    double *wy,
+    double *yy,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+    double wy_re = 0.0, wy_im = 0.0, yy_re = 0.0;
+
+    if ( A.storage_type == Magma_CSR || A.storage_type == Magma_CUCSR ) {
+        #pragma omp parallel
+        {
+            magma_int_t start, end;
+            double lwy_re = 0.0, lwy_im = 0.0, lyy_re = 0.0;
+            dmerge_range( A.num_rows, &start, &end );
+            for( magma_int_t i=start; i<end; i++ ){
+                double dot = MAGMA_D_ZERO;
+                for( magma_int_t j=A.row[i]; j<A.row[i+1]; j++ ){
+                    dot += A.val[j] * x[ A.col[j] ];
+                }
+                y[i] = dot;
+                double tmp = MAGMA_D_CONJ( w[i] ) * dot;
+                lwy_re += MAGMA_D_REAL( tmp );
+                lwy_im += MAGMA_D_IMAG( tmp );
+                lyy_re += MAGMA_D_REAL( dot ) * MAGMA_D_REAL( dot )
+                        + MAGMA_D_IMAG( dot ) * MAGMA_D_IMAG( dot );
+            }
+            #pragma omp for ordered schedule(static,1)
+            for( magma_int_t tid=0; tid<dmerge_nthreads(); tid++ ){
+                #pragma omp ordered
+                {
+                    wy_re += lwy_re;
+                    wy_im += lwy_im;
+                    yy_re += lyy_re;
+                }
+            }
+        }
+        *wy = MAGMA_D_MAKE( wy_re, wy_im );
+        if ( yy != NULL ) {
+            *yy = yy_re;
+        }
+    }
+    else {
+        // other formats: SpMV and reduction in separate sweeps
+        magma_d_matrix xv={Magma_CSR}, yv={Magma_CSR};
+        CHECK( magma_dvset( A.num_cols, 1, x, &xv, queue ));
+        CHECK( magma_dvset( A.num_rows, 1, y, &yv, queue ));
+        CHECK( magma_d_spmv( MAGMA_D_ONE, A, xv, MAGMA_D_ZERO, yv, queue ));
+        *wy = magma_ddot_cpu( A.num_rows, w, 1, y, 1, queue );
+        if ( yy != NULL ) {
+            double nrm = magma_dnrm2_cpu( A.num_rows, y, 1, queue );
+            *yy = nrm * nrm;
+        }
+    }
+
+cleanup:
+    return info;
+}
+
+
+/**
+    Purpose
+    -------
+
+    Merges the SpMV z = A d with the dot product den = d^H z of the CG
+    iteration into one sweep. A is expected in CSR format in CPU memory;
+    other formats fall back to a separate SpMV and dot product.
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_d_matrix
+                system matrix
+
+    @param[in]
+    d           double*
+                search direction
+
+    @param[out]
+    z           double*
+                z = A d
+
+    @param[out]
+    den         double*
+                den = d^H z
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_dgegpuk
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_dcgmerge_spmv1_cpu(
+    magma_d_matrix A,
+    double *d,
+    double *z,
+    double *den,
+    magma_queue_t queue )
+{
+    return dmerge_spmv_dot( A, d, z, d, den, NULL, queue );
+}
+
+
+/**
+    Purpose
+    -------
+
+    Merges the updates of the CG iterate and residual with the computation
+    of the new residual norm:
+
+    x = x + alpha d
+    r = r - alpha z
+    nrm2 = r^H r
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                vector length
+
+    @param[in]
+    alpha       double
+                step length
+
+    @param[in]
+    d           double*
+                search direction
+
+    @param[in]
+    z           double*
+                z = A d
+
+    @param[in,out]
+    x           double*
+                iterate
+
+    @param[in,out]
+    r           double*
+                residual
+
+    @param[out]
+    nrm2        double*
+                squared residual norm
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_dgegpuk
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_dcgmerge_xr_cpu(
+    magma_int_t n,
+    double alpha,
+    double *d,
+    double *z,
+    double *x,
+    double *r,
+    double *nrm2,
+    magma_queue_t queue )
+{
+    double sum = 0.0;
+
+    #pragma omp parallel
+    {
+        magma_int_t start, end;
+        double loc = 0.0;
+        dmerge_range( n, &start, &end );
+        #pragma omp simd reduction(+:loc)
+        for( magma_int_t i=start; i<end; i++ ){
+            x[i] = x[i] + alpha * d[i];
+            double ri = r[i] - alpha * z[i];
+            r[i] = ri;
+            loc += MAGMA_D_REAL( ri ) * MAGMA_D_REAL( ri )
+                 + MAGMA_D_IMAG( ri ) * MAGMA_D_IMAG( ri );
+        }
+        #pragma omp for ordered schedule(static,1)
+        for( magma_int_t tid=0; tid<dmerge_nthreads(); tid++ ){
+            #pragma omp ordered
+            sum += loc;
+        }
+    }
+    *nrm2 = sum;
+
+    return MAGMA_SUCCESS;
+}
+
+
+/**
+    Purpose
+    -------
+
+    Updates the CG search direction: d = h + beta d
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                vector length
+
+    @param[in]
+    beta        double
+                scalar beta
+
+    @param[in]
+    h           double*
+                (preconditioned) residual
+
+    @param[in,out]
+    d           double*
+                search direction
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_dgegpuk
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_dcgmerge_d_cpu(
+    magma_int_t n,
+    double beta,
+    double *h,
+    double *d,
+    magma_queue_t queue )
+{
+    #pragma omp parallel
+    {
+        magma_int_t start, end;
+        dmerge_range( n, &start, &end );
+        #pragma omp simd
+        for( magma_int_t i=start; i<end; i++ ){
+            d[i] = h[i] + beta * d[i];
+        }
+    }
+
+    return MAGMA_SUCCESS;
+}
+
+
+/**
+    Purpose
+    -------
+
+    Computes the inner product r^H h of the preconditioned CG with the
+    same partition and reduction order as the other fused kernels.
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                vector length
+
+    @param[in]
+    r           double*
+                residual
+
+    @param[in]
+    h           double*
+                preconditioned residual
+
+    @param[out]
+    rh          double*
+                rh = r^H h
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_dgegpuk
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_dcgmerge_rh_cpu(
+    magma_int_t n,
+    double *r,
+    double *h,
+    double *rh,
+    magma_queue_t queue )
+{
+    double sum_re = 0.0, sum_im = 0.0;
+
+    #pragma omp parallel
+    {
+        magma_int_t start, end;
+        double loc_re = 0.0, loc_im = 0.0;
+        dmerge_range( n, &start, &end );
+        #pragma omp simd reduction(+:loc_re,loc_im)
+        for( magma_int_t i=start; i<end; i++ ){
+            double tmp = MAGMA_D_CONJ( r[i] ) * h[i];
+            loc_re += MAGMA_D_REAL( tmp );
+            loc_im += MAGMA_D_IMAG( tmp );
+        }
+        #pragma omp for ordered schedule(static,1)
+        for( magma_int_t tid=0; tid<dmerge_nthreads(); tid++ ){
+            #pragma omp ordered
+            {
+                sum_re += loc_re;
+                sum_im += loc_im;
+            }
+        }
+    }
+    *rh = MAGMA_D_MAKE( sum_re, sum_im );
+
+    return MAGMA_SUCCESS;
+}
+
+
+/**
+    Purpose
+    -------
+
+    First BiCGSTAB update: p = r + beta * ( p - omega * v )
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                vector length
+
+    @param[in]
+    beta        double
+                scalar beta
+
+    @param[in]
+    omega       double
+                scalar omega
+
+    @param[in]
+    r           double*
+                residual
+
+    @param[in]
+    v           double*
+                v = A p of the previous iteration
+
+    @param[in,out]
+    p           double*
+                search direction
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_dgegpuk
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_dbicgmerge1_cpu(
+    magma_int_t n,
+    double beta,
+    double omega,
+    double *r,
+    double *v,
+    double *p,
+    magma_queue_t queue )
+{
+    #pragma omp parallel
+    {
+        magma_int_t start, end;
+        dmerge_range( n, &start, &end );
+        #pragma omp simd
+        for( magma_int_t i=start; i<end; i++ ){
+            p[i] = r[i] + beta * ( p[i] - omega * v[i] );
+        }
+    }
+
+    return MAGMA_SUCCESS;
+}
+
+
+/**
+    Purpose
+    -------
+
+    Merges the first BiCGSTAB SpMV v = A p with the dot product
+    rrv = rr^H v into one sweep.
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_d_matrix
+                system matrix
+
+    @param[in]
+    rr          double*
+                shadow residual
+
+    @param[in]
+    p           double*
+                search direction
+
+    @param[out]
+    v           double*
+                v = A p
+
+    @param[out]
+    rrv         double*
+                rrv = rr^H v
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_dgegpuk
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_dbicgmerge_spmv1_cpu(
+    magma_d_matrix A,
+    double *rr,
+    double *p,
+    double *v,
+    double *rrv,
+    magma_queue_t queue )
+{
+    return dmerge_spmv_dot( A, p, v, rr, rrv, NULL, queue );
+}
+
+
+/**
+    Purpose
+    -------
+
+    Second BiCGSTAB update: s = r - alpha v
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                vector length
+
+    @param[in]
+    alpha       double
+                scalar alpha
+
+    @param[in]
+    r           double*
+                residual
+
+    @param[in]
+    v           double*
+                v = A p
+
+    @param[out]
+    s           double*
+                s = r - alpha v
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_dgegpuk
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_dbicgmerge2_cpu(
+    magma_int_t n,
+    double alpha,
+    double *r,
+    double *v,
+    double *s,
+    magma_queue_t queue )
+{
+    #pragma omp parallel
+    {
+        magma_int_t start, end;
+        dmerge_range( n, &start, &end );
+        #pragma omp simd
+        for( magma_int_t i=start; i<end; i++ ){
+            s[i] = r[i] - alpha * v[i];
+        }
+    }
+
+    return MAGMA_SUCCESS;
+}
+
+
+/**
+    Purpose
+    -------
+
+    Merges the second BiCGSTAB SpMV t = A s with the dot products
+    ts = t^H s and tt = t^H t into one sweep.
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_d_matrix
+                system matrix
+
+    @param[in]
+    s           double*
+                s = r - alpha v
+
+    @param[out]
+    t           double*
+                t = A s
+
+    @param[out]
+    ts          double*
+                ts = t^H s
+
+    @param[out]
+    tt          double*
+                tt = t^H t
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_dgegpuk
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_dbicgmerge_spmv2_cpu(
+    magma_d_matrix A,
+    double *s,
+    double *t,
+    double *ts,
+    double *tt,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+    double st;
+
+    CHECK( dmerge_spmv_dot( A, s, t, s, &st, tt, queue ));
+    *ts = MAGMA_D_CONJ( st );
+
+cleanup:
+    return info;
+}
+
+
+/**
+    Purpose
+    -------
+
+    Merges the last BiCGSTAB updates with the reductions needed for the
+    convergence check and the next iteration:
+
+    x = x + alpha p + omega s
+    r = s - omega t
+    rho = rr^H r
+    nrm2 = r^H r
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                vector length
+
+    @param[in]
+    alpha       double
+                scalar alpha
+
+    @param[in]
+    omega       double
+                scalar omega
+
+    @param[in]
+    rr          double*
+                shadow residual
+
+    @param[in]
+    p           double*
+                search direction
+
+    @param[in]
+    s           double*
+                s = r - alpha v
+
+    @param[in]
+    t           double*
+                t = A s
+
+    @param[in,out]
+    x           double*
+                iterate
+
+    @param[out]
+    r           double*
+                residual
+
+    @param[out]
+    rho         double*
+                rho = rr^H r
+
+    @param[out]
+    nrm2        double*
+                squared residual norm
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_dgegpuk
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_dbicgmerge_xrbeta_cpu(
+    magma_int_t n,
+    double alpha,
+    double omega,
+    double *rr,
+    double *p,
+    double *s,
+    double *t,
+    double *x,
+    double *r,
+    double *rho,
+    double *nrm2,
+    magma_queue_t queue )
+{
+    double rho_re = 0.0, rho_im = 0.0, nrm = 0.0;
+
+    #pragma omp parallel
+    {
+        magma_int_t start, end;
+        double lrho_re = 0.0, lrho_im = 0.0, lnrm = 0.0;
+        dmerge_range( n, &start, &end );
+        #pragma omp simd reduction(+:lrho_re,lrho_im,lnrm)
+        for( magma_int_t i=start; i<end; i++ ){
+            x[i] = x[i] + alpha * p[i] + omega * s[i];
+            double ri = s[i] - omega * t[i];
+            r[i] = ri;
+            double tmp = MAGMA_D_CONJ( rr[i] ) * ri;
+            lrho_re += MAGMA_D_REAL( tmp );
+            lrho_im += MAGMA_D_IMAG( tmp );
+            lnrm += MAGMA_D_REAL( ri ) * MAGMA_D_REAL( ri )
+                  + MAGMA_D_IMAG( ri ) * MAGMA_D_IMAG( ri );
+        }
+        #pragma omp for ordered schedule(static,1)
+        for( magma_int_t tid=0; tid<dmerge_nthreads(); tid++ ){
+            #pragma omp ordered
+            {
+                rho_re += lrho_re;
+                rho_im += lrho_im;
+                nrm += lnrm;
+            }
+        }
+    }
+    *rho = MAGMA_D_MAKE( rho_re, rho_im );
+    *nrm2 = nrm;
+
+    return MAGMA_SUCCESS;
+}
@@ -5,7 +5,7 @@
        Univ. of Colorado, Denver
        @date April 2022
 
-       @generated from sparse/blas/magma_z_blaswrapper.cpp, normal z -> d, Wed Apr 20 17:38:06 2022
+       @generated from sparse/blas/magma_z_blaswrapper.cpp, normal z -> d, Sun Oct 18 19:32:00 2026
        @author Hartwig Anzt
 
 */
@@ -322,7 +322,20 @@ magma_d_spmv(
             }
         }
     }
-    // CPU case missing!
+    // CPU case: CSR-based formats are handled by the OpenMP host kernel
+    else if ( A.num_cols == x.num_rows && x.num_cols == 1 &&
+              ( A.storage_type == Magma_CSR   ||
+                A.storage_type == Magma_CUCSR ||
+                A.storage_type == Magma_CSRL  ||
+                A.storage_type == Magma_CSRU  ||
+                A.storage_type == Magma_CSC ) )
+    {
+        CHECK( magma_dgecsrmv_cpu(
+                ( A.storage_type == Magma_CSC ) ? MagmaTrans : MagmaNoTrans,
+                A.num_rows, A.num_cols, alpha, A.val, A.row, A.col,
+                x.val, beta, y.val, queue ));
+    }
+    // remaining CPU formats are processed on the device
     else {
         CHECK( magma_dmtransfer( x, &dx, x.memory_location, Magma_DEV, queue ));
         CHECK( magma_dmtransfer( y, &dy, y.memory_location, Magma_DEV, queue ));
@@ -0,0 +1,423 @@
+/*
+    -- MAGMA (version 2.6.2) --
+       Univ. of Tennessee, Knoxville
+       Univ. of California, Berkeley
+       Univ. of Colorado, Denver
+       @date April 2022
+
+       @generated from sparse/blas/magma_zspgemm_cpu.cpp, normal z -> d, Sun Oct 18 22:17:07 2026
+       @author Hartwig Anzt
+
+*/
+#include <algorithm>
+
+#include "magmasparse_internal.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#define PRECISION_d
+
+// rows per chunk in the dynamically scheduled row loops
+#define SPGEMM_CHUNK 64
+
+
+/*
+    Upper bound for the number of nonzeros in row row of A * B: the number
+    of merged entries, but at most the number of columns of B.
+*/
+static inline magma_int_t
+magma_dspgemm_bound(
+    const magma_d_matrix &A,
+    const magma_d_matrix &B,
+    magma_int_t row )
+{
+    int64_t bound = 0;
+    for( magma_int_t i=A.row[ row ]; i<A.row[ row+1 ]; i++ ){
+        magma_index_t k = A.col[ i ];
+        bound += B.row[ k+1 ] - B.row[ k ];
+    }
+    return ( bound < B.num_cols ) ? (magma_int_t) bound : B.num_cols;
+}
+
+
+/**
+    Purpose
+    -------
+
+    Symbolic phase of the sparse matrix-matrix product C = A * B of two CSR
+    matrices located in CPU memory. Generates the row pointer and the
+    column indices (sorted within every row) of C and allocates its values.
+    The rows of C are computed with Gustavson's row merge: every thread
+    marks the columns reached in a hash table (see magma_colmap_size) sized
+    for the longest merged row, not for B.num_cols. The pattern can be
+    reused for several numeric phases with
+    magma_dspgemm_numeric_cpu as long as the patterns of A and B do not
+    change.
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_d_matrix
+                input matrix A in CSR
+
+    @param[in]
+    B           magma_d_matrix
+                input matrix B in CSR
+
+    @param[out]
+    C           magma_d_matrix*
+                pattern of A * B in CSR
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_dblas
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_dspgemm_symbolic_cpu(
+    magma_d_matrix A,
+    magma_d_matrix B,
+    magma_d_matrix *C,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+    magma_int_t num_threads = 1, max_bound = 0, tsize;
+    magma_index_t *mark = NULL;
+
+    if( A.num_cols != B.num_rows ){
+        info = MAGMA_ERR_NOT_SUPPORTED;
+        goto cleanup;
+    }
+#ifdef _OPENMP
+    num_threads = omp_get_max_threads();
+#endif
+    magma_dmfree( C, queue );
+    C->storage_type = Magma_CSR;
+    C->memory_location = Magma_CPU;
+    C->num_rows = A.num_rows;
+    C->num_cols = B.num_cols;
+    CHECK( magma_index_malloc_cpu( &C->row, A.num_rows+1 ));
+
+    // the column map of every thread is sized for the longest merged row
+    #pragma omp parallel for reduction(max:max_bound)
+    for( magma_int_t row=0; row<A.num_rows; row++ ){
+        magma_int_t bound = magma_dspgemm_bound( A, B, row );
+        max_bound = ( bound > max_bound ) ? bound : max_bound;
+    }
+    tsize = magma_colmap_size( max_bound );
+    CHECK( magma_index_malloc_cpu( &mark, (size_t) num_threads * tsize ));
+
+    // count the distinct columns of every row of C
+    #pragma omp parallel num_threads(num_threads)
+    {
+        magma_int_t id = 0;
+#ifdef _OPENMP
+        id = omp_get_thread_num();
+#endif
+        magma_index_t *lmark = mark + (size_t) id * tsize;
+        #pragma omp for schedule(dynamic,SPGEMM_CHUNK)
+        for( magma_int_t row=0; row<A.num_rows; row++ ){
+            magma_int_t size = magma_colmap_size(
+                magma_dspgemm_bound( A, B, row ));
+            magma_index_t nz = 0;
+            magma_colmap_clear( lmark, size );
+            for( magma_int_t i=A.row[ row ]; i<A.row[ row+1 ]; i++ ){
+                magma_index_t k = A.col[ i ];
+                for( magma_int_t j=B.row[ k ]; j<B.row[ k+1 ]; j++ ){
+                    magma_index_t c = B.col[ j ];
+                    magma_int_t slot = magma_colmap_slot( lmark, size, c );
+                    if( lmark[ slot ] != c ){
+                        lmark[ slot ] = c;
+                        nz++;
+                    }
+                }
+            }
+            C->row[ row+1 ] = nz;
+        }
+    }
+    C->row[ 0 ] = 0;
+    CHECK( magma_dmatrix_createrowptr( C->num_rows, C->row, queue ));
+    C->nnz = C->row[ C->num_rows ];
+
+    CHECK( magma_dmalloc_cpu( &C->val, C->nnz ));
+    CHECK( magma_index_malloc_cpu( &C->col, C->nnz ));
+    CHECK( magma_dfirsttouch_cpu( C->nnz, C->val, C->col, NULL, queue ));
+
+    // collect and sort the columns
+    #pragma omp parallel num_threads(num_threads)
+    {
+        magma_int_t id = 0;
+#ifdef _OPENMP
+        id = omp_get_thread_num();
+#endif
+        magma_index_t *lmark = mark + (size_t) id * tsize;
+        #pragma omp for schedule(dynamic,SPGEMM_CHUNK)
+        for( magma_int_t row=0; row<A.num_rows; row++ ){
+            magma_int_t size = magma_colmap_size(
+                C->row[ row+1 ] - C->row[ row ] );
+            magma_index_t nz = C->row[ row ];
+            magma_colmap_clear( lmark, size );
+            for( magma_int_t i=A.row[ row ]; i<A.row[ row+1 ]; i++ ){
+                magma_index_t k = A.col[ i ];
+                for( magma_int_t j=B.row[ k ]; j<B.row[ k+1 ]; j++ ){
+                    magma_index_t c = B.col[ j ];
+                    magma_int_t slot = magma_colmap_slot( lmark, size, c );
+                    if( lmark[ slot ] != c ){
+                        lmark[ slot ] = c;
+                        C->col[ nz++ ] = c;
+                    }
+                }
+            }
+            std::sort( C->col + C->row[ row ], C->col + C->row[ row+1 ] );
+        }
+    }
+
+cleanup:
+    if( info != 0 ){
+        magma_dmfree( C, queue );
+    }
+    magma_free_cpu( mark );
+    return info;
+}
+
+
+/**
+    Purpose
+    -------
+
+    Numeric phase of the sparse matrix-matrix product: computes the values
+    of C = alpha * A * B on the given pattern of C. Contributions of A * B
+    outside the pattern of C are dropped, so the pattern may come from
+    magma_dspgemm_symbolic_cpu (full product) or from any other matrix
+    (masked product C = mask .* (alpha * A * B)). Every thread maps the
+    columns of the current row of C to their positions in a hash table
+    sized for the longest row of C and accumulates the merged rows of B
+    directly into C->val.
+
+    Arguments
+    ---------
+
+    @param[in]
+    alpha       double
+                scalar alpha
+
+    @param[in]
+    A           magma_d_matrix
+                input matrix A in CSR
+
+    @param[in]
+    B           magma_d_matrix
+                input matrix B in CSR
+
+    @param[in,out]
+    C           magma_d_matrix*
+                input: pattern of C in CSR, with column indices < B.num_cols
+                output: values of C
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_dblas
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_dspgemm_numeric_cpu(
+    double alpha,
+    magma_d_matrix A,
+    magma_d_matrix B,
+    magma_d_matrix *C,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+    magma_int_t num_threads = 1, max_len = 0, tsize;
+    magma_index_t *key = NULL, *pos = NULL;
+
+    if( A.num_cols != B.num_rows || A.num_rows != C->num_rows ){
+        info = MAGMA_ERR_NOT_SUPPORTED;
+        goto cleanup;
+    }
+#ifdef _OPENMP
+    num_threads = omp_get_max_threads();
+#endif
+    #pragma omp parallel for reduction(max:max_len)
+    for( magma_int_t row=0; row<C->num_rows; row++ ){
+        magma_int_t len = C->row[ row+1 ] - C->row[ row ];
+        max_len = ( len > max_len ) ? len : max_len;
+    }
+    tsize = magma_colmap_size( max_len );
+    CHECK( magma_index_malloc_cpu( &key, (size_t) num_threads * tsize ));
+    CHECK( magma_index_malloc_cpu( &pos, (size_t) num_threads * tsize ));
+
+    #pragma omp parallel num_threads(num_threads)
+    {
+        magma_int_t id = 0;
+#ifdef _OPENMP
+        id = omp_get_thread_num();
+#endif
+        magma_index_t *lkey = key + (size_t) id * tsize;
+        magma_index_t *lpos = pos + (size_t) id * tsize;
+        #pragma omp for schedule(dynamic,SPGEMM_CHUNK)
+        for( magma_int_t row=0; row<A.num_rows; row++ ){
+            magma_int_t size = magma_colmap_size(
+                C->row[ row+1 ] - C->row[ row ] );
+            magma_colmap_clear( lkey, size );
+            for( magma_int_t k=C->row[ row ]; k<C->row[ row+1 ]; k++ ){
+                magma_int_t slot = magma_colmap_slot( lkey, size, C->col[ k ] );
+                lkey[ slot ] = C->col[ k ];
+                lpos[ slot ] = k;
+                C->val[ k ] = MAGMA_D_ZERO;
+            }
+            for( magma_int_t i=A.row[ row ]; i<A.row[ row+1 ]; i++ ){
+                double a = alpha * A.val[ i ];
+                magma_index_t k = A.col[ i ];
+                for( magma_int_t j=B.row[ k ]; j<B.row[ k+1 ]; j++ ){
+                    magma_int_t slot = magma_colmap_slot( lkey, size,
+                        B.col[ j ] );
+                    if( lkey[ slot ] == B.col[ j ] ){
+                        C->val[ lpos[ slot ] ] += a * B.val[ j ];
+                    }
+                }
+            }
+        }
+    }
+
+cleanup:
+    magma_free_cpu( key );
+    magma_free_cpu( pos );
+    return info;
+}
+
+
+/**
+    Purpose
+    -------
+
+    Computes the sparse matrix-matrix product C = alpha * A * B of two CSR
+    matrices located in CPU memory: symbolic phase followed by the numeric
+    phase. This is the host counterpart of magma_d_spmm.
+
+    Arguments
+    ---------
+
+    @param[in]
+    alpha       double
+                scalar alpha
+
+    @param[in]
+    A           magma_d_matrix
+                input matrix A in CSR
+
+    @param[in]
+    B           magma_d_matrix
+                input matrix B in CSR
+
+    @param[out]
+    C           magma_d_matrix*
+                output matrix C = alpha * A * B in CSR
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_dblas
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_dspgemm_cpu(
+    double alpha,
+    magma_d_matrix A,
+    magma_d_matrix B,
+    magma_d_matrix *C,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+
+    CHECK( magma_dspgemm_symbolic_cpu( A, B, C, queue ));
+    CHECK( magma_dspgemm_numeric_cpu( alpha, A, B, C, queue ));
+
+cleanup:
+    return info;
+}
+
+
+/**
+    Purpose
+    -------
+
+    Computes the masked sparse matrix-matrix product
+    C = M .* (alpha * A * B) of CSR matrices located in CPU memory: C has
+    the pattern of M, only the entries of A * B in this pattern are
+    computed. The values of M are not used.
+
+    Arguments
+    ---------
+
+    @param[in]
+    alpha       double
+                scalar alpha
+
+    @param[in]
+    A           magma_d_matrix
+                input matrix A in CSR
+
+    @param[in]
+    B           magma_d_matrix
+                input matrix B in CSR
+
+    @param[in]
+    M           magma_d_matrix
+                mask in CSR, M.num_rows = A.num_rows, M.num_cols = B.num_cols
+
+    @param[out]
+    C           magma_d_matrix*
+                output matrix with the pattern of M in CSR
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_dblas
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_dspgemm_masked_cpu(
+    double alpha,
+    magma_d_matrix A,
+    magma_d_matrix B,
+    magma_d_matrix M,
+    magma_d_matrix *C,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+
+    magma_dmfree( C, queue );
+    C->storage_type = Magma_CSR;
+    C->memory_location = Magma_CPU;
+    C->num_rows = M.num_rows;
+    C->num_cols = M.num_cols;
+    C->nnz = M.nnz;
+    CHECK( magma_index_malloc_cpu( &C->row, M.num_rows+1 ));
+    CHECK( magma_index_malloc_cpu( &C->col, M.nnz ));
+    CHECK( magma_dmalloc_cpu( &C->val, M.nnz ));
+
+    #pragma omp parallel for schedule(static)
+    for( magma_int_t i=0; i<M.nnz; i++ ){
+        C->col[ i ] = M.col[ i ];
+    }
+    #pragma omp parallel for schedule(static)
+    for( magma_int_t i=0; i<M.num_rows+1; i++ ){
+        C->row[ i ] = M.row[ i ];
+    }
+    CHECK( magma_dspgemm_numeric_cpu( alpha, A, B, C, queue ));
+
+cleanup:
+    if( info != 0 ){
+        magma_dmfree( C, queue );
+    }
+    return info;
+}
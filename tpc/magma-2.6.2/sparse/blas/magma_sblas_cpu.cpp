@@ -0,0 +1,614 @@
+/*
+    -- MAGMA (version 2.6.2) --
+       Univ. of Tennessee, Knoxville
+       Univ. of California, Berkeley
+       Univ. of Colorado, Denver
+       @date April 2022
+
+       @generated from sparse/blas/magma_zblas_cpu.cpp, normal z -> s, Sun Oct 18 22:02:53 2026
+       @author Hartwig Anzt
+
+*/
+#include "magmasparse_internal.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#define PRECISION_s
+
+
+/**
+    Purpose
+    -------
+
+    Computes the dot product x^H y of two vectors located in CPU memory.
+    The vectors are split into contiguous chunks among the OpenMP threads.
+    This is the host counterpart of magma_sdot.
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                vector length
+
+    @param[in]
+    x           const float*
+                vector x
+
+    @param[in]
+    incx        magma_int_t
+                stride of x
+
+    @param[in]
+    y           const float*
+                vector y
+
+    @param[in]
+    incy        magma_int_t
+                stride of y
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_sblas
+    ********************************************************************/
+
+extern "C" float
+magma_sdot_cpu(
+    magma_int_t n,
+    const float *x, magma_int_t incx,
+    const float *y, magma_int_t incy,
+    magma_queue_t queue )
+{
+    float sum_re = 0.0;
+#if defined(PRECISION_z) || defined(PRECISION_c)
+    float sum_im = 0.0;
+    #pragma omp parallel for schedule(static) reduction(+:sum_re,sum_im)
+    for( magma_int_t i=0; i<n; i++ ){
+        float tmp = MAGMA_S_CONJ( x[i*incx] ) * y[i*incy];
+        sum_re += MAGMA_S_REAL( tmp );
+        sum_im += MAGMA_S_IMAG( tmp );
+    }
+    return MAGMA_S_MAKE( sum_re, sum_im );
+#else
+    #pragma omp parallel for schedule(static) reduction(+:sum_re)
+    for( magma_int_t i=0; i<n; i++ ){
+        sum_re += x[i*incx] * y[i*incy];
+    }
+    return sum_re;
+#endif
+}
+
+
+/**
+    Purpose
+    -------
+
+    Computes the Euclidean norm of a vector located in CPU memory.
+    This is the host counterpart of magma_snrm2.
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                vector length
+
+    @param[in]
+    x           const float*
+                vector x
+
+    @param[in]
+    incx        magma_int_t
+                stride of x
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_sblas
+    ********************************************************************/
+
+extern "C" float
+magma_snrm2_cpu(
+    magma_int_t n,
+    const float *x, magma_int_t incx,
+    magma_queue_t queue )
+{
+    float sum = 0.0;
+    #pragma omp parallel for schedule(static) reduction(+:sum)
+    for( magma_int_t i=0; i<n; i++ ){
+        float re = MAGMA_S_REAL( x[i*incx] );
+        float im = MAGMA_S_IMAG( x[i*incx] );
+        sum += re*re + im*im;
+    }
+    return sqrt( sum );
+}
+
+
+/**
+    Purpose
+    -------
+
+    Computes y = alpha * x + y for vectors located in CPU memory.
+    This is the host counterpart of magma_saxpy.
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                vector length
+
+    @param[in]
+    alpha       float
+                scalar alpha
+
+    @param[in]
+    x           const float*
+                vector x
+
+    @param[in]
+    incx        magma_int_t
+                stride of x
+
+    @param[in,out]
+    y           float*
+                vector y
+
+    @param[in]
+    incy        magma_int_t
+                stride of y
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_sblas
+    ********************************************************************/
+
+extern "C" void
+magma_saxpy_cpu(
+    magma_int_t n,
+    float alpha,
+    const float *x, magma_int_t incx,
+    float *y, magma_int_t incy,
+    magma_queue_t queue )
+{
+    #pragma omp parallel for schedule(static)
+    for( magma_int_t i=0; i<n; i++ ){
+        y[i*incy] = y[i*incy] + alpha * x[i*incx];
+    }
+}
+
+
+/**
+    Purpose
+    -------
+
+    Computes x = alpha * x for a vector located in CPU memory.
+    This is the host counterpart of magma_sscal.
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                vector length
+
+    @param[in]
+    alpha       float
+                scalar alpha
+
+    @param[in,out]
+    x           float*
+                vector x
+
+    @param[in]
+    incx        magma_int_t
+                stride of x
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_sblas
+    ********************************************************************/
+
+extern "C" void
+magma_sscal_cpu(
+    magma_int_t n,
+    float alpha,
+    float *x, magma_int_t incx,
+    magma_queue_t queue )
+{
+    #pragma omp parallel for schedule(static)
+    for( magma_int_t i=0; i<n; i++ ){
+        x[i*incx] = alpha * x[i*incx];
+    }
+}
+
+
+/**
+    Purpose
+    -------
+
+    Copies the vector x into y, both located in CPU memory.
+    This is the host counterpart of magma_scopy.
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                vector length
+
+    @param[in]
+    x           const float*
+                vector x
+
+    @param[in]
+    incx        magma_int_t
+                stride of x
+
+    @param[out]
+    y           float*
+                vector y
+
+    @param[in]
+    incy        magma_int_t
+                stride of y
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_sblas
+    ********************************************************************/
+
+extern "C" void
+magma_scopy_cpu(
+    magma_int_t n,
+    const float *x, magma_int_t incx,
+    float *y, magma_int_t incy,
+    magma_queue_t queue )
+{
+    #pragma omp parallel for schedule(static)
+    for( magma_int_t i=0; i<n; i++ ){
+        y[i*incy] = x[i*incx];
+    }
+}
+
+
+/**
+    Purpose
+    -------
+
+    This routine computes y = alpha *  A *  x + beta * y on the CPU.
+    The input format is CSR (val, row, col). With transA == MagmaTrans,
+    the arrays are interpreted as the CSC representation of A, i.e.
+    y = alpha * A^T * x + beta * y is computed for the CSR matrix; with
+    more than one thread, this scatters into one private copy of y per
+    thread. For beta == 0, y is not read on input.
+
+    Arguments
+    ---------
+
+    @param[in]
+    transA      magma_trans_t
+                transposition parameter for A
+
+    @param[in]
+    m           magma_int_t
+                number of rows in A
+
+    @param[in]
+    n           magma_int_t
+                number of columns in A
+
+    @param[in]
+    alpha       float
+                scalar multiplier
+
+    @param[in]
+    val         float*
+                array containing values of A in CSR
+
+    @param[in]
+    rowptr      magma_index_t*
+                rowpointer of A in CSR
+
+    @param[in]
+    colind      magma_index_t*
+                columnindices of A in CSR
+
+    @param[in]
+    x           float*
+                input vector x
+
+    @param[in]
+    beta        float
+                scalar multiplier
+
+    @param[out]
+    y           float*
+                input/output vector y
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_sblas
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_sgecsrmv_cpu(
+    magma_trans_t transA,
+    magma_int_t m, magma_int_t n,
+    float alpha,
+    float *val,
+    magma_index_t *rowptr,
+    magma_index_t *colind,
+    float *x,
+    float beta,
+    float *y,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+    float c_zero = MAGMA_S_ZERO;
+    float *work = NULL;
+    magma_int_t num_threads = 1;
+
+#ifdef _OPENMP
+    num_threads = omp_get_max_threads();
+#endif
+
+    if ( transA == MagmaNoTrans ) {
+        // rows are independent: dynamic chunks balance rows of varying length
+        #pragma omp parallel for schedule(dynamic,256)
+        for( magma_int_t i=0; i<m; i++ ){
+            float dot = c_zero;
+            for( magma_int_t j=rowptr[i]; j<rowptr[i+1]; j++ ){
+                dot += val[j] * x[ colind[j] ];
+            }
+            y[i] = ( MAGMA_S_EQUAL( beta, c_zero ) )
+                        ? alpha * dot : alpha * dot + beta * y[i];
+        }
+    } else if ( num_threads == 1 ) {
+        // scatter along the columns of the CSR structure
+        for( magma_int_t j=0; j<n; j++ ){
+            y[j] = ( MAGMA_S_EQUAL( beta, c_zero ) ) ? c_zero : beta * y[j];
+        }
+        for( magma_int_t i=0; i<m; i++ ){
+            float ax = alpha * x[i];
+            for( magma_int_t j=rowptr[i]; j<rowptr[i+1]; j++ ){
+                y[ colind[j] ] += val[j] * ax;
+            }
+        }
+    } else {
+        // every thread scatters its rows into a private copy of y,
+        // the copies are summed up column-wise afterwards
+        CHECK( magma_smalloc_cpu( &work, (size_t)num_threads * n ));
+        #pragma omp parallel num_threads(num_threads)
+        {
+            magma_int_t id = 0;
+#ifdef _OPENMP
+            id = omp_get_thread_num();
+#endif
+            float *ylocal = work + (size_t)id * n;
+            for( magma_int_t j=0; j<n; j++ ){
+                ylocal[j] = c_zero;
+            }
+            #pragma omp for schedule(dynamic,256)
+            for( magma_int_t i=0; i<m; i++ ){
+                float ax = alpha * x[i];
+                for( magma_int_t j=rowptr[i]; j<rowptr[i+1]; j++ ){
+                    ylocal[ colind[j] ] += val[j] * ax;
+                }
+            }
+            #pragma omp for schedule(static)
+            for( magma_int_t j=0; j<n; j++ ){
+                float s = c_zero;
+                for( magma_int_t t=0; t<num_threads; t++ ){
+                    s += work[ (size_t)t * n + j ];
+                }
+                y[j] = ( MAGMA_S_EQUAL( beta, c_zero ) ) ? s : beta * y[j] + s;
+            }
+        }
+    }
+
+cleanup:
+    magma_free_cpu( work );
+    return info;
+}
+
+
+/**
+    Purpose
+    -------
+
+    Solves the triangular system A x = b on the CPU via forward (uplo =
+    MagmaLower) or backward (uplo = MagmaUpper) substitution. A is stored in
+    CSR format; the entries of a row need not be sorted, and the diagonal
+    entry has to be present in every row. Entries in the opposite triangle
+    are ignored. x and b may not alias.
+
+    Arguments
+    ---------
+
+    @param[in]
+    uplo        magma_uplo_t
+                MagmaLower or MagmaUpper
+
+    @param[in]
+    A           magma_s_matrix
+                triangular matrix in CSR on the CPU
+
+    @param[in]
+    b           float*
+                right-hand side
+
+    @param[out]
+    x           float*
+                solution
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_sblas
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_scsrtrsv_cpu(
+    magma_uplo_t uplo,
+    magma_s_matrix A,
+    float *b,
+    float *x,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+    float c_zero = MAGMA_S_ZERO;
+
+    if ( uplo == MagmaLower ) {
+        for( magma_int_t i=0; i<A.num_rows; i++ ){
+            float s = b[i], diag = c_zero;
+            for( magma_int_t j=A.row[i]; j<A.row[i+1]; j++ ){
+                magma_index_t col = A.col[j];
+                if ( col < i ) {
+                    s -= A.val[j] * x[col];
+                } else if ( col == i ) {
+                    diag = A.val[j];
+                }
+            }
+            if ( MAGMA_S_EQUAL( diag, c_zero ) ) {
+                info = MAGMA_ERR_NOT_SUPPORTED;
+                goto cleanup;
+            }
+            x[i] = s / diag;
+        }
+    } else {
+        for( magma_int_t i=A.num_rows-1; i>=0; i-- ){
+            float s = b[i], diag = c_zero;
+            for( magma_int_t j=A.row[i]; j<A.row[i+1]; j++ ){
+                magma_index_t col = A.col[j];
+                if ( col > i ) {
+                    s -= A.val[j] * x[col];
+                } else if ( col == i ) {
+                    diag = A.val[j];
+                }
+            }
+            if ( MAGMA_S_EQUAL( diag, c_zero ) ) {
+                info = MAGMA_ERR_NOT_SUPPORTED;
+                goto cleanup;
+            }
+            x[i] = s / diag;
+        }
+    }
+
+cleanup:
+    return info;
+}
+
+
+/**
+    Purpose
+    -------
+
+    Solves the triangular system A x = b on the CPU for a matrix in
+    multicolor ordering, see magma_smcolor: rows of the same color do not
+    depend on each other, hence every color is processed in parallel. The
+    colors are traversed in increasing order for uplo = MagmaLower and in
+    decreasing order for uplo = MagmaUpper. As in magma_scsrtrsv_cpu,
+    entries in the opposite triangle are ignored, and the diagonal entries
+    have to be present and nonzero, otherwise MAGMA_ERR_NOT_SUPPORTED is
+    returned. x and b may not alias.
+
+    Arguments
+    ---------
+
+    @param[in]
+    uplo        magma_uplo_t
+                MagmaLower or MagmaUpper
+
+    @param[in]
+    A           magma_s_matrix
+                triangular matrix in CSR on the CPU
+
+    @param[in]
+    ncolors     magma_int_t
+                number of colors
+
+    @param[in]
+    colorptr    magma_index_t*
+                first row of every color (ncolors+1 entries)
+
+    @param[in]
+    b           float*
+                right-hand side
+
+    @param[out]
+    x           float*
+                solution
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_sblas
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_scsrtrsv_mc_cpu(
+    magma_uplo_t uplo,
+    magma_s_matrix A,
+    magma_int_t ncolors,
+    magma_index_t *colorptr,
+    float *b,
+    float *x,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+    float c_zero = MAGMA_S_ZERO;
+    magma_int_t zerodiag = 0;
+
+    #pragma omp parallel
+    for( magma_int_t k=0; k<ncolors; k++ ){
+        magma_int_t c = ( uplo == MagmaLower ) ? k : ncolors-1-k;
+        #pragma omp for schedule(static)
+        for( magma_int_t i=colorptr[c]; i<colorptr[c+1]; i++ ){
+            float s = b[i], diag = c_zero;
+            for( magma_int_t j=A.row[i]; j<A.row[i+1]; j++ ){
+                magma_index_t col = A.col[j];
+                if ( col == i ) {
+                    diag = A.val[j];
+                } else if ( ( uplo == MagmaLower ) == ( col < i ) ) {
+                    s -= A.val[j] * x[col];
+                }
+            }
+            if ( MAGMA_S_EQUAL( diag, c_zero ) ) {
+                #pragma omp atomic write
+                zerodiag = 1;
+            } else {
+                x[i] = s / diag;
+            }
+        }
+        // the barrier of the loop above makes the flag visible to all
+        // threads, the second one keeps it from changing before every
+        // thread has read it, so they leave the color loop together
+        magma_int_t stop;
+        #pragma omp atomic read
+        stop = zerodiag;
+        #pragma omp barrier
+        if ( stop ) {
+            break;
+        }
+    }
+    if ( zerodiag ) {
+        info = MAGMA_ERR_NOT_SUPPORTED;
+    }
+
+    return info;
+}
@@ -0,0 +1,614 @@
+/*
+    -- MAGMA (version 2.6.2) --
+       Univ. of Tennessee, Knoxville
+       Univ. of California, Berkeley
+       Univ. of Colorado, Denver
+       @date April 2022
+
+       @precisions normal z -> c d s
+       @author Hartwig Anzt
+
+*/
+#include "magmasparse_internal.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#define PRECISION_z
+
+
+/**
+    Purpose
+    -------
+
+    Computes the dot product x^H y of two vectors located in CPU memory.
+    The vectors are split into contiguous chunks among the OpenMP threads.
+    This is the host counterpart of magma_zdotc.
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                vector length
+
+    @param[in]
+    x           const magmaDoubleComplex*
+                vector x
+
+    @param[in]
+    incx        magma_int_t
+                stride of x
+
+    @param[in]
+    y           const magmaDoubleComplex*
+                vector y
+
+    @param[in]
+    incy        magma_int_t
+                stride of y
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_zblas
+    ********************************************************************/
+
+extern "C" magmaDoubleComplex
+magma_zdotc_cpu(
+    magma_int_t n,
+    const magmaDoubleComplex *x, magma_int_t incx,
+    const magmaDoubleComplex *y, magma_int_t incy,
+    magma_queue_t queue )
+{
+    double sum_re = 0.0;
+#if defined(PRECISION_z) || defined(PRECISION_c)
+    double sum_im = 0.0;
+    #pragma omp parallel for schedule(static) reduction(+:sum_re,sum_im)
+    for( magma_int_t i=0; i<n; i++ ){
+        magmaDoubleComplex tmp = MAGMA_Z_CONJ( x[i*incx] ) * y[i*incy];
+        sum_re += MAGMA_Z_REAL( tmp );
+        sum_im += MAGMA_Z_IMAG( tmp );
+    }
+    return MAGMA_Z_MAKE( sum_re, sum_im );
+#else
+    #pragma omp parallel for schedule(static) reduction(+:sum_re)
+    for( magma_int_t i=0; i<n; i++ ){
+        sum_re += x[i*incx] * y[i*incy];
+    }
+    return sum_re;
+#endif
+}
+
+
+/**
+    Purpose
+    -------
+
+    Computes the Euclidean norm of a vector located in CPU memory.
+    This is the host counterpart of magma_dznrm2.
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                vector length
+
+    @param[in]
+    x           const magmaDoubleComplex*
+                vector x
+
+    @param[in]
+    incx        magma_int_t
+                stride of x
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_zblas
+    ********************************************************************/
+
+extern "C" double
+magma_dznrm2_cpu(
+    magma_int_t n,
+    const magmaDoubleComplex *x, magma_int_t incx,
+    magma_queue_t queue )
+{
+    double sum = 0.0;
+    #pragma omp parallel for schedule(static) reduction(+:sum)
+    for( magma_int_t i=0; i<n; i++ ){
+        double re = MAGMA_Z_REAL( x[i*incx] );
+        double im = MAGMA_Z_IMAG( x[i*incx] );
+        sum += re*re + im*im;
+    }
+    return sqrt( sum );
+}
+
+
+/**
+    Purpose
+    -------
+
+    Computes y = alpha * x + y for vectors located in CPU memory.
+    This is the host counterpart of magma_zaxpy.
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                vector length
+
+    @param[in]
+    alpha       magmaDoubleComplex
+                scalar alpha
+
+    @param[in]
+    x           const magmaDoubleComplex*
+                vector x
+
+    @param[in]
+    incx        magma_int_t
+                stride of x
+
+    @param[in,out]
+    y           magmaDoubleComplex*
+                vector y
+
+    @param[in]
+    incy        magma_int_t
+                stride of y
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_zblas
+    ********************************************************************/
+
+extern "C" void
+magma_zaxpy_cpu(
+    magma_int_t n,
+    magmaDoubleComplex alpha,
+    const magmaDoubleComplex *x, magma_int_t incx,
+    magmaDoubleComplex *y, magma_int_t incy,
+    magma_queue_t queue )
+{
+    #pragma omp parallel for schedule(static)
+    for( magma_int_t i=0; i<n; i++ ){
+        y[i*incy] = y[i*incy] + alpha * x[i*incx];
+    }
+}
+
+
+/**
+    Purpose
+    -------
+
+    Computes x = alpha * x for a vector located in CPU memory.
+    This is the host counterpart of magma_zscal.
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                vector length
+
+    @param[in]
+    alpha       magmaDoubleComplex
+                scalar alpha
+
+    @param[in,out]
+    x           magmaDoubleComplex*
+                vector x
+
+    @param[in]
+    incx        magma_int_t
+                stride of x
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_zblas
+    ********************************************************************/
+
+extern "C" void
+magma_zscal_cpu(
+    magma_int_t n,
+    magmaDoubleComplex alpha,
+    magmaDoubleComplex *x, magma_int_t incx,
+    magma_queue_t queue )
+{
+    #pragma omp parallel for schedule(static)
+    for( magma_int_t i=0; i<n; i++ ){
+        x[i*incx] = alpha * x[i*incx];
+    }
+}
+
+
+/**
+    Purpose
+    -------
+
+    Copies the vector x into y, both located in CPU memory.
+    This is the host counterpart of magma_zcopy.
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                vector length
+
+    @param[in]
+    x           const magmaDoubleComplex*
+                vector x
+
+    @param[in]
+    incx        magma_int_t
+                stride of x
+
+    @param[out]
+    y           magmaDoubleComplex*
+                vector y
+
+    @param[in]
+    incy        magma_int_t
+                stride of y
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_zblas
+    ********************************************************************/
+
+extern "C" void
+magma_zcopy_cpu(
+    magma_int_t n,
+    const magmaDoubleComplex *x, magma_int_t incx,
+    magmaDoubleComplex *y, magma_int_t incy,
+    magma_queue_t queue )
+{
+    #pragma omp parallel for schedule(static)
+    for( magma_int_t i=0; i<n; i++ ){
+        y[i*incy] = x[i*incx];
+    }
+}
+
+
+/**
+    Purpose
+    -------
+
+    This routine computes y = alpha *  A *  x + beta * y on the CPU.
+    The input format is CSR (val, row, col). With transA == MagmaTrans,
+    the arrays are interpreted as the CSC representation of A, i.e.
+    y = alpha * A^T * x + beta * y is computed for the CSR matrix; with
+    more than one thread, this scatters into one private copy of y per
+    thread. For beta == 0, y is not read on input.
+
+    Arguments
+    ---------
+
+    @param[in]
+    transA      magma_trans_t
+                transposition parameter for A
+
+    @param[in]
+    m           magma_int_t
+                number of rows in A
+
+    @param[in]
+    n           magma_int_t
+                number of columns in A
+
+    @param[in]
+    alpha       magmaDoubleComplex
+                scalar multiplier
+
+    @param[in]
+    val         magmaDoubleComplex*
+                array containing values of A in CSR
+
+    @param[in]
+    rowptr      magma_index_t*
+                rowpointer of A in CSR
+
+    @param[in]
+    colind      magma_index_t*
+                columnindices of A in CSR
+
+    @param[in]
+    x           magmaDoubleComplex*
+                input vector x
+
+    @param[in]
+    beta        magmaDoubleComplex
+                scalar multiplier
+
+    @param[out]
+    y           magmaDoubleComplex*
+                input/output vector y
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_zblas
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_zgecsrmv_cpu(
+    magma_trans_t transA,
+    magma_int_t m, magma_int_t n,
+    magmaDoubleComplex alpha,
+    magmaDoubleComplex *val,
+    magma_index_t *rowptr,
+    magma_index_t *colind,
+    magmaDoubleComplex *x,
+    magmaDoubleComplex beta,
+    magmaDoubleComplex *y,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+    magmaDoubleComplex c_zero = MAGMA_Z_ZERO;
+    magmaDoubleComplex *work = NULL;
+    magma_int_t num_threads = 1;
+
+#ifdef _OPENMP
+    num_threads = omp_get_max_threads();
+#endif
+
+    if ( transA == MagmaNoTrans ) {
+        // rows are independent: dynamic chunks balance rows of varying length
+        #pragma omp parallel for schedule(dynamic,256)
+        for( magma_int_t i=0; i<m; i++ ){
+            magmaDoubleComplex dot = c_zero;
+            for( magma_int_t j=rowptr[i]; j<rowptr[i+1]; j++ ){
+                dot += val[j] * x[ colind[j] ];
+            }
+            y[i] = ( MAGMA_Z_EQUAL( beta, c_zero ) )
+                        ? alpha * dot : alpha * dot + beta * y[i];
+        }
+    } else if ( num_threads == 1 ) {
+        // scatter along the columns of the CSR structure
+        for( magma_int_t j=0; j<n; j++ ){
+            y[j] = ( MAGMA_Z_EQUAL( beta, c_zero ) ) ? c_zero : beta * y[j];
+        }
+        for( magma_int_t i=0; i<m; i++ ){
+            magmaDoubleComplex ax = alpha * x[i];
+            for( magma_int_t j=rowptr[i]; j<rowptr[i+1]; j++ ){
+                y[ colind[j] ] += val[j] * ax;
+            }
+        }
+    } else {
+        // every thread scatters its rows into a private copy of y,
+        // the copies are summed up column-wise afterwards
+        CHECK( magma_zmalloc_cpu( &work, (size_t)num_threads * n ));
+        #pragma omp parallel num_threads(num_threads)
+        {
+            magma_int_t id = 0;
+#ifdef _OPENMP
+            id = omp_get_thread_num();
+#endif
+            magmaDoubleComplex *ylocal = work + (size_t)id * n;
+            for( magma_int_t j=0; j<n; j++ ){
+                ylocal[j] = c_zero;
+            }
+            #pragma omp for schedule(dynamic,256)
+            for( magma_int_t i=0; i<m; i++ ){
+                magmaDoubleComplex ax = alpha * x[i];
+                for( magma_int_t j=rowptr[i]; j<rowptr[i+1]; j++ ){
+                    ylocal[ colind[j] ] += val[j] * ax;
+                }
+            }
+            #pragma omp for schedule(static)
+            for( magma_int_t j=0; j<n; j++ ){
+                magmaDoubleComplex s = c_zero;
+                for( magma_int_t t=0; t<num_threads; t++ ){
+                    s += work[ (size_t)t * n + j ];
+                }
+                y[j] = ( MAGMA_Z_EQUAL( beta, c_zero ) ) ? s : beta * y[j] + s;
+            }
+        }
+    }
+
+cleanup:
+    magma_free_cpu( work );
+    return info;
+}
+
+
+/**
+    Purpose
+    -------
+
+    Solves the triangular system A x = b on the CPU via forward (uplo =
+    MagmaLower) or backward (uplo = MagmaUpper) substitution. A is stored in
+    CSR format; the entries of a row need not be sorted, and the diagonal
+    entry has to be present in every row. Entries in the opposite triangle
+    are ignored. x and b may not alias.
+
+    Arguments
+    ---------
+
+    @param[in]
+    uplo        magma_uplo_t
+                MagmaLower or MagmaUpper
+
+    @param[in]
+    A           magma_z_matrix
+                triangular matrix in CSR on the CPU
+
+    @param[in]
+    b           magmaDoubleComplex*
+                right-hand side
+
+    @param[out]
+    x           magmaDoubleComplex*
+                solution
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_zblas
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_zcsrtrsv_cpu(
+    magma_uplo_t uplo,
+    magma_z_matrix A,
+    magmaDoubleComplex *b,
+    magmaDoubleComplex *x,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+    magmaDoubleComplex c_zero = MAGMA_Z_ZERO;
+
+    if ( uplo == MagmaLower ) {
+        for( magma_int_t i=0; i<A.num_rows; i++ ){
+            magmaDoubleComplex s = b[i], diag = c_zero;
+            for( magma_int_t j=A.row[i]; j<A.row[i+1]; j++ ){
+                magma_index_t col = A.col[j];
+                if ( col < i ) {
+                    s -= A.val[j] * x[col];
+                } else if ( col == i ) {
+                    diag = A.val[j];
+                }
+            }
+            if ( MAGMA_Z_EQUAL( diag, c_zero ) ) {
+                info = MAGMA_ERR_NOT_SUPPORTED;
+                goto cleanup;
+            }
+            x[i] = s / diag;
+        }
+    } else {
+        for( magma_int_t i=A.num_rows-1; i>=0; i-- ){
+            magmaDoubleComplex s = b[i], diag = c_zero;
+            for( magma_int_t j=A.row[i]; j<A.row[i+1]; j++ ){
+                magma_index_t col = A.col[j];
+                if ( col > i ) {
+                    s -= A.val[j] * x[col];
+                } else if ( col == i ) {
+                    diag = A.val[j];
+                }
+            }
+            if ( MAGMA_Z_EQUAL( diag, c_zero ) ) {
+                info = MAGMA_ERR_NOT_SUPPORTED;
+                goto cleanup;
+            }
+            x[i] = s / diag;
+        }
+    }
+
+cleanup:
+    return info;
+}
+
+
+/**
+    Purpose
+    -------
+
+    Solves the triangular system A x = b on the CPU for a matrix in
+    multicolor ordering, see magma_zmcolor: rows of the same color do not
+    depend on each other, hence every color is processed in parallel. The
+    colors are traversed in increasing order for uplo = MagmaLower and in
+    decreasing order for uplo = MagmaUpper. As in magma_zcsrtrsv_cpu,
+    entries in the opposite triangle are ignored, and the diagonal entries
+    have to be present and nonzero, otherwise MAGMA_ERR_NOT_SUPPORTED is
+    returned. x and b may not alias.
+
+    Arguments
+    ---------
+
+    @param[in]
+    uplo        magma_uplo_t
+                MagmaLower or MagmaUpper
+
+    @param[in]
+    A           magma_z_matrix
+                triangular matrix in CSR on the CPU
+
+    @param[in]
+    ncolors     magma_int_t
+                number of colors
+
+    @param[in]
+    colorptr    magma_index_t*
+                first row of every color (ncolors+1 entries)
+
+    @param[in]
+    b           magmaDoubleComplex*
+                right-hand side
+
+    @param[out]
+    x           magmaDoubleComplex*
+                solution
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_zblas
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_zcsrtrsv_mc_cpu(
+    magma_uplo_t uplo,
+    magma_z_matrix A,
+    magma_int_t ncolors,
+    magma_index_t *colorptr,
+    magmaDoubleComplex *b,
+    magmaDoubleComplex *x,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+    magmaDoubleComplex c_zero = MAGMA_Z_ZERO;
+    magma_int_t zerodiag = 0;
+
+    #pragma omp parallel
+    for( magma_int_t k=0; k<ncolors; k++ ){
+        magma_int_t c = ( uplo == MagmaLower ) ? k : ncolors-1-k;
+        #pragma omp for schedule(static)
+        for( magma_int_t i=colorptr[c]; i<colorptr[c+1]; i++ ){
+            magmaDoubleComplex s = b[i], diag = c_zero;
+            for( magma_int_t j=A.row[i]; j<A.row[i+1]; j++ ){
+                magma_index_t col = A.col[j];
+                if ( col == i ) {
+                    diag = A.val[j];
+                } else if ( ( uplo == MagmaLower ) == ( col < i ) ) {
+                    s -= A.val[j] * x[col];
+                }
+            }
+            if ( MAGMA_Z_EQUAL( diag, c_zero ) ) {
+                #pragma omp atomic write
+                zerodiag = 1;
+            } else {
+                x[i] = s / diag;
+            }
+        }
+        // the barrier of the loop above makes the flag visible to all
+        // threads, the second one keeps it from changing before every
+        // thread has read it, so they leave the color loop together
+        magma_int_t stop;
+        #pragma omp atomic read
+        stop = zerodiag;
+        #pragma omp barrier
+        if ( stop ) {
+            break;
+        }
+    }
+    if ( zerodiag ) {
+        info = MAGMA_ERR_NOT_SUPPORTED;
+    }
+
+    return info;
+}
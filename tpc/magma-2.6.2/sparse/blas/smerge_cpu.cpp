@@ -0,0 +1,728 @@
+/*
+    -- MAGMA (version 2.6.2) --
+       Univ. of Tennessee, Knoxville
+       Univ. of California, Berkeley
+       Univ. of Colorado, Denver
+       @date April 2022
+
+       @generated from sparse/blas/zmerge_cpu.cpp, normal z -> s, Sun Oct 18 19:36:20 2026
+       @author Hartwig Anzt
+
+*/
+#include "magmasparse_internal.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#define PRECISION_s
+
+
+/*
+    Fused host kernels for the merged CG and BiCGSTAB solvers.
+
+    Every kernel performs one sweep over the vectors. The index range is
+    split into one contiguous block per OpenMP thread (essentially the
+    partition schedule(static) uses when magma_svinit touches the vectors
+    first), so a thread mostly streams through memory local to its NUMA node.
+    Each thread reduces its block with SIMD instructions; the partial sums are
+    then combined in thread order, so the results are bitwise reproducible
+    for a fixed number of threads.
+*/
+
+// contiguous block [start, end) of thread tid out of nthreads
+static inline void
+smerge_range(
+    magma_int_t n,
+    magma_int_t *start,
+    magma_int_t *end )
+{
+#ifdef _OPENMP
+    magma_int_t nthreads = omp_get_num_threads();
+    magma_int_t tid = omp_get_thread_num();
+#else
+    magma_int_t nthreads = 1;
+    magma_int_t tid = 0;
+#endif
+    magma_int_t chunk = magma_ceildiv( n, nthreads );
+    *start = min( n, tid*chunk );
+    *end = min( n, *start + chunk );
+}
+
+
+static inline magma_int_t
+smerge_nthreads()
+{
+#ifdef _OPENMP
+    return omp_get_num_threads();
+#else
+    return 1;
+#endif
+}
+
+
+// y = A x on the CPU with reductions wy = w^H y and (if yy != NULL)
+// yy = y^H y fused into the same sweep.
+static magma_int_t
+smerge_spmv_dot(
+    magma_s_matrix A,
+    float *x,
+    float *y,
+    float *w,
+    float *wy,
+    float *yy,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+    float wy_re = 0.0, wy_im = 0.0, yy_re = 0.0;
+
+    if ( A.storage_type == Magma_CSR || A.storage_type == Magma_CUCSR ) {
+        #pragma omp parallel
+        {
+            magma_int_t start, end;
+            float lwy_re = 0.0, lwy_im = 0.0, lyy_re = 0.0;
+            smerge_range( A.num_rows, &start, &end );
+            for( magma_int_t i=start; i<end; i++ ){
+                float dot = MAGMA_S_ZERO;
+                for( magma_int_t j=A.row[i]; j<A.row[i+1]; j++ ){
+                    dot += A.val[j] * x[ A.col[j] ];
+                }
+                y[i] = dot;
+                float tmp = MAGMA_S_CONJ( w[i] ) * dot;
+                lwy_re += MAGMA_S_REAL( tmp );
+                lwy_im += MAGMA_S_IMAG( tmp );
+                lyy_re += MAGMA_S_REAL( dot ) * MAGMA_S_REAL( dot )
+                        + MAGMA_S_IMAG( dot ) * MAGMA_S_IMAG( dot );
+            }
+            #pragma omp for ordered schedule(static,1)
+            for( magma_int_t tid=0; tid<smerge_nthreads(); tid++ ){
+                #pragma omp ordered
+                {
+                    wy_re += lwy_re;
+                    wy_im += lwy_im;
+                    yy_re += lyy_re;
+                }
+            }
+        }
+        *wy = MAGMA_S_MAKE( wy_re, wy_im );
+        if ( yy != NULL ) {
+            *yy = yy_re;
+        }
+    }
+    else {
+        // other formats: SpMV and reduction in separate sweeps
+        magma_s_matrix xv={Magma_CSR}, yv={Magma_CSR};
+        CHECK( magma_svset( A.num_cols, 1, x, &xv, queue ));
+        CHECK( magma_svset( A.num_rows, 1, y, &yv, queue ));
+        CHECK( magma_s_spmv( MAGMA_S_ONE, A, xv, MAGMA_S_ZERO, yv, queue ));
+        *wy = magma_sdot_cpu( A.num_rows, w, 1, y, 1, queue );
+        if ( yy != NULL ) {
+            float nrm = magma_snrm2_cpu( A.num_rows, y, 1, queue );
+            *yy = nrm * nrm;
+        }
+    }
+
+cleanup:
+    return info;
+}
+
+
+/**
+    Purpose
+    -------
+
+    Merges the SpMV z = A d with the dot product den = d^H z of the CG
+    iteration into one sweep. A is expected in CSR format in CPU memory;
+    other formats fall back to a separate SpMV and dot product.
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_s_matrix
+                system matrix
+
+    @param[in]
+    d           float*
+                search direction
+
+    @param[out]
+    z           float*
+                z = A d
+
+    @param[out]
+    den         float*
+                den = d^H z
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_sgegpuk
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_scgmerge_spmv1_cpu(
+    magma_s_matrix A,
+    float *d,
+    float *z,
+    float *den,
+    magma_queue_t queue )
+{
+    return smerge_spmv_dot( A, d, z, d, den, NULL, queue );
+}
+
+
+/**
+    Purpose
+    -------
+
+    Merges the updates of the CG iterate and residual with the computation
+    of the new residual norm:
+
+    x = x + alpha d
+    r = r - alpha z
+    nrm2 = r^H r
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                vector length
+
+    @param[in]
+    alpha       float
+                step length
+
+    @param[in]
+    d           float*
+                search direction
+
+    @param[in]
+    z           float*
+                z = A d
+
+    @param[in,out]
+    x           float*
+                iterate
+
+    @param[in,out]
+    r           float*
+                residual
+
+    @param[out]
+    nrm2        float*
+                squared residual norm
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_sgegpuk
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_scgmerge_xr_cpu(
+    magma_int_t n,
+    float alpha,
+    float *d,
+    float *z,
+    float *x,
+    float *r,
+    float *nrm2,
+    magma_queue_t queue )
+{
+    float sum = 0.0;
+
+    #pragma omp parallel
+    {
+        magma_int_t start, end;
+        float loc = 0.0;
+        smerge_range( n, &start, &end );
+        #pragma omp simd reduction(+:loc)
+        for( magma_int_t i=start; i<end; i++ ){
+            x[i] = x[i] + alpha * d[i];
+            float ri = r[i] - alpha * z[i];
+            r[i] = ri;
+            loc += MAGMA_S_REAL( ri ) * MAGMA_S_REAL( ri )
+                 + MAGMA_S_IMAG( ri ) * MAGMA_S_IMAG( ri );
+        }
+        #pragma omp for ordered schedule(static,1)
+        for( magma_int_t tid=0; tid<smerge_nthreads(); tid++ ){
+            #pragma omp ordered
+            sum += loc;
+        }
+    }
+    *nrm2 = sum;
+
+    return MAGMA_SUCCESS;
+}
+
+
+/**
+    Purpose
+    -------
+
+    Updates the CG search direction: d = h + beta d
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                vector length
+
+    @param[in]
+    beta        float
+                scalar beta
+
+    @param[in]
+    h           float*
+                (preconditioned) residual
+
+    @param[in,out]
+    d           float*
+                search direction
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_sgegpuk
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_scgmerge_d_cpu(
+    magma_int_t n,
+    float beta,
+    float *h,
+    float *d,
+    magma_queue_t queue )
+{
+    #pragma omp parallel
+    {
+        magma_int_t start, end;
+        smerge_range( n, &start, &end );
+        #pragma omp simd
+        for( magma_int_t i=start; i<end; i++ ){
+            d[i] = h[i] + beta * d[i];
+        }
+    }
+
+    return MAGMA_SUCCESS;
+}
+
+
+/**
+    Purpose
+    -------
+
+    Computes the inner product r^H h of the preconditioned CG with the
+    same partition and reduction order as the other fused kernels.
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                vector length
+
+    @param[in]
+    r           float*
+                residual
+
+    @param[in]
+    h           float*
+                preconditioned residual
+
+    @param[out]
+    rh          float*
+                rh = r^H h
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_sgegpuk
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_scgmerge_rh_cpu(
+    magma_int_t n,
+    float *r,
+    float *h,
+    float *rh,
+    magma_queue_t queue )
+{
+    float sum_re = 0.0, sum_im = 0.0;
+
+    #pragma omp parallel
+    {
+        magma_int_t start, end;
+        float loc_re = 0.0, loc_im = 0.0;
+        smerge_range( n, &start, &end );
+        #pragma omp simd reduction(+:loc_re,loc_im)
+        for( magma_int_t i=start; i<end; i++ ){
+            float tmp = MAGMA_S_CONJ( r[i] ) * h[i];
+            loc_re += MAGMA_S_REAL( tmp );
+            loc_im += MAGMA_S_IMAG( tmp );
+        }
+        #pragma omp for ordered schedule(static,1)
+        for( magma_int_t tid=0; tid<smerge_nthreads(); tid++ ){
+            #pragma omp ordered
+            {
+                sum_re += loc_re;
+                sum_im += loc_im;
+            }
+        }
+    }
+    *rh = MAGMA_S_MAKE( sum_re, sum_im );
+
+    return MAGMA_SUCCESS;
+}
+
+
+/**
+    Purpose
+    -------
+
+    First BiCGSTAB update: p = r + beta * ( p - omega * v )
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                vector length
+
+    @param[in]
+    beta        float
+                scalar beta
+
+    @param[in]
+    omega       float
+                scalar omega
+
+    @param[in]
+    r           float*
+                residual
+
+    @param[in]
+    v           float*
+                v = A p of the previous iteration
+
+    @param[in,out]
+    p           float*
+                search direction
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_sgegpuk
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_sbicgmerge1_cpu(
+    magma_int_t n,
+    float beta,
+    float omega,
+    float *r,
+    float *v,
+    float *p,
+    magma_queue_t queue )
+{
+    #pragma omp parallel
+    {
+        magma_int_t start, end;
+        smerge_range( n, &start, &end );
+        #pragma omp simd
+        for( magma_int_t i=start; i<end; i++ ){
+            p[i] = r[i] + beta * ( p[i] - omega * v[i] );
+        }
+    }
+
+    return MAGMA_SUCCESS;
+}
+
+
+/**
+    Purpose
+    -------
+
+    Merges the first BiCGSTAB SpMV v = A p with the dot product
+    rrv = rr^H v into one sweep.
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_s_matrix
+                system matrix
+
+    @param[in]
+    rr          float*
+                shadow residual
+
+    @param[in]
+    p           float*
+                search direction
+
+    @param[out]
+    v           float*
+                v = A p
+
+    @param[out]
+    rrv         float*
+                rrv = rr^H v
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_sgegpuk
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_sbicgmerge_spmv1_cpu(
+    magma_s_matrix A,
+    float *rr,
+    float *p,
+    float *v,
+    float *rrv,
+    magma_queue_t queue )
+{
+    return smerge_spmv_dot( A, p, v, rr, rrv, NULL, queue );
+}
+
+
+/**
+    Purpose
+    -------
+
+    Second BiCGSTAB update: s = r - alpha v
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                vector length
+
+    @param[in]
+    alpha       float
+                scalar alpha
+
+    @param[in]
+    r           float*
+                residual
+
+    @param[in]
+    v           float*
+                v = A p
+
+    @param[out]
+    s           float*
+                s = r - alpha v
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_sgegpuk
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_sbicgmerge2_cpu(
+    magma_int_t n,
+    float alpha,
+    float *r,
+    float *v,
+    float *s,
+    magma_queue_t queue )
+{
+    #pragma omp parallel
+    {
+        magma_int_t start, end;
+        smerge_range( n, &start, &end );
+        #pragma omp simd
+        for( magma_int_t i=start; i<end; i++ ){
+            s[i] = r[i] - alpha * v[i];
+        }
+    }
+
+    return MAGMA_SUCCESS;
+}
+
+
+/**
+    Purpose
+    -------
+
+    Merges the second BiCGSTAB SpMV t = A s with the dot products
+    ts = t^H s and tt = t^H t into one sweep.
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_s_matrix
+                system matrix
+
+    @param[in]
+    s           float*
+                s = r - alpha v
+
+    @param[out]
+    t           float*
+                t = A s
+
+    @param[out]
+    ts          float*
+                ts = t^H s
+
+    @param[out]
+    tt          float*
+                tt = t^H t
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_sgegpuk
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_sbicgmerge_spmv2_cpu(
+    magma_s_matrix A,
+    float *s,
+    float *t,
+    float *ts,
+    float *tt,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+    float st;
+
+    CHECK( smerge_spmv_dot( A, s, t, s, &st, tt, queue ));
+    *ts = MAGMA_S_CONJ( st );
+
+cleanup:
+    return info;
+}
+
+
+/**
+    Purpose
+    -------
+
+    Merges the last BiCGSTAB updates with the reductions needed for the
+    convergence check and the next iteration:
+
+    x = x + alpha p + omega s
+    r = s - omega t
+    rho = rr^H r
+    nrm2 = r^H r
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                vector length
+
+    @param[in]
+    alpha       float
+                scalar alpha
+
+    @param[in]
+    omega       float
+                scalar omega
+
+    @param[in]
+    rr          float*
+                shadow residual
+
+    @param[in]
+    p           float*
+                search direction
+
+    @param[in]
+    s           float*
+                s = r - alpha v
+
+    @param[in]
+    t           float*
+                t = A s
+
+    @param[in,out]
+    x           float*
+                iterate
+
+    @param[out]
+    r           float*
+                residual
+
+    @param[out]
+    rho         float*
+                rho = rr^H r
+
+    @param[out]
+    nrm2        float*
+                squared residual norm
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_sgegpuk
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_sbicgmerge_xrbeta_cpu(
+    magma_int_t n,
+    float alpha,
+    float omega,
+    float *rr,
+    float *p,
+    float *s,
+    float *t,
+    float *x,
+    float *r,
+    float *rho,
+    float *nrm2,
+    magma_queue_t queue )
+{
+    float rho_re = 0.0, rho_im = 0.0, nrm = 0.0;
+
+    #pragma omp parallel
+    {
+        magma_int_t start, end;
+        float lrho_re = 0.0, lrho_im = 0.0, lnrm = 0.0;
+        smerge_range( n, &start, &end );
+        #pragma omp simd reduction(+:lrho_re,lrho_im,lnrm)
+        for( magma_int_t i=start; i<end; i++ ){
+            x[i] = x[i] + alpha * p[i] + omega * s[i];
+            float ri = s[i] - omega * t[i];
+            r[i] = ri;
+            float tmp = MAGMA_S_CONJ( rr[i] ) * ri;
+            lrho_re += MAGMA_S_REAL( tmp );
+            lrho_im += MAGMA_S_IMAG( tmp );
+            lnrm += MAGMA_S_REAL( ri ) * MAGMA_S_REAL( ri )
+                  + MAGMA_S_IMAG( ri ) * MAGMA_S_IMAG( ri );
+        }
+        #pragma omp for ordered schedule(static,1)
+        for( magma_int_t tid=0; tid<smerge_nthreads(); tid++ ){
+            #pragma omp ordered
+            {
+                rho_re += lrho_re;
+                rho_im += lrho_im;
+                nrm += lnrm;
+            }
+        }
+    }
+    *rho = MAGMA_S_MAKE( rho_re, rho_im );
+    *nrm2 = nrm;
+
+    return MAGMA_SUCCESS;
+}
@@ -0,0 +1,728 @@
+/*
+    -- MAGMA (version 2.6.2) --
+       Univ. of Tennessee, Knoxville
+       Univ. of California, Berkeley
+       Univ. of Colorado, Denver
+       @date April 2022
+
+       @precisions normal z -> c d s
+       @author Hartwig Anzt
+
+*/
+#include "magmasparse_internal.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#define PRECISION_z
+
+
+/*
+    Fused host kernels for the merged CG and BiCGSTAB solvers.
+
+    Every kernel performs one sweep over the vectors. The index range is
+    split into one contiguous block per OpenMP thread (essentially the
+    partition schedule(static) uses when magma_zvinit touches the vectors
+    first), so a thread mostly streams through memory local to its NUMA node.
+    Each thread reduces its block with SIMD instructions; the partial sums are
+    then combined in thread order, so the results are bitwise reproducible
+    for a fixed number of threads.
+*/
+
+// contiguous block [start, end) of thread tid out of nthreads
+static inline void
+zmerge_range(
+    magma_int_t n,
+    magma_int_t *start,
+    magma_int_t *end )
+{
+#ifdef _OPENMP
+    magma_int_t nthreads = omp_get_num_threads();
+    magma_int_t tid = omp_get_thread_num();
+#else
+    magma_int_t nthreads = 1;
+    magma_int_t tid = 0;
+#endif
+    magma_int_t chunk = magma_ceildiv( n, nthreads );
+    *start = min( n, tid*chunk );
+    *end = min( n, *start + chunk );
+}
+
+
+static inline magma_int_t
+zmerge_nthreads()
+{
+#ifdef _OPENMP
+    return omp_get_num_threads();
+#else
+    return 1;
+#endif
+}
+
+
+// y = A x on the CPU with reductions wy = w^H y and (if yy != NULL)
+// yy = y^H y fused into the same sweep.
+static magma_int_t
+zmerge_spmv_dot(
+    magma_z_matrix A,
+    magmaDoubleComplex *x,
+    magmaDoubleComplex *y,
+    magmaDoubleComplex *w,
+    magmaDoubleComplex *wy,
+    double *yy,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+    double wy_re = 0.0, wy_im = 0.0, yy_re = 0.0;
+
+    if ( A.storage_type == Magma_CSR || A.storage_type == Magma_CUCSR ) {
+        #pragma omp parallel
+        {
+            magma_int_t start, end;
+            double lwy_re = 0.0, lwy_im = 0.0, lyy_re = 0.0;
+            zmerge_range( A.num_rows, &start, &end );
+            for( magma_int_t i=start; i<end; i++ ){
+                magmaDoubleComplex dot = MAGMA_Z_ZERO;
+                for( magma_int_t j=A.row[i]; j<A.row[i+1]; j++ ){
+                    dot += A.val[j] * x[ A.col[j] ];
+                }
+                y[i] = dot;
+                magmaDoubleComplex tmp = MAGMA_Z_CONJ( w[i] ) * dot;
+                lwy_re += MAGMA_Z_REAL( tmp );
+                lwy_im += MAGMA_Z_IMAG( tmp );
+                lyy_re += MAGMA_Z_REAL( dot ) * MAGMA_Z_REAL( dot )
+                        + MAGMA_Z_IMAG( dot ) * MAGMA_Z_IMAG( dot );
+            }
+            #pragma omp for ordered schedule(static,1)
+            for( magma_int_t tid=0; tid<zmerge_nthreads(); tid++ ){
+                #pragma omp ordered
+                {
+                    wy_re += lwy_re;
+                    wy_im += lwy_im;
+                    yy_re += lyy_re;
+                }
+            }
+        }
+        *wy = MAGMA_Z_MAKE( wy_re, wy_im );
+        if ( yy != NULL ) {
+            *yy = yy_re;
+        }
+    }
+    else {
+        // other formats: SpMV and reduction in separate sweeps
+        magma_z_matrix xv={Magma_CSR}, yv={Magma_CSR};
+        CHECK( magma_zvset( A.num_cols, 1, x, &xv, queue ));
+        CHECK( magma_zvset( A.num_rows, 1, y, &yv, queue ));
+        CHECK( magma_z_spmv( MAGMA_Z_ONE, A, xv, MAGMA_Z_ZERO, yv, queue ));
+        *wy = magma_zdotc_cpu( A.num_rows, w, 1, y, 1, queue );
+        if ( yy != NULL ) {
+            double nrm = magma_dznrm2_cpu( A.num_rows, y, 1, queue );
+            *yy = nrm * nrm;
+        }
+    }
+
+cleanup:
+    return info;
+}
+
+
+/**
+    Purpose
+    -------
+
+    Merges the SpMV z = A d with the dot product den = d^H z of the CG
+    iteration into one sweep. A is expected in CSR format in CPU memory;
+    other formats fall back to a separate SpMV and dot product.
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_z_matrix
+                system matrix
+
+    @param[in]
+    d           magmaDoubleComplex*
+                search direction
+
+    @param[out]
+    z           magmaDoubleComplex*
+                z = A d
+
+    @param[out]
+    den         magmaDoubleComplex*
+                den = d^H z
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_zgegpuk
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_zcgmerge_spmv1_cpu(
+    magma_z_matrix A,
+    magmaDoubleComplex *d,
+    magmaDoubleComplex *z,
+    magmaDoubleComplex *den,
+    magma_queue_t queue )
+{
+    return zmerge_spmv_dot( A, d, z, d, den, NULL, queue );
+}
+
+
+/**
+    Purpose
+    -------
+
+    Merges the updates of the CG iterate and residual with the computation
+    of the new residual norm:
+
+    x = x + alpha d
+    r = r - alpha z
+    nrm2 = r^H r
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                vector length
+
+    @param[in]
+    alpha       magmaDoubleComplex
+                step length
+
+    @param[in]
+    d           magmaDoubleComplex*
+                search direction
+
+    @param[in]
+    z           magmaDoubleComplex*
+                z = A d
+
+    @param[in,out]
+    x           magmaDoubleComplex*
+                iterate
+
+    @param[in,out]
+    r           magmaDoubleComplex*
+                residual
+
+    @param[out]
+    nrm2        double*
+                squared residual norm
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_zgegpuk
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_zcgmerge_xr_cpu(
+    magma_int_t n,
+    magmaDoubleComplex alpha,
+    magmaDoubleComplex *d,
+    magmaDoubleComplex *z,
+    magmaDoubleComplex *x,
+    magmaDoubleComplex *r,
+    double *nrm2,
+    magma_queue_t queue )
+{
+    double sum = 0.0;
+
+    #pragma omp parallel
+    {
+        magma_int_t start, end;
+        double loc = 0.0;
+        zmerge_range( n, &start, &end );
+        #pragma omp simd reduction(+:loc)
+        for( magma_int_t i=start; i<end; i++ ){
+            x[i] = x[i] + alpha * d[i];
+            magmaDoubleComplex ri = r[i] - alpha * z[i];
+            r[i] = ri;
+            loc += MAGMA_Z_REAL( ri ) * MAGMA_Z_REAL( ri )
+                 + MAGMA_Z_IMAG( ri ) * MAGMA_Z_IMAG( ri );
+        }
+        #pragma omp for ordered schedule(static,1)
+        for( magma_int_t tid=0; tid<zmerge_nthreads(); tid++ ){
+            #pragma omp ordered
+            sum += loc;
+        }
+    }
+    *nrm2 = sum;
+
+    return MAGMA_SUCCESS;
+}
+
+
+/**
+    Purpose
+    -------
+
+    Updates the CG search direction: d = h + beta d
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                vector length
+
+    @param[in]
+    beta        magmaDoubleComplex
+                scalar beta
+
+    @param[in]
+    h           magmaDoubleComplex*
+                (preconditioned) residual
+
+    @param[in,out]
+    d           magmaDoubleComplex*
+                search direction
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_zgegpuk
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_zcgmerge_d_cpu(
+    magma_int_t n,
+    magmaDoubleComplex beta,
+    magmaDoubleComplex *h,
+    magmaDoubleComplex *d,
+    magma_queue_t queue )
+{
+    #pragma omp parallel
+    {
+        magma_int_t start, end;
+        zmerge_range( n, &start, &end );
+        #pragma omp simd
+        for( magma_int_t i=start; i<end; i++ ){
+            d[i] = h[i] + beta * d[i];
+        }
+    }
+
+    return MAGMA_SUCCESS;
+}
+
+
+/**
+    Purpose
+    -------
+
+    Computes the inner product r^H h of the preconditioned CG with the
+    same partition and reduction order as the other fused kernels.
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                vector length
+
+    @param[in]
+    r           magmaDoubleComplex*
+                residual
+
+    @param[in]
+    h           magmaDoubleComplex*
+                preconditioned residual
+
+    @param[out]
+    rh          magmaDoubleComplex*
+                rh = r^H h
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_zgegpuk
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_zcgmerge_rh_cpu(
+    magma_int_t n,
+    magmaDoubleComplex *r,
+    magmaDoubleComplex *h,
+    magmaDoubleComplex *rh,
+    magma_queue_t queue )
+{
+    double sum_re = 0.0, sum_im = 0.0;
+
+    #pragma omp parallel
+    {
+        magma_int_t start, end;
+        double loc_re = 0.0, loc_im = 0.0;
+        zmerge_range( n, &start, &end );
+        #pragma omp simd reduction(+:loc_re,loc_im)
+        for( magma_int_t i=start; i<end; i++ ){
+            magmaDoubleComplex tmp = MAGMA_Z_CONJ( r[i] ) * h[i];
+            loc_re += MAGMA_Z_REAL( tmp );
+            loc_im += MAGMA_Z_IMAG( tmp );
+        }
+        #pragma omp for ordered schedule(static,1)
+        for( magma_int_t tid=0; tid<zmerge_nthreads(); tid++ ){
+            #pragma omp ordered
+            {
+                sum_re += loc_re;
+                sum_im += loc_im;
+            }
+        }
+    }
+    *rh = MAGMA_Z_MAKE( sum_re, sum_im );
+
+    return MAGMA_SUCCESS;
+}
+
+
+/**
+    Purpose
+    -------
+
+    First BiCGSTAB update: p = r + beta * ( p - omega * v )
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                vector length
+
+    @param[in]
+    beta        magmaDoubleComplex
+                scalar beta
+
+    @param[in]
+    omega       magmaDoubleComplex
+                scalar omega
+
+    @param[in]
+    r           magmaDoubleComplex*
+                residual
+
+    @param[in]
+    v           magmaDoubleComplex*
+                v = A p of the previous iteration
+
+    @param[in,out]
+    p           magmaDoubleComplex*
+                search direction
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_zgegpuk
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_zbicgmerge1_cpu(
+    magma_int_t n,
+    magmaDoubleComplex beta,
+    magmaDoubleComplex omega,
+    magmaDoubleComplex *r,
+    magmaDoubleComplex *v,
+    magmaDoubleComplex *p,
+    magma_queue_t queue )
+{
+    #pragma omp parallel
+    {
+        magma_int_t start, end;
+        zmerge_range( n, &start, &end );
+        #pragma omp simd
+        for( magma_int_t i=start; i<end; i++ ){
+            p[i] = r[i] + beta * ( p[i] - omega * v[i] );
+        }
+    }
+
+    return MAGMA_SUCCESS;
+}
+
+
+/**
+    Purpose
+    -------
+
+    Merges the first BiCGSTAB SpMV v = A p with the dot product
+    rrv = rr^H v into one sweep.
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_z_matrix
+                system matrix
+
+    @param[in]
+    rr          magmaDoubleComplex*
+                shadow residual
+
+    @param[in]
+    p           magmaDoubleComplex*
+                search direction
+
+    @param[out]
+    v           magmaDoubleComplex*
+                v = A p
+
+    @param[out]
+    rrv         magmaDoubleComplex*
+                rrv = rr^H v
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_zgegpuk
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_zbicgmerge_spmv1_cpu(
+    magma_z_matrix A,
+    magmaDoubleComplex *rr,
+    magmaDoubleComplex *p,
+    magmaDoubleComplex *v,
+    magmaDoubleComplex *rrv,
+    magma_queue_t queue )
+{
+    return zmerge_spmv_dot( A, p, v, rr, rrv, NULL, queue );
+}
+
+
+/**
+    Purpose
+    -------
+
+    Second BiCGSTAB update: s = r - alpha v
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                vector length
+
+    @param[in]
+    alpha       magmaDoubleComplex
+                scalar alpha
+
+    @param[in]
+    r           magmaDoubleComplex*
+                residual
+
+    @param[in]
+    v           magmaDoubleComplex*
+                v = A p
+
+    @param[out]
+    s           magmaDoubleComplex*
+                s = r - alpha v
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_zgegpuk
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_zbicgmerge2_cpu(
+    magma_int_t n,
+    magmaDoubleComplex alpha,
+    magmaDoubleComplex *r,
+    magmaDoubleComplex *v,
+    magmaDoubleComplex *s,
+    magma_queue_t queue )
+{
+    #pragma omp parallel
+    {
+        magma_int_t start, end;
+        zmerge_range( n, &start, &end );
+        #pragma omp simd
+        for( magma_int_t i=start; i<end; i++ ){
+            s[i] = r[i] - alpha * v[i];
+        }
+    }
+
+    return MAGMA_SUCCESS;
+}
+
+
+/**
+    Purpose
+    -------
+
+    Merges the second BiCGSTAB SpMV t = A s with the dot products
+    ts = t^H s and tt = t^H t into one sweep.
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_z_matrix
+                system matrix
+
+    @param[in]
+    s           magmaDoubleComplex*
+                s = r - alpha v
+
+    @param[out]
+    t           magmaDoubleComplex*
+                t = A s
+
+    @param[out]
+    ts          magmaDoubleComplex*
+                ts = t^H s
+
+    @param[out]
+    tt          double*
+                tt = t^H t
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_zgegpuk
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_zbicgmerge_spmv2_cpu(
+    magma_z_matrix A,
+    magmaDoubleComplex *s,
+    magmaDoubleComplex *t,
+    magmaDoubleComplex *ts,
+    double *tt,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+    magmaDoubleComplex st;
+
+    CHECK( zmerge_spmv_dot( A, s, t, s, &st, tt, queue ));
+    *ts = MAGMA_Z_CONJ( st );
+
+cleanup:
+    return info;
+}
+
+
+/**
+    Purpose
+    -------
+
+    Merges the last BiCGSTAB updates with the reductions needed for the
+    convergence check and the next iteration:
+
+    x = x + alpha p + omega s
+    r = s - omega t
+    rho = rr^H r
+    nrm2 = r^H r
+
+    Arguments
+    ---------
+
+    @param[in]
+    n           magma_int_t
+                vector length
+
+    @param[in]
+    alpha       magmaDoubleComplex
+                scalar alpha
+
+    @param[in]
+    omega       magmaDoubleComplex
+                scalar omega
+
+    @param[in]
+    rr          magmaDoubleComplex*
+                shadow residual
+
+    @param[in]
+    p           magmaDoubleComplex*
+                search direction
+
+    @param[in]
+    s           magmaDoubleComplex*
+                s = r - alpha v
+
+    @param[in]
+    t           magmaDoubleComplex*
+                t = A s
+
+    @param[in,out]
+    x           magmaDoubleComplex*
+                iterate
+
+    @param[out]
+    r           magmaDoubleComplex*
+                residual
+
+    @param[out]
+    rho         magmaDoubleComplex*
+                rho = rr^H r
+
+    @param[out]
+    nrm2        double*
+                squared residual norm
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_zgegpuk
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_zbicgmerge_xrbeta_cpu(
+    magma_int_t n,
+    magmaDoubleComplex alpha,
+    magmaDoubleComplex omega,
+    magmaDoubleComplex *rr,
+    magmaDoubleComplex *p,
+    magmaDoubleComplex *s,
+    magmaDoubleComplex *t,
+    magmaDoubleComplex *x,
+    magmaDoubleComplex *r,
+    magmaDoubleComplex *rho,
+    double *nrm2,
+    magma_queue_t queue )
+{
+    double rho_re = 0.0, rho_im = 0.0, nrm = 0.0;
+
+    #pragma omp parallel
+    {
+        magma_int_t start, end;
+        double lrho_re = 0.0, lrho_im = 0.0, lnrm = 0.0;
+        zmerge_range( n, &start, &end );
+        #pragma omp simd reduction(+:lrho_re,lrho_im,lnrm)
+        for( magma_int_t i=start; i<end; i++ ){
+            x[i] = x[i] + alpha * p[i] + omega * s[i];
+            magmaDoubleComplex ri = s[i] - omega * t[i];
+            r[i] = ri;
+            magmaDoubleComplex tmp = MAGMA_Z_CONJ( rr[i] ) * ri;
+            lrho_re += MAGMA_Z_REAL( tmp );
+            lrho_im += MAGMA_Z_IMAG( tmp );
+            lnrm += MAGMA_Z_REAL( ri ) * MAGMA_Z_REAL( ri )
+                  + MAGMA_Z_IMAG( ri ) * MAGMA_Z_IMAG( ri );
+        }
+        #pragma omp for ordered schedule(static,1)
+        for( magma_int_t tid=0; tid<zmerge_nthreads(); tid++ ){
+            #pragma omp ordered
+            {
+                rho_re += lrho_re;
+                rho_im += lrho_im;
+                nrm += lnrm;
+            }
+        }
+    }
+    *rho = MAGMA_Z_MAKE( rho_re, rho_im );
+    *nrm2 = nrm;
+
+    return MAGMA_SUCCESS;
+}
@@ -5,7 +5,7 @@
        Univ. of Colorado, Denver
        @date April 2022
 
-       @generated from sparse/control/magma_zmconvert.cpp, normal z -> c, Wed Apr 20 17:38:06 2022
+       @generated from sparse/control/magma_zmconvert.cpp, normal z -> c, Sun Oct 18 21:20:39 2026
        @author Hartwig Anzt
 */
 #include "magmasparse_internal.h"
@@ -248,10 +248,13 @@ magma_cmconvert(
                 CHECK( magma_index_malloc_cpu( &B->row, A.num_rows+1 ));
                 CHECK( magma_index_malloc_cpu( &B->col, A.nnz ));
 
+                // the copy places the pages like the sweeps access them
+                #pragma omp parallel for schedule(static)
                 for( magma_int_t i=0; i < A.nnz; i++) {
                     B->val[i] = A.val[i];
                     B->col[i] = A.col[i];
                 }
+                #pragma omp parallel for
                 for( magma_int_t i=0; i < A.num_rows+1; i++) {
                     B->row[i] = A.row[i];
                 }
@@ -264,88 +267,23 @@ magma_cmconvert(
 
             // CSR to CSRL
             else if ( new_format == Magma_CSRL ) {
+                CHECK( magma_cmatrix_split( A, B, 
+                    ( B->diagorder_type == Magma_UNITY ) ? Magma_UNITY : Magma_VALUE,
+                    NULL, Magma_VALUE, NULL, queue ));
                 // fill in information for B
-                B->storage_type = Magma_CSR;
-                B->memory_location = A.memory_location;
                 B->fill_mode = MagmaLower;
-                B->num_rows = A.num_rows;
-                B->num_cols = A.num_cols;
                 B->true_nnz = A.true_nnz;
                 B->diameter = A.diameter;
-
-                magma_int_t numzeros=0;
-                for( magma_int_t i=0; i < A.num_rows; i++) {
-                    for( magma_int_t j=A.row[i]; j < A.row[i+1]; j++) {
-                        if ( A.col[j] <= i) {
-                            numzeros++;
-                        }
-                    }
-                }
-                B->nnz = numzeros;
-                CHECK( magma_cmalloc_cpu( &B->val, numzeros ));
-                CHECK( magma_index_malloc_cpu( &B->row, A.num_rows+1 ));
-                CHECK( magma_index_malloc_cpu( &B->col, numzeros ));
-
-                numzeros=0;
-                for( magma_int_t i=0; i < A.num_rows; i++) {
-                    B->row[i]=numzeros;
-                    for( magma_int_t j=A.row[i]; j < A.row[i+1]; j++) {
-                        if ( A.col[j] < i) {
-                            B->val[numzeros] = A.val[j];
-                            B->col[numzeros] = A.col[j];
-                            numzeros++;
-                        }
-                        else if ( A.col[j] == i &&
-                                        B->diagorder_type == Magma_UNITY) {
-                            B->val[numzeros] = MAGMA_C_MAKE(1.0, 0.0);
-                            B->col[numzeros] = A.col[j];
-                            numzeros++;
-                        }
-                        else if ( A.col[j] == i ) {
-                            B->val[numzeros] = A.val[j];
-                            B->col[numzeros] = A.col[j];
-                            numzeros++;
-                        }
-                    }
-                }
-                B->row[B->num_rows] = numzeros;
             }
 
             // CSR to CSRU
             else if (  new_format == Magma_CSRU ) {
+                CHECK( magma_cmatrix_split( A, NULL, Magma_VALUE, 
+                    B, Magma_VALUE, NULL, queue ));
                 // fill in information for B
-                B->storage_type = Magma_CSR;
-                B->memory_location = A.memory_location;
-                B->fill_mode = MagmaLower;
-                B->num_rows = A.num_rows; B->true_nnz = A.true_nnz;
-                B->num_cols = A.num_cols;
-                B->diameter = A.diameter;
                 B->fill_mode = MagmaUpper;
-                magma_int_t numzeros=0;
-                for( magma_int_t i=0; i < A.num_rows; i++) {
-                    for( magma_int_t j=A.row[i]; j < A.row[i+1]; j++) {
-                        if ( A.col[j] >= i) {
-                            numzeros++;
-                        }
-                    }
-                }
-                B->nnz = numzeros;
-                CHECK( magma_cmalloc_cpu( &B->val, numzeros ));
-                CHECK( magma_index_malloc_cpu( &B->row, A.num_rows+1 ));
-                CHECK( magma_index_malloc_cpu( &B->col, numzeros ));
-
-                numzeros=0;
-                for( magma_int_t i=0; i < A.num_rows; i++) {
-                    B->row[i]=numzeros;
-                    for( magma_int_t j=A.row[i]; j < A.row[i+1]; j++) {
-                        if ( A.col[j] >= i) {
-                            B->val[numzeros] = A.val[j];
-                            B->col[numzeros] = A.col[j];
-                            numzeros++;
-                        }
-                    }
-                }
-                B->row[B->num_rows] = numzeros;
+                B->true_nnz = A.true_nnz;
+                B->diameter = A.diameter;
             }
 
             // CSR to CSRD (diagonal elements first)
@@ -389,7 +327,9 @@ magma_cmconvert(
 
                 magma_free_cpu( B->row );
                 CHECK( magma_index_malloc_cpu( &B->row, A.nnz ));
+                CHECK( magma_cfirsttouch_cpu( A.nnz, NULL, B->row, NULL, queue ));
 
+                #pragma omp parallel for
                 for(magma_int_t i=0; i < A.num_rows; i++) {
                     for(magma_int_t j=A.row[i]; j < A.row[i+1]; j++) {
                         B->row[j] = i;
@@ -403,7 +343,9 @@ magma_cmconvert(
                 B->storage_type = Magma_CSRCOO;
 
                 CHECK( magma_index_malloc_cpu( &B->rowidx, A.nnz ));
+                CHECK( magma_cfirsttouch_cpu( A.nnz, NULL, NULL, B->rowidx, queue ));
 
+                #pragma omp parallel for
                 for(magma_int_t i=0; i < A.num_rows; i++) {
                     for(magma_int_t j=A.row[i]; j < A.row[i+1]; j++) {
                         B->rowidx[j] = i;
@@ -1234,14 +1176,7 @@ magma_cmconvert(
             // CSRD to CSR (diagonal elements first)
             else if ( old_format == Magma_CSRD ) {
                 CHECK( magma_cmconvert( A, B, Magma_CSR, Magma_CSR, queue ));
-                for( magma_int_t i=0; i < A.num_rows; i++) {
-                    magma_cindexsortval(
-                    B->col,
-                    B->val,
-                    B->row[i],
-                    B->row[i+1]-1,
-                    queue );
-                }
+                CHECK( magma_csegsortval( B->num_rows, B->row, B->col, B->val, queue ));
             }
 
             // CSRCOO to CSR
@@ -1268,14 +1203,7 @@ magma_cmconvert(
                     B->row[ row+1 ] = numnnz;
                 }
                 // sort elements in every row according to col
-                for( magma_int_t i=0; i < A.num_rows; i++) {
-                    magma_cindexsortval(
-                    B->col,
-                    B->val,
-                    B->row[i],
-                    B->row[i+1]-1,
-                    queue );
-                }
+                CHECK( magma_csegsortval( B->num_rows, B->row, B->col, B->val, queue ));
             }
 
             // ELL/ELLPACK to CSR
@@ -5,7 +5,7 @@
        Univ. of Colorado, Denver
        @date April 2022
 
-       @generated from sparse/control/magma_zmio.cpp, normal z -> c, Wed Apr 20 17:38:06 2022
+       @generated from sparse/control/magma_zmio.cpp, normal z -> c, Sun Oct 18 21:03:04 2026
        @author Hartwig Anzt
        @author Mark Gates
 */
@@ -13,29 +13,10 @@
 //  in this file, many routines are taken from
 //  the IO functions provided by MatrixMarket
 
-#include <algorithm>
-#include <vector>
-#include <utility>  // pair
-
 #include "magmasparse_internal.h"
 #include "magmasparse_mmio.h"
 
 
-/**
-    Purpose
-    -------
-    Returns true if first element of a is less than first element of b.
-    Ignores second element. Used for sorting pairs,
-    std::pair< int, magmaFloatComplex >, of column indices and values.
-*/
-static bool compare_first(
-    const std::pair< magma_index_t, magmaFloatComplex >& a,
-    const std::pair< magma_index_t, magmaFloatComplex >& b )
-{
-    return (a.first < b.first);
-}
-
-
 /**
     Purpose
     -------
@@ -111,7 +92,6 @@ magma_int_t read_c_csr_from_mtx(
     magmaFloatComplex *new_val=NULL;
     magma_int_t hermitian = 0;
     
-    std::vector< std::pair< magma_index_t, magmaFloatComplex > > rowval;
     
     FILE *fid = NULL;
     MM_typecode matcode;
@@ -305,21 +285,8 @@ magma_int_t read_c_csr_from_mtx(
     
     (*row)[*n_row] = *nnz;
 
-    // sort column indices within each row
-    // copy into vector of pairs (column index, value), sort by column index, then copy back
-    for (magma_index_t k=0; k < *n_row; ++k) {
-        int kk  = (*row)[k];
-        int len = (*row)[k+1] - (*row)[k];
-        rowval.resize( len );
-        for( int i=0; i < len; ++i ) {
-            rowval[i] = std::make_pair( (*col)[kk+i], (*val)[kk+i] );
-        }
-        std::sort( rowval.begin(), rowval.end(), compare_first );
-        for( int i=0; i < len; ++i ) {
-            (*col)[kk+i] = rowval[i].first;
-            (*val)[kk+i] = rowval[i].second;
-        }
-    }
+    // sort column indices within each row, the values are permuted along
+    CHECK( magma_csegsortval( *n_row, *row, *col, *val, queue ));
 
     printf(" done.\n");
 cleanup:
@@ -963,7 +930,6 @@ magma_c_csr_mtx(
     // make sure the target structure is empty
     magma_cmfree( A, queue );
     A->ownership = MagmaTrue;
-    std::vector< std::pair< magma_index_t, magmaFloatComplex > > rowval;
     
     FILE *fid = NULL;
     MM_typecode matcode;
@@ -1163,21 +1129,8 @@ magma_c_csr_mtx(
     }
     (A->row)[A->num_rows] = A->nnz;
     
-    // sort column indices within each row
-    // copy into vector of pairs (column index, value), sort by column index, then copy back
-    for (magma_index_t k=0; k < A->num_rows; ++k) {
-        int kk  = (A->row)[k];
-        int len = (A->row)[k+1] - (A->row)[k];
-        rowval.resize( len );
-        for( int i=0; i < len; ++i ) {
-            rowval[i] = std::make_pair( (A->col)[kk+i], (A->val)[kk+i] );
-        }
-        std::sort( rowval.begin(), rowval.end(), compare_first );
-        for( int i=0; i < len; ++i ) {
-            (A->col)[kk+i] = rowval[i].first;
-            (A->val)[kk+i] = rowval[i].second;
-        }
-    }
+    // sort column indices within each row, the values are permuted along
+    CHECK( magma_csegsortval( A->num_rows, A->row, A->col, A->val, queue ));
 
     if ( csr_compressor > 0) { // run the CSR compressor to remove zeros
         //printf("removing zeros: ");
@@ -1251,7 +1204,6 @@ magma_c_csr_mtxsymm(
     magma_index_t *coo_col=NULL, *coo_row=NULL;
     magmaFloatComplex *coo_val=NULL;
 
-    std::vector< std::pair< magma_index_t, magmaFloatComplex > > rowval;
     
     FILE *fid = NULL;
     MM_typecode matcode;
@@ -1409,21 +1361,8 @@ magma_c_csr_mtxsymm(
     
     (A->row)[A->num_rows]=A->nnz;
     
-    // sort column indices within each row
-    // copy into vector of pairs (column index, value), sort by column index, then copy back
-    for (magma_index_t k=0; k < A->num_rows; ++k) {
-        int kk  = (A->row)[k];
-        int len = (A->row)[k+1] - (A->row)[k];
-        rowval.resize( len );
-        for( int i=0; i < len; ++i ) {
-            rowval[i] = std::make_pair( (A->col)[kk+i], (A->val)[kk+i] );
-        }
-        std::sort( rowval.begin(), rowval.end(), compare_first );
-        for( int i=0; i < len; ++i ) {
-            (A->col)[kk+i] = rowval[i].first;
-            (A->val)[kk+i] = rowval[i].second;
-        }
-    }
+    // sort column indices within each row, the values are permuted along
+    CHECK( magma_csegsortval( A->num_rows, A->row, A->col, A->val, queue ));
 
     if ( csr_compressor > 0) { // run the CSR compressor to remove zeros
         //printf("removing zeros: ");
@@ -0,0 +1,828 @@
+/*
+    -- MAGMA (version 2.6.2) --
+       Univ. of Tennessee, Knoxville
+       Univ. of California, Berkeley
+       Univ. of Colorado, Denver
+       @date April 2022
+
+       @generated from sparse/control/magma_zmreorder.cpp, normal z -> c, Sun Oct 18 19:59:12 2026
+       @author Hartwig Anzt
+*/
+#include <algorithm>
+#include "magmasparse_internal.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// levels smaller than this are processed by a single thread
+#define RCM_PAR_THRESHOLD 1024
+// size of the thread-local buffer for newly discovered nodes
+#define RCM_CHUNK 256
+
+
+// orders nodes by increasing degree, ties broken by the node index
+struct magma_crcm_degree_less {
+    const magma_index_t *deg;
+    magma_crcm_degree_less( const magma_index_t *d ) : deg( d ) { }
+    bool operator()( magma_index_t a, magma_index_t b ) const
+    {
+        return ( deg[a] < deg[b] ) || ( deg[a] == deg[b] && a < b );
+    }
+};
+
+
+/*
+    Nonzero pattern of A^T, computed with a parallel counting sort. The order
+    of the column indices within a row is arbitrary, which does not affect
+    the orderings computed below.
+*/
+static magma_int_t
+magma_cmreorder_transpose(
+    magma_c_matrix A,
+    magma_index_t **trow,
+    magma_index_t **tcol,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+    magma_index_t *fill=NULL;
+
+    CHECK( magma_index_malloc_cpu( trow, A.num_cols+1 ));
+    CHECK( magma_index_malloc_cpu( tcol, A.nnz ));
+    CHECK( magma_index_malloc_cpu( &fill, A.num_cols ));
+
+    #pragma omp parallel for schedule(static)
+    for( magma_int_t i=0; i<A.num_cols+1; i++ ){
+        (*trow)[i] = 0;
+    }
+    #pragma omp parallel for schedule(static)
+    for( magma_int_t j=0; j<A.row[A.num_rows]; j++ ){
+        #pragma omp atomic
+        (*trow)[A.col[j]+1]++;
+    }
+    CHECK( magma_cmatrix_createrowptr( A.num_cols, *trow, queue ));
+    #pragma omp parallel for schedule(static)
+    for( magma_int_t i=0; i<A.num_cols; i++ ){
+        fill[i] = (*trow)[i];
+    }
+    #pragma omp parallel for schedule(static)
+    for( magma_int_t i=0; i<A.num_rows; i++ ){
+        for( magma_index_t j=A.row[i]; j<A.row[i+1]; j++ ){
+            magma_index_t o;
+            #pragma omp atomic capture
+            o = fill[A.col[j]]++;
+            (*tcol)[o] = i;
+        }
+    }
+
+cleanup:
+    magma_free_cpu( fill );
+    return info;
+}
+
+
+// deterministic pseudo-random weight of node i for the Jones-Plassmann coloring
+static inline unsigned int
+magma_cmcolor_weight( magma_index_t i )
+{
+    unsigned int h = (unsigned int) i;
+    h ^= h >> 16;
+    h *= 0x7feb352dU;
+    h ^= h >> 15;
+    h *= 0x846ca68bU;
+    h ^= h >> 16;
+    return h;
+}
+
+
+/*
+    One level-synchronous step of a breadth-first search in the graph of
+    A + A^T, given by the patterns (row, col) of A and (trow, tcol) of A^T.
+    All neighbours of list[beg..end) with level -1 get level lev and are
+    appended to list starting at *tail, *tail is advanced accordingly.
+    The order of the new nodes is arbitrary.
+*/
+static void
+magma_crcm_expand(
+    magma_index_t beg,
+    magma_index_t end,
+    magma_index_t lev,
+    const magma_index_t *row,
+    const magma_index_t *col,
+    const magma_index_t *trow,
+    const magma_index_t *tcol,
+    magma_index_t *level,
+    magma_index_t *list,
+    magma_index_t *tail )
+{
+    magma_index_t t = *tail;
+
+    #pragma omp parallel if( end-beg > RCM_PAR_THRESHOLD )
+    {
+        magma_index_t loc[RCM_CHUNK];
+        magma_int_t nloc = 0;
+        #pragma omp for schedule(dynamic,64) nowait
+        for( magma_index_t k=beg; k<end; k++ ){
+            magma_index_t u = list[k];
+            for( magma_int_t pass=0; pass<2; pass++ ){
+                const magma_index_t *r = ( pass == 0 ) ? row : trow;
+                const magma_index_t *c = ( pass == 0 ) ? col : tcol;
+                for( magma_index_t j=r[u]; j<r[u+1]; j++ ){
+                    magma_index_t v = c[j], lv;
+                    #pragma omp atomic read
+                    lv = level[v];
+                    if( lv != -1 ){
+                        continue;
+                    }
+                    #pragma omp atomic capture
+                    { lv = level[v]; level[v] = lev; }
+                    if( lv != -1 ){
+                        continue;
+                    }
+                    loc[nloc++] = v;
+                    if( nloc == RCM_CHUNK ){
+                        magma_index_t off;
+                        #pragma omp atomic capture
+                        { off = t; t += nloc; }
+                        for( magma_int_t i=0; i<nloc; i++ ){
+                            list[off+i] = loc[i];
+                        }
+                        nloc = 0;
+                    }
+                }
+            }
+        }
+        if( nloc > 0 ){
+            magma_index_t off;
+            #pragma omp atomic capture
+            { off = t; t += nloc; }
+            for( magma_int_t i=0; i<nloc; i++ ){
+                list[off+i] = loc[i];
+            }
+        }
+    }
+    *tail = t;
+}
+
+
+/*
+    Breadth-first search from root, the visited nodes are stored level by
+    level in list[0..*count), the last level starts at *lastbeg.
+    Returns the number of levels (the eccentricity of root plus one).
+*/
+static magma_index_t
+magma_crcm_levels(
+    magma_index_t root,
+    const magma_index_t *row,
+    const magma_index_t *col,
+    const magma_index_t *trow,
+    const magma_index_t *tcol,
+    magma_index_t *level,
+    magma_index_t *list,
+    magma_index_t *count,
+    magma_index_t *lastbeg )
+{
+    magma_index_t beg = 0, end = 1, tail, nlev = 1;
+
+    list[0] = root;
+    level[root] = 0;
+    while( 1 ){
+        tail = end;
+        magma_crcm_expand( beg, end, nlev, row, col, trow, tcol, level,
+                           list, &tail );
+        if( tail == end ){
+            break;
+        }
+        beg = end;
+        end = tail;
+        nlev++;
+    }
+    *count = end;
+    *lastbeg = beg;
+    return nlev;
+}
+
+
+/**
+    Purpose
+    -------
+
+    Computes the Reverse Cuthill-McKee ordering of a sparse matrix on the CPU.
+    The ordering is computed for the nonzero pattern of A + A^T, every
+    connected component is started from a pseudo-peripheral node found with
+    the George-Liu algorithm.
+
+    The breadth-first search is level-synchronous and parallelized with
+    OpenMP: the nodes of the next level are discovered in parallel, each is
+    assigned to the neighbour in the current level that comes first in the
+    ordering, and the children of every node are sorted by increasing degree.
+    This yields the same ordering as the sequential algorithm (ties are broken
+    by the node index), independent of the number of threads.
+
+    On return, perm maps new to old indices, iperm old to new indices:
+    row i of the reordered matrix is row perm[i] of A, and iperm[perm[i]] = i.
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_c_matrix
+                square CSR matrix on the CPU
+
+    @param[out]
+    perm        magma_index_t**
+                permutation (new -> old), allocated on the CPU
+
+    @param[out]
+    iperm       magma_index_t**
+                inverse permutation (old -> new), allocated on the CPU
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_caux
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_crcm(
+    magma_c_matrix A,
+    magma_index_t **perm,
+    magma_index_t **iperm,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+
+    magma_index_t *trow=NULL, *tcol=NULL;
+    magma_index_t *level=NULL, *deg=NULL, *parent=NULL, *mark=NULL,
+                  *cnt=NULL, *order=NULL, *pos=NULL;
+    magma_index_t n = A.num_rows, numbered = 0, seed = 0;
+
+    *perm = NULL;
+    *iperm = NULL;
+
+    if ( A.memory_location != Magma_CPU || A.storage_type != Magma_CSR ||
+         A.num_rows != A.num_cols ) {
+        printf("error: RCM needs a square CSR matrix on the CPU.\n");
+        info = MAGMA_ERR_NOT_SUPPORTED;
+        goto cleanup;
+    }
+
+    // pattern of A^T to traverse the graph of A + A^T
+    CHECK( magma_cmreorder_transpose( A, &trow, &tcol, queue ));
+
+    CHECK( magma_index_malloc_cpu( &order, n ));
+    CHECK( magma_index_malloc_cpu( &pos, n ));
+    CHECK( magma_index_malloc_cpu( &level, n ));
+    CHECK( magma_index_malloc_cpu( &deg, n ));
+    CHECK( magma_index_malloc_cpu( &parent, n ));
+    CHECK( magma_index_malloc_cpu( &mark, n ));
+    CHECK( magma_index_malloc_cpu( &cnt, n ));
+
+    #pragma omp parallel for schedule(static)
+    for( magma_index_t i=0; i<n; i++ ){
+        level[i] = -1;
+        mark[i] = -1;
+        deg[i] = ( A.row[i+1] - A.row[i] ) + ( trow[i+1] - trow[i] );
+    }
+
+    while( numbered < n ){
+        // next component: first node not yet numbered
+        while( level[seed] != -1 ){
+            seed++;
+        }
+
+        // pseudo-peripheral node: restart the search from a node of
+        // minimal degree in the last level as long as the depth grows
+        // (order[numbered..] serves as workspace here)
+        magma_index_t *list = order + numbered;
+        magma_index_t root = seed, count, lastbeg;
+        magma_index_t nlev = magma_crcm_levels( root, A.row, A.col,
+                            trow, tcol, level, list, &count, &lastbeg );
+        while( nlev > 1 ){
+            magma_index_t cand = list[lastbeg];
+            for( magma_index_t k=lastbeg+1; k<count; k++ ){
+                if( magma_crcm_degree_less( deg )( list[k], cand ) ){
+                    cand = list[k];
+                }
+            }
+            #pragma omp parallel for schedule(static) if( count > RCM_PAR_THRESHOLD )
+            for( magma_index_t k=0; k<count; k++ ){
+                level[list[k]] = -1;
+            }
+            magma_index_t cnlev = magma_crcm_levels( cand, A.row, A.col,
+                            trow, tcol, level, list, &count, &lastbeg );
+            if( cnlev <= nlev ){
+                break;
+            }
+            root = cand;
+            nlev = cnlev;
+        }
+        #pragma omp parallel for schedule(static) if( count > RCM_PAR_THRESHOLD )
+        for( magma_index_t k=0; k<count; k++ ){
+            level[list[k]] = -1;
+        }
+
+        // Cuthill-McKee numbering of the component
+        magma_index_t lev = 0, beg = numbered, end = numbered+1, tail;
+        order[numbered] = root;
+        pos[root] = numbered;
+        level[root] = 0;
+        while( beg < end ){
+            // discover the next level
+            tail = end;
+            magma_crcm_expand( beg, end, lev+1, A.row, A.col, trow, tcol,
+                               level, order, &tail );
+            if( tail == end ){
+                break;
+            }
+
+            // parent: neighbour in the current level numbered first
+            #pragma omp parallel for schedule(dynamic,64) if( tail-end > RCM_PAR_THRESHOLD )
+            for( magma_index_t k=end; k<tail; k++ ){
+                magma_index_t v = order[k], p = tail;
+                for( magma_index_t j=A.row[v]; j<A.row[v+1]; j++ ){
+                    magma_index_t w = A.col[j];
+                    if( level[w] == lev && pos[w] < p ){
+                        p = pos[w];
+                    }
+                }
+                for( magma_index_t j=trow[v]; j<trow[v+1]; j++ ){
+                    magma_index_t w = tcol[j];
+                    if( level[w] == lev && pos[w] < p ){
+                        p = pos[w];
+                    }
+                }
+                parent[v] = p;
+            }
+
+            // number of distinct children of each node in the current level,
+            // the parent is the only one touching mark[] of its children
+            #pragma omp parallel for schedule(dynamic,64) if( end-beg > RCM_PAR_THRESHOLD )
+            for( magma_index_t k=beg; k<end; k++ ){
+                magma_index_t u = order[k], c = 0;
+                for( magma_index_t j=A.row[u]; j<A.row[u+1]; j++ ){
+                    magma_index_t v = A.col[j];
+                    if( level[v] == lev+1 && parent[v] == k && mark[v] != k ){
+                        mark[v] = k;
+                        c++;
+                    }
+                }
+                for( magma_index_t j=trow[u]; j<trow[u+1]; j++ ){
+                    magma_index_t v = tcol[j];
+                    if( level[v] == lev+1 && parent[v] == k && mark[v] != k ){
+                        mark[v] = k;
+                        c++;
+                    }
+                }
+                cnt[k] = c;
+            }
+            magma_index_t off = end;
+            for( magma_index_t k=beg; k<end; k++ ){
+                magma_index_t c = cnt[k];
+                cnt[k] = off;
+                off += c;
+            }
+
+            // place the children of each node, sorted by degree
+            #pragma omp parallel for schedule(dynamic,64) if( end-beg > RCM_PAR_THRESHOLD )
+            for( magma_index_t k=beg; k<end; k++ ){
+                magma_index_t u = order[k], o = cnt[k];
+                for( magma_index_t j=A.row[u]; j<A.row[u+1]; j++ ){
+                    magma_index_t v = A.col[j];
+                    if( level[v] == lev+1 && parent[v] == k && mark[v] == k ){
+                        mark[v] = -2;
+                        order[o++] = v;
+                    }
+                }
+                for( magma_index_t j=trow[u]; j<trow[u+1]; j++ ){
+                    magma_index_t v = tcol[j];
+                    if( level[v] == lev+1 && parent[v] == k && mark[v] == k ){
+                        mark[v] = -2;
+                        order[o++] = v;
+                    }
+                }
+                std::sort( order+cnt[k], order+o, magma_crcm_degree_less( deg ) );
+            }
+            #pragma omp parallel for schedule(static) if( tail-end > RCM_PAR_THRESHOLD )
+            for( magma_index_t k=end; k<tail; k++ ){
+                pos[order[k]] = k;
+            }
+
+            beg = end;
+            end = tail;
+            lev++;
+        }
+        numbered = end;
+    }
+
+    // reverse the Cuthill-McKee ordering
+    CHECK( magma_index_malloc_cpu( perm, n ));
+    CHECK( magma_index_malloc_cpu( iperm, n ));
+    #pragma omp parallel for schedule(static)
+    for( magma_index_t i=0; i<n; i++ ){
+        (*perm)[i] = order[n-1-i];
+        (*iperm)[order[n-1-i]] = i;
+    }
+
+cleanup:
+    if ( info != 0 ) {
+        magma_free_cpu( *perm );
+        magma_free_cpu( *iperm );
+        *perm = NULL;
+        *iperm = NULL;
+    }
+    magma_free_cpu( trow );
+    magma_free_cpu( tcol );
+    magma_free_cpu( order );
+    magma_free_cpu( pos );
+    magma_free_cpu( level );
+    magma_free_cpu( deg );
+    magma_free_cpu( parent );
+    magma_free_cpu( mark );
+    magma_free_cpu( cnt );
+    return info;
+}
+
+
+/**
+    Purpose
+    -------
+
+    Computes a multicolor ordering of a sparse matrix on the CPU with the
+    Jones-Plassmann algorithm on the nonzero pattern of A + A^T: in every
+    round, all uncolored nodes whose weight exceeds the weights of their
+    uncolored neighbours are colored in parallel with the smallest color not
+    used by a neighbour. The weights are a hash of the node index, hence the
+    coloring does not depend on the number of threads.
+
+    Rows of the same color are not coupled, i.e., after the symmetric
+    permutation with magma_cmpermute the diagonal block of every color is a
+    diagonal matrix. The rows of color c are colorptr[c] to colorptr[c+1]-1
+    of the permuted matrix, within a color the original order is kept.
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_c_matrix
+                square CSR matrix on the CPU
+
+    @param[out]
+    perm        magma_index_t**
+                permutation (new -> old), allocated on the CPU
+
+    @param[out]
+    iperm       magma_index_t**
+                inverse permutation (old -> new), allocated on the CPU
+
+    @param[out]
+    colorptr    magma_index_t**
+                first row of every color (ncolors+1 entries), allocated
+                on the CPU
+
+    @param[out]
+    ncolors     magma_int_t*
+                number of colors
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_caux
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_cmcolor(
+    magma_c_matrix A,
+    magma_index_t **perm,
+    magma_index_t **iperm,
+    magma_index_t **colorptr,
+    magma_int_t *ncolors,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+
+    magma_index_t *trow=NULL, *tcol=NULL;
+    magma_index_t *color=NULL, *list=NULL, *sel=NULL, *used=NULL, *cnt=NULL;
+    magma_index_t n = A.num_rows, nlist = A.num_rows, maxdeg = 0, maxcolor = -1;
+    magma_int_t num_threads = 1;
+
+    *perm = NULL;
+    *iperm = NULL;
+    *colorptr = NULL;
+    *ncolors = 0;
+
+    if ( A.memory_location != Magma_CPU || A.storage_type != Magma_CSR ||
+         A.num_rows != A.num_cols ) {
+        printf("error: coloring needs a square CSR matrix on the CPU.\n");
+        info = MAGMA_ERR_NOT_SUPPORTED;
+        goto cleanup;
+    }
+
+    // pattern of A^T to traverse the graph of A + A^T
+    CHECK( magma_cmreorder_transpose( A, &trow, &tcol, queue ));
+
+    #ifdef _OPENMP
+    num_threads = omp_get_max_threads();
+    #endif
+
+    CHECK( magma_index_malloc_cpu( &color, n ));
+    CHECK( magma_index_malloc_cpu( &list, n ));
+    CHECK( magma_index_malloc_cpu( &sel, n ));
+
+    #pragma omp parallel for schedule(static) reduction(max:maxdeg)
+    for( magma_index_t i=0; i<n; i++ ){
+        color[i] = -1;
+        list[i] = i;
+        maxdeg = max( maxdeg,
+                ( A.row[i+1] - A.row[i] ) + ( trow[i+1] - trow[i] ) );
+    }
+    // a node never gets a color larger than its degree
+    CHECK( magma_index_malloc_cpu( &used, (maxdeg+1)*num_threads ));
+    for( magma_index_t i=0; i<(maxdeg+1)*num_threads; i++ ){
+        used[i] = -1;
+    }
+
+    while( nlist > 0 ){
+        // select the local maxima among the uncolored nodes
+        #pragma omp parallel for schedule(dynamic,256)
+        for( magma_index_t k=0; k<nlist; k++ ){
+            magma_index_t u = list[k];
+            unsigned int wu = magma_cmcolor_weight( u );
+            magma_index_t ismax = 1;
+            for( magma_int_t pass=0; pass<2 && ismax; pass++ ){
+                const magma_index_t *r = ( pass == 0 ) ? A.row : trow;
+                const magma_index_t *c = ( pass == 0 ) ? A.col : tcol;
+                for( magma_index_t j=r[u]; j<r[u+1]; j++ ){
+                    magma_index_t v = c[j];
+                    if( v == u || color[v] != -1 ){
+                        continue;
+                    }
+                    unsigned int wv = magma_cmcolor_weight( v );
+                    if( wv > wu || ( wv == wu && v > u ) ){
+                        ismax = 0;
+                        break;
+                    }
+                }
+            }
+            sel[k] = ismax;
+        }
+
+        // color them, selected nodes are never adjacent
+        #pragma omp parallel
+        {
+            magma_int_t tid = 0;
+            #ifdef _OPENMP
+            tid = omp_get_thread_num();
+            #endif
+            magma_index_t *lused = used + tid*(maxdeg+1);
+            #pragma omp for schedule(dynamic,256) reduction(max:maxcolor)
+            for( magma_index_t k=0; k<nlist; k++ ){
+                if( sel[k] == 0 ){
+                    continue;
+                }
+                magma_index_t u = list[k], cu = 0;
+                for( magma_index_t j=A.row[u]; j<A.row[u+1]; j++ ){
+                    if( color[A.col[j]] >= 0 ){
+                        lused[color[A.col[j]]] = u;
+                    }
+                }
+                for( magma_index_t j=trow[u]; j<trow[u+1]; j++ ){
+                    if( color[tcol[j]] >= 0 ){
+                        lused[color[tcol[j]]] = u;
+                    }
+                }
+                while( lused[cu] == u ){
+                    cu++;
+                }
+                color[u] = cu;
+                maxcolor = max( maxcolor, cu );
+            }
+        }
+
+        // remaining uncolored nodes
+        magma_index_t m = 0;
+        for( magma_index_t k=0; k<nlist; k++ ){
+            if( sel[k] == 0 ){
+                list[m++] = list[k];
+            }
+        }
+        nlist = m;
+    }
+    *ncolors = maxcolor+1;
+
+    // stable counting sort by color: thread t handles a contiguous block of
+    // nodes, the offsets are ordered by color first and thread second
+    CHECK( magma_index_malloc_cpu( colorptr, *ncolors+1 ));
+    CHECK( magma_index_malloc_cpu( &cnt, (*ncolors)*num_threads ));
+    CHECK( magma_index_malloc_cpu( perm, n ));
+    CHECK( magma_index_malloc_cpu( iperm, n ));
+    #pragma omp parallel
+    {
+        magma_int_t tid = 0, nt = 1;
+        #ifdef _OPENMP
+        tid = omp_get_thread_num();
+        nt = omp_get_num_threads();
+        #endif
+        magma_index_t chunk = magma_ceildiv( n, nt );
+        magma_index_t beg = min( n, tid*chunk ), end = min( n, beg+chunk );
+        magma_index_t *lcnt = cnt + tid*(*ncolors);
+        for( magma_int_t c=0; c<*ncolors; c++ ){
+            lcnt[c] = 0;
+        }
+        for( magma_index_t i=beg; i<end; i++ ){
+            lcnt[color[i]]++;
+        }
+        #pragma omp barrier
+        #pragma omp single
+        {
+            magma_index_t off = 0;
+            for( magma_int_t c=0; c<*ncolors; c++ ){
+                (*colorptr)[c] = off;
+                for( magma_int_t t=0; t<nt; t++ ){
+                    magma_index_t tmp = cnt[t*(*ncolors)+c];
+                    cnt[t*(*ncolors)+c] = off;
+                    off += tmp;
+                }
+            }
+            (*colorptr)[*ncolors] = off;
+        }
+        for( magma_index_t i=beg; i<end; i++ ){
+            magma_index_t p = lcnt[color[i]]++;
+            (*perm)[p] = i;
+            (*iperm)[i] = p;
+        }
+    }
+
+cleanup:
+    if ( info != 0 ) {
+        magma_free_cpu( *perm );
+        magma_free_cpu( *iperm );
+        magma_free_cpu( *colorptr );
+        *perm = NULL;
+        *iperm = NULL;
+        *colorptr = NULL;
+    }
+    magma_free_cpu( trow );
+    magma_free_cpu( tcol );
+    magma_free_cpu( color );
+    magma_free_cpu( list );
+    magma_free_cpu( sel );
+    magma_free_cpu( used );
+    magma_free_cpu( cnt );
+    return info;
+}
+
+
+/**
+    Purpose
+    -------
+
+    Applies a symmetric permutation to a CSR matrix on the CPU:
+    B = P * A * P^T, i.e., B(i,j) = A(perm[i],perm[j]).
+    The column indices of every row of B are sorted.
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_c_matrix
+                square CSR matrix on the CPU
+
+    @param[out]
+    B           magma_c_matrix*
+                permuted matrix
+
+    @param[in]
+    perm        magma_index_t*
+                permutation (new -> old), e.g., from magma_crcm
+
+    @param[in]
+    iperm       magma_index_t*
+                inverse permutation (old -> new)
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_caux
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_cmpermute(
+    magma_c_matrix A,
+    magma_c_matrix *B,
+    magma_index_t *perm,
+    magma_index_t *iperm,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+
+    if ( A.memory_location != Magma_CPU || A.storage_type != Magma_CSR ||
+         A.num_rows != A.num_cols ) {
+        printf("error: permutation needs a square CSR matrix on the CPU.\n");
+        info = MAGMA_ERR_NOT_SUPPORTED;
+        goto cleanup;
+    }
+
+    B->num_rows = A.num_rows;
+    B->num_cols = A.num_cols;
+    B->storage_type = Magma_CSR;
+    B->memory_location = Magma_CPU;
+
+    CHECK( magma_index_malloc_cpu( &B->row, A.num_rows+1 ));
+    #pragma omp parallel for
+    for( magma_int_t i=0; i<A.num_rows; i++ ){
+        B->row[i+1] = A.row[perm[i]+1] - A.row[perm[i]];
+    }
+    B->row[0] = 0;
+    CHECK( magma_cmatrix_createrowptr( B->num_rows, B->row, queue ));
+    B->nnz = B->row[B->num_rows];
+
+    CHECK( magma_cmalloc_cpu( &B->val, B->nnz ));
+    CHECK( magma_index_malloc_cpu( &B->col, B->nnz ));
+
+    #pragma omp parallel for
+    for( magma_int_t i=0; i<A.num_rows; i++ ){
+        magma_index_t offset = B->row[i];
+        magma_index_t old = perm[i];
+        for( magma_index_t j=A.row[old]; j<A.row[old+1]; j++ ){
+            B->col[offset] = iperm[A.col[j]];
+            B->val[offset] = A.val[j];
+            offset++;
+        }
+        magma_cindexsortval( B->col, B->val, B->row[i], B->row[i+1]-1, queue );
+    }
+
+cleanup:
+    return info;
+}
+
+
+/**
+    Purpose
+    -------
+
+    Permutes the rows of a dense vector (block) on the CPU:
+    y[i] = x[perm[i]]. Passing the inverse permutation of the one used
+    for magma_cmpermute maps the solution of the reordered system back.
+
+    Arguments
+    ---------
+
+    @param[in]
+    x           magma_c_matrix
+                dense vector on the CPU
+
+    @param[out]
+    y           magma_c_matrix*
+                permuted vector
+
+    @param[in]
+    perm        magma_index_t*
+                permutation
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_caux
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_cvpermute(
+    magma_c_matrix x,
+    magma_c_matrix *y,
+    magma_index_t *perm,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+    magma_int_t n = x.num_rows, m = x.num_cols;
+
+    if ( x.memory_location != Magma_CPU ) {
+        printf("error: permutation needs a vector on the CPU.\n");
+        info = MAGMA_ERR_NOT_SUPPORTED;
+        goto cleanup;
+    }
+
+    CHECK( magma_cvinit( y, Magma_CPU, n, m, MAGMA_C_ZERO, queue ));
+    y->major = x.major;
+    if ( x.major == MagmaRowMajor ) {
+        #pragma omp parallel for
+        for( magma_int_t i=0; i<n; i++ ){
+            for( magma_int_t j=0; j<m; j++ ){
+                y->val[i*m+j] = x.val[perm[i]*m+j];
+            }
+        }
+    } else {
+        #pragma omp parallel for
+        for( magma_int_t i=0; i<n; i++ ){
+            for( magma_int_t j=0; j<m; j++ ){
+                y->val[i+j*n] = x.val[perm[i]+j*n];
+            }
+        }
+    }
+
+cleanup:
+    return info;
+}
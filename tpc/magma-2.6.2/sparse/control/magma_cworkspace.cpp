@@ -0,0 +1,336 @@
+/*
+    -- MAGMA (version 2.6.2) --
+       Univ. of Tennessee, Knoxville
+       Univ. of California, Berkeley
+       Univ. of Colorado, Denver
+       @date April 2022
+
+       @generated from sparse/control/magma_zworkspace.cpp, normal z -> c, Sun Oct 18 20:21:50 2026
+       @author Hartwig Anzt
+
+*/
+
+#include "magmasparse_internal.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+
+/*
+    Makes room for one more buffer in the buffer table of the workspace.
+    Has to be called inside the workspace critical section.
+*/
+static magma_int_t
+magma_cworkspace_grow_table(
+    magma_c_workspace *ws )
+{
+    magma_int_t info = 0;
+    magma_int_t max_buffers = ( ws->max_buffers > 0 ) ? 2 * ws->max_buffers : 32;
+    void **buffer = NULL, **buffer_swap;
+    size_t *capacity = NULL, *capacity_swap;
+    magma_int_t *in_use = NULL, *in_use_swap;
+
+    if( ws->num_buffers < ws->max_buffers ){
+        return info;
+    }
+    CHECK( magma_malloc_cpu( (void**) &buffer, max_buffers*sizeof(void*) ));
+    CHECK( magma_malloc_cpu( (void**) &capacity, max_buffers*sizeof(size_t) ));
+    CHECK( magma_malloc_cpu( (void**) &in_use, max_buffers*sizeof(magma_int_t) ));
+    for( magma_int_t i=0; i<ws->num_buffers; i++ ){
+        buffer[ i ] = ws->buffer[ i ];
+        capacity[ i ] = ws->capacity[ i ];
+        in_use[ i ] = ws->in_use[ i ];
+    }
+    // the old tables are freed in the cleanup
+    buffer_swap = ws->buffer;       ws->buffer = buffer;        buffer = buffer_swap;
+    capacity_swap = ws->capacity;   ws->capacity = capacity;    capacity = capacity_swap;
+    in_use_swap = ws->in_use;       ws->in_use = in_use;        in_use = in_use_swap;
+    ws->max_buffers = max_buffers;
+
+cleanup:
+    magma_free_cpu( buffer );
+    magma_free_cpu( capacity );
+    magma_free_cpu( in_use );
+    return info;
+}
+
+
+/*
+    Hands the buffer ptr back to the workspace. If ptr was not drawn from the
+    workspace, it is either taken over as a free buffer of the given size
+    (adopt == 1), or freed (adopt == 0).
+    Has to be called inside the workspace critical section.
+*/
+static void
+magma_cworkspace_release(
+    magma_c_workspace *ws,
+    void *ptr,
+    size_t size,
+    magma_int_t adopt )
+{
+    if( ptr == NULL ){
+        return;
+    }
+    for( magma_int_t i=0; i<ws->num_buffers; i++ ){
+        if( ws->buffer[ i ] == ptr ){
+            ws->in_use[ i ] = 0;
+            return;
+        }
+    }
+    if( adopt == 1 && magma_cworkspace_grow_table( ws ) == MAGMA_SUCCESS ){
+        magma_int_t i = ws->num_buffers++;
+        ws->buffer[ i ] = ptr;
+        ws->capacity[ i ] = size;
+        ws->in_use[ i ] = 0;
+        ws->footprint += size;
+    } else {
+        magma_free_cpu( ptr );
+    }
+}
+
+
+/***************************************************************************//**
+    Purpose
+    -------
+    Hands out a host buffer of at least size bytes from the workspace.
+    The smallest free buffer that is large enough is reused. If there is none,
+    the largest free buffer is reallocated with at least twice its capacity,
+    so buffers that grow over the iterations only trigger a logarithmic number
+    of allocations. A zero-initialized magma_c_workspace is a valid, empty
+    workspace. The function is thread-safe.
+
+    Arguments
+    ---------
+
+    @param[in,out]
+    ws          magma_c_workspace*
+                Workspace. If NULL, the buffer is allocated with
+                magma_malloc_cpu.
+
+    @param[out]
+    ptr         void**
+                Host buffer.
+
+    @param[in]
+    size        size_t
+                Requested size in bytes.
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_caux
+*******************************************************************************/
+
+extern "C" magma_int_t
+magma_cworkspace_malloc(
+    magma_c_workspace *ws,
+    void **ptr,
+    size_t size,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+
+    if( ws == NULL ){
+        return magma_malloc_cpu( ptr, size );
+    }
+
+    #pragma omp critical(magma_cworkspace)
+    {
+        magma_int_t fit = -1, grow = -1;
+        for( magma_int_t i=0; i<ws->num_buffers; i++ ){
+            if( ws->in_use[ i ] == 0 ){
+                if( ws->capacity[ i ] >= size ){
+                    if( fit == -1 || ws->capacity[ i ] < ws->capacity[ fit ] ){
+                        fit = i;
+                    }
+                } else if( grow == -1 || ws->capacity[ i ] > ws->capacity[ grow ] ){
+                    grow = i;
+                }
+            }
+        }
+        if( fit == -1 && grow == -1 ){
+            info = magma_cworkspace_grow_table( ws );
+            if( info == 0 ){
+                grow = ws->num_buffers++;
+                ws->buffer[ grow ] = NULL;
+                ws->capacity[ grow ] = 0;
+                ws->in_use[ grow ] = 0;
+            }
+        }
+        if( fit == -1 && info == 0 ){
+            size_t newcap = ( size > 2*ws->capacity[ grow ] ) ?
+                size : 2*ws->capacity[ grow ];
+            magma_free_cpu( ws->buffer[ grow ] );
+            ws->footprint -= ws->capacity[ grow ];
+            ws->capacity[ grow ] = 0;
+            info = magma_malloc_cpu( &ws->buffer[ grow ], newcap );
+            if( info == 0 ){
+                ws->capacity[ grow ] = newcap;
+                ws->footprint += newcap;
+                ws->num_alloc++;
+                fit = grow;
+            }
+        }
+        if( info == 0 ){
+            ws->in_use[ fit ] = 1;
+            *ptr = ws->buffer[ fit ];
+        } else {
+            *ptr = NULL;
+        }
+    }
+
+    return info;
+}
+
+
+/***************************************************************************//**
+    Purpose
+    -------
+    Hands a buffer obtained from magma_cworkspace_malloc back to the
+    workspace. The memory is kept for later use. Pointers that were not drawn
+    from the workspace are freed.
+
+    Arguments
+    ---------
+
+    @param[in,out]
+    ws          magma_c_workspace*
+                Workspace. If NULL, the buffer is freed with magma_free_cpu.
+
+    @param[in]
+    ptr         void*
+                Host buffer.
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_caux
+*******************************************************************************/
+
+extern "C" magma_int_t
+magma_cworkspace_free(
+    magma_c_workspace *ws,
+    void *ptr,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+
+    if( ws == NULL ){
+        magma_free_cpu( ptr );
+        return info;
+    }
+
+    #pragma omp critical(magma_cworkspace)
+    {
+        magma_cworkspace_release( ws, ptr, 0, 0 );
+    }
+
+    return info;
+}
+
+
+/***************************************************************************//**
+    Purpose
+    -------
+    Hands the arrays of a host CSR matrix back to the workspace, and resets
+    the matrix. Arrays that were not drawn from the workspace are taken over
+    as free buffers, so the matrix has to own its arrays. This allows to
+    recycle the factors and candidate lists of the ParILUT iterations.
+
+    Arguments
+    ---------
+
+    @param[in,out]
+    ws          magma_c_workspace*
+                Workspace. If NULL, the matrix is freed with magma_cmfree.
+
+    @param[in,out]
+    A           magma_c_matrix*
+                Host matrix in CSR or CSRCOO format.
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_caux
+*******************************************************************************/
+
+extern "C" magma_int_t
+magma_cworkspace_mfree(
+    magma_c_workspace *ws,
+    magma_c_matrix *A,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+
+    if( ws == NULL || A->memory_location != Magma_CPU ){
+        return magma_cmfree( A, queue );
+    }
+
+    #pragma omp critical(magma_cworkspace)
+    {
+        magma_cworkspace_release( ws, A->val,
+            A->nnz*sizeof(magmaFloatComplex), 1 );
+        magma_cworkspace_release( ws, A->col, A->nnz*sizeof(magma_index_t), 1 );
+        magma_cworkspace_release( ws, A->rowidx, A->nnz*sizeof(magma_index_t), 1 );
+        magma_cworkspace_release( ws, A->row,
+            (A->num_rows+1)*sizeof(magma_index_t), 1 );
+    }
+    A->val = NULL;
+    A->col = NULL;
+    A->rowidx = NULL;
+    A->row = NULL;
+    A->num_rows = 0;
+    A->num_cols = 0;
+    A->nnz = 0;
+    A->true_nnz = 0;
+
+    return info;
+}
+
+
+/***************************************************************************//**
+    Purpose
+    -------
+    Frees all buffers held by the workspace, including buffers that are still
+    handed out, and resets it to an empty workspace.
+
+    Arguments
+    ---------
+
+    @param[in,out]
+    ws          magma_c_workspace*
+                Workspace.
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_caux
+*******************************************************************************/
+
+extern "C" magma_int_t
+magma_cworkspace_destroy(
+    magma_c_workspace *ws,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+
+    for( magma_int_t i=0; i<ws->num_buffers; i++ ){
+        magma_free_cpu( ws->buffer[ i ] );
+    }
+    magma_free_cpu( ws->buffer );
+    magma_free_cpu( ws->capacity );
+    magma_free_cpu( ws->in_use );
+    ws->buffer = NULL;
+    ws->capacity = NULL;
+    ws->in_use = NULL;
+    ws->num_buffers = 0;
+    ws->max_buffers = 0;
+    ws->num_alloc = 0;
+    ws->footprint = 0;
+
+    return info;
+}
@@ -5,15 +5,23 @@
        Univ. of Colorado, Denver
        @date April 2022
 
-       @generated from sparse/control/magma_zgeisai_tools.cpp, normal z -> d, Wed Apr 20 17:38:07 2022
+       @generated from sparse/control/magma_zgeisai_tools.cpp, normal z -> d, Sun Oct 18 22:20:41 2026
        @author Hartwig Anzt
 
 */
 
 #include "magmasparse_internal.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #define WARP_SIZE 32
 
+// systems solved together in SIMD lanes by magma_dmtrisolve_vbatched,
+// systems larger than ISAI_SIMD_MAX are solved one at a time
+#define ISAI_BATCH 8
+#define ISAI_SIMD_MAX 64
+
 
 /***************************************************************************//**
     Purpose
@@ -25,6 +33,8 @@
         * an array containing all the sparse triangular systems
             - padded with zeros to size 32x32
         * an array containing the RHS
+    Rows of LC with more than 32 nonzeros are not supported, see
+    magma_dmprepare_vbatched for a packed layout without this limit.
 
     Arguments
     ---------
@@ -320,6 +330,597 @@ magma_dmbackinsert_batched(
 }
 
 
+/*
+    Solves op(T) x = b for a dense triangular system T of size n (column-major,
+    leading dimension n) in blocks of WARP_SIZE: triangular solve on the
+    diagonal block, then a matrix-vector update of the remaining part of x.
+*/
+static void
+magma_disai_trsv_blocked(
+    magma_uplo_t uplotype,
+    magma_trans_t transtype,
+    magma_diag_t diagtype,
+    magma_int_t n,
+    double *T,
+    double *x )
+{
+    const char *uplo  = lapack_uplo_const( uplotype );
+    const char *trans = lapack_trans_const( transtype );
+    const char *diag  = lapack_diag_const( diagtype );
+    double c_one = MAGMA_D_ONE, c_neg_one = MAGMA_D_NEG_ONE;
+    magma_int_t ione = 1;
+    magma_int_t nb, nr;
+
+    if( (uplotype == MagmaLower) == (transtype == MagmaNoTrans) ){
+        // op(T) is lower triangular: forward substitution
+        for( magma_int_t b=0; b<n; b+=WARP_SIZE ){
+            nb = min( WARP_SIZE, n-b );
+            nr = n-b-nb;
+            blasf77_dtrsv( uplo, trans, diag, &nb, &T[b+(size_t) b*n], &n, &x[b], &ione );
+            if( nr == 0 ){
+                break;
+            }
+            if( transtype == MagmaNoTrans ){
+                blasf77_dgemv( trans, &nr, &nb, &c_neg_one, &T[b+nb+(size_t) b*n], &n,
+                               &x[b], &ione, &c_one, &x[b+nb], &ione );
+            } else {
+                blasf77_dgemv( trans, &nb, &nr, &c_neg_one, &T[b+(size_t) (b+nb)*n], &n,
+                               &x[b], &ione, &c_one, &x[b+nb], &ione );
+            }
+        }
+    } else {
+        // op(T) is upper triangular: backward substitution
+        for( magma_int_t e=n; e>0; e-=WARP_SIZE ){
+            nb = min( WARP_SIZE, e );
+            nr = e-nb;
+            blasf77_dtrsv( uplo, trans, diag, &nb, &T[nr+(size_t) nr*n], &n, &x[nr], &ione );
+            if( nr == 0 ){
+                break;
+            }
+            if( transtype == MagmaNoTrans ){
+                blasf77_dgemv( trans, &nr, &nb, &c_neg_one, &T[(size_t) nr*n], &n,
+                               &x[nr], &ione, &c_one, x, &ione );
+            } else {
+                blasf77_dgemv( trans, &nb, &nr, &c_neg_one, &T[nr], &n,
+                               &x[nr], &ione, &c_one, x, &ione );
+            }
+        }
+    }
+}
+
+
+/*
+    Offsets of the packed systems: sysptr[i+1] - sysptr[i] is the squared
+    size of system i. The prefix sum is computed in size_t, in blocks of
+    rows: every block is summed in parallel, then the block sums are
+    scanned and added.
+*/
+static magma_int_t
+magma_disai_sysptr_cpu(
+    magma_d_matrix LC,
+    size_t *sysptr )
+{
+    magma_int_t info = 0;
+
+    magma_int_t num_blocks = 1, block_size;
+    size_t *offset = NULL;
+
+#ifdef _OPENMP
+    num_blocks = omp_get_max_threads();
+#endif
+    block_size = magma_ceildiv( LC.num_rows, num_blocks );
+    CHECK( magma_malloc_cpu( (void**) &offset, (num_blocks+1)*sizeof(size_t) ));
+
+    #pragma omp parallel for schedule(static)
+    for( magma_int_t b=0; b<num_blocks; b++ ){
+        magma_int_t end = min( (b+1)*block_size, LC.num_rows );
+        size_t sum = 0;
+        for( magma_int_t i=b*block_size; i<end; i++ ){
+            size_t size = LC.row[i+1] - LC.row[i];
+            sum += size*size;
+            sysptr[i+1] = sum;
+        }
+        offset[b+1] = sum;
+    }
+    offset[0] = 0;
+    for( magma_int_t b=0; b<num_blocks; b++ ){
+        offset[b+1] += offset[b];
+    }
+    sysptr[0] = 0;
+    #pragma omp parallel for schedule(static)
+    for( magma_int_t b=1; b<num_blocks; b++ ){
+        magma_int_t end = min( (b+1)*block_size, LC.num_rows );
+        for( magma_int_t i=b*block_size; i<end; i++ ){
+            sysptr[i+1] += offset[b];
+        }
+    }
+
+cleanup:
+    magma_free_cpu( offset );
+    return info;
+}
+
+
+/***************************************************************************//**
+    Purpose
+    -------
+    Variable-size counterpart of magma_dmprepare_batched. Every local
+    triangular system is stored at its real size instead of being padded to
+    32x32, and there is no limit on the number of nonzeros per row of LC:
+        * sysptr[i] is the offset of system i in trisystems, the prefix sum
+          of the squared system sizes; system i is L(J,J) for the pattern
+          J = LC.col[ LC.row[i] : LC.row[i+1] ], stored column-major at
+          trisystems + sysptr[i]
+        * the RHS of system i starts at rhs + LC.row[i] and is the unit
+          vector of the first (lower) or last (upper) entry of J
+    The arrays sysptr, trisystems and rhs are allocated in CPU memory and
+    have to be released with magma_free_cpu.
+
+    Arguments
+    ---------
+
+    @param[in]
+    uplotype    magma_uplo_t
+                lower or upper triangular
+
+    @param[in]
+    transtype   magma_trans_t
+                possibility for transposed matrix
+
+    @param[in]
+    diagtype    magma_diag_t
+                unit diagonal or not
+
+    @param[in]
+    L           magma_d_matrix
+                Matrix in CSR format
+
+    @param[in]
+    LC          magma_d_matrix
+                same matrix, also CSR, but col-major, the column indices of
+                every row sorted in ascending order
+
+    @param[out]
+    sysptr      size_t**
+                offsets of the systems, array of size LC.num_rows+1
+
+    @param[out]
+    trisystems  double**
+                packed trisystems, array of size sysptr[LC.num_rows]
+
+    @param[out]
+    rhs         double**
+                packed right-hand sides, array of size LC.nnz
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_daux
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_dmprepare_vbatched(
+    magma_uplo_t uplotype,
+    magma_trans_t transtype,
+    magma_diag_t diagtype,
+    magma_d_matrix L,
+    magma_d_matrix LC,
+    size_t **sysptr,
+    double **trisystems,
+    double **rhs,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+
+    size_t *ptr = NULL;
+    double *tri = NULL, *b = NULL;
+
+    CHECK( magma_malloc_cpu( (void**) &ptr, (LC.num_rows+1)*sizeof(size_t) ));
+    CHECK( magma_disai_sysptr_cpu( LC, ptr ));
+    CHECK( magma_dmalloc_cpu( &tri, ptr[LC.num_rows] ));
+    CHECK( magma_dmalloc_cpu( &b, LC.nnz ));
+
+    // the systems are zeroed by the thread filling them
+    #pragma omp parallel for schedule(dynamic,WARP_SIZE)
+    for( magma_int_t i=0; i<LC.num_rows; i++ ){
+        magma_int_t size = LC.row[i+1] - LC.row[i];
+        magma_index_t *loc = &LC.col[ LC.row[i] ];
+        double *T = &tri[ ptr[i] ];
+        double *x = &b[ LC.row[i] ];
+
+        for( size_t j=0; j<(size_t) size*size; j++ ){
+            T[j] = MAGMA_D_ZERO;
+        }
+        for( magma_int_t j=0; j<size; j++ ){
+            x[j] = MAGMA_D_ZERO;
+        }
+        if( size > 0 ){
+            x[ uplotype == MagmaLower ? 0 : size-1 ] = MAGMA_D_ONE;
+        }
+        // row j of T is row loc[j] of L restricted to the pattern
+        for( magma_int_t j=0; j<size; j++ ){
+            magma_int_t k = L.row[ loc[j] ];
+            magma_int_t l = 0;
+            while( k < L.row[ loc[j]+1 ] && l < size ){
+                if( loc[l] == L.col[k] ){
+                    T[ (size_t) l*size + j ] = L.val[k];
+                    k++;
+                    l++;
+                } else if( L.col[k] < loc[l] ){
+                    k++;
+                } else {
+                    l++;
+                }
+            }
+        }
+    }
+
+    *sysptr = ptr;
+    *trisystems = tri;
+    *rhs = b;
+
+cleanup:
+    if( info != 0 ){
+        magma_free_cpu( ptr );
+        magma_free_cpu( tri );
+        magma_free_cpu( b );
+    }
+    return info;
+}
+
+
+/*
+    Solves op(T) x = b for the nb packed systems listed in sys[0:count].
+    The systems are copied interleaved, entry (a,c) of op(T) of lane s at
+    W[(a*m+c)*nb+s], so every step of the substitution runs across the
+    lanes. Lanes and rows beyond the size of a system are padded with the
+    identity and a zero right-hand side.
+*/
+template <int nb>
+static void
+magma_disai_batch_cpu(
+    magma_uplo_t uplotype,
+    magma_trans_t transtype,
+    magma_diag_t diagtype,
+    magma_d_matrix LC,
+    const size_t *sysptr,
+    const double *trisystems,
+    double *rhs,
+    const magma_index_t *sys,
+    magma_int_t count,
+    double *W,
+    double *x )
+{
+    bool lower = ( (uplotype == MagmaLower) == (transtype == MagmaNoTrans) );
+    magma_int_t m = 0;
+    for( magma_int_t s=0; s<count; s++ ){
+        m = max( m, (magma_int_t) (LC.row[ sys[s]+1 ] - LC.row[ sys[s] ]) );
+    }
+
+    for( magma_int_t s=0; s<nb; s++ ){
+        magma_int_t ns = 0;
+        if( s < count ){
+            const double *T = trisystems + sysptr[ sys[s] ];
+            const double *b = rhs + LC.row[ sys[s] ];
+            ns = LC.row[ sys[s]+1 ] - LC.row[ sys[s] ];
+            for( magma_int_t a=0; a<ns; a++ ){
+                for( magma_int_t c=0; c<ns; c++ ){
+                    double t;
+                    if( transtype == MagmaNoTrans ){
+                        t = T[ c*ns+a ];
+                    } else if( transtype == MagmaTrans ){
+                        t = T[ a*ns+c ];
+                    } else {
+                        t = MAGMA_D_CONJ( T[ a*ns+c ] );
+                    }
+                    W[ (a*m+c)*nb+s ] = t;
+                }
+                for( magma_int_t c=ns; c<m; c++ ){
+                    W[ (a*m+c)*nb+s ] = MAGMA_D_ZERO;
+                }
+                if( diagtype == MagmaUnit ){
+                    W[ (a*m+a)*nb+s ] = MAGMA_D_ONE;
+                }
+                x[ a*nb+s ] = b[ a ];
+            }
+        }
+        for( magma_int_t a=ns; a<m; a++ ){
+            for( magma_int_t c=0; c<m; c++ ){
+                W[ (a*m+c)*nb+s ] = ( a == c ) ? MAGMA_D_ONE : MAGMA_D_ZERO;
+            }
+            x[ a*nb+s ] = MAGMA_D_ZERO;
+        }
+    }
+
+    // forward or backward substitution, in place
+    for( magma_int_t i=0; i<m; i++ ){
+        magma_int_t a = lower ? i : m-1-i;
+        magma_int_t cstart = lower ? 0 : a+1;
+        magma_int_t cend = lower ? a : m;
+        for( magma_int_t c=cstart; c<cend; c++ ){
+            #pragma omp simd
+            for( magma_int_t s=0; s<nb; s++ ){
+                x[ a*nb+s ] -= W[ (a*m+c)*nb+s ] * x[ c*nb+s ];
+            }
+        }
+        #pragma omp simd
+        for( magma_int_t s=0; s<nb; s++ ){
+            x[ a*nb+s ] = x[ a*nb+s ] / W[ (a*m+a)*nb+s ];
+        }
+    }
+
+    for( magma_int_t s=0; s<count; s++ ){
+        double *b = rhs + LC.row[ sys[s] ];
+        magma_int_t ns = LC.row[ sys[s]+1 ] - LC.row[ sys[s] ];
+        for( magma_int_t a=0; a<ns; a++ ){
+            b[ a ] = x[ a*nb+s ];
+        }
+    }
+}
+
+
+/***************************************************************************//**
+    Purpose
+    -------
+    Does all triangular solves op(T) x = b on the packed layout of
+    magma_dmprepare_vbatched. The systems are sorted by size and solved in
+    batches of ISAI_BATCH with the substitution vectorized across the
+    systems of a batch. Systems larger than ISAI_SIMD_MAX are solved one
+    at a time in place, blockwise with blocks of size 32.
+
+    Arguments
+    ---------
+
+    @param[in]
+    uplotype    magma_uplo_t
+                lower or upper triangular
+
+    @param[in]
+    transtype   magma_trans_t
+                possibility for transposed matrix
+
+    @param[in]
+    diagtype    magma_diag_t
+                unit diagonal or not
+
+    @param[in]
+    LC          magma_d_matrix
+                pattern the systems were generated for, CSR col-major
+
+    @param[in]
+    sysptr      size_t*
+                offsets of the systems
+
+    @param[in,out]
+    trisystems  double*
+                packed trisystems
+
+    @param[in,out]
+    rhs         double*
+                packed right-hand sides, overwritten with the solutions
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_daux
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_dmtrisolve_vbatched(
+    magma_uplo_t uplotype,
+    magma_trans_t transtype,
+    magma_diag_t diagtype,
+    magma_d_matrix LC,
+    size_t *sysptr,
+    double *trisystems,
+    double *rhs,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+
+    magma_int_t num_threads = 1;
+    magma_int_t maxsize = 0, nsmall, nbatches, msimd;
+    size_t lwork;
+    magma_index_t *order = NULL, *count = NULL;
+    double *work = NULL;
+
+#ifdef _OPENMP
+    num_threads = omp_get_max_threads();
+#endif
+
+    // sort the systems by size, a batch then holds systems of similar size
+    for( magma_int_t i=0; i<LC.num_rows; i++ ){
+        maxsize = max( maxsize, (magma_int_t) (LC.row[i+1] - LC.row[i]) );
+    }
+    CHECK( magma_index_malloc_cpu( &count, maxsize+2 ));
+    CHECK( magma_index_malloc_cpu( &order, LC.num_rows ));
+    for( magma_int_t i=0; i<maxsize+2; i++ ){
+        count[ i ] = 0;
+    }
+    for( magma_int_t i=0; i<LC.num_rows; i++ ){
+        count[ LC.row[i+1] - LC.row[i] + 1 ]++;
+    }
+    for( magma_int_t i=0; i<maxsize+1; i++ ){
+        count[ i+1 ] += count[ i ];
+    }
+    nsmall = count[ min( maxsize, (magma_int_t) ISAI_SIMD_MAX ) + 1 ];
+    for( magma_int_t i=0; i<LC.num_rows; i++ ){
+        order[ count[ LC.row[i+1] - LC.row[i] ]++ ] = i;
+    }
+    nbatches = magma_ceildiv( nsmall, ISAI_BATCH ) + LC.num_rows - nsmall;
+
+    msimd = min( maxsize, (magma_int_t) ISAI_SIMD_MAX );
+    lwork = (size_t) msimd*(msimd+1)*ISAI_BATCH;
+    CHECK( magma_dmalloc_cpu( &work, num_threads*lwork ));
+
+    #pragma omp parallel num_threads(num_threads)
+    {
+        magma_int_t id = 0;
+#ifdef _OPENMP
+        id = omp_get_thread_num();
+#endif
+        double *W = work + id*lwork;
+        #pragma omp for schedule(dynamic,1)
+        for( magma_int_t b=0; b<nbatches; b++ ){
+            magma_int_t first = b*ISAI_BATCH;
+            if( first < nsmall ){
+                magma_int_t nsys = min( (magma_int_t) ISAI_BATCH, nsmall-first );
+                magma_disai_batch_cpu<ISAI_BATCH>( uplotype, transtype,
+                    diagtype, LC, sysptr, trisystems, rhs, order+first, nsys,
+                    W, W+msimd*msimd*ISAI_BATCH );
+            } else {
+                magma_int_t r = nsmall + b - magma_ceildiv( nsmall, ISAI_BATCH );
+                magma_int_t i = order[ r ];
+                magma_disai_trsv_blocked( uplotype, transtype, diagtype,
+                    LC.row[i+1] - LC.row[i], &trisystems[ sysptr[i] ],
+                    &rhs[ LC.row[i] ] );
+            }
+        }
+    }
+
+cleanup:
+    magma_free_cpu( order );
+    magma_free_cpu( count );
+    magma_free_cpu( work );
+    return info;
+}
+
+
+/***************************************************************************//**
+    Purpose
+    -------
+    Inserts the solutions of magma_dmtrisolve_vbatched into the
+    preconditioner matrix. M has the pattern of LC, so the packed
+    right-hand sides line up with M->val.
+
+    Arguments
+    ---------
+
+    @param[in]
+    uplotype    magma_uplo_t
+                lower or upper triangular
+
+    @param[in]
+    transtype   magma_trans_t
+                possibility for transposed matrix
+
+    @param[in]
+    diagtype    magma_diag_t
+                unit diagonal or not
+
+    @param[in,out]
+    M           magma_d_matrix*
+                SPAI preconditioner CSR col-major
+
+    @param[in]
+    rhs         double*
+                packed solutions
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_daux
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_dmbackinsert_vbatched(
+    magma_uplo_t uplotype,
+    magma_trans_t transtype,
+    magma_diag_t diagtype,
+    magma_d_matrix *M,
+    double *rhs,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+
+    #pragma omp parallel for schedule(static)
+    for( magma_int_t i=0; i<M->nnz; i++ ){
+        M->val[i] = rhs[i];
+    }
+
+    return info;
+}
+
+
+/***************************************************************************//**
+    Purpose
+    -------
+    Generates the ISAI preconditioner on the CPU, this is the host
+    counterpart of magma_disai_generator_regs. Every row j of M holds the
+    pattern J of the j-th column of the ISAI, and the values of the column
+    solve L(J,J) m = e_j. The systems are generated, solved and inserted
+    with magma_dmprepare_vbatched, magma_dmtrisolve_vbatched and
+    magma_dmbackinsert_vbatched. There is no limit on the size of the
+    systems.
+
+    Arguments
+    ---------
+
+    @param[in]
+    uplotype    magma_uplo_t
+                lower or upper triangular
+
+    @param[in]
+    transtype   magma_trans_t
+                possibility for transposed matrix: only MagmaNoTrans
+
+    @param[in]
+    diagtype    magma_diag_t
+                unit diagonal or not
+
+    @param[in]
+    L           magma_d_matrix
+                triangular factor in CSR for which the ISAI matrix is
+                computed.
+
+    @param[in,out]
+    M           magma_d_matrix*
+                SPAI preconditioner CSR col-major, the column indices of
+                every row sorted in ascending order
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_daux
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_disai_generator_cpu(
+    magma_uplo_t uplotype,
+    magma_trans_t transtype,
+    magma_diag_t diagtype,
+    magma_d_matrix L,
+    magma_d_matrix *M,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+
+    size_t *sysptr = NULL;
+    double *trisystems = NULL, *rhs = NULL;
+
+    if( transtype != MagmaNoTrans ){
+        info = MAGMA_ERR_NOT_SUPPORTED;
+        goto cleanup;
+    }
+    CHECK( magma_dmprepare_vbatched( uplotype, transtype, diagtype, L, *M,
+                                     &sysptr, &trisystems, &rhs, queue ));
+    CHECK( magma_dmtrisolve_vbatched( uplotype, transtype, diagtype, *M,
+                                      sysptr, trisystems, rhs, queue ));
+    CHECK( magma_dmbackinsert_vbatched( uplotype, transtype, diagtype, M,
+                                        rhs, queue ));
+
+cleanup:
+    magma_free_cpu( sysptr );
+    magma_free_cpu( trisystems );
+    magma_free_cpu( rhs );
+    return info;
+}
+
+
 /***************************************************************************//**
     Purpose
     -------
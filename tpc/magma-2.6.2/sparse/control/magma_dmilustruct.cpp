@@ -5,14 +5,19 @@
        Univ. of Colorado, Denver
        @date April 2022
 
-       @generated from sparse/control/magma_zmilustruct.cpp, normal z -> d, Wed Apr 20 17:38:07 2022
+       @generated from sparse/control/magma_zmilustruct.cpp, normal z -> d, Sun Oct 18 22:37:38 2026
        @author Hartwig Anzt
 */
 
 //  in this file, many routines are taken from
 //  the IO functions provided by MatrixMarket
 
+#include <thread>
+
 #include "magmasparse_internal.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 
 /******************************************************************************
@@ -54,8 +59,24 @@ void magma_dshell_sort(
 // factors magma_int_to separate upper and lower parts
 // sorts the entries in each row of A by index
 // assumes no zero rows
+//
+// Row i depends on the rows of U that end up in its lower part, and those
+// are only known once the merge reaches them. Rows are handed out in
+// increasing order in chunks of SYMILU_CHUNK, and a thread merging row i
+// waits until the next row of the lower part is marked ready, so the
+// oldest unfinished row can always proceed. Every thread keeps its own
+// linked list and level array of length n, and stores the L and U
+// patterns of its rows in blocks of at least SYMILU_BLOCK indices that
+// are never moved. The dense arrays take num_threads*(2n+maxlen+1)
+// indices, so the number of threads is reduced until they fit into the
+// storage *nzl + *nzu provided for the factors; for ILU(0) of a 7-point
+// stencil with the storage of magma_dsymbilu this allows 7 threads. After all rows are done, the row pointers are scanned
+// and the patterns are copied into the output arrays.
 */
 
+#define SYMILU_CHUNK 32
+#define SYMILU_BLOCK 65536
+
 extern "C"
 magma_int_t
 magma_dsymbolic_ilu(
@@ -72,166 +93,296 @@ magma_dsymbolic_ilu(
 {
     magma_int_t info = 0;
     
-    magma_int_t i;
-    magma_index_t *lnklst=NULL;
-    magma_index_t *curlev=NULL;
-    magma_index_t *levels=NULL;
-    magma_index_t *iwork=NULL;
-    
-    magma_int_t knzl = 0;
-    magma_int_t knzu = 0;
-
-    CHECK( magma_index_malloc_cpu( &lnklst, n ));
-    CHECK( magma_index_malloc_cpu( &curlev, n ));
-    CHECK( magma_index_malloc_cpu( &levels, *nzu ));
-    CHECK( magma_index_malloc_cpu( &iwork, n ));
+    magma_int_t num_threads = 1;
+    magma_int_t maxlen = 0;
+    magma_int_t nextrow = 0;
+    size_t wsize;
+    magma_index_t *work=NULL;
+    magma_index_t *ready=NULL;
+    magma_index_t **rowdata=NULL;
+    void **blocks=NULL;
     
-    for(magma_int_t t=0; t<n; t++){
-        lnklst[t] = 0;
-        curlev[t] = 0;
-        iwork[t] = 0;
+#ifdef _OPENMP
+    num_threads = omp_get_max_threads();
+#endif
+    for (magma_int_t i=0; i<n; i++) {
+        maxlen = max( maxlen, (magma_int_t) (ia[i+1] - ia[i]) );
     }
-
-    for(magma_int_t t=0; t<*nzu; t++){
-        levels[t] = 0;
+    // per-thread linked list, levels and sorted row, sized in size_t; the
+    // number of workers is bounded so that these dense arrays take no more
+    // memory than the factors the caller provided storage for
+    wsize = 2*(size_t) n + maxlen + 1;
+    num_threads = max( (magma_int_t) 1, min( num_threads,
+        (magma_int_t) ( ((size_t) *nzl + (size_t) *nzu) / wsize ) ));
+    CHECK( magma_index_malloc_cpu( &work, num_threads*wsize ));
+    CHECK( magma_index_malloc_cpu( &ready, n ));
+    CHECK( magma_malloc_cpu( (void**) &rowdata, n*sizeof(magma_index_t*) ));
+    CHECK( magma_malloc_cpu( (void**) &blocks, num_threads*sizeof(void*) ));
+    for (magma_int_t t=0; t<num_threads; t++) {
+        blocks[t] = NULL;
+    }
+    #pragma omp parallel for schedule(static)
+    for (magma_int_t t=0; t<n; t++) {
+        ready[t] = 0;
     }
 
-    ial[0] = 0;
-    iau[0] = 0;
-
-    for (i=0; i<n; i++) {
-        //printf("check line %d\n", i);
-        magma_int_t first, next, j;
-
-        /* copy column indices of row into workspace and sort them */
-
-        magma_int_t len = ia[i+1] - ia[i];
-        next = 0;
-        for (j=ia[i]; j<ia[i+1]; j++)
-            iwork[next++] = ja[j];
-        magma_dshell_sort(len, iwork);
-        //printf("check2 line %d\n", i);
-        /* construct implied linked list for row */
-
-        first = iwork[0];
-        curlev[first] = 0;
-
-        for (j=0; j<=len-2; j++)
-        {
-            lnklst[iwork[j]] = iwork[j+1];
-            curlev[iwork[j]] = 0;
+    #pragma omp parallel num_threads(num_threads)
+    {
+        magma_int_t id = 0;
+#ifdef _OPENMP
+        id = omp_get_thread_num();
+#endif
+        magma_index_t *lnklst = work + id*wsize;
+        magma_index_t *curlev = lnklst + n;
+        magma_index_t *iwork = curlev + n;
+        magma_index_t *store = NULL;
+        magma_int_t used = 0, cap = 0;
+        magma_int_t tinfo = 0, blocked = 0;
+        
+        for (magma_int_t t=0; t<n; t++) {
+            lnklst[t] = 0;
+            curlev[t] = 0;
         }
-        // printf("check3 line %d iwork[len-1]:%d\n", i, iwork[len-1]);
-        lnklst[iwork[len-1]] = n;
-        curlev[iwork[len-1]] = 0;
-
-        /* merge with rows in U */
-        // printf("check4 line %d lnklst[iwork[len-1]]:%d\n", i, lnklst[iwork[len-1]]);
-        next = first;
-        // printf("next:%d (!<) first:%d\n", next, i);
-        while (next < i)
-        {
-          //  printf("check line %d while %d\n", i, next);
-            magma_int_t oldlst = next;
-            magma_int_t nxtlst = lnklst[next];
-            magma_int_t row = next;
-            magma_int_t ii;
-
-            /* scan row */
-
-            for (ii=iau[row]+1; ii<iau[row+1]; /*nop*/)
-            {
-                if (jau[ii] < nxtlst)
+        
+        while (true) {
+            magma_int_t chunk, failed;
+            #pragma omp atomic capture
+            { chunk = nextrow; nextrow += SYMILU_CHUNK; }
+            #pragma omp atomic read
+            failed = info;
+            if (chunk >= n || failed != 0) {
+                break;
+            }
+            for (magma_int_t i=chunk; i<min(chunk+SYMILU_CHUNK, n); i++) {
+                magma_int_t first, next, j, knzl, knzu;
+                
+                /* copy column indices of row into workspace and sort them */
+                
+                magma_int_t len = ia[i+1] - ia[i];
+                next = 0;
+                for (j=ia[i]; j<ia[i+1]; j++)
+                    iwork[next++] = ja[j];
+                magma_dshell_sort(len, iwork);
+                
+                /* construct implied linked list for row */
+                
+                first = ( len > 0 ) ? iwork[0] : n;
+                for (j=0; j<=len-2; j++)
                 {
-                    /* new fill-in */
-                    magma_int_t newlev = curlev[row] + levels[ii] + 1;
-                    if (newlev <= levfill)
+                    lnklst[iwork[j]] = iwork[j+1];
+                    curlev[iwork[j]] = 0;
+                }
+                if (len > 0) {
+                    lnklst[iwork[len-1]] = n;
+                    curlev[iwork[len-1]] = 0;
+                }
+                
+                /* merge with rows in U, waiting until they are ready */
+                
+                next = first;
+                while (next < i)
+                {
+                    magma_int_t oldlst = next;
+                    magma_int_t nxtlst = lnklst[next];
+                    magma_int_t row = next;
+                    magma_int_t ii, done = 0;
+                    
+                    while (true) {
+                        #pragma omp atomic read
+                        done = ready[row];
+                        if (done != 0) {
+                            break;
+                        }
+                        // give way to the owner when threads share cores
+                        std::this_thread::yield();
+                    }
+                    #pragma omp flush
+                    if (done < 0) {
+                        blocked = 1;
+                        break;
+                    }
+                    const magma_index_t *ju = rowdata[row] + ial[row+1];
+                    const magma_index_t *lev = ju + iau[row+1];
+                    
+                    /* scan row */
+                    
+                    for (ii=1; ii<iau[row+1]; /*nop*/)
                     {
-                        lnklst[oldlst]  = jau[ii];
-                        lnklst[jau[ii]] = nxtlst;
-                        oldlst = jau[ii];
-                        curlev[jau[ii]] = newlev;
+                        if (ju[ii] < nxtlst)
+                        {
+                            /* new fill-in */
+                            magma_int_t newlev = curlev[row] + lev[ii] + 1;
+                            if (newlev <= levfill)
+                            {
+                                lnklst[oldlst]  = ju[ii];
+                                lnklst[ju[ii]] = nxtlst;
+                                oldlst = ju[ii];
+                                curlev[ju[ii]] = newlev;
+                            }
+                            ii++;
+                        }
+                        else if (ju[ii] == nxtlst)
+                        {
+                            magma_int_t newlev;
+                            oldlst = nxtlst;
+                            nxtlst = lnklst[oldlst];
+                            newlev = curlev[row] + lev[ii] + 1;
+                            curlev[ju[ii]] = min( curlev[ju[ii]], newlev );
+                            ii++;
+                        }
+                        else /* (ju[ii] > nxtlst) */
+                        {
+                            oldlst = nxtlst;
+                            nxtlst = lnklst[oldlst];
+                        }
                     }
-                    ii++;
+                    next = lnklst[next];
                 }
-                else if (jau[ii] == nxtlst)
+                
+                // a row this one depends on failed: the thread that failed
+                // has set info, only pass the failure on to the dependents
+                if (blocked) {
+                    #pragma omp atomic write
+                    ready[i] = -1;
+                    break;
+                }
+                
+                /* count the pattern and make room in the current block */
+                
+                knzl = 0;
+                knzu = 0;
+                for (next=first; next<n; next=lnklst[next]) {
+                    if (next < i) {
+                        knzl++;
+                    } else {
+                        knzu++;
+                    }
+                }
+                if (used + knzl + 2*knzu > cap) {
+                    void *blk = NULL;
+                    cap = max( (magma_int_t) SYMILU_BLOCK, knzl + 2*knzu );
+                    // blocks are chained through a pointer in front of the data
+                    if (magma_malloc_cpu( &blk, sizeof(void*)
+                                          + cap*sizeof(magma_index_t) ) != MAGMA_SUCCESS) {
+                        tinfo = MAGMA_ERR_HOST_ALLOC;
+                    } else {
+                        *((void**) blk) = blocks[id];
+                        blocks[id] = blk;
+                        store = (magma_index_t*) ((void**) blk + 1);
+                        used = 0;
+                    }
+                }
+                if (tinfo != 0) {
+                    #pragma omp atomic write
+                    info = tinfo;
+                    #pragma omp atomic write
+                    ready[i] = -1;
+                    break;
+                }
+                
+                /* gather the pattern magma_int_to L and U */
+                
+                magma_index_t *jl = store + used;
+                magma_index_t *ju = jl + knzl;
+                magma_index_t *lev = ju + knzu;
+                used += knzl + 2*knzu;
+                knzl = 0;
+                knzu = 0;
+                next = first;
+                while (next < i)
+                {
+                    jl[knzl++] = next;
+                    next = lnklst[next];
+                }
+                if (next != i)
                 {
-                    magma_int_t newlev;
-                    oldlst = nxtlst;
-                    nxtlst = lnklst[oldlst];
-                    newlev = curlev[row] + levels[ii] + 1;
-                    curlev[jau[ii]] = min( curlev[jau[ii]], newlev );
-                    ii++;
+                    printf("ILU structurally singular.\n");
                 }
-                else /* (jau[ii] > nxtlst) */
+                while (next < n)
                 {
-                    oldlst = nxtlst;
-                    nxtlst = lnklst[oldlst];
+                    lev[knzu] = curlev[next];
+                    ju[knzu++] = next;
+                    next = lnklst[next];
                 }
+                rowdata[i] = jl;
+                ial[i+1] = knzl;
+                iau[i+1] = knzu;
+                #pragma omp flush
+                #pragma omp atomic write
+                ready[i] = 1;
+            }
+            if (tinfo != 0 || blocked) {
+                break;
             }
-            next = lnklst[next];
         }
         
-        /* gather the pattern magma_int_to L and U */
-       // printf("check line5 %d\n", i);
-        next = first;
-        while (next < i)
-        {
-            if (knzl >= *nzl) {
-                printf("ILU: STORAGE parameter value %d<%d too small.\n", int(*nzl), int(knzl));
-                printf("Increase STORAGE parameter.\n");
-                info = -1;
-                goto cleanup;
+        // unblock the threads waiting for rows that will not be finished
+        if (tinfo != 0 || blocked) {
+            for (magma_int_t i=0; i<n; i++) {
+                magma_index_t done;
+                #pragma omp atomic read
+                done = ready[i];
+                if (done == 0) {
+                    #pragma omp atomic write
+                    ready[i] = -1;
+                }
             }
-            jal[knzl++] = next;
-            next = lnklst[next];
         }
-        ial[i+1] = knzl;
-        //  printf("check line6 %d\n", i);
-        if (next != i)
-        {
-            printf("ILU structurally singular.\n");
-            /*
-                assert(knzu < *nzu);
-                levels[knzu] = 2*n;
-                jau[knzu++] = i;
-            */
+    }
+    if (info != 0) {
+        goto cleanup;
+    }
+    
+    ial[0] = 0;
+    iau[0] = 0;
+    CHECK( magma_dmatrix_createrowptr( n, ial, NULL ));
+    CHECK( magma_dmatrix_createrowptr( n, iau, NULL ));
+    if (ial[n] > *nzl) {
+        printf("ILU: STORAGE parameter value %d<%d too small.\n", int(*nzl), int(ial[n]));
+        printf("Increase STORAGE parameter.\n");
+        info = -1;
+        goto cleanup;
+    }
+    if (iau[n] > *nzu) {
+        printf("ILU: STORAGE parameter value %d < %d too small.\n", int(*nzu), int(iau[n]));
+        printf("Increase STORAGE parameter.\n");
+        info = -1;
+        goto cleanup;
+    }
+    
+    #pragma omp parallel for schedule(static)
+    for (magma_int_t i=0; i<n; i++) {
+        const magma_index_t *jl = rowdata[i];
+        const magma_index_t *ju = jl + (ial[i+1] - ial[i]);
+        for (magma_int_t j=ial[i]; j<ial[i+1]; j++) {
+            jal[j] = *jl++;
         }
-        //  printf("check line7 %d\n", i);
-        //                 printf("next:%d  n:%d \n", next, n);
-        while (next < n)
-        {
-            if (knzu >= *nzu) {
-                printf("ILU: STORAGE parameter value %d < %d too small.\n", int(*nzu), int(knzu));
-                printf("Increase STORAGE parameter.\n");
-                info = -1;
-                goto cleanup;
-            }
-            // printf("1 knzu:%d  next:%d \n", knzu, next );
-            levels[knzu] = curlev[next];
-            //  printf("2 knzu:%d  next:%d \n", knzu, next );
-            jau[knzu++] = next;
-            //  printf("3 knzu:%d  next:%d \n", knzu, next );
-            next = lnklst[next];
-            //  printf("4 next:%d  n:%d \n", next, n);
+        for (magma_int_t j=iau[i]; j<iau[i+1]; j++) {
+            jau[j] = *ju++;
         }
-        iau[i+1] = knzu;
     }
-
-    *nzl = knzl;
-    *nzu = knzu;
-
-    // printf("ende\n");
+    
+    *nzl = ial[n];
+    *nzu = iau[n];
 
 #if 0
     printf( "Actual nnz for ILU: %d\n", *nzl + *nzu );
 #endif
 
 cleanup:
-    magma_free_cpu(lnklst);
-    magma_free_cpu(curlev);
-    magma_free_cpu(levels);
-    magma_free_cpu(iwork);
+    if (blocks != NULL) {
+        for (magma_int_t t=0; t<num_threads; t++) {
+            while (blocks[t] != NULL) {
+                void *prev = *((void**) blocks[t]);
+                magma_free_cpu( blocks[t] );
+                blocks[t] = prev;
+            }
+        }
+    }
+    magma_free_cpu(blocks);
+    magma_free_cpu(rowdata);
+    magma_free_cpu(ready);
+    magma_free_cpu(work);
     
     return info;
 }
@@ -342,20 +493,23 @@ magma_dsymbilu(
         CHECK( magma_index_malloc_cpu( &L->col, num_lnnz ));
         CHECK( magma_index_malloc_cpu( &U->col, num_unnz ));
 
-        magma_dsymbolic_ilu( levels, A->num_rows, &num_lnnz, &num_unnz, B.row, B.col,
-                                            L->row, L->col, U->row, U->col );
+        CHECK( magma_dsymbolic_ilu( levels, A->num_rows, &num_lnnz, &num_unnz, B.row, B.col,
+                                            L->row, L->col, U->row, U->col ));
         L->nnz = num_lnnz;
         U->nnz = num_unnz;
         magma_free_cpu( L->val );
         magma_free_cpu( U->val );
         CHECK( magma_dmalloc_cpu( &L->val, L->nnz ));
         CHECK( magma_dmalloc_cpu( &U->val, U->nnz ));
+        #pragma omp parallel for schedule(static)
         for( magma_int_t i=0; i<L->nnz; i++ )
             L->val[i] = MAGMA_D_MAKE( 0.0, 0.0 );
 
+        #pragma omp parallel for schedule(static)
         for( magma_int_t i=0; i<U->nnz; i++ )
             U->val[i] = MAGMA_D_MAKE( 0.0, 0.0 );
         // take the original values (scaled) as initial guess for L
+        #pragma omp parallel for schedule(dynamic,64)
         for(magma_int_t i=0; i<L->num_rows; i++){
             for(magma_int_t j=B.row[i]; j<B.row[i+1]; j++){
                 magma_index_t lcol = B.col[j];
@@ -368,6 +522,7 @@ magma_dsymbilu(
         }
 
         // take the original values (scaled) as initial guess for U
+        #pragma omp parallel for schedule(dynamic,64)
         for(magma_int_t i=0; i<U->num_rows; i++){
             for(magma_int_t j=B.row[i]; j<B.row[i+1]; j++){
                 magma_index_t lcol = B.col[j];
@@ -386,9 +541,13 @@ magma_dsymbilu(
         CHECK( magma_dmalloc_cpu( &A->val, L->nnz+U->nnz ));
         A->nnz = L->nnz+U->nnz;
         
-        magma_int_t z = 0;
+        #pragma omp parallel for schedule(static)
+        for(magma_int_t i=0; i<=A->num_rows; i++){
+            A->row[i] = L->row[i] + U->row[i];
+        }
+        #pragma omp parallel for schedule(dynamic,64)
         for(magma_int_t i=0; i<A->num_rows; i++){
-            A->row[i] = z;
+            magma_int_t z = A->row[i];
             for(magma_int_t j=L->row[i]; j<L->row[i+1]; j++){
                 A->col[z] = L->col[j];
                 A->val[z] = L->val[j];
@@ -400,8 +559,8 @@ magma_dsymbilu(
                 z++;
             }
         }
-        A->row[A->num_rows] = z;
         // reset the values of A to the original entries
+        #pragma omp parallel for schedule(dynamic,64)
         for(magma_int_t i=0; i<A->num_rows; i++){
             for(magma_int_t j=A_copy.row[i]; j<A_copy.row[i+1]; j++){
                 magma_index_t lcol = A_copy.col[j];
@@ -5,7 +5,7 @@
        Univ. of Colorado, Denver
        @date April 2022
 
-       @generated from sparse/control/magma_zsolverinfo.cpp, normal z -> d, Wed Apr 20 17:38:06 2022
+       @generated from sparse/control/magma_zsolverinfo.cpp, normal z -> d, Sun Oct 18 19:59:12 2026
        @author Hartwig Anzt
 
 */
@@ -180,6 +180,14 @@ magma_dsolverinfo(
                 printf("%%  PARDISO performance analysis every %lld iterations\n",
                         (long long) k );
                 break;
+            case Magma_PIPECG:
+                printf("%%  CG (pipelined) performance analysis every %lld iterations\n",
+                        (long long) k );
+                break;
+            case Magma_SSTEPCG:
+                printf("%%  CG (s-step, s = %lld) performance analysis every %lld iterations\n",
+                        (long long) solver_par->restart, (long long) k );
+                break;
             default:
                 printf("%%  Detailed performance analysis not supported.\n");
                 break;
@@ -241,6 +249,14 @@ magma_dsolverinfo(
             case Magma_ISAI:
                 printf("%%   Preconditioner used: ParILU-SPAI.\n" );
                 break;
+            case Magma_MCILU:
+                printf("%%   Preconditioner used: multicolor ILU(0), %lld colors.\n",
+                        (long long) precond_par->ncolors );
+                break;
+            case Magma_MCSGS:
+                printf("%%   Preconditioner used: multicolor SGS, %lld colors.\n",
+                        (long long) precond_par->ncolors );
+                break;
             default:
                 break;
         }
@@ -284,6 +300,8 @@ magma_dsolverinfo(
             case Magma_JACOBI:
             case Magma_BAITER:
             case Magma_BAITERO:
+            case Magma_PIPECG:
+            case Magma_SSTEPCG:
                 printf("%%   iter   ||   residual-nrm2    ||   runtime    ||   SpMV-count*  ||   info\n");
                 printf("%%=================================================================================%%\n");
                 for( int j=0; j<(solver_par->numiter)/k+1; j++ ) {
@@ -410,6 +428,12 @@ magma_dsolverinfo(
         case Magma_PARDISO:
             printf("%% PARDISO solver summary:\n");
             break;
+        case Magma_PIPECG:
+            printf("%% pipelined CG solver summary:\n");
+            break;
+        case Magma_SSTEPCG:
+            printf("%% s-step CG solver summary:\n");
+            break;
         default:
             printf("%%   Solver info not supported.\n");
             goto cleanup;
@@ -605,6 +629,9 @@ magma_dsolverinfo_init(
     precond_par->U_dgraphindegree = NULL;
     precond_par->L_dgraphindegree_bak = NULL;
     precond_par->U_dgraphindegree_bak = NULL;
+    precond_par->perm = NULL;
+    precond_par->colorptr = NULL;
+    precond_par->ncolors = 0;
 
 cleanup:
     if( info != 0 ){
@@ -5,7 +5,7 @@
        Univ. of Colorado, Denver
        @date April 2022
 
-       @generated from sparse/control/magma_zutil_sparse.cpp, normal z -> d, Wed Apr 20 17:38:06 2022
+       @generated from sparse/control/magma_zutil_sparse.cpp, normal z -> d, Sun Oct 18 22:08:58 2026
 
        @author Hartwig Anzt
 
@@ -26,17 +26,21 @@ static const char *usage_sparse =
 " --solver      Possibility to choose a solver:\n"
 "               CG, PCG, BICGSTAB, PBICGSTAB, GMRES, PGMRES, LOBPCG, JACOBI,\n"
 "               BAITER, IDR, PIDR, CGS, PCGS, TFQMR, PTFQMR, QMR, PQMR, BICG,\n"
-"               PBICG, BOMBARDMENT, ITERREF.\n"
+"               PBICG, BOMBARDMENT, ITERREF,\n"
+"               PIPECG, SSTEPCG (CPU only).\n"
 " --basic       Use non-optimized version\n"
 " --ev x        For eigensolvers, set number of eigenvalues/eigenvectors to compute.\n"
 " --restart     For GMRES: possibility to choose the restart.\n"
 "               For IDR: Number of distinct subspaces (1,2,4,8).\n"
+"               For SSTEPCG: step size s (at most 8).\n"
 " --atol x      Set an absolute residual stopping criterion.\n"
 " --verbose x   Possibility to print intermediate residuals every x iteration.\n"
 " --maxiter x   Set an upper limit for the iteration count.\n"
 " --rtol x      Set a relative residual stopping criterion.\n"
 " --format      Possibility to choose a format for the sparse matrix:\n"
 "               CSR, ELL, SELLP, CUSPARSECSR, CSR5.\n"
+" --location    Possibility to choose where the solver is executed:\n"
+"               DEV (default), CPU (OpenMP host solvers: CG, BICGSTAB, GMRES, IDR).\n"
 " --blocksize x Set a specific blocksize for SELL-P format.\n"
 " --alignment x Set a specific alignment for SELL-P format.\n"
 " --mscale      Possibility to scale the original matrix:\n"
@@ -45,7 +49,9 @@ static const char *usage_sparse =
 " --precond x   Possibility to choose a preconditioner:\n"
 "               CG, BICGSTAB, GMRES, LOBPCG, JACOBI,\n"
 "               BAITER, IDR, CGS, TFQMR, QMR, BICG\n"
-"               BOMBARDMENT, ITERREF, ILU, PARILU, PARILUT, NONE.\n"
+"               BOMBARDMENT, ITERREF, ILU, PARILU, PARILUT, NONE,\n"
+"               MCILU, MCSGS (multicolor ILU(0) and SGS, CPU only),\n"
+"               PARILUB (block ParILU on supernodes of size --ppattern).\n"
 "                   --patol atol  Absolute residual stopping criterion for preconditioner.\n"
 "                   --prtol rtol  Relative residual stopping criterion for preconditioner.\n"
 "                   --piters k    Iteration count for iterative preconditioner.\n"
@@ -53,6 +59,12 @@ static const char *usage_sparse =
 "                   --triolver k  Solver for triangular ILU factors: e.g. CUSOLVE, JACOBI, ISAI.\n"
 "                   --ppattern k  Pattern used for ISAI preconditioner.\n"
 "                   --psweeps x   Number of iterative ParILU sweeps.\n"
+"                   --padaptive tol  Row-adaptive ParILU sweeps (CPU): rows are skipped once\n"
+"                                 their relative change is below tol. Default 0: off.\n"
+"                   --pwarmtol tol   ParILUT warm start: accepted relative change of the factors\n"
+"                                 in the last sweep; larger ones must still decrease. Default 1e-2.\n"
+"                   --preport k   ParILUT report: 0 counters only, 1 timings, 2 print tables.\n"
+"                   --pjson file  Write the ParILUT report as JSON to file.\n"
 " --trisolver   Possibility to choose a triangular solver for ILU preconditioning: \n"
 "               e.g. CUSOLVE, ISPTRSV, JACOBI, VBJACOBI, ISAI.\n"
 " --ppattern k  Possibility to choose a pattern for the trisolver: ISAI(k) or Block Jacobi.\n"
@@ -113,6 +125,7 @@ magma_dparse_opts(
     opts->output_format = Magma_CSR;
     opts->input_location = Magma_CPU;
     opts->output_location = Magma_CPU;
+    opts->compute_location = Magma_DEV;
     opts->scaling = Magma_NOSCALE;
     #if defined(PRECISION_z) | defined(PRECISION_d)
         opts->solver_par.atol = 1e-16;
@@ -141,6 +154,10 @@ magma_dparse_opts(
     opts->precond_par.sweeps = 5;
     opts->precond_par.maxiter = 1;
     opts->precond_par.pattern = 1;
+    opts->precond_par.adaptive_tol = 0.0;
+    opts->precond_par.warmstart_tol = 1e-2;
+    opts->precond_par.report.level = 0;
+    opts->precond_par.report.json = NULL;
     opts->solver_par.solver = Magma_CGMERGE;
     
     printf( usage_sparse_short, argv[0] );
@@ -166,6 +183,15 @@ magma_dparse_opts(
             } else {
                 printf( "%%error: invalid format, use default (CSR).\n" );
             }
+        } else if ( strcmp("--location", argv[i]) == 0 && i+1 < argc ) {
+            i++;
+            if ( strcmp("DEV", argv[i]) == 0 ) {
+                opts->compute_location = Magma_DEV;
+            } else if ( strcmp("CPU", argv[i]) == 0 ) {
+                opts->compute_location = Magma_CPU;
+            } else {
+                printf( "%%error: invalid location, use default (DEV).\n" );
+            }
         } else if ( strcmp("--mscale", argv[i]) == 0 && i+1 < argc ) {
             i++;
             if ( strcmp("NOSCALE", argv[i]) == 0 ) {
@@ -263,6 +289,12 @@ magma_dparse_opts(
             else if ( strcmp("PARDISO", argv[i]) == 0 ) {
                 opts->solver_par.solver = Magma_PARDISO;
             }
+            else if ( strcmp("PIPECG", argv[i]) == 0 ) {
+                opts->solver_par.solver = Magma_PIPECG;
+            }
+            else if ( strcmp("SSTEPCG", argv[i]) == 0 ) {
+                opts->solver_par.solver = Magma_SSTEPCG;
+            }
             else {
                 printf( "%%error: invalid solver.\n" );
             }
@@ -336,6 +368,9 @@ magma_dparse_opts(
             else if ( strcmp("PARIC", argv[i]) == 0 ) {
                 opts->precond_par.solver = Magma_PARILU;
             }
+            else if ( strcmp("PARILUB", argv[i]) == 0 ) {
+                opts->precond_par.solver = Magma_PARILUB;
+            }
             else if ( strcmp("PARICT", argv[i]) == 0 ) {
                 opts->precond_par.solver = Magma_PARICT;
             }
@@ -351,6 +386,12 @@ magma_dparse_opts(
             else if ( strcmp("ISAI", argv[i]) == 0 ) {
                 opts->precond_par.solver = Magma_ISAI;
             }
+            else if ( strcmp("MCILU", argv[i]) == 0 || strcmp("MCIC", argv[i]) == 0 ) {
+                opts->precond_par.solver = Magma_MCILU;
+            }
+            else if ( strcmp("MCSGS", argv[i]) == 0 ) {
+                opts->precond_par.solver = Magma_MCSGS;
+            }
             else if ( strcmp("NONE", argv[i]) == 0 ) {
                 opts->precond_par.solver = Magma_NONE;
             }
@@ -421,8 +462,19 @@ magma_dparse_opts(
             opts->precond_par.pattern = atoi( argv[++i] );
         } else if ( strcmp("--psweeps", argv[i]) == 0 && i+1 < argc ) {
             opts->precond_par.sweeps = atoi( argv[++i] );
+        } else if ( strcmp("--padaptive", argv[i]) == 0 && i+1 < argc ) {
+            sscanf( argv[++i], "%lf", &opts->precond_par.adaptive_tol );
+        } else if ( strcmp("--pwarmtol", argv[i]) == 0 && i+1 < argc ) {
+            sscanf( argv[++i], "%lf", &opts->precond_par.warmstart_tol );
         } else if ( strcmp("--plevels", argv[i]) == 0 && i+1 < argc ) {
             opts->precond_par.levels = atoi( argv[++i] );
+        } else if ( strcmp("--preport", argv[i]) == 0 && i+1 < argc ) {
+            opts->precond_par.report.level = atoi( argv[++i] );
+        } else if ( strcmp("--pjson", argv[i]) == 0 && i+1 < argc ) {
+            opts->precond_par.report.json = argv[++i];
+            opts->precond_par.report.level = 
+                ( opts->precond_par.report.level > 0 ) ? 
+                opts->precond_par.report.level : 1;
         } else if ( strcmp("--blocksize", argv[i]) == 0 && i+1 < argc ) {
             opts->blocksize = atoi( argv[++i] );
         } else if ( strcmp("--alignment", argv[i]) == 0 && i+1 < argc ) {
@@ -499,10 +551,12 @@ magma_dparse_opts(
     }
     
     // ensure to take a symmetric preconditioner for the PCG
-    if ( ( opts->solver_par.solver == Magma_PCG || opts->solver_par.solver == Magma_PCGMERGE )
+    if ( ( opts->solver_par.solver == Magma_PCG || opts->solver_par.solver == Magma_PCGMERGE
+        || opts->solver_par.solver == Magma_PIPECG )
         && opts->precond_par.solver == Magma_ILU )
             opts->precond_par.solver = Magma_ICC;
-    if ( ( opts->solver_par.solver == Magma_PCG || opts->solver_par.solver == Magma_PCGMERGE )
+    if ( ( opts->solver_par.solver == Magma_PCG || opts->solver_par.solver == Magma_PCGMERGE
+        || opts->solver_par.solver == Magma_PIPECG )
         && opts->precond_par.solver == Magma_PARILU )
             opts->precond_par.solver = Magma_PARIC;
             
@@ -5,7 +5,7 @@
        Univ. of Colorado, Denver
        @date April 2022
 
-       @generated from sparse/control/magma_zvinit.cpp, normal z -> d, Wed Apr 20 17:38:07 2022
+       @generated from sparse/control/magma_zvinit.cpp, normal z -> d, Sun Oct 18 19:36:21 2026
        @author Hartwig Anzt
 */
 #include "magmasparse_internal.h"
@@ -93,6 +93,8 @@ magma_dvinit(
     x->ld = num_rows;
     if ( mem_loc == Magma_CPU ) {
         CHECK( magma_dmalloc_cpu( &x->val, x->nnz ));
+        // static schedule: first touch matches the host solver kernels
+        #pragma omp parallel for schedule(static)
         for( magma_int_t i=0; i<x->nnz; i++) {
              x->val[i] = values;
         }
@@ -5,11 +5,13 @@
        Univ. of Colorado, Denver
        @date April 2022
 
-       @generated from sparse/control/magma_zmatrix_tools.cpp, normal z -> s, Wed Apr 20 17:38:07 2022
+       @generated from sparse/control/magma_zmatrix_tools.cpp, normal z -> s, Sun Oct 18 22:11:09 2026
        @author Hartwig Anzt
 
 */
 
+#include <climits>
+
 #include "magmasparse_internal.h"
 #ifdef _OPENMP
 #include <omp.h>
@@ -21,6 +23,163 @@
 #define AVOID_DUPLICATES
 //#define NANCHECK
 
+// entries of the merged rows of A and B kept by magma_smatrix_setop
+#define SETOP_A     1   // entries only in A
+#define SETOP_B     2   // entries only in B
+#define SETOP_AB    4   // entries in both A and B
+
+// column window of magma_smatrix_setop, entries outside are ignored
+#define SETOP_ALL   0   // all entries
+#define SETOP_VALID 1   // col >= 0, entries marked with col = -1 are skipped
+#define SETOP_TRIL  2   // col <= row
+#define SETOP_TRIU  3   // col >= row
+
+
+/*
+    Value combining functors for the entries in both A and B.
+*/
+struct magma_ssetop_first {
+    float operator()( float a, float b ) const
+    { return a; }
+};
+
+struct magma_ssetop_one {
+    float operator()( float a, float b ) const
+    { return MAGMA_S_ONE; }
+};
+
+
+/*
+    Merge kernel for one row: walks the sorted column indices of the rows
+    of A and B and counts the kept entries. With fill, the entries are also
+    written to U starting at U->row[row].
+*/
+template <bool fill, typename Combine>
+static inline magma_int_t
+magma_smatrix_setop_row(
+    const magma_s_matrix &A,
+    const magma_s_matrix &B,
+    magma_int_t row,
+    magma_int_t keep,
+    magma_int_t window,
+    Combine combine,
+    magma_s_matrix *U)
+{
+    magma_int_t a = A.row[row], enda = A.row[row+1];
+    magma_int_t b = B.row[row], endb = B.row[row+1];
+    magma_int_t add = 0, offset = fill ? U->row[row] : 0;
+    magma_index_t cmin = (window == SETOP_TRIU) ? row : 
+                         (window == SETOP_VALID) ? 0 : INT_MIN;
+    magma_index_t cmax = (window == SETOP_TRIL) ? row : INT_MAX;
+    
+    while (true) {
+        bool va = (a < enda && A.col[a] <= cmax);
+        bool vb = (b < endb && B.col[b] <= cmax);
+        // stop once no more entries can be kept
+        if ((!va && !vb) || (!va && !(keep & SETOP_B)) 
+                         || (!vb && !(keep & SETOP_A))) {
+            break;
+        }
+        magma_index_t acol = va ? A.col[a] : INT_MAX;
+        magma_index_t bcol = vb ? B.col[b] : INT_MAX;
+        if (va && acol < cmin) {
+            a++;
+        } else if (vb && bcol < cmin) {
+            b++;
+        } else if (acol == bcol) {
+            if (keep & SETOP_AB) {
+                if (fill) {
+                    U->col[offset+add] = acol;
+                    U->rowidx[offset+add] = row;
+                    U->val[offset+add] = combine(A.val[a], B.val[b]);
+                }
+                add++;
+            }
+            a++;
+            b++;
+        } else if (acol < bcol) {
+            if (keep & SETOP_A) {
+                if (fill) {
+                    U->col[offset+add] = acol;
+                    U->rowidx[offset+add] = row;
+                    U->val[offset+add] = A.val[a];
+                }
+                add++;
+            }
+            a++;
+        } else {
+            if (keep & SETOP_B) {
+                if (fill) {
+                    U->col[offset+add] = bcol;
+                    U->rowidx[offset+add] = row;
+                    U->val[offset+add] = B.val[b];
+                }
+                add++;
+            }
+            b++;
+        }
+    }
+    return add;
+}
+
+
+/*
+    Sparse pattern algebra on two CSR matrices with sorted rows: U holds
+    the entries selected by keep among the entries of A and B inside the
+    column window, with the values of A, of B, or combine(a,b) for the
+    entries in both. A count pass and a fill pass run the same row merge
+    kernel in parallel, the row pointer in between is an exclusive scan
+    over the counts. The arrays of U are drawn from ws, which may be NULL.
+*/
+template <typename Combine>
+static magma_int_t
+magma_smatrix_setop(
+    magma_s_matrix A,
+    magma_s_matrix B,
+    magma_s_matrix *U,
+    magma_int_t keep,
+    magma_int_t window,
+    Combine combine,
+    magma_s_workspace *ws,
+    magma_queue_t queue)
+{
+    magma_int_t info = 0;
+    assert(A.num_rows == B.num_rows);
+    U->num_rows = A.num_rows;
+    U->num_cols = A.num_cols;
+    U->storage_type = Magma_CSR;
+    U->memory_location = Magma_CPU;
+    
+    CHECK(magma_sworkspace_malloc(ws, (void**) &U->row, 
+        (U->num_rows+1)*sizeof(magma_index_t), queue));
+    #pragma omp parallel for schedule(static)
+    for (magma_int_t row=0; row<A.num_rows; row++) {
+        U->row[row+1] = magma_smatrix_setop_row<false>(A, B, row, keep, 
+            window, combine, U);
+    }
+    
+    // new row pointer
+    U->row[0] = 0;
+    CHECK(magma_smatrix_createrowptr(U->num_rows, U->row, queue));
+    U->nnz = U->row[U->num_rows];
+    
+    CHECK(magma_sworkspace_malloc(ws, (void**) &U->val, 
+        U->nnz*sizeof(float), queue));
+    CHECK(magma_sworkspace_malloc(ws, (void**) &U->rowidx, 
+        U->nnz*sizeof(magma_index_t), queue));
+    CHECK(magma_sworkspace_malloc(ws, (void**) &U->col, 
+        U->nnz*sizeof(magma_index_t), queue));
+    
+    #pragma omp parallel for schedule(static)
+    for (magma_int_t row=0; row<A.num_rows; row++) {
+        magma_smatrix_setop_row<true>(A, B, row, keep, window, combine, U);
+    }
+    
+cleanup:
+    return info;
+}
+
+
 /***************************************************************************//**
     Purpose
     -------
@@ -43,6 +202,10 @@
                 Not a real matrix, but the list of all matrix entries included 
                 in either A or B. No duplicates.
 
+    @param[in,out]
+    ws          magma_s_workspace*
+                Workspace the arrays of U are drawn from. May be NULL.
+
     @param[in]
     queue       magma_queue_t
                 Queue to execute in.
@@ -55,147 +218,11 @@ magma_smatrix_cup(
     magma_s_matrix A,
     magma_s_matrix B,
     magma_s_matrix *U,
+    magma_s_workspace *ws,
     magma_queue_t queue)
 {
-    magma_int_t info = 0;
-    assert(A.num_rows == B.num_rows);
-    U->num_rows = A.num_rows;
-    U->num_cols = A.num_cols;
-    U->storage_type = Magma_CSR;
-    U->memory_location = Magma_CPU;
-    
-    CHECK(magma_index_malloc_cpu(&U->row, U->num_rows+1));
-    #pragma omp parallel for
-    for (magma_int_t row=0; row<A.num_rows; row++) {
-        magma_int_t add = 0;
-        magma_int_t a = A.row[row];
-        magma_int_t b = B.row[row];
-        magma_int_t enda = A.row[ row+1 ];
-        magma_int_t endb = B.row[ row+1 ]; 
-        magma_int_t acol;
-        magma_int_t bcol;
-        if(a<enda && b<endb) {
-            do{
-                acol = A.col[ a ];
-                bcol = B.col[ b ];
-                
-                if(acol == -1) { // stop in case acol = -1
-                    a++;
-                } 
-                else if(bcol == -1) { // stop in case bcol = -1
-                    b++;
-                }
-                else if(acol == bcol) {
-                    add++;
-                    a++;
-                    b++;
-                }
-                else if(acol<bcol) {
-                    add++;
-                    a++;
-                }
-                else {
-                    add++;
-                    b++;
-                }
-            }while(a<enda && b<endb);
-        }
-        // now th rest - if existing
-        if(a<enda) {
-            do{
-                add++;
-                a++;
-            }while(a<enda);            
-        }
-        if(b<endb) {
-            do{
-                add++;
-                b++;
-            }while(b<endb);            
-        }
-        U->row[ row+1 ] = add; 
-    }
-    
-    // get the total element count
-    U->row[ 0 ] = 0;
-    CHECK(magma_smatrix_createrowptr(U->num_rows, U->row, queue));
-    U->nnz = U->row[ U->num_rows ];
-        
-    CHECK(magma_smalloc_cpu(&U->val, U->nnz));
-    CHECK(magma_index_malloc_cpu(&U->rowidx, U->nnz));
-    CHECK(magma_index_malloc_cpu(&U->col, U->nnz));
-    #pragma omp parallel for
-    for (magma_int_t i=0; i<U->nnz; i++) {
-        U->val[i] = MAGMA_S_ONE;
-    }
-    #pragma omp parallel for
-    for (magma_int_t row=0; row<A.num_rows; row++) {
-        magma_int_t add = 0;
-        magma_int_t offset = U->row[row];
-        magma_int_t a = A.row[row];
-        magma_int_t b = B.row[row];
-        magma_int_t enda = A.row[ row+1 ];
-        magma_int_t endb = B.row[ row+1 ]; 
-        magma_int_t acol;
-        magma_int_t bcol;
-        if(a<enda && b<endb) {
-            do{
-                acol = A.col[ a ];
-                bcol = B.col[ b ];
-                if(acol == -1) { // stop in case acol = -1
-                    a++;
-                } 
-                else if(bcol == -1) { // stop in case bcol = -1
-                    b++;
-                }
-                else if(acol == bcol) {
-                    U->col[ offset + add ] = acol;
-                    U->rowidx[ offset + add ] = row;
-                    U->val[ offset + add ] = A.val[ a ];
-                    add++;
-                    a++;
-                    b++;
-                }
-                else if(acol<bcol) {
-                    U->col[ offset + add ] = acol;
-                    U->rowidx[ offset + add ] = row;
-                    U->val[ offset + add ] = A.val[ a ];
-                    add++;
-                    a++;
-                }
-                else {
-                    U->col[ offset + add ] = bcol;
-                    U->rowidx[ offset + add ] = row;
-                    U->val[ offset + add ] = B.val[ b ];
-                    add++;
-                    b++;
-                }
-            }while(a<enda && b<endb);
-        }
-        // now th rest - if existing
-        if(a<enda) {
-            do{
-                acol = A.col[ a ];
-                U->col[ offset + add ] = acol;
-                U->rowidx[ offset + add ] = row;
-                U->val[ offset + add ] = A.val[ a ];
-                add++;
-                a++;
-            }while(a<enda);            
-        }
-        if(b<endb) {
-            do{
-                bcol = B.col[ b ];
-                U->col[ offset + add ] = bcol;
-                U->rowidx[ offset + add ] = row;
-                U->val[ offset + add ] = B.val[ b ];
-                add++;
-                b++;
-            }while(b<endb);            
-        }
-    }
-cleanup:
-    return info;
+    return magma_smatrix_setop(A, B, U, SETOP_A | SETOP_B | SETOP_AB, 
+        SETOP_VALID, magma_ssetop_first(), ws, queue);
 }
 
 
@@ -235,86 +262,8 @@ magma_smatrix_cap(
     magma_s_matrix *U,
     magma_queue_t queue)
 {
-    magma_int_t info = 0;
-    //printf("\n"); fflush(stdout);
-    // parallel for using openmp
-    assert(A.num_rows == B.num_rows);
-    U->num_rows = A.num_rows;
-    U->num_cols = A.num_cols;
-    U->storage_type = Magma_CSR;
-    U->memory_location = Magma_CPU;
-    
-    CHECK(magma_index_malloc_cpu(&U->row, A.num_rows+1));
-    #pragma omp parallel for
-    for (magma_int_t row=0; row<A.num_rows; row++) {
-        magma_int_t add = 0;
-        magma_int_t a = A.row[row];
-        magma_int_t b = B.row[row];
-        magma_int_t enda = A.row[ row+1 ];
-        magma_int_t endb = B.row[ row+1 ]; 
-        magma_int_t acol;
-        magma_int_t bcol;
-        do{
-            acol = A.col[ a ];
-            bcol = B.col[ b ];
-            if(acol == bcol) {
-                add++;
-                a++;
-                b++;
-            }
-            else if(acol<bcol) {
-                a++;
-            }
-            else {
-                b++;
-            }
-        }while(a<enda && b<endb);
-        U->row[ row+1 ] = add; 
-    }
-     
-        // new row pointer
-    U->row[ 0 ] = 0;
-    CHECK(magma_smatrix_createrowptr(U->num_rows, U->row, queue));
-    U->nnz = U->row[ U->num_rows ];
-    
-    CHECK(magma_smalloc_cpu(&U->val, U->nnz));
-    CHECK(magma_index_malloc_cpu(&U->rowidx, U->nnz));
-    CHECK(magma_index_malloc_cpu(&U->col, U->nnz));
-    #pragma omp parallel for
-    for (magma_int_t i=0; i<U->nnz; i++) {
-        U->val[i] = MAGMA_S_ONE;
-    }
-    
-    #pragma omp parallel for
-    for (magma_int_t row=0; row<A.num_rows; row++) {
-        magma_int_t add = 0;
-        magma_int_t offset = U->row[row];
-        magma_int_t a = A.row[row];
-        magma_int_t b = B.row[row];
-        magma_int_t enda = A.row[ row+1 ];
-        magma_int_t endb = B.row[ row+1 ]; 
-        magma_int_t acol;
-        magma_int_t bcol;
-        do{
-            acol = A.col[ a ];
-            bcol = B.col[ b ];
-            if(acol == bcol) {
-                U->col[ offset + add ] = acol;
-                U->rowidx[ offset + add ] = row;
-                add++;
-                a++;
-                b++;
-            }
-            else if(acol<bcol) {
-                a++;
-            }
-            else {
-                b++;
-            }
-        }while(a<enda && b<endb);
-    }
-cleanup:
-    return info;
+    return magma_smatrix_setop(A, B, U, SETOP_AB, SETOP_ALL, 
+        magma_ssetop_one(), NULL, queue);
 }
 
 
@@ -355,102 +304,8 @@ magma_smatrix_negcap(
     magma_s_matrix *U,
     magma_queue_t queue)
 {
-    magma_int_t info = 0;
-    //printf("\n"); fflush(stdout);
-    // parallel for using openmp
-    assert(A.num_rows == B.num_rows);
-    U->num_rows = A.num_rows;
-    U->num_cols = A.num_cols;
-    U->storage_type = Magma_CSR;
-    U->memory_location = Magma_CPU;
-    
-    CHECK(magma_index_malloc_cpu(&U->row, A.num_rows+1));
-    #pragma omp parallel for
-    for (magma_int_t row=0; row<A.num_rows; row++) {
-        magma_int_t add = 0;
-        magma_int_t a = A.row[row];
-        magma_int_t b = B.row[row];
-        magma_int_t enda = A.row[ row+1 ];
-        magma_int_t endb = B.row[ row+1 ]; 
-        magma_int_t acol;
-        magma_int_t bcol;
-        do{
-            acol = A.col[ a ];
-            bcol = B.col[ b ];
-            if(acol == bcol) {
-                a++;
-                b++;
-            }
-            else if(acol<bcol) {
-                add++;
-                a++;
-            }
-            else {
-                b++;
-            }
-        }while(a<enda && b<endb);
-        // now th rest - if existing
-        if(a<enda) {
-            do{
-                add++;
-                a++;
-            }while(a<enda);            
-        }
-        U->row[ row+1 ] = add; 
-    }
-        
-    // new row pointer
-    U->row[ 0 ] = 0;
-    CHECK(magma_smatrix_createrowptr(U->num_rows, U->row, queue));
-    U->nnz = U->row[ U->num_rows ];
-    
-    CHECK(magma_smalloc_cpu(&U->val, U->nnz));
-    CHECK(magma_index_malloc_cpu(&U->rowidx, U->nnz));
-    CHECK(magma_index_malloc_cpu(&U->col, U->nnz));
-    
-    #pragma omp parallel for
-    for (magma_int_t row=0; row<A.num_rows; row++) {
-        magma_int_t add = 0;
-        magma_int_t offset = U->row[row];
-        magma_int_t a = A.row[row];
-        magma_int_t b = B.row[row];
-        magma_int_t enda = A.row[ row+1 ];
-        magma_int_t endb = B.row[ row+1 ]; 
-        magma_int_t acol;
-        magma_int_t bcol;
-        do{
-            acol = A.col[ a ];
-            bcol = B.col[ b ];
-            if(acol == bcol) {
-                a++;
-                b++;
-            }
-            else if(acol<bcol) {
-                U->col[ offset + add ] = acol;
-                U->rowidx[ offset + add ] = row;
-                U->val[ offset + add ] = A.val[a];
-                add++;
-                a++;
-            }
-            else {
-                b++;
-            }
-        }while(a<enda && b<endb);
-        // now th rest - if existing
-        if(a<enda) {
-            do{
-                acol = A.col[ a ];
-                U->col[ offset + add ] = acol;
-                U->rowidx[ offset + add ] = row;
-                U->val[ offset + add ] = A.val[a];
-                add++;
-                a++;
-            }while(a<enda);            
-        }
-    }
-
-cleanup:
-    return info;
+    return magma_smatrix_setop(A, B, U, SETOP_A, SETOP_ALL, 
+        magma_ssetop_first(), NULL, queue);
 }
 
 
@@ -491,124 +346,8 @@ magma_smatrix_tril_negcap(
     magma_s_matrix *U,
     magma_queue_t queue)
 {
-    magma_int_t info = 0;
-    //printf("\n"); fflush(stdout);
-    // parallel for using openmp
-    assert(A.num_rows == B.num_rows);
-    U->num_rows = A.num_rows;
-    U->num_cols = A.num_cols;
-    U->storage_type = Magma_CSR;
-    U->memory_location = Magma_CPU;
-    
-    CHECK(magma_index_malloc_cpu(&U->row, A.num_rows+1));
-    #pragma omp parallel for
-    for (magma_int_t row=0; row<A.num_rows; row++) {
-        magma_int_t add = 0;
-        magma_int_t a = A.row[row];
-        magma_int_t b = B.row[row];
-        magma_int_t enda = A.row[ row+1 ];
-        magma_int_t endb = B.row[ row+1 ]; 
-        magma_int_t acol;
-        magma_int_t bcol;
-        if(a<enda && b<endb) {
-            do{
-                acol = A.col[ a ];
-                bcol = B.col[ b ];
-                if(acol > row) {
-                    a = enda;
-                    break;    
-                }
-                if(acol == bcol) {
-                    a++;
-                    b++;
-                }
-                else if(acol<bcol) {
-                    add++;
-                    a++;
-                }
-                else {
-                    b++;
-                }
-            }while(a<enda && b<endb);
-        }
-        // now th rest - if existing
-        if(a<enda) {
-            do{
-                acol = A.col[ a ];
-                if(acol > row) {
-                    a = enda;
-                    break;    
-                } else {
-                    add++;
-                    a++;
-                }
-            }while(a<enda);            
-        }
-        U->row[ row+1 ] = add; 
-    }
-        
-    // new row pointer
-    U->row[ 0 ] = 0;
-    CHECK(magma_smatrix_createrowptr(U->num_rows, U->row, queue));
-    U->nnz = U->row[ U->num_rows ];
-    
-    CHECK(magma_smalloc_cpu(&U->val, U->nnz));
-    CHECK(magma_index_malloc_cpu(&U->rowidx, U->nnz));
-    CHECK(magma_index_malloc_cpu(&U->col, U->nnz));
-    
-    #pragma omp parallel for
-    for (magma_int_t row=0; row<A.num_rows; row++) {
-        magma_int_t add = 0;
-        magma_int_t offset = U->row[row];
-        magma_int_t a = A.row[row];
-        magma_int_t b = B.row[row];
-        magma_int_t enda = A.row[ row+1 ];
-        magma_int_t endb = B.row[ row+1 ]; 
-        magma_int_t acol;
-        magma_int_t bcol;
-        if(a<enda && b<endb) {
-            do{
-                acol = A.col[ a ];
-                bcol = B.col[ b ];
-                if(acol > row) {
-                    a = enda;
-                    break;    
-                }
-                if(acol == bcol) {
-                    a++;
-                    b++;
-                }
-                else if(acol<bcol) {
-                    U->col[ offset + add ] = acol;
-                    U->rowidx[ offset + add ] = row;
-                    U->val[ offset + add ] = A.val[a];
-                    add++;
-                    a++;
-                }
-                else {
-                    b++;
-                }
-            }while(a<enda && b<endb);
-        }
-        // now th rest - if existing
-        if(a<enda) {
-            do{
-                acol = A.col[ a ];
-                if(acol > row) {
-                    a = enda;
-                    break;    
-                } else {
-                    U->col[ offset + add ] = acol;
-                    U->rowidx[ offset + add ] = row;
-                    U->val[ offset + add ] = A.val[a];
-                    add++;
-                    a++;
-                }
-            }while(a<enda);            
-        }
-    }
-cleanup:
-    return info;
+    return magma_smatrix_setop(A, B, U, SETOP_A, SETOP_TRIL, 
+        magma_ssetop_first(), NULL, queue);
 }
 
 
@@ -647,121 +386,102 @@ magma_smatrix_triu_negcap(
     magma_s_matrix B,
     magma_s_matrix *U,
     magma_queue_t queue)
+{
+    return magma_smatrix_setop(A, B, U, SETOP_A, SETOP_TRIU, 
+        magma_ssetop_first(), NULL, queue);
+}
+
+
+/*
+    Returns 1 if the environment variable MAGMA_SPARSE_FIRST_TOUCH is set to
+    a nonzero value.
+*/
+static magma_int_t
+magma_sfirsttouch_enabled()
+{
+    const char *touch_str = getenv("MAGMA_SPARSE_FIRST_TOUCH");
+    return (touch_str != NULL && atoi(touch_str) != 0) ? 1 : 0;
+}
+
+
+/***************************************************************************//**
+    Purpose
+    -------
+    Places the pages of host arrays holding nnz entries of a sparse matrix
+    on the NUMA nodes of the threads that later work on them. Memory from
+    magma_malloc_cpu is mapped to a NUMA node when it is first written, so
+    arrays filled by a single thread, or row by row, end up on one socket,
+    or distributed differently from the sweeps. This function writes the
+    given arrays with the static partitioning over the nonzeros that the
+    ParILU and ParILUT sweeps use. It has to be called after allocating the
+    arrays and before filling them. Any of the arrays may be NULL.
+
+    The placement is only done if the environment variable
+    MAGMA_SPARSE_FIRST_TOUCH is set to a nonzero value, otherwise the
+    function returns immediately.
+
+    Arguments
+    ---------
+
+    @param[in]
+    nnz         magma_int_t
+                Length of the arrays.
+
+    @param[in,out]
+    val         float*
+                Value array, set to zero.
+
+    @param[in,out]
+    col         magma_index_t*
+                Index array, set to zero.
+
+    @param[in,out]
+    rowidx      magma_index_t*
+                Index array, set to zero.
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_saux
+*******************************************************************************/
+
+extern "C" magma_int_t
+magma_sfirsttouch_cpu(
+    magma_int_t nnz,
+    float *val,
+    magma_index_t *col,
+    magma_index_t *rowidx,
+    magma_queue_t queue)
 {
     magma_int_t info = 0;
-    assert(A.num_rows == B.num_rows);
-    U->num_rows = A.num_rows;
-    U->num_cols = A.num_cols;
-    U->storage_type = Magma_CSR;
-    U->memory_location = Magma_CPU;
-    
-    CHECK(magma_index_malloc_cpu(&U->row, A.num_rows+1));
-    #pragma omp parallel for
-    for (magma_int_t row=0; row<A.num_rows; row++) {
-        magma_int_t add = 0;
-        magma_int_t a = A.row[row];
-        magma_int_t b = B.row[row];
-        magma_int_t enda = A.row[ row+1 ];
-        magma_int_t endb = B.row[ row+1 ]; 
-        magma_int_t acol;
-        magma_int_t bcol;
-        if(a<enda && b<endb) {
-            do{
-                acol = A.col[ a ];
-                bcol = B.col[ b ];
-                if(acol == bcol) {
-                    a++;
-                    b++;
-                }
-                else if(acol<bcol) {
-                    if(acol >= row) {
-                        add++;
-                        a++;
-                    } else {
-                        a++;
-                    }
-                }
-                else {
-                    b++;
-                }
-            }while(a<enda && b<endb);
-        }
-        // now th rest - if existing
-        if(a<enda) {
-            do{
-                acol = A.col[ a ];
-                if(acol >= row) {
-                    add++;
-                    a++;
-                } else {
-                    a++;
-                }
-            }while(a<enda);            
+    // the initialization of a local static is thread-safe, this function
+    // is also called from within OpenMP regions
+    static const magma_int_t enabled = magma_sfirsttouch_enabled();
+
+    if (enabled == 0) {
+        return info;
+    }
+
+    if (val != NULL) {
+        #pragma omp parallel for schedule(static)
+        for (magma_int_t i=0; i<nnz; i++) {
+            val[i] = MAGMA_S_ZERO;
         }
-        U->row[ row+1 ] = add; 
     }
-        
-    // new row pointer
-    U->row[ 0 ] = 0;
-    CHECK(magma_smatrix_createrowptr(U->num_rows, U->row, queue));
-    U->nnz = U->row[ U->num_rows ];
-    
-    CHECK(magma_smalloc_cpu(&U->val, U->nnz));
-    CHECK(magma_index_malloc_cpu(&U->rowidx, U->nnz));
-    CHECK(magma_index_malloc_cpu(&U->col, U->nnz));
-    
-    #pragma omp parallel for
-    for (magma_int_t row=0; row<A.num_rows; row++) {
-        magma_int_t add = 0;
-        magma_int_t offset = U->row[row];
-        magma_int_t a = A.row[row];
-        magma_int_t b = B.row[row];
-        magma_int_t enda = A.row[ row+1 ];
-        magma_int_t endb = B.row[ row+1 ]; 
-        magma_int_t acol;
-        magma_int_t bcol;
-        if(a<enda && b<endb) {
-            do{
-                acol = A.col[ a ];
-                bcol = B.col[ b ];
-                if(acol == bcol) {
-                    a++;
-                    b++;
-                }
-                else if(acol<bcol) {
-                    if(acol >= row) {
-                        U->col[ offset + add ] = acol;
-                        U->rowidx[ offset + add ] = row;
-                        U->val[ offset + add ] = A.val[a];
-                        add++;
-                        a++;
-                    } else {
-                        a++;
-                    }
-                }
-                else {
-                    b++;
-                }
-            }while(a<enda && b<endb);
+    if (col != NULL) {
+        #pragma omp parallel for schedule(static)
+        for (magma_int_t i=0; i<nnz; i++) {
+            col[i] = 0;
         }
-        // now th rest - if existing
-        if(a<enda) {
-            do{
-                acol = A.col[ a ];
-                if(acol >= row) {
-                    U->col[ offset + add ] = acol;
-                    U->rowidx[ offset + add ] = row;
-                    U->val[ offset + add ] = A.val[a];
-                    add++;
-                    a++;
-                } else {
-                    a++;
-                }
-            }while(a<enda);            
+    }
+    if (rowidx != NULL) {
+        #pragma omp parallel for schedule(static)
+        for (magma_int_t i=0; i<nnz; i++) {
+            rowidx[i] = 0;
         }
     }
 
-cleanup:
     return info;
 }
 
@@ -793,6 +513,7 @@ magma_smatrix_addrowindex(
     magma_int_t info = 0;
     
     CHECK(magma_index_malloc_cpu(&A->rowidx, A->nnz));
+    CHECK(magma_sfirsttouch_cpu(A->nnz, NULL, NULL, A->rowidx, queue));
     
     #pragma omp parallel for
     for (magma_int_t row=0; row<A->num_rows; row++) {
@@ -824,6 +545,11 @@ cleanup:
     B           magma_s_matrix*
                 Transposed matrix.
 
+    @param[in,out]
+    ws          magma_s_workspace*
+                Workspace the arrays of B and the temporary arrays are drawn 
+                from. May be NULL.
+
     @param[in]
     queue       magma_queue_t
                 Queue to execute in.
@@ -835,12 +561,13 @@ extern "C" magma_int_t
 magma_scsrcoo_transpose(
     magma_s_matrix A,
     magma_s_matrix *B,
+    magma_s_workspace *ws,
     magma_queue_t queue)
 {
     magma_int_t info = 0;
-    magma_index_t *linked_list;
-    magma_index_t *row_ptr;
-    magma_index_t *last_rowel;
+    magma_index_t *linked_list = NULL;
+    magma_index_t *row_ptr = NULL;
+    magma_index_t *last_rowel = NULL;
     
     magma_int_t el_per_block, num_threads=1;
     
@@ -851,13 +578,20 @@ magma_scsrcoo_transpose(
     B->num_cols = A.num_cols;
     B->nnz      = A.nnz;
     
-    CHECK(magma_index_malloc_cpu(&linked_list, A.nnz));
-    CHECK(magma_index_malloc_cpu(&row_ptr, A.num_rows+1));
-    CHECK(magma_index_malloc_cpu(&last_rowel, A.num_rows+1));
-    CHECK(magma_index_malloc_cpu(&B->row, A.num_rows+1));
-    CHECK(magma_index_malloc_cpu(&B->rowidx, A.nnz));
-    CHECK(magma_index_malloc_cpu(&B->col, A.nnz));
-    CHECK(magma_smalloc_cpu(&B->val, A.nnz));
+    CHECK(magma_sworkspace_malloc(ws, (void**) &linked_list, 
+        A.nnz*sizeof(magma_index_t), queue));
+    CHECK(magma_sworkspace_malloc(ws, (void**) &row_ptr, 
+        (A.num_rows+1)*sizeof(magma_index_t), queue));
+    CHECK(magma_sworkspace_malloc(ws, (void**) &last_rowel, 
+        (A.num_rows+1)*sizeof(magma_index_t), queue));
+    CHECK(magma_sworkspace_malloc(ws, (void**) &B->row, 
+        (A.num_rows+1)*sizeof(magma_index_t), queue));
+    CHECK(magma_sworkspace_malloc(ws, (void**) &B->rowidx, 
+        A.nnz*sizeof(magma_index_t), queue));
+    CHECK(magma_sworkspace_malloc(ws, (void**) &B->col, 
+        A.nnz*sizeof(magma_index_t), queue));
+    CHECK(magma_sworkspace_malloc(ws, (void**) &B->val, 
+        A.nnz*sizeof(float), queue));
 #ifdef _OPENMP
     #pragma omp parallel
     {
@@ -925,9 +659,9 @@ magma_scsrcoo_transpose(
     }
     
 cleanup:
-    magma_free_cpu(row_ptr);
-    magma_free_cpu(last_rowel);
-    magma_free_cpu(linked_list);
+    magma_sworkspace_free(ws, row_ptr, queue);
+    magma_sworkspace_free(ws, last_rowel, queue);
+    magma_sworkspace_free(ws, linked_list, queue);
     return info;
 }
 
@@ -1107,59 +841,8 @@ magma_smatrix_tril(
     magma_s_matrix *L,
     magma_queue_t queue)
 {
-    magma_int_t info = 0;
-    
-    L->num_rows = A.num_rows;
-    L->num_cols = A.num_cols;
-    L->storage_type = Magma_CSR;
-    L->memory_location = Magma_CPU;
-    
-    CHECK(magma_index_malloc_cpu(&L->row, A.num_rows+1));
-    #pragma omp parallel for
-    for (magma_int_t row=0; row<A.num_rows; row++) {
-        magma_int_t nz = 0;
-        
-        for (magma_int_t i=A.row[row]; i<A.row[row+1]; i++) {
-            magma_index_t col = A.col[i];
-            if(col <= row) {
-                nz++;    
-            } else {
-                i=A.row[row+1];   
-            }
-        }
-        L->row[row+1] = nz;
-    }
-    
-    // new row pointer
-    L->row[ 0 ] = 0;
-    CHECK(magma_smatrix_createrowptr(L->num_rows, L->row, queue));
-    L->nnz = L->row[ L->num_rows ];
-    
-    // allocate memory
-    CHECK(magma_smalloc_cpu(&L->val, L->nnz));
-    CHECK(magma_index_malloc_cpu(&L->col, L->nnz));
-    
-    // copy
-    #pragma omp parallel for
-    for (magma_int_t row=0; row<A.num_rows; row++) {
-        magma_int_t nz = 0;
-        magma_int_t offset = L->row[row];
-        
-        for (magma_int_t i=A.row[row]; i<A.row[row+1]; i++) {
-            magma_index_t col = A.col[i];
-            if(col <= row) {
-                L->col[offset+nz] = col;
-                L->val[offset+nz] = A.val[i];
-                nz++;    
-            } else {
-                i=A.row[row+1];    
-            }
-        }
-    }
-    
-
-cleanup:
-    return info;
+    return magma_smatrix_split(A, L, Magma_VALUE, NULL, Magma_VALUE, NULL, 
+        queue);
 }
 
 
@@ -1192,59 +875,202 @@ magma_smatrix_triu(
     magma_s_matrix A,
     magma_s_matrix *U,
     magma_queue_t queue)
+{
+    return magma_smatrix_split(A, NULL, Magma_VALUE, U, Magma_VALUE, NULL, 
+        queue);
+}
+
+
+/***************************************************************************//**
+    Purpose
+    -------
+    Splits a matrix into its triangular parts and its diagonal in one pass:
+    L = tril(A), U = triu(A), D = diag(A). Any of the outputs may be NULL.
+    For L and U, the diagonal is either taken from A (Magma_VALUE), set to
+    one (Magma_UNITY), or left out (Magma_NODIAG). With Magma_UNITY, every
+    row gets exactly one unit diagonal entry, also if A has none, placed
+    last in L and first in U. D holds the diagonal entries present in A.
+    
+    All outputs are counted in one parallel read of A, their row pointers
+    come from one shared blocked scan over the row counts, and a second
+    parallel pass over A fills them. The entries keep the order of A.
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_s_matrix
+                Input matrix in CSR on the CPU.
+
+    @param[out]
+    L           magma_s_matrix*
+                Lower triangular part of A. May be NULL.
+
+    @param[in]
+    ldiag       magma_diagorder_t
+                Diagonal of L: Magma_VALUE, Magma_UNITY or Magma_NODIAG.
+
+    @param[out]
+    U           magma_s_matrix*
+                Upper triangular part of A. May be NULL.
+
+    @param[in]
+    udiag       magma_diagorder_t
+                Diagonal of U: Magma_VALUE, Magma_UNITY or Magma_NODIAG.
+
+    @param[out]
+    D           magma_s_matrix*
+                Diagonal part of A. May be NULL.
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_saux
+*******************************************************************************/
+
+extern "C" magma_int_t
+magma_smatrix_split(
+    magma_s_matrix A,
+    magma_s_matrix *L,
+    magma_diagorder_t ldiag,
+    magma_s_matrix *U,
+    magma_diagorder_t udiag,
+    magma_s_matrix *D,
+    magma_queue_t queue)
 {
     magma_int_t info = 0;
+    magma_index_t *offset = NULL;
+    magma_index_t *lrow = NULL, *urow = NULL, *drow = NULL;
+    magma_int_t num_threads = 1;
+    magma_s_matrix *out[3] = { L, U, D };
     
-    U->num_rows = A.num_rows;
-    U->num_cols = A.num_cols;
-    U->storage_type = Magma_CSR;
-    U->memory_location = Magma_CPU;
+#ifdef _OPENMP
+    num_threads = omp_get_max_threads();
+#endif
+    for (int p=0; p<3; p++) {
+        if (out[p] != NULL) {
+            out[p]->num_rows = A.num_rows;
+            out[p]->num_cols = A.num_cols;
+            out[p]->storage_type = Magma_CSR;
+            out[p]->memory_location = Magma_CPU;
+            CHECK(magma_index_malloc_cpu(&out[p]->row, A.num_rows+1));
+            out[p]->row[0] = 0;
+        }
+    }
+    lrow = (L != NULL) ? L->row : NULL;
+    urow = (U != NULL) ? U->row : NULL;
+    drow = (D != NULL) ? D->row : NULL;
+    CHECK(magma_index_malloc_cpu(&offset, 3*(num_threads+1)));
     
-    CHECK(magma_index_malloc_cpu(&U->row, A.num_rows+1));
-    #pragma omp parallel for
-    for (magma_int_t row=0; row<A.num_rows; row++) {
-        magma_int_t nz = 0;
+    // count pass: every thread counts its block of rows and accumulates the
+    // counts of L, U and D; the block totals are scanned and added on
+    #pragma omp parallel num_threads(num_threads)
+    {
+        magma_int_t id = 0, nt = 1;
+#ifdef _OPENMP
+        id = omp_get_thread_num();
+        nt = omp_get_num_threads();
+#endif
+        magma_int_t el_per_block = magma_ceildiv(A.num_rows, nt);
+        magma_int_t start = min(id*el_per_block, A.num_rows);
+        magma_int_t end = min((id+1)*el_per_block, A.num_rows);
+        magma_int_t sl = 0, su = 0, sd = 0;
         
-        for (magma_int_t i=A.row[row]; i<A.row[row+1]; i++) {
-            magma_index_t col = A.col[i];
-            if(col >= row) {
-                nz++;    
-            } else {
-                ;    
+        for (magma_int_t row=start; row<end; row++) {
+            magma_int_t nl = 0, nu = 0, nd = 0;
+            for (magma_int_t i=A.row[row]; i<A.row[row+1]; i++) {
+                magma_index_t col = A.col[i];
+                nl += (col < row) ? 1 : 0;
+                nd += (col == row) ? 1 : 0;
+                nu += (col > row) ? 1 : 0;
+            }
+            sl += nl + ((ldiag == Magma_VALUE) ? nd : 
+                        (ldiag == Magma_UNITY) ? 1 : 0);
+            su += nu + ((udiag == Magma_VALUE) ? nd : 
+                        (udiag == Magma_UNITY) ? 1 : 0);
+            sd += nd;
+            if (lrow != NULL) lrow[row+1] = sl;
+            if (urow != NULL) urow[row+1] = su;
+            if (drow != NULL) drow[row+1] = sd;
+        }
+        offset[3*(id+1)+0] = sl;
+        offset[3*(id+1)+1] = su;
+        offset[3*(id+1)+2] = sd;
+        #pragma omp barrier
+        #pragma omp single
+        {
+            offset[0] = offset[1] = offset[2] = 0;
+            for (magma_int_t t=1; t<=nt; t++) {
+                for (int p=0; p<3; p++) {
+                    offset[3*t+p] += offset[3*(t-1)+p];
+                }
             }
         }
-        U->row[row+1] = nz;
+        for (magma_int_t row=start; row<end; row++) {
+            if (lrow != NULL) lrow[row+1] += offset[3*id+0];
+            if (urow != NULL) urow[row+1] += offset[3*id+1];
+            if (drow != NULL) drow[row+1] += offset[3*id+2];
+        }
     }
     
-    // new row pointer
-    U->row[ 0 ] = 0;
-    CHECK(magma_smatrix_createrowptr(U->num_rows, U->row, queue));
-    U->nnz = U->row[ U->num_rows ];
-    
-    
     // allocate memory
-    CHECK(magma_smalloc_cpu(&U->val, U->nnz));
-    CHECK(magma_index_malloc_cpu(&U->col, U->nnz));
+    for (int p=0; p<3; p++) {
+        if (out[p] != NULL) {
+            out[p]->nnz = out[p]->row[A.num_rows];
+            CHECK(magma_smalloc_cpu(&out[p]->val, out[p]->nnz));
+            CHECK(magma_index_malloc_cpu(&out[p]->col, out[p]->nnz));
+            CHECK(magma_sfirsttouch_cpu(out[p]->nnz, out[p]->val, 
+                out[p]->col, NULL, queue));
+        }
+    }
     
-    // copy
-    #pragma omp parallel for
+    // fill pass; a unit diagonal is the last entry of the L row and the
+    // first entry of the U row
+    #pragma omp parallel for schedule(static)
     for (magma_int_t row=0; row<A.num_rows; row++) {
-        magma_int_t nz = 0;
-        magma_int_t offset = U->row[row];
-        
+        magma_int_t l = (L != NULL) ? L->row[row] : 0;
+        magma_int_t u = (U != NULL) ? U->row[row] : 0;
+        magma_int_t d = (D != NULL) ? D->row[row] : 0;
+        if (U != NULL && udiag == Magma_UNITY) {
+            U->col[u] = row;
+            U->val[u++] = MAGMA_S_ONE;
+        }
         for (magma_int_t i=A.row[row]; i<A.row[row+1]; i++) {
             magma_index_t col = A.col[i];
-            if(col >= row) {
-                U->col[offset+nz] = col;
-                U->val[offset+nz] = A.val[i];
-                nz++;    
+            if (col < row) {
+                if (L != NULL) {
+                    L->col[l] = col;
+                    L->val[l++] = A.val[i];
+                }
+            } else if (col > row) {
+                if (U != NULL) {
+                    U->col[u] = col;
+                    U->val[u++] = A.val[i];
+                }
             } else {
-                ;    
+                if (L != NULL && ldiag == Magma_VALUE) {
+                    L->col[l] = col;
+                    L->val[l++] = A.val[i];
+                }
+                if (U != NULL && udiag == Magma_VALUE) {
+                    U->col[u] = col;
+                    U->val[u++] = A.val[i];
+                }
+                if (D != NULL) {
+                    D->col[d] = col;
+                    D->val[d++] = A.val[i];
+                }
             }
         }
+        if (L != NULL && ldiag == Magma_UNITY) {
+            L->col[l] = row;
+            L->val[l] = MAGMA_S_ONE;
+        }
     }
     
 cleanup:
+    magma_free_cpu(offset);
     return info;
 }
 
@@ -1296,7 +1122,9 @@ magma_smatrix_abssum(
 /***************************************************************************//**
     Purpose
     -------
-    SOrts the elements in a CSR matrix for increasing column index.
+    Sorts the elements in a CSR matrix for increasing column index. The
+    values are permuted along with the column indices, see
+    magma_ssegsortval.
 
     Arguments
     ---------
@@ -1319,15 +1147,14 @@ magma_scsr_sort(
 {
     magma_int_t info = 0;
     
-    if (A->memory_location == Magma_CPU && A->storage_type == Magma_CSR){
-        #pragma omp parallel  
-        for (int row=0; row<A->num_rows; row++) {
-            magma_sindexsort(&A->col[A->row[row]], 0, 
-                A->row[row+1]-A->row[row]-1, queue);
-        }
+    if (A->memory_location == Magma_CPU && 
+        (A->storage_type == Magma_CSR || A->storage_type == Magma_CSRCOO)) {
+        // the row index of CSRCOO is not affected
+        CHECK(magma_ssegsortval(A->num_rows, A->row, A->col, A->val, queue));
     } else {
         info = MAGMA_ERR_NOT_SUPPORTED;
     }
     
+cleanup:
     return info;
 }
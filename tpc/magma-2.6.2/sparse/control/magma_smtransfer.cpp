@@ -5,7 +5,7 @@
        Univ. of Colorado, Denver
        @date April 2022
 
-       @generated from sparse/control/magma_zmtransfer.cpp, normal z -> s, Wed Apr 20 17:38:07 2022
+       @generated from sparse/control/magma_zmtransfer.cpp, normal z -> s, Sun Oct 18 20:54:09 2026
        @author Hartwig Anzt
 */
 #include "magmasparse_internal.h"
@@ -749,6 +749,7 @@ magma_smtransfer(
             CHECK( magma_smalloc_cpu( &B->val, A.nnz ));
             CHECK( magma_index_malloc_cpu( &B->row, A.num_rows + 1 ));
             CHECK( magma_index_malloc_cpu( &B->col, A.nnz ));
+            CHECK( magma_sfirsttouch_cpu( A.nnz, B->val, B->col, NULL, queue ));
             // data transfer
             magma_sgetvector( A.nnz, A.dval, 1, B->val, 1, queue );
             magma_index_getvector( A.num_rows + 1, A.drow, 1, B->row, 1, queue );
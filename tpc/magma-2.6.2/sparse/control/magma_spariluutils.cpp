@@ -5,13 +5,95 @@
        Univ. of Colorado, Denver
        @date April 2022
 
-       @generated from sparse/control/magma_zpariluutils.cpp, normal z -> s, Wed Apr 20 17:38:06 2022
+       @generated from sparse/control/magma_zpariluutils.cpp, normal z -> s, Sun Oct 18 22:17:07 2026
        @author Hartwig Anzt
 */
 #include "magmasparse_internal.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #define PRECISION_s
 
+
+/*
+    Subtracts A from the product LU on the common pattern and accumulates
+    the squared Frobenius norms of A - LU over the union of both patterns
+    (res) and over the pattern of A (nonlinres). Entries of A missing in LU
+    contribute |a|^2 to both. Every thread maps the columns of the current
+    row of LU to their positions in a hash table (see magma_colmap_size)
+    sized for the longest row of LU.
+*/
+static magma_int_t
+magma_slures_diff(
+    magma_s_matrix A,
+    magma_s_matrix *LU,
+    real_Double_t *res,
+    real_Double_t *nonlinres,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+    magma_int_t num_threads = 1, max_len = 0, tsize;
+    magma_index_t *key = NULL, *pos = NULL;
+    real_Double_t lres = 0.0, lnonlinres = 0.0;
+
+#ifdef _OPENMP
+    num_threads = omp_get_max_threads();
+#endif
+    #pragma omp parallel for reduction(max:max_len)
+    for( magma_int_t i=0; i<A.num_rows; i++ ){
+        magma_int_t len = LU->row[i+1] - LU->row[i];
+        max_len = ( len > max_len ) ? len : max_len;
+    }
+    tsize = magma_colmap_size( max_len );
+    CHECK( magma_index_malloc_cpu( &key, (size_t) num_threads * tsize ));
+    CHECK( magma_index_malloc_cpu( &pos, (size_t) num_threads * tsize ));
+
+    #pragma omp parallel num_threads(num_threads) reduction(+:lres,lnonlinres)
+    {
+        magma_int_t id = 0;
+#ifdef _OPENMP
+        id = omp_get_thread_num();
+#endif
+        magma_index_t *lkey = key + (size_t) id * tsize;
+        magma_index_t *lpos = pos + (size_t) id * tsize;
+        #pragma omp for schedule(dynamic,64)
+        for( magma_int_t i=0; i<A.num_rows; i++ ){
+            magma_int_t size = magma_colmap_size( LU->row[i+1] - LU->row[i] );
+            magma_colmap_clear( lkey, size );
+            for( magma_int_t k=LU->row[i]; k<LU->row[i+1]; k++ ){
+                magma_int_t slot = magma_colmap_slot( lkey, size, LU->col[k] );
+                lkey[ slot ] = LU->col[k];
+                lpos[ slot ] = k;
+            }
+            for( magma_int_t j=A.row[i]; j<A.row[i+1]; j++ ){
+                magma_int_t slot = magma_colmap_slot( lkey, size, A.col[j] );
+                if( lkey[ slot ] == A.col[j] ){
+                    magma_index_t k = lpos[ slot ];
+                    LU->val[k] = LU->val[k] - A.val[j];
+                    real_Double_t tmp = MAGMA_S_ABS( LU->val[k] );
+                    lnonlinres += tmp*tmp;
+                } else {
+                    real_Double_t tmp = MAGMA_S_ABS( A.val[j] );
+                    lnonlinres += tmp*tmp;
+                    lres += tmp*tmp;
+                }
+            }
+            for( magma_int_t k=LU->row[i]; k<LU->row[i+1]; k++ ){
+                real_Double_t tmp = MAGMA_S_ABS( LU->val[k] );
+                lres += tmp*tmp;
+            }
+        }
+    }
+    *res = lres;
+    *nonlinres = lnonlinres;
+
+cleanup:
+    magma_free_cpu( key );
+    magma_free_cpu( pos );
+    return info;
+}
+
 /**
     Purpose
     -------
@@ -99,7 +181,7 @@ magma_sfrobenius(
 
     @param[out]
     LU          magma_s_matrix*
-                output sparse matrix in A-LU in CSR
+                output sparse matrix LU-A on the pattern of A in CSR
 
     @param[out]
     res         real_Double_t*
@@ -122,63 +204,22 @@ magma_snonlinres(
     magma_queue_t queue )
 {
     magma_int_t info = 0;
-
     real_Double_t tmp2;
-    magma_int_t i,j,k;
-        
-    float one = MAGMA_S_MAKE( 1.0, 0.0 );
-
-    magma_s_matrix dL={Magma_CSR}, dU={Magma_CSR}, dLU={Magma_CSR}, A_t={Magma_CSR};
-    
-    // make sure the target structure is empty
-    magma_smfree( LU, queue );
-
-    CHECK( magma_smtransfer( L, &dL, Magma_CPU, Magma_DEV, queue  ));
-    CHECK( magma_smtransfer( U, &dU, Magma_CPU, Magma_DEV, queue  ));
-    CHECK( magma_smtransfer( A, &A_t, Magma_CPU, Magma_CPU, queue  ));
-    CHECK( magma_s_spmm( one, dL, dU, &dLU, queue ));
 
-    CHECK( magma_smtransfer(dLU, LU, Magma_DEV, Magma_CPU, queue ));
-    magma_smfree( &dL, queue  );
-    magma_smfree( &dU, queue  );
-    magma_smfree( &dLU, queue  );
-
-    // compute Frobenius norm of A-LU
-    for(i=0; i<A.num_rows; i++){
-        for(j=A.row[i]; j<A.row[i+1]; j++){
-            magma_index_t lcol = A.col[j];
-            float newval = MAGMA_S_MAKE(0.0, 0.0);
-            for(k=LU->row[i]; k<LU->row[i+1]; k++){
-                if( LU->col[k] == lcol ){
-                    newval = MAGMA_S_MAKE(
-                        MAGMA_S_REAL( LU->val[k] )- MAGMA_S_REAL( A.val[j] )
-                                                , 0.0 );
-                }
-            }
-            A_t.val[j] = newval;
-        }
-    }
+    float one = MAGMA_S_MAKE( 1.0, 0.0 );
 
-    for(i=0; i<A.num_rows; i++){
-        for(j=A.row[i]; j<A.row[i+1]; j++){
-            tmp2 = (real_Double_t) fabs( MAGMA_S_REAL(A_t.val[j]) );
-            (*res) = (*res) + tmp2* tmp2;
-        }
-    }
+    *res = 0.0;
 
-    magma_smfree( LU, queue  );
-    magma_smfree( &A_t, queue  );
+    // L * U is only needed on the pattern of A
+    CHECK( magma_sspgemm_masked_cpu( one, L, U, A, LU, queue ));
+    CHECK( magma_slures_diff( A, LU, &tmp2, res, queue ));
 
     (*res) =  sqrt((*res));
-    
+
 cleanup:
     if( info !=0 ){
         magma_smfree( LU, queue  );
     }
-    magma_smfree( &A_t, queue  );
-    magma_smfree( &dL, queue  );
-    magma_smfree( &dU, queue  );
-    magma_smfree( &dLU, queue  );
     return info;
 }
 
@@ -236,85 +277,22 @@ magma_silures(
 {
     magma_int_t info = 0;
 
-    float tmp;
-    real_Double_t tmp2;
-    magma_int_t i, j, k;
-    
     float one = MAGMA_S_MAKE( 1.0, 0.0 );
 
-    magma_s_matrix LL={Magma_CSR}, dL={Magma_CSR}, dU={Magma_CSR}, dLU={Magma_CSR};
-    
-    // make sure the target structure is empty
-    magma_smfree( LU, queue );
-
-    if( L.row[1]==1 ){        // lower triangular with unit diagonal
-        //printf("L lower triangular.\n");
-        LL.diagorder_type = Magma_UNITY;
-        CHECK( magma_smconvert( L, &LL, Magma_CSR, Magma_CSRL, queue ));
-    }
-    else if ( L.row[1]==0 ){ // strictly lower triangular
-        //printf("L strictly lower triangular.\n");
-        CHECK( magma_smtransfer( L, &LL, Magma_CPU, Magma_CPU, queue ));
-        magma_free_cpu( LL.col );
-        magma_free_cpu( LL.val );
-        LL.nnz = L.nnz+L.num_rows;
-        CHECK( magma_smalloc_cpu( &LL.val, LL.nnz ));
-        CHECK( magma_index_malloc_cpu( &LL.col, LL.nnz ));
-        magma_int_t z=0;
-        for (i=0; i < L.num_rows; i++) {
-            LL.row[i] = z;
-            for (j=L.row[i]; j < L.row[i+1]; j++) {
-                LL.val[z] = L.val[j];
-                LL.col[z] = L.col[j];
-                z++;
-            }
-            // add unit diagonal
-            LL.val[z] = MAGMA_S_MAKE(1.0, 0.0);
-            LL.col[z] = i;
-            z++;
-        }
-        LL.row[LL.num_rows] = z;
-    }
-    else {
-        printf("error: L neither lower nor strictly lower triangular!\n");
-    }
-
-    CHECK( magma_smtransfer( LL, &dL, Magma_CPU, Magma_DEV, queue  ));
-    CHECK( magma_smtransfer( U, &dU, Magma_CPU, Magma_DEV, queue  ));
-    magma_smfree( &LL, queue );
-    CHECK( magma_s_spmm( one, dL, dU, &dLU, queue ));
-
-
-
-    CHECK( magma_smtransfer(dLU, LU, Magma_DEV, Magma_CPU, queue ));
-    magma_smfree( &dL, queue );
-    magma_smfree( &dU, queue );
-    magma_smfree( &dLU, queue );
+    magma_s_matrix LL={Magma_CSR};
 
-    // compute Frobenius norm of A-LU
-    for(i=0; i<A.num_rows; i++){
-        for(j=A.row[i]; j<A.row[i+1]; j++){
-            magma_index_t lcol = A.col[j];
-            for(k=LU->row[i]; k<LU->row[i+1]; k++){
-                if( LU->col[k] == lcol ){
-                    tmp = MAGMA_S_MAKE(
-                        MAGMA_S_REAL( LU->val[k] )- MAGMA_S_REAL( A.val[j] )
-                                                , 0.0 );
-                    LU->val[k] = tmp;
-
-                    tmp2 = (real_Double_t) fabs( MAGMA_S_REAL(tmp) );
-                    (*nonlinres) = (*nonlinres) + tmp2*tmp2;
-                }
-            }
-        }
-    }
+    *res = 0.0;
+    *nonlinres = 0.0;
 
-    for(i=0; i<LU->num_rows; i++){
-        for(j=LU->row[i]; j<LU->row[i+1]; j++){
-            tmp2 = (real_Double_t) fabs( MAGMA_S_REAL(LU->val[j]) );
-            (*res) = (*res) + tmp2* tmp2;
-        }
+    if( L.row[1] > 1 ){
+        printf("error: L neither lower nor strictly lower triangular!\n");
     }
+    // lower triangular part of L with unit diagonal, whether L stores
+    // the diagonal or not
+    CHECK( magma_smatrix_split( L, &LL, Magma_UNITY, NULL, Magma_NODIAG,
+                                NULL, queue ));
+    CHECK( magma_sspgemm_cpu( one, LL, U, LU, queue ));
+    CHECK( magma_slures_diff( A, LU, res, nonlinres, queue ));
 
     (*res) =  sqrt((*res));
     (*nonlinres) =  sqrt((*nonlinres));
@@ -324,14 +302,13 @@ cleanup:
         magma_smfree( LU, queue  );
     }
     magma_smfree( &LL, queue );
-    magma_smfree( &dL, queue  );
-    magma_smfree( &dU, queue  );
-    magma_smfree( &dLU, queue  );
     return info;
 }
 
 
 
+
+
 /**
     Purpose
     -------
@@ -385,53 +362,14 @@ magma_sicres(
     magma_queue_t queue )
 {
     magma_int_t info = 0;
-    
-    float tmp;
-    real_Double_t tmp2;
-    magma_int_t i,j,k;
 
     float one = MAGMA_S_MAKE( 1.0, 0.0 );
-    
-    magma_s_matrix dL={Magma_CSR}, dU={Magma_CSR}, dLU={Magma_CSR};
-    
-    // make sure the target structure is empty
-    magma_smfree( LU, queue );
-    
+
     *res = 0.0;
     *nonlinres = 0.0;
 
-    CHECK( magma_smtransfer( C, &dL, Magma_CPU, Magma_DEV, queue ));
-    CHECK( magma_smtransfer( CT, &dU, Magma_CPU, Magma_DEV, queue ));
-    CHECK( magma_s_spmm( one, dL, dU, &dLU, queue ));
-    CHECK( magma_smtransfer(dLU, LU, Magma_DEV, Magma_CPU, queue ));
-
-    magma_smfree( &dLU, queue );
-
-    // compute Frobenius norm of A-LU
-    for(i=0; i<A.num_rows; i++){
-        for(j=A.row[i]; j<A.row[i+1]; j++){
-            magma_index_t lcol = A.col[j];
-            for(k=LU->row[i]; k<LU->row[i+1]; k++){
-                if( LU->col[k] == lcol ){
-                    tmp = MAGMA_S_MAKE(
-                        MAGMA_S_REAL( LU->val[k] )- MAGMA_S_REAL( A.val[j] )
-                                                , 0.0 );
-                    LU->val[k] = tmp;
-
-                    tmp2 = (real_Double_t) fabs( MAGMA_S_REAL(tmp) );
-                    (*nonlinres) = (*nonlinres) + tmp2*tmp2;
-                }
-            }
-        }
-    }
-
-    for(i=0; i<LU->num_rows; i++){
-        for(j=LU->row[i]; j<LU->row[i+1]; j++){
-            tmp2 = (real_Double_t) fabs( MAGMA_S_REAL(LU->val[j]) );
-            (*res) = (*res) + tmp2* tmp2;
-        }
-    }
-
+    CHECK( magma_sspgemm_cpu( one, C, CT, LU, queue ));
+    CHECK( magma_slures_diff( A, LU, res, nonlinres, queue ));
 
     (*res) =  sqrt((*res));
     (*nonlinres) =  sqrt((*nonlinres));
@@ -440,14 +378,12 @@ cleanup:
     if( info !=0 ){
         magma_smfree( LU, queue  );
     }
-    magma_smfree( &dL, queue  );
-    magma_smfree( &dU, queue  );
-    magma_smfree( &dLU, queue  );
     return info;
 }
 
 
 
+
 /**
     Purpose
     -------
@@ -464,19 +464,31 @@ magma_zprecondfree(
     magma_queue_t queue ){
 
     if ( precond_par->d.val != NULL ) {
-        magma_free( precond_par->d.val );
+        if ( precond_par->d.memory_location == Magma_DEV )
+            magma_free( precond_par->d.dval );
+        else
+            magma_free_cpu( precond_par->d.val );
         precond_par->d.val = NULL;
     }
     if ( precond_par->d2.val != NULL ) {
-        magma_free( precond_par->d2.val );
+        if ( precond_par->d2.memory_location == Magma_DEV )
+            magma_free( precond_par->d2.dval );
+        else
+            magma_free_cpu( precond_par->d2.val );
         precond_par->d2.val = NULL;
     }
     if ( precond_par->work1.val != NULL ) {
-        magma_free( precond_par->work1.val );
+        if ( precond_par->work1.memory_location == Magma_DEV )
+            magma_free( precond_par->work1.dval );
+        else
+            magma_free_cpu( precond_par->work1.val );
         precond_par->work1.val = NULL;
     }
     if ( precond_par->work2.val != NULL ) {
-        magma_free( precond_par->work2.val );
+        if ( precond_par->work2.memory_location == Magma_DEV )
+            magma_free( precond_par->work2.dval );
+        else
+            magma_free_cpu( precond_par->work2.val );
         precond_par->work2.val = NULL;
     }
     if ( precond_par->M.val != NULL ) {
@@ -738,6 +750,15 @@ magma_zprecondfree(
         magma_free( precond_par->U_dgraphindegree_bak );
         precond_par->U_dgraphindegree_bak = NULL;
     }
+    if ( precond_par->perm != NULL ) {
+        magma_free_cpu( precond_par->perm );
+        precond_par->perm = NULL;
+    }
+    if ( precond_par->colorptr != NULL ) {
+        magma_free_cpu( precond_par->colorptr );
+        precond_par->colorptr = NULL;
+    }
+    precond_par->ncolors = 0;
 
     precond_par->solver = Magma_NONE;
     
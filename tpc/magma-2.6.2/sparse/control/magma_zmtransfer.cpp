@@ -749,6 +749,7 @@ magma_zmtransfer(
             CHECK( magma_zmalloc_cpu( &B->val, A.nnz ));
             CHECK( magma_index_malloc_cpu( &B->row, A.num_rows + 1 ));
             CHECK( magma_index_malloc_cpu( &B->col, A.nnz ));
+            CHECK( magma_zfirsttouch_cpu( A.nnz, B->val, B->col, NULL, queue ));
             // data transfer
             magma_zgetvector( A.nnz, A.dval, 1, B->val, 1, queue );
             magma_index_getvector( A.num_rows + 1, A.drow, 1, B->row, 1, queue );
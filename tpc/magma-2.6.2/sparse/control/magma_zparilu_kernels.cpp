@@ -62,7 +62,7 @@ magma_zparilu_sweep(
     magmaDoubleComplex zero = MAGMA_Z_MAKE(0.0, 0.0);
     int il, iu, jl, ju;
 
-    #pragma omp parallel for
+    #pragma omp parallel for private(i, j, il, iu, jl, ju)
     for (int k=0; k < A.nnz; k++) {
         i = A.rowidx[k];
         j = A.col[k];
@@ -157,7 +157,7 @@ magma_zparilu_sweep_sync(
         L_new_val[L->row[k+1]-1] = MAGMA_Z_ONE;
     }
     
-    #pragma omp parallel for
+    #pragma omp parallel for private(i, j, il, iu, jl, ju)
     for (int k=0; k < A.nnz; k++) {
         i = A.rowidx[k];
         j = A.col[k];
@@ -201,3 +201,149 @@ cleanup:
     
     return info;
 }
+
+
+
+/***************************************************************************//**
+    Purpose
+    -------
+    This function does one asynchronous ParILU sweep that only updates the
+    rows marked as active. Input and output array are identical.
+    
+    For every row, the largest relative change of its entries in L and U is
+    tracked. A row stays active for the next sweep if this change exceeds
+    tol, or if one of the rows it depends on, i.e. the rows k with 
+    L(i,k) != 0, changed by more than tol. On exit, active contains the mask
+    for the next sweep. With tol = 0, only rows whose values and dependencies
+    did not change at all are skipped.
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_z_matrix
+                System matrix in CSRCOO (CSR with row index).
+
+    @param[in,out]
+    L           magma_z_matrix*
+                Current approximation for the lower triangular factor
+                The format is sorted CSR.
+
+    @param[in,out]
+    U           magma_z_matrix*
+                Current approximation for the upper triangular factor
+                The format is sorted CSC (U^T in CSR).
+
+    @param[in]
+    tol         double
+                Tolerance for the relative change of a row.
+
+    @param[in,out]
+    active      magma_index_t*
+                Mask of size A.num_rows, 1 for the rows to update.
+                On exit the mask for the next sweep.
+
+    @param[out]
+    changed     magma_index_t*
+                Workspace of size A.num_rows.
+
+    @param[out]
+    num_active  magma_int_t*
+                Number of rows active for the next sweep. If zero, the
+                iteration has converged.
+
+    @param[out]
+    nnz_active  magma_int_t*
+                Number of nonzeros updated in this sweep.
+                
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_zaux
+*******************************************************************************/
+
+
+extern "C" magma_int_t
+magma_zparilu_sweep_adaptive(
+    magma_z_matrix A,
+    magma_z_matrix *L,
+    magma_z_matrix *U,
+    double tol,
+    magma_index_t *active,
+    magma_index_t *changed,
+    magma_int_t *num_active,
+    magma_int_t *nnz_active,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+    magma_int_t rows = 0, nnz = 0;
+    
+    magmaDoubleComplex zero = MAGMA_Z_MAKE(0.0, 0.0);
+
+    #pragma omp parallel for reduction(+:nnz)
+    for (magma_int_t row=0; row < A.num_rows; row++) {
+        double change = 0.0;
+        changed[row] = 0;
+        if (active[row] == 0) {
+            continue;
+        }
+        nnz += A.row[row+1] - A.row[row];
+        for (magma_int_t k=A.row[row]; k < A.row[row+1]; k++) {
+            int i = A.rowidx[k];
+            int j = A.col[k];
+            int il, iu, jl, ju;
+            magmaDoubleComplex s, sp, old;
+            s =  A.val[k];
+            sp = zero;
+
+            il = L->row[i];
+            iu = U->row[j];
+
+            while (il < L->row[i+1] && iu < U->row[j+1])
+            {
+                sp = zero;
+                jl = L->col[il];
+                ju = U->col[iu];
+
+                // avoid branching
+                sp = ( jl == ju ) ? L->val[il] * U->val[iu] : sp;
+                s = ( jl == ju ) ? s-sp : s;
+                il = ( jl <= ju ) ? il+1 : il;
+                iu = ( jl >= ju ) ? iu+1 : iu;
+            }
+            // undo the last operation (it must be the last)
+            s += sp;
+            
+            if ( i > j ) {    // modify l entry
+                old = L->val[il-1];
+                s = s / U->val[U->row[j+1]-1];
+                L->val[il-1] = s;
+            } else {          // modify u entry
+                old = U->val[iu-1];
+                U->val[iu-1] = s;
+            }
+            double diff = MAGMA_Z_ABS( s - old );
+            double nrm = MAGMA_Z_ABS( s );
+            diff = ( nrm > 0.0 ) ? diff / nrm : diff;
+            change = ( diff > change ) ? diff : change;
+        }
+        changed[row] = ( change > tol ) ? 1 : 0;
+    }
+    
+    // a row is active if it changed, or if one of its dependencies changed
+    #pragma omp parallel for reduction(+:rows)
+    for (magma_int_t row=0; row < A.num_rows; row++) {
+        magma_index_t act = changed[row];
+        for (magma_int_t k=L->row[row]; k < L->row[row+1] && act == 0; k++) {
+            act = changed[ L->col[k] ];
+        }
+        active[row] = act;
+        rows += act;
+    }
+    
+    *num_active = rows;
+    *nnz_active = nnz;
+    
+    return info;
+}
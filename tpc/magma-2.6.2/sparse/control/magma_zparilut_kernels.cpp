@@ -415,3 +415,358 @@ magma_zparilut_residuals(
 
     return info;
 }
+
+
+
+/***************************************************************************//**
+    Purpose
+    -------
+    This function computes for every nonzero of F the location of the entry
+    of A with the same row and column index, or -1 if A has no entry there.
+    The rows of F and A have to match, i.e. for the transposed storage of U
+    used in ParILUT, the map has to be generated with respect to A^T.
+    Sorted rows of F are matched with a merge against the row of A, unsorted
+    rows (as they appear in the candidate lists) fall back to a binary search.
+    The map stays valid as long as the pattern of F does not change, and
+    replaces the linear search for A(i,j) in the sweeps and the residuals.
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_z_matrix
+                System matrix. The format is sorted CSR.
+
+    @param[in]
+    F           magma_z_matrix
+                Factor or candidate list with row pointer and column indices.
+
+    @param[in,out]
+    amap        magma_index_t**
+                Location of A(i,j) for each nonzero of F, or -1.
+                An existing map is released and replaced.
+
+    @param[in,out]
+    ws          magma_z_workspace*
+                Workspace the map is drawn from. May be NULL.
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_zaux
+*******************************************************************************/
+
+extern "C" magma_int_t
+magma_zparilut_amap(
+    magma_z_matrix A,
+    magma_z_matrix F,
+    magma_index_t **amap,
+    magma_z_workspace *ws,
+    magma_queue_t queue)
+{
+    magma_int_t info = 0;
+    magma_index_t *map = NULL;
+
+    magma_zworkspace_free( ws, *amap, queue );
+    *amap = NULL;
+    CHECK( magma_zworkspace_malloc( ws, (void**) &map, 
+        F.nnz*sizeof(magma_index_t), queue ) );
+
+    #pragma omp parallel for
+    for (magma_int_t row=0; row<F.num_rows; row++) {
+        magma_int_t i = F.row[ row ];
+        magma_int_t endi = F.row[ row+1 ];
+        magma_int_t j = A.row[ row ];
+        magma_int_t endj = A.row[ row+1 ];
+        magma_int_t sorted = 1;
+        for (magma_int_t k=i+1; k<endi; k++) {
+            if (F.col[ k ] < F.col[ k-1 ]) {
+                sorted = 0;
+                break;
+            }
+        }
+        if (sorted == 1) {
+            // merge the row of F with the row of A
+            while (i < endi) {
+                if (j == endj || F.col[ i ] < A.col[ j ]) {
+                    map[ i ] = -1;
+                    i++;
+                } else if (F.col[ i ] == A.col[ j ]) {
+                    map[ i ] = j;
+                    i++;
+                } else {
+                    j++;
+                }
+            }
+        } else {
+            // binary search in the row of A
+            for (; i<endi; i++) {
+                magma_index_t col = F.col[ i ];
+                magma_int_t lo = j, hi = endj;
+                while (lo < hi) {
+                    magma_int_t mid = lo + (hi-lo)/2;
+                    if (A.col[ mid ] < col) {
+                        lo = mid+1;
+                    } else {
+                        hi = mid;
+                    }
+                }
+                map[ i ] = (lo < endj && A.col[ lo ] == col) ? lo : -1;
+            }
+        }
+    }
+    *amap = map;
+
+cleanup:
+    return info;
+}
+
+
+/***************************************************************************//**
+    Purpose
+    -------
+    This function does an ParILUT sweep like magma_zparilut_sweep_sync, but
+    the entries of A are read through the maps generated by
+    magma_zparilut_amap instead of searching the rows of A.
+
+    This is the CPU version of the synchronous ParILUT sweep.
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_z_matrix*
+                System matrix. The format is sorted CSR.
+
+    @param[in]
+    AT          magma_z_matrix*
+                Transpose of A. The format is sorted CSR.
+
+    @param[in,out]
+    L           magma_z_matrix*
+                Current approximation for the lower triangular factor
+                The format is MAGMA_CSRCOO. This is sorted CSR plus the
+                rowindexes being stored.
+
+    @param[in,out]
+    U           magma_z_matrix*
+                Current approximation for the upper triangular factor
+                transposed. The format is MAGMA_CSRCOO.
+
+    @param[in]
+    Lmap        magma_index_t*
+                Map of L into A generated by magma_zparilut_amap.
+
+    @param[in]
+    Umap        magma_index_t*
+                Map of U into AT generated by magma_zparilut_amap.
+
+    @param[in,out]
+    ws          magma_z_workspace*
+                Workspace the new value arrays are drawn from, the old ones
+                are handed back to it. May be NULL.
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_zaux
+*******************************************************************************/
+
+extern "C" magma_int_t
+magma_zparilut_sweep_sync_map(
+    magma_z_matrix *A,
+    magma_z_matrix *AT,
+    magma_z_matrix *L,
+    magma_z_matrix *U,
+    magma_index_t *Lmap,
+    magma_index_t *Umap,
+    magma_z_workspace *ws,
+    magma_queue_t queue)
+{
+    magma_int_t info = 0;
+    magmaDoubleComplex *L_new_val = NULL, *U_new_val = NULL, *val_swap = NULL;
+    CHECK(magma_zworkspace_malloc(ws, (void**) &L_new_val, 
+        L->nnz*sizeof(magmaDoubleComplex), queue));
+    CHECK(magma_zworkspace_malloc(ws, (void**) &U_new_val, 
+        U->nnz*sizeof(magmaDoubleComplex), queue));
+
+    #pragma omp parallel for
+    for (magma_int_t e=0; e<U->nnz; e++) {
+        magma_int_t i,j,icol,jcol;
+
+        magma_index_t row = U->col[ e ];
+        magma_index_t col = U->rowidx[ e ];
+        magmaDoubleComplex A_e = (Umap[ e ] > -1) ?
+                                    AT->val[ Umap[ e ] ] : MAGMA_Z_ZERO;
+        //now do the actual iteration
+        i = L->row[ row ];
+        j = U->row[ col ];
+        magma_int_t endi = L->row[ row+1 ];
+        magma_int_t endj = U->row[ col+1 ];
+        magmaDoubleComplex sum = MAGMA_Z_ZERO;
+        magmaDoubleComplex lsum = MAGMA_Z_ZERO;
+        do{
+            lsum = MAGMA_Z_ZERO;
+            icol = L->col[i];
+            jcol = U->col[j];
+            if(icol == jcol) {
+                lsum = L->val[i] * U->val[j];
+                sum = sum + lsum;
+                i++;
+                j++;
+            }
+            else if(icol<jcol) {
+                i++;
+            }
+            else {
+                j++;
+            }
+        }while(i<endi && j<endj);
+        sum = sum - lsum;
+
+        // write back to location e
+        U_new_val[ e ] =  (A_e - sum);
+    }// end omp parallel section
+
+    #pragma omp parallel for
+    for (magma_int_t e=0; e<L->nnz; e++) {
+        magma_int_t i,j,icol,jcol,jold;
+        magma_index_t row = L->rowidx[ e ];
+        magma_index_t col = L->col[ e ];
+
+        if(row == col) {
+            L_new_val[ e ] = MAGMA_Z_ONE; // lower triangular has 1-diagonal
+        } else {
+            magmaDoubleComplex A_e = (Lmap[ e ] > -1) ?
+                                        A->val[ Lmap[ e ] ] : MAGMA_Z_ZERO;
+            //now do the actual iteration
+            i = L->row[ row ];
+            j = U->row[ col ];
+            magma_int_t endi = L->row[ row+1 ];
+            magma_int_t endj = U->row[ col+1 ];
+            magmaDoubleComplex sum = MAGMA_Z_ZERO;
+            magmaDoubleComplex lsum = MAGMA_Z_ZERO;
+            do{
+                lsum = MAGMA_Z_ZERO;
+                jold = j;
+                icol = L->col[i];
+                jcol = U->col[j];
+                if(icol == jcol) {
+                    lsum = L->val[i] * U_new_val[j];
+                    sum = sum + lsum;
+                    i++;
+                    j++;
+                }
+                else if(icol<jcol) {
+                    i++;
+                }
+                else {
+                    j++;
+                }
+            }while(i<endi && j<endj);
+            sum = sum - lsum;
+            // write back to location e
+            L_new_val[ e ] =  (A_e - sum)/ U->val[jold];
+        }
+    }// end omp parallel section
+
+    // swap old and new values
+    SWAP(L_new_val, L->val);
+    SWAP(U_new_val, U->val);
+
+cleanup:
+    magma_zworkspace_free(ws, L_new_val, queue);
+    magma_zworkspace_free(ws, U_new_val, queue);
+    return info;
+}
+
+
+/***************************************************************************//**
+    Purpose
+    -------
+    This function computes the ILU residual in the locations included in the
+    sparsity pattern of R like magma_zparilut_residuals, but the entries of A
+    are read through the map generated by magma_zparilut_amap.
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_z_matrix
+                System matrix A.
+
+    @param[in]
+    L           magma_z_matrix
+                Current approximation for the lower triangular factor.
+                The format is sorted CSR.
+
+    @param[in]
+    U           magma_z_matrix
+                Current approximation for the upper triangular factor.
+                The format is sorted CSR.
+
+    @param[in]
+    Rmap        magma_index_t*
+                Map of R into A generated by magma_zparilut_amap.
+
+    @param[in,out]
+    R           magma_z_matrix*
+                Sparsity pattern on which the ILU residual is computed.
+                R is in COO format. On output, R contains the ILU residual.
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_zaux
+*******************************************************************************/
+
+extern "C" magma_int_t
+magma_zparilut_residuals_map(
+    magma_z_matrix A,
+    magma_z_matrix L,
+    magma_z_matrix U,
+    magma_index_t *Rmap,
+    magma_z_matrix *R,
+    magma_queue_t queue)
+{
+    magma_int_t info = 0;
+    #pragma omp parallel for
+    for (magma_int_t e=0; e<R->nnz; e++) {
+        magma_int_t i,j,icol,jcol;
+        magma_index_t row = R->rowidx[ e ];
+        magma_index_t col = R->col[ e ];
+        magmaDoubleComplex A_e = (Rmap[ e ] > -1) ?
+                                    A.val[ Rmap[ e ] ] : MAGMA_Z_ZERO;
+        //now do the actual iteration
+        i = L.row[ row ];
+        j = U.row[ col ];
+        magma_int_t endi = L.row[ row+1 ];
+        magma_int_t endj = U.row[ col+1 ];
+        magmaDoubleComplex sum = MAGMA_Z_ZERO;
+        magmaDoubleComplex lsum = MAGMA_Z_ZERO;
+        do{
+            lsum = MAGMA_Z_ZERO;
+            icol = L.col[i];
+            jcol = U.col[j];
+            if(icol == jcol) {
+                lsum = L.val[i] * U.val[j];
+                sum = sum + lsum;
+                i++;
+            }
+            else if(icol<jcol) {
+                i++;
+            }
+            else {
+                j++;
+            }
+        }while(i<endi && j<endj);
+        sum = sum - lsum;
+        // write back to location e
+        R->val[ e ] =  (A_e - sum);
+    }// end omp parallel section
+
+    return info;
+}
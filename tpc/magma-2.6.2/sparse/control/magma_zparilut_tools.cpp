@@ -10,6 +10,8 @@
 
 */
 
+#include <algorithm>
+
 #include "magmasparse_internal.h"
 #ifdef _OPENMP
 #include <omp.h>
@@ -24,6 +26,38 @@
 // this file is marked as deprecated, and will be removed in future.
 
 
+/*
+    Appends col to the growing candidate buffer buf.
+*/
+static magma_int_t
+magma_zparilut_candidates_push(
+    magma_index_t **buf,
+    magma_int_t *size,
+    magma_int_t *cap,
+    magma_index_t col,
+    magma_z_workspace *ws,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+    if( *size == *cap ){
+        magma_int_t newcap = ( *cap > 0 ) ? 2 * (*cap) : 1024;
+        magma_index_t *tmp = NULL;
+        CHECK( magma_zworkspace_malloc( ws, (void**) &tmp, 
+            newcap*sizeof(magma_index_t), queue ));
+        for( magma_int_t i=0; i<*size; i++ ){
+            tmp[ i ] = (*buf)[ i ];
+        }
+        magma_zworkspace_free( ws, *buf, queue );
+        *buf = tmp;
+        *cap = newcap;
+    }
+    (*buf)[ (*size)++ ] = col;
+
+cleanup:
+    return info;
+}
+
+
 /***************************************************************************//**
     Purpose
     -------
@@ -47,6 +81,11 @@
     thrs        double*
                 Threshold: all elements smaller are discarded
 
+    @param[in,out]
+    ws          magma_z_workspace*
+                Workspace the new arrays of A are drawn from, the old arrays
+                of A are handed back to it. May be NULL.
+
     @param[in]
     queue       magma_queue_t
                 Queue to execute in.
@@ -59,6 +98,7 @@ magma_zparilut_thrsrm(
     magma_int_t order,
     magma_z_matrix *A,
     double *thrs,
+    magma_z_workspace *ws,
     magma_queue_t queue )
 {
     magma_int_t info = 0;
@@ -69,7 +109,8 @@ magma_zparilut_thrsrm(
     B.storage_type = Magma_CSR;
     B.memory_location = Magma_CPU;
     
-    CHECK( magma_index_malloc_cpu( &B.row, A->num_rows+1 ) );
+    CHECK( magma_zworkspace_malloc( ws, (void**) &B.row, 
+        (A->num_rows+1)*sizeof(magma_index_t), queue ) );
     
     
     if( order == 1 ){
@@ -87,7 +128,7 @@ magma_zparilut_thrsrm(
                         A->col[i] = -1; // cheaper than val  
                         rm++;
                     } else {
-                        ;
+                        el++; // the diagonal is kept
                     }
                 } else {
                     el++;    
@@ -109,7 +150,7 @@ magma_zparilut_thrsrm(
                         A->col[i] = -1; // cheaper than val  
                         rm++;
                     } else {
-                        ;
+                        el++; // the diagonal is kept
                     }
                 } else {
                     el++;    
@@ -125,9 +166,12 @@ magma_zparilut_thrsrm(
     B.nnz = B.row[ B.num_rows ];
     
     // allocate new arrays
-    CHECK( magma_zmalloc_cpu( &B.val, B.nnz ) );
-    CHECK( magma_index_malloc_cpu( &B.rowidx, B.nnz ) );
-    CHECK( magma_index_malloc_cpu( &B.col, B.nnz ) );
+    CHECK( magma_zworkspace_malloc( ws, (void**) &B.val, 
+        B.nnz*sizeof(magmaDoubleComplex), queue ) );
+    CHECK( magma_zworkspace_malloc( ws, (void**) &B.rowidx, 
+        B.nnz*sizeof(magma_index_t), queue ) );
+    CHECK( magma_zworkspace_malloc( ws, (void**) &B.col, 
+        B.nnz*sizeof(magma_index_t), queue ) );
     
     #pragma omp parallel for
     for( magma_int_t row=0; row<A->num_rows; row++){
@@ -152,7 +196,7 @@ magma_zparilut_thrsrm(
 
     
 cleanup:
-    magma_zmfree( &B, queue );
+    magma_zworkspace_mfree( ws, &B, queue );
     return info;
 }
 
@@ -605,7 +649,7 @@ magma_zparilut_selectoneperrow(
             
         }
         B.row[B.num_rows] = B.num_rows;
-        CHECK( magma_zparilut_thrsrm( 1, &B, &thrs, queue ) );
+        CHECK( magma_zparilut_thrsrm( 1, &B, &thrs, NULL, queue ) );
     } else {
         #pragma omp parallel for
         for( magma_int_t row=0; row<A->num_rows; row++){
@@ -631,7 +675,7 @@ magma_zparilut_selectoneperrow(
             
         } 
         B.row[B.num_rows] = B.num_rows;
-        CHECK( magma_zparilut_thrsrm( 1, &B, &thrs, queue ) );
+        CHECK( magma_zparilut_thrsrm( 1, &B, &thrs, NULL, queue ) );
     }
     
     // finally, swap the matrices
@@ -857,7 +901,7 @@ magma_zparilut_selectoneperrowthrs_lower(
         
     }
     B.row[B.num_rows] = B.num_rows;
-    CHECK( magma_zparilut_thrsrm( 1, &B, &thrs, queue ) );
+    CHECK( magma_zparilut_thrsrm( 1, &B, &thrs, NULL, queue ) );
     
     // finally, swap the matrices
     // keep the copy!
@@ -964,7 +1008,7 @@ magma_zparilut_selectoneperrowthrs_upper(
         }
     }
     B.row[B.num_rows] = B.num_rows;
-    CHECK( magma_zparilut_thrsrm( 1, &B, &thrs, queue ) );
+    CHECK( magma_zparilut_thrsrm( 1, &B, &thrs, NULL, queue ) );
     
     // finally, swap the matrices
     // keep the copy!
@@ -1004,7 +1048,9 @@ cleanup:
     oneA        magma_z_matrix*
                 Matrix where elements are removed.
                 
-                
+    @param[in,out]
+    ws          magma_z_workspace*
+                Workspace the values of oneA are drawn from. May be NULL.
 
     @param[in]
     queue       magma_queue_t
@@ -1018,6 +1064,7 @@ magma_zparilut_preselect(
     magma_int_t order,
     magma_z_matrix *A,
     magma_z_matrix *oneA,
+    magma_z_workspace *ws,
     magma_queue_t queue )
 {
     magma_int_t info = 0;
@@ -1028,7 +1075,8 @@ magma_zparilut_preselect(
     oneA->storage_type = Magma_CSR;
     oneA->memory_location = Magma_CPU;
     
-    CHECK( magma_zmalloc_cpu( &oneA->val, oneA->nnz ) );
+    CHECK( magma_zworkspace_malloc( ws, (void**) &oneA->val, 
+        oneA->nnz*sizeof(magmaDoubleComplex), queue ) );
     
     if( order == 1 ){ // don't copy the first
         #pragma omp parallel for
@@ -2829,12 +2877,41 @@ magma_zparilut_insert(
 
 
 
+/*
+    Upper bound for the number of distinct columns the candidate search
+    visits in row row of L or of U: the current and the original rows and
+    the merged rows of U, but at most L.num_cols.
+*/
+static inline magma_int_t
+magma_zparilut_candidates_bound(
+    const magma_z_matrix &L0,
+    const magma_z_matrix &U0,
+    const magma_z_matrix &L,
+    const magma_z_matrix &U,
+    magma_int_t row )
+{
+    int64_t bound = ( L.row[row+1] - L.row[row] ) + ( L0.row[row+1] - L0.row[row] )
+                  + ( U.row[row+1] - U.row[row] ) + ( U0.row[row+1] - U0.row[row] );
+    for( magma_index_t el1=L.row[row]; el1<L.row[row+1]-1; el1++ ){
+        magma_index_t col1 = L.col[ el1 ];
+        bound += U.row[ col1+1 ] - U.row[ col1 ];
+    }
+    return ( bound < L.num_cols ) ? (magma_int_t) bound : L.num_cols;
+}
+
+
 /***************************************************************************//**
     Purpose
     -------
     This function identifies the candidates like they appear as ILU1 fill-in.
-    In this version, the matrices are assumed unordered,
-    the linked list is traversed to acces the entries of a row.
+    In addition, the elements of the original pattern L0/U0 that are missing
+    in the current approximation are candidates.
+
+    The candidates are generated in a single pass: every thread handles a
+    contiguous block of rows and appends the candidates into thread-local
+    buffers, using a per-row hash of the columns (see magma_colmap_size) to
+    skip existing entries and duplicates.
+    The buffers are then compacted in parallel into the CSR output.
 
     Arguments
     ---------
@@ -2856,12 +2933,18 @@ magma_zparilut_insert(
                 Current upper triangular factor.
 
     @param[in,out]
-    LU_new      magma_z_matrix*
+    L_new       magma_z_matrix*
                 List of candidates for L in COO format.
 
     @param[in,out]
-    LU_new      magma_z_matrix*
+    U_new       magma_z_matrix*
                 List of candidates for U in COO format.
+                If NULL, only the candidates for L are generated.
+
+    @param[in,out]
+    ws          magma_z_workspace*
+                Workspace the candidate lists and the temporary arrays are
+                drawn from. May be NULL.
 
     @param[in]
     queue       magma_queue_t
@@ -2878,6 +2961,424 @@ magma_zparilut_candidates(
     magma_z_matrix U,
     magma_z_matrix *L_new,
     magma_z_matrix *U_new,
+    magma_z_workspace *ws,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+    magma_index_t *offL = NULL, *offU = NULL, *mark = NULL;
+    magma_int_t num_threads = 1, max_bound = 0, tsize;
+    magma_int_t withU = ( U_new != NULL ) ? 1 : 0;
+
+#ifdef _OPENMP
+    num_threads = omp_get_max_threads();
+#endif
+
+    CHECK( magma_zworkspace_malloc( ws, (void**) &offL, 
+        (num_threads+1)*sizeof(magma_index_t), queue ));
+    CHECK( magma_zworkspace_malloc( ws, (void**) &offU, 
+        (num_threads+1)*sizeof(magma_index_t), queue ));
+    // one pair of column maps per thread, sized for the longest row
+    #pragma omp parallel for reduction(max:max_bound)
+    for( magma_int_t row=0; row<L.num_rows; row++ ){
+        magma_int_t bound = magma_zparilut_candidates_bound( L0, U0, L, U, row );
+        max_bound = ( bound > max_bound ) ? bound : max_bound;
+    }
+    tsize = magma_colmap_size( max_bound );
+    CHECK( magma_zworkspace_malloc( ws, (void**) &mark, 
+        2*(size_t) num_threads*tsize*sizeof(magma_index_t), queue ));
+    CHECK( magma_zworkspace_malloc( ws, (void**) &L_new->row, 
+        (L.num_rows+1)*sizeof(magma_index_t), queue ));
+    L_new->num_rows = L.num_rows;
+    L_new->num_cols = L.num_cols;
+    L_new->storage_type = Magma_CSR;
+    L_new->memory_location = Magma_CPU;
+    L_new->row[ 0 ] = 0;
+    if( withU ){
+        CHECK( magma_zworkspace_malloc( ws, (void**) &U_new->row, 
+            (L.num_rows+1)*sizeof(magma_index_t), queue ));
+        U_new->num_rows = L.num_rows;
+        U_new->num_cols = L.num_cols;
+        U_new->storage_type = Magma_CSR;
+        U_new->memory_location = Magma_CPU;
+        U_new->row[ 0 ] = 0;
+    }
+    offL[ 0 ] = 0;
+    offU[ 0 ] = 0;
+
+    #pragma omp parallel
+    {
+        magma_int_t id = 0, nt = 1;
+#ifdef _OPENMP
+        id = omp_get_thread_num();
+        nt = omp_get_num_threads();
+#endif
+        magma_int_t rstart = ( L.num_rows * id ) / nt;
+        magma_int_t rend = ( L.num_rows * (id+1) ) / nt;
+        magma_index_t *markL = mark + 2*(size_t) id*tsize;
+        magma_index_t *markU = markL + tsize;
+        magma_index_t *bufL = NULL, *bufU = NULL;
+        magma_int_t sizeL = 0, sizeU = 0, capL = 0, capU = 0, tinfo = 0;
+
+        // elements of the original pattern are stored as -col-1,
+        // fill-in elements as col
+        for( magma_index_t row=rstart; row<rend && tinfo==0; row++ ){
+            magma_int_t startL = sizeL, startU = sizeU, slot;
+            magma_int_t size = magma_colmap_size(
+                magma_zparilut_candidates_bound( L0, U0, L, U, row ));
+            magma_colmap_clear( markL, size );
+            for( magma_index_t k=L.row[row]; k<L.row[row+1]; k++ ){
+                slot = magma_colmap_slot( markL, size, L.col[ k ] );
+                markL[ slot ] = L.col[ k ];
+            }
+            for( magma_index_t k=L0.row[row]; k<L0.row[row+1] && tinfo==0; k++ ){
+                magma_index_t col = L0.col[ k ];
+                slot = magma_colmap_slot( markL, size, col );
+                if( markL[ slot ] != col ){
+                    markL[ slot ] = col;
+                    tinfo = magma_zparilut_candidates_push( &bufL, &sizeL, &capL, -col-1, ws, queue );
+                }
+            }
+            if( withU ){
+                magma_colmap_clear( markU, size );
+                for( magma_index_t k=U.row[row]; k<U.row[row+1]; k++ ){
+                    slot = magma_colmap_slot( markU, size, U.col[ k ] );
+                    markU[ slot ] = U.col[ k ];
+                }
+                for( magma_index_t k=U0.row[row]; k<U0.row[row+1] && tinfo==0; k++ ){
+                    magma_index_t col = U0.col[ k ];
+                    slot = magma_colmap_slot( markU, size, col );
+                    if( markU[ slot ] != col ){
+                        markU[ slot ] = col;
+                        tinfo = magma_zparilut_candidates_push( &bufU, &sizeU, &capU, -col-1, ws, queue );
+                    }
+                }
+            }
+            // for each node i, look at any "intermediate" neighbor nodes numbered
+            // less, and then see if this neighbor has another neighbor j numbered
+            // more than the intermediate; if so, fill in is (i,j) if it is not
+            // already nonzero
+            for( magma_index_t el1=L.row[row]; el1<L.row[row+1]-1 && tinfo==0; el1++ ){
+                magma_index_t col1 = L.col[ el1 ];
+                for( magma_index_t el2 = U.row[ col1 ]+1; el2 < U.row[ col1+1 ] && tinfo==0; el2++ ){
+                    magma_index_t col2 = U.col[ el2 ];
+                    if( col2 < row ){
+                        slot = magma_colmap_slot( markL, size, col2 );
+                        if( markL[ slot ] != col2 ){
+                            markL[ slot ] = col2;
+                            tinfo = magma_zparilut_candidates_push( &bufL, &sizeL, &capL, col2, ws, queue );
+                        }
+                    } else if( withU ){
+                        slot = magma_colmap_slot( markU, size, col2 );
+                        if( markU[ slot ] != col2 ){
+                            markU[ slot ] = col2;
+                            tinfo = magma_zparilut_candidates_push( &bufU, &sizeU, &capU, col2, ws, queue );
+                        }
+                    }
+                }
+            }
+            L_new->row[ row+1 ] = sizeL - startL;
+            if( withU ){
+                U_new->row[ row+1 ] = sizeU - startU;
+            }
+        }
+        if( tinfo != 0 ){
+            #pragma omp atomic write
+            info = MAGMA_ERR_HOST_ALLOC;
+        }
+        offL[ id+1 ] = sizeL;
+        offU[ id+1 ] = sizeU;
+        #pragma omp barrier
+        #pragma omp single
+        {
+            for( magma_int_t i=0; i<nt; i++ ){
+                offL[ i+1 ] += offL[ i ];
+                offU[ i+1 ] += offU[ i ];
+            }
+            L_new->nnz = offL[ nt ];
+            if( info == 0 ){
+                info += magma_zworkspace_malloc( ws, (void**) &L_new->val, 
+                    L_new->nnz*sizeof(magmaDoubleComplex), queue );
+                info += magma_zworkspace_malloc( ws, (void**) &L_new->rowidx, 
+                    L_new->nnz*sizeof(magma_index_t), queue );
+                info += magma_zworkspace_malloc( ws, (void**) &L_new->col, 
+                    L_new->nnz*sizeof(magma_index_t), queue );
+            }
+            if( withU ){
+                U_new->nnz = offU[ nt ];
+                if( info == 0 ){
+                    info += magma_zworkspace_malloc( ws, (void**) &U_new->val, 
+                        U_new->nnz*sizeof(magmaDoubleComplex), queue );
+                    info += magma_zworkspace_malloc( ws, (void**) &U_new->rowidx, 
+                        U_new->nnz*sizeof(magma_index_t), queue );
+                    info += magma_zworkspace_malloc( ws, (void**) &U_new->col, 
+                        U_new->nnz*sizeof(magma_index_t), queue );
+                }
+            }
+        }
+        // compact the thread-local buffers into the CSR output
+        if( info == 0 ){
+            magma_int_t pos = offL[ id ], kb = 0;
+            for( magma_index_t row=rstart; row<rend; row++ ){
+                magma_int_t cnt = L_new->row[ row+1 ];
+                for( magma_int_t k=0; k<cnt; k++, kb++, pos++ ){
+                    magma_index_t col = bufL[ kb ];
+                    L_new->col[ pos ] = ( col < 0 ) ? -col-1 : col;
+                    L_new->rowidx[ pos ] = row;
+                    L_new->val[ pos ] = ( col < 0 ) ?
+                        MAGMA_Z_ONE + MAGMA_Z_ONE + MAGMA_Z_ONE : MAGMA_Z_ONE;
+                }
+                L_new->row[ row+1 ] = pos;
+            }
+            if( withU ){
+                pos = offU[ id ];
+                kb = 0;
+                for( magma_index_t row=rstart; row<rend; row++ ){
+                    magma_int_t cnt = U_new->row[ row+1 ];
+                    for( magma_int_t k=0; k<cnt; k++, kb++, pos++ ){
+                        magma_index_t col = bufU[ kb ];
+                        U_new->col[ pos ] = ( col < 0 ) ? -col-1 : col;
+                        U_new->rowidx[ pos ] = row;
+                        U_new->val[ pos ] = ( col < 0 ) ?
+                            MAGMA_Z_ONE + MAGMA_Z_ONE + MAGMA_Z_ONE : MAGMA_Z_ONE;
+                    }
+                    U_new->row[ row+1 ] = pos;
+                }
+            }
+        }
+        magma_zworkspace_free( ws, bufL, queue );
+        magma_zworkspace_free( ws, bufU, queue );
+    }
+
+cleanup:
+    magma_zworkspace_free( ws, mark, queue );
+    magma_zworkspace_free( ws, offL, queue );
+    magma_zworkspace_free( ws, offU, queue );
+    return info;
+}
+
+
+
+/***************************************************************************//**
+    Purpose
+    -------
+    Updates the transpose UT of the upper triangular factor instead of
+    transposing U again in every ParILUT iteration. The candidates that were
+    added to U are merged into the rows of UT, and all elements that
+    magma_zparilut_thrsrm( 1, U, thrs ) is going to remove from U are dropped
+    from UT in the same pass. Every element of UT is located in the sorted
+    row of U by bisection, so no linked list or atomic operation is needed,
+    and the values of UT are gathered from U.
+
+    The function has to be called after the candidates were added to U and
+    before the elements are removed from U.
+
+    Arguments
+    ---------
+
+    @param[in]
+    U           magma_z_matrix
+                Current factor in CSR, including the candidates, with sorted
+                rows. This is the transpose of the factor UT.
+
+    @param[in]
+    U_cand      magma_z_matrix
+                Candidates that were added to U, in the layout of UT with
+                sorted rows, i.e. the transpose of the candidates added to U.
+
+    @param[in]
+    thrs        double
+                Threshold used for the removal of elements from U.
+
+    @param[in,out]
+    UT          magma_z_matrix*
+                Transpose of U before the candidates were added, with sorted
+                rows. Updated to the transpose of U after the removal.
+
+    @param[in,out]
+    ws          magma_z_workspace*
+                Workspace the arrays of UT and the temporary arrays are drawn
+                from. May be NULL.
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_zaux
+*******************************************************************************/
+
+extern "C" magma_int_t
+magma_zparilut_transpose_update(
+    magma_z_matrix U,
+    magma_z_matrix U_cand,
+    double thrs,
+    magma_z_matrix *UT,
+    magma_z_workspace *ws,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+    magma_z_matrix B={Magma_CSR};
+    magma_index_t *pos = NULL, *mcol = NULL;
+    
+    B.num_rows = UT->num_rows;
+    B.num_cols = UT->num_cols;
+    B.storage_type = Magma_CSR;
+    B.memory_location = Magma_CPU;
+    
+    CHECK( magma_zworkspace_malloc( ws, (void**) &B.row, 
+        (B.num_rows+1)*sizeof(magma_index_t), queue ) );
+    CHECK( magma_zworkspace_malloc( ws, (void**) &pos, 
+        (UT->nnz+U_cand.nnz)*sizeof(magma_index_t), queue ) );
+    CHECK( magma_zworkspace_malloc( ws, (void**) &mcol, 
+        (UT->nnz+U_cand.nnz)*sizeof(magma_index_t), queue ) );
+    
+    // merge the rows of UT and the candidates, and look up every element 
+    // (row,col) as (col,row) in U. Removed elements get the position -1.
+    #pragma omp parallel for
+    for( magma_int_t row=0; row<UT->num_rows; row++ ){
+        magma_int_t a = UT->row[ row ];
+        magma_int_t b = U_cand.row[ row ];
+        magma_int_t enda = UT->row[ row+1 ];
+        magma_int_t endb = U_cand.row[ row+1 ];
+        magma_int_t m = a + b;
+        magma_int_t el = 0;
+        while( a < enda || b < endb ){
+            magma_index_t col;
+            if( b == endb || ( a < enda && UT->col[ a ] <= U_cand.col[ b ] ) ){
+                col = UT->col[ a ];
+                if( b < endb && U_cand.col[ b ] == col ){
+                    b++;
+                }
+                a++;
+            } else {
+                col = U_cand.col[ b ];
+                b++;
+            }
+            magma_int_t lo = U.row[ col ];
+            magma_int_t hi = U.row[ col+1 ] - 1;
+            magma_int_t k = -1;
+            while( lo <= hi ){
+                magma_int_t mid = ( lo + hi ) / 2;
+                if( U.col[ mid ] < row ){
+                    lo = mid + 1;
+                } else if( U.col[ mid ] > row ){
+                    hi = mid - 1;
+                } else {
+                    k = mid;
+                    break;
+                }
+            }
+            // same criterion as magma_zparilut_thrsrm, the diagonal is kept
+            if( k > -1 && col != row && MAGMA_Z_ABS( U.val[ k ] ) <= thrs ){
+                k = -1;
+            }
+            if( k > -1 ){
+                el++;
+            }
+            mcol[ m ] = col;
+            pos[ m ] = k;
+            m++;
+        }
+        // slots of elements contained in both UT and the candidates
+        for( ; m < enda + endb; m++ ){
+            pos[ m ] = -1;
+        }
+        B.row[ row+1 ] = el;
+    }
+    
+    // new row pointer
+    B.row[ 0 ] = 0;
+    CHECK( magma_zmatrix_createrowptr( B.num_rows, B.row, queue ) );
+    B.nnz = B.row[ B.num_rows ];
+    
+    CHECK( magma_zworkspace_malloc( ws, (void**) &B.val, 
+        B.nnz*sizeof(magmaDoubleComplex), queue ) );
+    CHECK( magma_zworkspace_malloc( ws, (void**) &B.rowidx, 
+        B.nnz*sizeof(magma_index_t), queue ) );
+    CHECK( magma_zworkspace_malloc( ws, (void**) &B.col, 
+        B.nnz*sizeof(magma_index_t), queue ) );
+    
+    // compact the merged rows
+    #pragma omp parallel for
+    for( magma_int_t row=0; row<UT->num_rows; row++ ){
+        magma_int_t el = B.row[ row ];
+        magma_int_t end = UT->row[ row+1 ] + U_cand.row[ row+1 ];
+        for( magma_int_t m = UT->row[ row ] + U_cand.row[ row ]; m < end; m++ ){
+            if( pos[ m ] > -1 ){
+                B.col[ el ] = mcol[ m ];
+                B.rowidx[ el ] = row;
+                B.val[ el ] = U.val[ pos[ m ] ];
+                el++;
+            }
+        }
+    }
+    
+    // finally, swap the matrices
+    CHECK( magma_zmatrix_swap( &B, UT, queue ) );
+    
+cleanup:
+    magma_zworkspace_free( ws, pos, queue );
+    magma_zworkspace_free( ws, mcol, queue );
+    magma_zworkspace_mfree( ws, &B, queue );
+    return info;
+}
+
+
+
+/***************************************************************************//**
+    Purpose
+    -------
+    This function identifies the candidates like they appear as ILU1 fill-in.
+    In this version, the matrices are assumed unordered,
+    the linked list is traversed to acces the entries of a row.
+
+    Arguments
+    ---------
+
+    @param[in]
+    L0          magma_z_matrix
+                tril( ILU(0) ) pattern of original system matrix.
+                
+    @param[in]
+    U0          magma_z_matrix
+                triu( ILU(0) ) pattern of original system matrix.
+                
+    @param[in]
+    L           magma_z_matrix
+                Current lower triangular factor.
+
+    @param[in]
+    U           magma_z_matrix
+                Current upper triangular factor transposed.
+
+    @param[in]
+    UR          magma_z_matrix
+                Current upper triangular factor - col-pointer and col-list.
+
+
+    @param[in,out]
+    LU_new      magma_z_matrix*
+                List of candidates for L in COO format.
+
+    @param[in,out]
+    LU_new      magma_z_matrix*
+                List of candidates for U in COO format.
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_zaux
+*******************************************************************************/
+
+extern "C" magma_int_t
+magma_zparilut_candidates_semilinked( // new
+    magma_z_matrix L0, // CSR
+    magma_z_matrix U0, // CSC
+    magma_z_matrix L, // CSR 
+    magma_z_matrix U, // CSC
+    magma_z_matrix UT, // CSR
+    magma_z_matrix *L_new, // CSR
+    magma_z_matrix *U_new,  //CSC
     magma_queue_t queue )
 {
     magma_int_t info = 0;
@@ -2957,13 +3458,6 @@ magma_zparilut_candidates(
                     ilu0++;
                 }
             }while( ilut<endilut && ilu0<endilu0 );
-            // do the rest if existing
-            if( ilu0<endilu0 ){
-                do{
-                    numaddrowL++;
-                    ilu0++;
-                }while( ilu0<endilu0 ); 
-            }
             L_new->row[ row+1 ] = L_new->row[ row+1 ]+numaddrowL;
         }
         
@@ -2998,21 +3492,19 @@ magma_zparilut_candidates(
                     ilu0++;
                 }
             }while( ilut<endilut && ilu0<endilu0 );
-            if( ilu0<endilu0 ){
-                do{
-                    numaddrowU++;
-                    ilu0++;
-                }while( ilu0<endilu0 ); 
-            }
             U_new->row[ row+1 ] = U_new->row[ row+1 ]+numaddrowU;
         }
     } // end original
+    printf("originals done\n");
     if( ilufill == 1 ){
         // how to determine candidates:
-        // for each node i, look at any "intermediate" neighbor nodes numbered
-        // less, and then see if this neighbor has another neighbor j numbered
-        // more than the intermediate; if so, fill in is (i,j) if it is not
-        // already nonzero
+        // go over the rows i in L, ignore diagonal
+        // for every element in column k go over row k in U
+        // is stored in CSC, so use the linked list
+        // for every match in column j in U check whether this element already 
+        // exists: i<k -> chick in L, i>j -> check in U
+        // if not, it is a candidate
+        // be aware: candidates for U are generated in CSC format!
         #pragma omp parallel for
         for( magma_index_t row=0; row<L.num_rows; row++){
             magma_int_t numaddrowL = 0, numaddrowU = 0;
@@ -3020,14 +3512,16 @@ magma_zparilut_candidates(
             for( magma_index_t el1=L.row[row]; el1<L.row[row+1]-1; el1++ ){
                 magma_index_t col1 = L.col[ el1 ];
                 // now check the upper triangular
-                // second loop first element over row - only for elements larger the intermediate
-                for( magma_index_t el2 = U.row[ col1 ]+1; el2 < U.row[ col1+1 ]; el2++ ){
-                    magma_index_t col2 = U.col[ el2 ];
+                // the upper triangular is stored in CSC!
+                // use the linked list for access (UT)
+                magma_index_t el2 = UT.row[ col1 ];
+                do{
+                    magma_index_t col2 = UT.rowidx[ el2 ];
                     magma_index_t cand_row = row;
                     magma_index_t cand_col = col2;
                     // check whether this element already exists
                     // first case: part of L
-                    if( cand_col < row ){
+                    if( cand_col < cand_row ){
                         // check whether this element already exists in L
                         magma_int_t exist = 0;
                         if( existing == 0 ){
@@ -3047,10 +3541,11 @@ magma_zparilut_candidates(
                         }
                     } else {
                         // check whether this element already exists in U
+                        // cand_row and cand_col are here flipped as we have U in transposed form (CSC)
                         magma_int_t exist = 0;
                         if( existing == 0 ){
-                            for(magma_index_t k=U.row[cand_row]; k<U.row[cand_row+1]; k++ ){
-                                if( U.col[ k ] == cand_col ){
+                            for(magma_index_t k=U.row[cand_col]; k<U.row[cand_col+1]; k++ ){
+                                if( U.col[ k ] == cand_row ){
                                         exist = 1;
                                         break;
                                 }
@@ -3064,7 +3559,9 @@ magma_zparilut_candidates(
                             //numaddL[ row+1 ]++;
                         }
                     }
-                }
+                    el2 = UT.list[el2]; 
+                    printf("el2:%d\n", el2);
+                }while( el2 > 0 );
     
             }
             U_new->row[ row+1 ] = U_new->row[ row+1 ]+numaddrowU;
@@ -3073,7 +3570,7 @@ magma_zparilut_candidates(
     } // end ilu-fill
     //end = magma_sync_wtime( queue ); printf("llop 1.2 : %.2e\n", end-start);
     // #########################################################################
-
+   printf("first sweep done\n");
     // get the total candidate count
     L_new->nnz = 0;
     U_new->nnz = 0;
@@ -3100,539 +3597,7 @@ magma_zparilut_candidates(
             }
         }
     }
-    magma_zmalloc_cpu( &L_new->val, L_new->nnz );
-    magma_index_malloc_cpu( &L_new->rowidx, L_new->nnz );
-    magma_index_malloc_cpu( &L_new->col, L_new->nnz );
-    
-    magma_zmalloc_cpu( &U_new->val, U_new->nnz );
-    magma_index_malloc_cpu( &U_new->rowidx, U_new->nnz );
-    magma_index_malloc_cpu( &U_new->col, U_new->nnz );
-    
-    #pragma omp parallel for
-    for( magma_int_t i=0; i<L_new->nnz; i++ ){
-        L_new->val[i] = MAGMA_Z_ZERO;
-    }
-    #pragma omp parallel for
-    for( magma_int_t i=0; i<U_new->nnz; i++ ){
-        U_new->val[i] = MAGMA_Z_ZERO;
-    }
-    
-    #pragma omp parallel for
-    for( magma_int_t i=0; i<L_new->nnz; i++ ){
-        L_new->col[i] = -1;
-        L_new->rowidx[i] = -1;
-    }
-    #pragma omp parallel for
-    for( magma_int_t i=0; i<U_new->nnz; i++ ){
-        U_new->col[i] = -1;
-        U_new->rowidx[i] = -1;
-    }
-
-    // #########################################################################
-
-    
-    if( orig == 1 ){
-        
-       #pragma omp parallel for
-        for( magma_index_t row=0; row<L0.num_rows; row++){
-            magma_int_t laddL = 0;
-            magma_int_t offsetL = L_new->row[row];
-            magma_int_t ilu0 = L0.row[row];
-            magma_int_t ilut = L.row[row];
-            magma_int_t endilu0 = L0.row[ row+1 ];
-            magma_int_t endilut = L.row[ row+1 ]; 
-            magma_int_t ilu0col;
-            magma_int_t ilutcol;
-            do{
-                ilu0col = L0.col[ ilu0 ];
-                ilutcol = L.col[ ilut ];
-                if( ilu0col == ilutcol ){
-                    ilu0++;
-                    ilut++;
-                    if( existing==1 ){
-                        L_new->col[ offsetL + laddL ] = ilu0col;
-                        L_new->rowidx[ offsetL + laddL ] = row;
-                        L_new->val[ offsetL + laddL ] = MAGMA_Z_ONE;
-                        laddL++;
-                    }
-                }
-                else if( ilutcol<ilu0col ){
-                    if( existing==1 ){
-                        L_new->col[ offsetL + laddL ] = ilutcol;
-                        L_new->rowidx[ offsetL + laddL ] = row;
-                        L_new->val[ offsetL + laddL ] = MAGMA_Z_ONE;
-                        laddL++;
-                    }
-                    ilut++;
-                }
-                else {
-                    // this element is missing in the current approximation
-                    // mark it as candidate
-                    L_new->col[ offsetL + laddL ] = ilu0col;
-                    L_new->rowidx[ offsetL + laddL ] = row;
-                    L_new->val[ offsetL + laddL ] = MAGMA_Z_ONE + MAGMA_Z_ONE + MAGMA_Z_ONE;
-                    laddL++;
-                    ilu0++;
-                }
-            }while( ilut<endilut && ilu0<endilu0 );
-            if( ilu0<endilu0 ){
-                do{
-                    ilu0col = L0.col[ ilu0 ];
-                    L_new->col[ offsetL + laddL ] = ilu0col;
-                    L_new->rowidx[ offsetL + laddL ] = row;
-                    L_new->val[ offsetL + laddL ] = MAGMA_Z_ONE + MAGMA_Z_ONE + MAGMA_Z_ONE;
-                    laddL++;
-                    ilu0++;
-                }while( ilu0<endilu0 ); 
-            }
-            insertedL[row] = laddL;
-        }
-        
-        // same for U
-       #pragma omp parallel for
-        for( magma_index_t row=0; row<U0.num_rows; row++){
-            magma_int_t laddU = 0;
-            magma_int_t offsetU = U_new->row[row];
-            magma_int_t ilu0 = U0.row[row];
-            magma_int_t ilut = U.row[row];
-            magma_int_t endilu0 = U0.row[ row+1 ];
-            magma_int_t endilut = U.row[ row+1 ]; 
-            magma_int_t ilu0col;
-            magma_int_t ilutcol;
-            do{
-                ilu0col = U0.col[ ilu0 ];
-                ilutcol = U.col[ ilut ];
-                if( ilu0col == ilutcol ){
-                    ilu0++;
-                    ilut++;
-                    if( existing==1 ){
-                        U_new->col[ offsetU + laddU ] = ilu0col;
-                        U_new->rowidx[ offsetU + laddU ] = row;
-                        U_new->val[ offsetU + laddU ] = MAGMA_Z_ONE;
-                        laddU++;
-                    }
-                }
-                else if( ilutcol<ilu0col ){
-                    if( existing==1 ){
-                        U_new->col[ offsetU + laddU ] = ilutcol;
-                        U_new->rowidx[ offsetU + laddU ] = row;
-                        U_new->val[ offsetU + laddU ] = MAGMA_Z_ONE;
-                        laddU++;
-                    }
-                    ilut++;
-                }
-                else {
-                    // this element is missing in the current approximation
-                    // mark it as candidate
-                    U_new->col[ offsetU + laddU ] = ilu0col;
-                    U_new->rowidx[ offsetU + laddU ] = row;
-                    U_new->val[ offsetU + laddU ] = MAGMA_Z_ONE + MAGMA_Z_ONE + MAGMA_Z_ONE;
-                    laddU++;
-                    ilu0++;
-                }
-            }while( ilut<endilut && ilu0<endilu0 );
-            if( ilu0<endilu0 ){
-                do{
-                    ilu0col = U0.col[ ilu0 ];
-                    U_new->col[ offsetU + laddU ] = ilu0col;
-                    U_new->rowidx[ offsetU + laddU ] = row;
-                    U_new->val[ offsetU + laddU ] = MAGMA_Z_ONE + MAGMA_Z_ONE + MAGMA_Z_ONE;
-                    laddU++;
-                    ilu0++;
-                }while( ilu0<endilu0 ); 
-            }
-            insertedU[row] = laddU;
-        }
-    } // end original
-    
-    if( ilufill==1 ){
-        #pragma omp parallel for
-        for( magma_index_t row=0; row<L.num_rows; row++){
-            magma_int_t laddL = 0;
-            magma_int_t laddU = 0;
-            magma_int_t offsetL = L_new->row[row] + insertedL[row];
-            magma_int_t offsetU = U_new->row[row] + insertedU[row];
-            // loop first element over row - only for elements smaller the diagonal
-            for( magma_index_t el1=L.row[row]; el1<L.row[row+1]-1; el1++ ){
-                
-                magma_index_t col1 = L.col[ el1 ];
-                // now check the upper triangular
-                // second loop first element over row - only for elements larger the intermediate
-                for( magma_index_t el2 = U.row[ col1 ]+1; el2 < U.row[ col1+1 ]; el2++ ){
-                    magma_index_t col2 = U.col[ el2 ];
-                    magma_index_t cand_row = row;
-                    magma_index_t cand_col = col2;
-                    //$########### we now have the candidate cand_row cand_col
-                    
-                    
-                    // check whether this element already exists
-                    // first case: part of L
-                    if( cand_col < row ){
-                        magma_int_t exist = 0;
-                        if( existing == 0 ){
-                            for(magma_index_t k=L.row[cand_row]; k<L.row[cand_row+1]; k++ ){
-                                if( L.col[ k ] == cand_col ){
-                                        exist = 1;
-                                        break;
-                                }
-                            }
-                        }
-    #ifdef AVOID_DUPLICATES
-                        for( magma_int_t k=L_new->row[cand_row]; k<L_new->row[cand_row+1]; k++){
-                            if( L_new->col[ k ] == cand_col ){
-                                // element included in LU and nonzero
-                                exist = 1;
-                                break;
-                            }
-                        }
-    #endif
-                        // if it does not exist, increase counter for this location
-                        // use the entry one further down to allow for parallel insertion
-                        if( exist == 0 ){
-                            //  printf("---------------->>>  candidate in L at (%d, %d)\n", cand_row, cand_col);
-                            //add in the next location for this row
-                            // L_new->val[ numaddL[row] + laddL ] =  MAGMA_Z_MAKE(1e-14,0.0);
-                            L_new->rowidx[ offsetL + laddL ] = cand_row;
-                            L_new->col[ offsetL + laddL ] = cand_col;
-                            L_new->val[ offsetL + laddL ] = MAGMA_Z_ONE;
-                            // L_new->list[ numaddL[row] + laddL ] = -1;
-                            // L_new->row[ numaddL[row] + laddL ] = -1;
-                            laddL++;
-                        }
-                    } else {
-                        // check whether this element already exists in U
-                        magma_int_t exist = 0;
-                        if( existing == 0 ){
-                            for(magma_index_t k=U.row[cand_row]; k<U.row[cand_row+1]; k++ ){
-                                if( U.col[ k ] == cand_col ){
-                                        exist = 1;
-                                        break;
-                                }
-                            }
-                        }
-    #ifdef AVOID_DUPLICATES
-                        for( magma_int_t k=U_new->row[cand_row]; k<U_new->row[cand_row+1]; k++){
-                            if( U_new->col[ k ] == cand_col ){
-                                // element included in LU and nonzero
-                                exist = 1;
-                                break;
-                            }
-                        }
-    #endif
-                        // if it does not exist, increase counter for this location
-                        // use the entry one further down to allow for parallel insertion
-                        if( exist == 0 ){
-                            //  printf("---------------->>>  candidate in U at (%d, %d) stored in %d\n", cand_row, cand_col, numaddU[row] + laddU);
-                            //add in the next location for this row
-                            // U_new->val[ numaddU[row] + laddU ] =  MAGMA_Z_MAKE(1e-14,0.0);
-                            U_new->rowidx[ offsetU + laddU ] = cand_row;
-                            U_new->col[ offsetU + laddU ] = cand_col;
-                            U_new->val[ offsetU + laddU ] = MAGMA_Z_ONE;
-                            // U_new->list[ numaddU[row] + laddU ] = -1;
-                            // U_new->row[ numaddU[row] + laddU ] = -1;
-                            laddU++;
-                            //if( cand_row > cand_col )
-                             //   printf("inserted illegal candidate in case 4: (%d,%d) coming from (%d,%d)->(%d,%d)\n", cand_row, cand_col, row, col1, U.col[U.row[ cand_col ]], UR.col[ el2 ]);
-                        }
-                    }
-                }
-            }
-            //insertedU[row] = insertedU[row] + laddU;
-            //insertedL[row] = insertedL[row] + laddL;
-        }
-    } //end ilufill
-    
-#ifdef AVOID_DUPLICATES
-        // #####################################################################
-        
-        CHECK( magma_zparilut_thrsrm( 1, L_new, &thrs, queue ) );
-        CHECK( magma_zparilut_thrsrm( 1, U_new, &thrs, queue ) );
-
-        // #####################################################################
-#endif
-
-cleanup:
-    magma_free_cpu( insertedL );
-    magma_free_cpu( insertedU );
-    return info;
-}
-
-
-
-/***************************************************************************//**
-    Purpose
-    -------
-    This function identifies the candidates like they appear as ILU1 fill-in.
-    In this version, the matrices are assumed unordered,
-    the linked list is traversed to acces the entries of a row.
-
-    Arguments
-    ---------
-
-    @param[in]
-    L0          magma_z_matrix
-                tril( ILU(0) ) pattern of original system matrix.
-                
-    @param[in]
-    U0          magma_z_matrix
-                triu( ILU(0) ) pattern of original system matrix.
-                
-    @param[in]
-    L           magma_z_matrix
-                Current lower triangular factor.
-
-    @param[in]
-    U           magma_z_matrix
-                Current upper triangular factor transposed.
-
-    @param[in]
-    UR          magma_z_matrix
-                Current upper triangular factor - col-pointer and col-list.
-
-
-    @param[in,out]
-    LU_new      magma_z_matrix*
-                List of candidates for L in COO format.
-
-    @param[in,out]
-    LU_new      magma_z_matrix*
-                List of candidates for U in COO format.
-
-    @param[in]
-    queue       magma_queue_t
-                Queue to execute in.
-
-    @ingroup magmasparse_zaux
-*******************************************************************************/
-
-extern "C" magma_int_t
-magma_zparilut_candidates_semilinked( // new
-    magma_z_matrix L0, // CSR
-    magma_z_matrix U0, // CSC
-    magma_z_matrix L, // CSR 
-    magma_z_matrix U, // CSC
-    magma_z_matrix UT, // CSR
-    magma_z_matrix *L_new, // CSR
-    magma_z_matrix *U_new,  //CSC
-    magma_queue_t queue )
-{
-    magma_int_t info = 0;
-    magma_index_t *insertedL;
-    magma_index_t *insertedU;
-    double thrs = 1e-8;
-    
-    magma_int_t orig = 1; // the pattern L0 and U0 is considered
-    magma_int_t existing = 0; // existing elements are also considered
-    magma_int_t ilufill = 1;
-    
-    magma_int_t num_threads;
-    
-#ifdef _OPENMP
-    #pragma omp parallel
-    {
-        num_threads = omp_get_max_threads();
-    }
-#else
-    num_threads = 1;
-#endif
-    
-    // for now: also some part commented out. If it turns out
-    // this being correct, I need to clean up the code.
-
-    CHECK( magma_index_malloc_cpu( &L_new->row, L.num_rows+1 ));
-    CHECK( magma_index_malloc_cpu( &U_new->row, U.num_rows+1 ));
-    CHECK( magma_index_malloc_cpu( &insertedL, L.num_rows+1 ));
-    CHECK( magma_index_malloc_cpu( &insertedU, U.num_rows+1 )); 
-    
-    #pragma omp parallel for
-    for( magma_int_t i=0; i<L.num_rows+1; i++ ){
-        L_new->row[i] = 0;
-        U_new->row[i] = 0;
-        insertedL[i] = 0;
-        insertedU[i] = 0;
-    }
-    L_new->num_rows = L.num_rows;
-    L_new->num_cols = L.num_cols;
-    L_new->storage_type = Magma_CSR;
-    L_new->memory_location = Magma_CPU;
-    
-    U_new->num_rows = L.num_rows;
-    U_new->num_cols = L.num_cols;
-    U_new->storage_type = Magma_CSR;
-    U_new->memory_location = Magma_CPU;
-    
-    // go over the original matrix - this is the only way to allow elements to come back...
-    if( orig == 1 ){
-       #pragma omp parallel for
-        for( magma_index_t row=0; row<L0.num_rows; row++){
-            magma_int_t numaddrowL = 0;
-            magma_int_t ilu0 = L0.row[row];
-            magma_int_t ilut = L.row[row];
-            magma_int_t endilu0 = L0.row[ row+1 ];
-            magma_int_t endilut = L.row[ row+1 ]; 
-            magma_int_t ilu0col;
-            magma_int_t ilutcol;
-            do{
-                ilu0col = L0.col[ ilu0 ];
-                ilutcol = L.col[ ilut ];
-                if( ilu0col == ilutcol ){
-                    ilu0++;
-                    ilut++;
-                    if( existing==1 )
-                        numaddrowL++;
-                }
-                else if( ilutcol<ilu0col ){
-                    ilut++;
-                    if( existing==1 )
-                        numaddrowL++;
-                }
-                else {
-                    // this element is missing in the current approximation
-                    // mark it as candidate
-                    numaddrowL++;
-                    ilu0++;
-                }
-            }while( ilut<endilut && ilu0<endilu0 );
-            L_new->row[ row+1 ] = L_new->row[ row+1 ]+numaddrowL;
-        }
-        
-        // same for U
-       #pragma omp parallel for
-        for( magma_index_t row=0; row<U0.num_rows; row++){
-            magma_int_t numaddrowU = 0;
-            magma_int_t ilu0 = U0.row[row];
-            magma_int_t ilut = U.row[row];
-            magma_int_t endilu0 = U0.row[ row+1 ];
-            magma_int_t endilut = U.row[ row+1 ]; 
-            magma_int_t ilu0col;
-            magma_int_t ilutcol;
-            do{
-                ilu0col = U0.col[ ilu0 ];
-                ilutcol = U.col[ ilut ];
-                if( ilu0col == ilutcol ){
-                    ilu0++;
-                    ilut++;
-                    if( existing==1 )
-                        numaddrowU++;
-                }
-                else if( ilutcol<ilu0col ){
-                    ilut++;
-                    if( existing==1 )
-                        numaddrowU++;
-                }
-                else {
-                    // this element is missing in the current approximation
-                    // mark it as candidate
-                    numaddrowU++;
-                    ilu0++;
-                }
-            }while( ilut<endilut && ilu0<endilu0 );
-            U_new->row[ row+1 ] = U_new->row[ row+1 ]+numaddrowU;
-        }
-    } // end original
-    printf("originals done\n");
-    if( ilufill == 1 ){
-        // how to determine candidates:
-        // go over the rows i in L, ignore diagonal
-        // for every element in column k go over row k in U
-        // is stored in CSC, so use the linked list
-        // for every match in column j in U check whether this element already 
-        // exists: i<k -> chick in L, i>j -> check in U
-        // if not, it is a candidate
-        // be aware: candidates for U are generated in CSC format!
-        #pragma omp parallel for
-        for( magma_index_t row=0; row<L.num_rows; row++){
-            magma_int_t numaddrowL = 0, numaddrowU = 0;
-            // loop first element over row - only for elements smaller the diagonal
-            for( magma_index_t el1=L.row[row]; el1<L.row[row+1]-1; el1++ ){
-                magma_index_t col1 = L.col[ el1 ];
-                // now check the upper triangular
-                // the upper triangular is stored in CSC!
-                // use the linked list for access (UT)
-                magma_index_t el2 = UT.row[ col1 ];
-                do{
-                    magma_index_t col2 = UT.rowidx[ el2 ];
-                    magma_index_t cand_row = row;
-                    magma_index_t cand_col = col2;
-                    // check whether this element already exists
-                    // first case: part of L
-                    if( cand_col < cand_row ){
-                        // check whether this element already exists in L
-                        magma_int_t exist = 0;
-                        if( existing == 0 ){
-                            for(magma_index_t k=L.row[cand_row]; k<L.row[cand_row+1]; k++ ){
-                                if( L.col[ k ] == cand_col ){
-                                        exist = 1;
-                                        break;
-                                }
-                            }
-                        }
-                        // if it does not exist, increase counter for this location
-                        // use the entry one further down to allow for parallel insertion
-                        if( exist == 0 ){
-                            //printf("checked row: %d this element does not yet exist in L: (%d,%d)\n", cand_row, cand_col);
-                            numaddrowL++;
-                            //numaddL[ row+1 ]++;
-                        }
-                    } else {
-                        // check whether this element already exists in U
-                        // cand_row and cand_col are here flipped as we have U in transposed form (CSC)
-                        magma_int_t exist = 0;
-                        if( existing == 0 ){
-                            for(magma_index_t k=U.row[cand_col]; k<U.row[cand_col+1]; k++ ){
-                                if( U.col[ k ] == cand_row ){
-                                        exist = 1;
-                                        break;
-                                }
-                            }
-                        }
-                        // if it does not exist, increase counter for this location
-                        // use the entry one further down to allow for parallel insertion
-                        if( exist == 0 ){
-                            //printf("checked row: %d this element does not yet exist in L: (%d,%d)\n", cand_row, cand_col);
-                            numaddrowU++;
-                            //numaddL[ row+1 ]++;
-                        }
-                    }
-                    el2 = UT.list[el2]; 
-                    printf("el2:%d\n", el2);
-                }while( el2 > 0 );
-    
-            }
-            U_new->row[ row+1 ] = U_new->row[ row+1 ]+numaddrowU;
-            L_new->row[ row+1 ] = L_new->row[ row+1 ]+numaddrowL;
-        }
-    } // end ilu-fill
-    //end = magma_sync_wtime( queue ); printf("llop 1.2 : %.2e\n", end-start);
-    // #########################################################################
-   printf("first sweep done\n");
-    // get the total candidate count
-    L_new->nnz = 0;
-    U_new->nnz = 0;
-    L_new->row[ 0 ] = L_new->nnz;
-    U_new->row[ 0 ] = U_new->nnz;
-
-    #pragma omp parallel
-    {
-#ifdef _OPENMP
-    magma_int_t id = omp_get_thread_num();
-#else
-    magma_int_t id = 0;
-#endif
-        if( id == 0 ){
-            for( magma_int_t i = 0; i<L.num_rows; i++ ){
-                L_new->nnz = L_new->nnz + L_new->row[ i+1 ];
-                L_new->row[ i+1 ] = L_new->nnz;
-            }
-        }
-        if( id == num_threads-1 ){
-            for( magma_int_t i = 0; i<U.num_rows; i++ ){
-                U_new->nnz = U_new->nnz + U_new->row[ i+1 ];
-                U_new->row[ i+1 ] = U_new->nnz;
-            }
-        }
-    }
-    
+    
     magma_zmalloc_cpu( &L_new->val, L_new->nnz );
     magma_index_malloc_cpu( &L_new->rowidx, L_new->nnz );
     magma_index_malloc_cpu( &L_new->col, L_new->nnz );
@@ -3861,8 +3826,8 @@ printf("start second sweep\n");
 #ifdef AVOID_DUPLICATES
         // #####################################################################
         
-        CHECK( magma_zparilut_thrsrm( 1, L_new, &thrs, queue ) );
-        CHECK( magma_zparilut_thrsrm( 1, U_new, &thrs, queue ) );
+        CHECK( magma_zparilut_thrsrm( 1, L_new, &thrs, NULL, queue ) );
+        CHECK( magma_zparilut_thrsrm( 1, U_new, &thrs, NULL, queue ) );
 
         // #####################################################################
 #endif
@@ -4579,22 +4544,14 @@ magma_zparilut_set_thrs_randomselect(
     magma_int_t info = 0;
     
     magma_int_t size =  LU->nnz;
-    const magma_int_t incx = 1;
-    // copy as we may change the elements
-    magmaDoubleComplex *val=NULL;
-    CHECK( magma_zmalloc_cpu( &val, size ));
+    magma_int_t k = ( order == 0 ) ? num_rm : min( size-num_rm, size-1 );
+    magmaDoubleComplex element;
     assert( size > num_rm );
-    blasf77_zcopy(&size, LU->val, &incx, val, &incx );
-    if( order == 0 ){
-        magma_zselectrandom( val, size, num_rm, queue );
-        *thrs = MAGMA_Z_ABS(val[num_rm]);
-    } else {
-         magma_zselectrandom( val, size, size-num_rm, queue );
-        *thrs = MAGMA_Z_ABS(val[size-num_rm]);  
-    }
+    // LU->val is only read, no copy needed
+    CHECK( magma_zmultiselect( LU->val, size, 1, &k, &element, queue ));
+    *thrs = MAGMA_Z_ABS(element);
 
 cleanup:
-    magma_free_cpu( val );
     return info;
 }
 
@@ -4928,6 +4885,8 @@ cleanup:
     Purpose
     -------
     This routine provides the exact threshold for removing num_rm elements.
+    The threshold is selected with magma_zparilut_set_thrs_sampleselect, no
+    copy of the values is sorted.
 
     Arguments
     ---------
@@ -4946,7 +4905,8 @@ cleanup:
 
     @param[out]
     thrs        magmaDoubleComplex*
-                Size of the num_rm-th smallest element.
+                Magnitude of the num_rm-th smallest (order 0) or largest
+                (order 1) element.
 
     @param[in]
     queue       magma_queue_t
@@ -4964,77 +4924,104 @@ magma_zparilut_set_exact_thrs(
     magma_queue_t queue )
 {
     magma_int_t info = 0;
-    magmaDoubleComplex element;
-    magmaDoubleComplex *val=NULL;
-    const magma_int_t incy = 1;
-    const magma_int_t incx = 1;
-    magma_int_t loc_nnz;
-    double ratio;
-    magma_int_t loc_num_rm;
-    magma_int_t num_threads=1;
-    magmaDoubleComplex *elements = NULL;
+    magma_int_t loc_nnz = LU->nnz;
+    double element = 0.0;
 
-#ifdef _OPENMP
-    #pragma omp parallel
-    {
-        num_threads = omp_get_max_threads();
+    if (loc_nnz < 1) {
+        *thrs = MAGMA_Z_ZERO;
+        goto cleanup;
     }
-#else
-    num_threads = 1;
-#endif
-    // two options: either there are enough candidates such that we can use
-    // a parallel first step of order-statistics, or not...
+    num_rm = max( 0, min( num_rm, loc_nnz-1 ));
     
-    ratio = ((double)num_rm)/((double)LU->nnz);
-    loc_num_rm = (int) ((double)ratio*(double)loc_nnz);
-    loc_num_rm = num_rm;
-    CHECK( magma_zmalloc_cpu( &val, loc_nnz ));
-    CHECK( magma_zmalloc_cpu( &elements, num_threads ));
-    
-    blasf77_zcopy(&loc_nnz, LU->val, &incx, val, &incy );
-    // first step: every thread sorts a chunk of the array
-    // extract the num_rm elements in this chunk
-    // this only works if num_rm > loc_nnz / num_threads
-    if( loc_nnz / num_threads > loc_num_rm ){
-        #pragma omp parallel
-        {
-    #ifdef _OPENMP
-    magma_int_t id = omp_get_thread_num();
-#else
-    magma_int_t id = 0;
-#endif
-            if(id<num_threads){
-                magma_zorderstatistics(
-                    val + id*loc_nnz/num_threads, loc_nnz/num_threads, loc_num_rm, order, &elements[id], queue );
-            }
-        }
-        // Now copy the num_rm left-most elements of every chunk to the beginning of the array.
-        for( magma_int_t i=1; i<num_threads; i++){
-            blasf77_zcopy(&loc_num_rm, val+i*loc_nnz/num_threads, &incy, val+i*loc_num_rm, &incy );
-        }
-        // now we only look at the left num_threads*num_rm elements and use order stats
-        magma_zorderstatistics(
-                    val, num_threads*loc_num_rm, loc_num_rm, order, &element, queue );
-    } else {
-        magma_zorderstatistics(
-                    val, loc_nnz, loc_num_rm, order, &element, queue );
-    }
-
-    *thrs = element;
+    // rank num_rm of the increasing (order 0) or decreasing (order 1) order
+    CHECK( magma_zparilut_set_thrs_sampleselect(
+        ( order == 0 ) ? num_rm : loc_nnz-1-num_rm, LU, 0, 0.0, &element,
+        NULL, NULL, queue ));
+    *thrs = MAGMA_Z_MAKE( element, 0.0 );
 
 cleanup:
-    magma_free_cpu( val );
-    magma_free_cpu( elements );
     return info;
 }
 
 
+/***************************************************************************//**
+    Purpose
+    -------
+    This routine computes the threshold for removing num_rm elements via a
+    parallel sample-select on the magnitudes of LU->val, see
+    magma_zbucketselect. LU->val is read in place, no copy of all values
+    is needed.
+
+    For tol > 0, the selection stops as soon as the target bucket holds at
+    most tol*LU->nnz elements, and a bucket bound is returned as threshold,
+    i.e., the number of elements below the threshold differs by at most
+    tol*LU->nnz from the requested one.
+
+    Arguments
+    ---------
+
+    @param[in]
+    num_rm      magma_int_t
+                Number of Elements that are replaced.
+
+    @param[in]
+    LU          magma_z_matrix*
+                Current ILU approximation.
+
+    @param[in]
+    order       magma_int_t
+                Sort goal function: 0 = smallest, 1 = largest.
+
+    @param[in]
+    tol         double
+                Relative rank tolerance, 0.0 gives the exact threshold.
+
+    @param[out]
+    thrs        double*
+                Size of the num_rm-th smallest element.
+
+    @param[out]
+    num_le      magma_int_t*
+                Number of elements with magnitude smaller equal thrs.
+                Can be NULL.
+
+    @param[in,out]
+    ws          magma_z_workspace*
+                Workspace the temporary arrays are drawn from. May be NULL.
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_zaux
+*******************************************************************************/
+
+extern "C" magma_int_t
+magma_zparilut_set_thrs_sampleselect(
+    magma_int_t num_rm,
+    magma_z_matrix *LU,
+    magma_int_t order,
+    double tol,
+    double *thrs,
+    magma_int_t *num_le,
+    magma_z_workspace *ws,
+    magma_queue_t queue )
+{
+    magma_int_t k = ( order == 0 ) ? num_rm : LU->nnz-num_rm;
+
+    return magma_zbucketselect( LU->val, LU->nnz, 1, &k, tol, NULL, thrs,
+        num_le, ws, queue );
+}
+
+
 
 
 /***************************************************************************//**
     Purpose
     -------
-    This routine provides the exact threshold for removing num_rm elements.
+    This routine approximates the threshold for removing num_rm elements by
+    the threshold of a strided sample of about 1024 elements, which is
+    found by a partial selection.
 
     Arguments
     ---------
@@ -5053,7 +5040,8 @@ cleanup:
 
     @param[out]
     thrs        magmaDoubleComplex*
-                Size of the num_rm-th smallest element.
+                Magnitude of the num_rm-th smallest (order 0) or largest
+                (order 1) element.
 
     @param[in]
     queue       magma_queue_t
@@ -5071,43 +5059,32 @@ magma_zparilut_set_approx_thrs_inc(
     magma_queue_t queue )
 {
     magma_int_t info = 0;
-    magmaDoubleComplex element;
-    magmaDoubleComplex *val=NULL;
-    const magma_int_t incy = 1;
-    const magma_int_t incx = (int) (LU->nnz)/(1024);
+    double *val=NULL;
+    const magma_int_t incx = max( 1, (int) (LU->nnz)/(1024) );
     magma_int_t loc_nnz;
-    magma_int_t inc = 100;
-    magma_int_t offset = 10;
     double ratio;
     magma_int_t loc_num_rm = num_rm;
-    // magma_int_t num_threads=1;
-    magmaDoubleComplex *elements = NULL;
-    magma_int_t avg_count = 100;
     loc_nnz = (int) LU->nnz/incx;
     ratio = ((double)num_rm)/((double)LU->nnz);
     loc_num_rm = (int) ((double)ratio*(double)loc_nnz);
     
-    
-    CHECK( magma_zmalloc_cpu( &elements, avg_count ));
-    
-    CHECK( magma_zmalloc_cpu( &val, loc_nnz ));
-    blasf77_zcopy(&loc_nnz, LU->val, &incx, val, &incy );
-    for( magma_int_t i=1; i<avg_count; i++){
-        magma_zorderstatistics_inc(
-                    val + offset*i, loc_nnz - offset*i, loc_num_rm/inc, inc, order, &elements[i], queue );
+    if (loc_nnz < 1) {
+        *thrs = MAGMA_Z_ZERO;
+        goto cleanup;
     }
+    loc_num_rm = max( 0, min( loc_num_rm, loc_nnz-1 ));
+    loc_num_rm = ( order == 0 ) ? loc_num_rm : loc_nnz-1-loc_num_rm;
     
-    
-    element = MAGMA_Z_ZERO;
-    for( int z=0; z < avg_count; z++){
-        element = element+MAGMA_Z_MAKE(MAGMA_Z_ABS(elements[z]), 0.0);
+    // the threshold of the strided sample approximates the threshold of LU
+    CHECK( magma_dmalloc_cpu( &val, loc_nnz ));
+    for (magma_int_t i=0; i < loc_nnz; i++) {
+        val[i] = MAGMA_Z_ABS( LU->val[i*incx] );
     }
-    element = element/MAGMA_Z_MAKE((double)avg_count, 0.0);
+    std::nth_element( val, val + loc_num_rm, val + loc_nnz );
     
-    *thrs = element;
+    *thrs = MAGMA_Z_MAKE( val[loc_num_rm], 0.0 );
 cleanup:
     magma_free_cpu( val );
-    magma_free_cpu( elements );
     return info;
 }
 
@@ -5173,3 +5150,84 @@ magma_zparilut_align_residuals(
     return info;
 }
 
+
+
+
+/***************************************************************************//**
+    Purpose
+    -------
+    Writes the performance report of a ParILUT or ParICT run as a JSON object
+    to the file report.json. The phase timings are zero if the report was
+    collected with report.level = 0.
+
+    Arguments
+    ---------
+
+    @param[in]
+    report      magma_z_parilut_report
+                Performance report filled in by magma_zparilut_cpu or
+                magma_zparict_cpu.
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_zaux
+*******************************************************************************/
+
+extern "C" magma_int_t
+magma_zparilut_report_write(
+    magma_z_parilut_report report,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+    FILE *fp = NULL;
+    
+    fp = fopen( report.json, "w" );
+    if( fp == NULL ){
+        printf("\n%% error writing report: cannot open %s\n", report.json );
+        info = MAGMA_ERR_FILESYSTEM;
+        goto cleanup;
+    }
+    
+    fprintf( fp, "{\n" );
+    fprintf( fp, "  \"num_threads\": %lld,\n", (long long) report.num_threads );
+    fprintf( fp, "  \"iters\": %lld,\n", (long long) report.iters );
+    fprintf( fp, "  \"warm_start\": %lld,\n", (long long) report.warm_start );
+    fprintf( fp, "  \"nnz_A\": %lld,\n", (long long) report.nnz_A );
+    fprintf( fp, "  \"nnz_L\": %lld,\n", (long long) report.nnz_L );
+    fprintf( fp, "  \"nnz_U\": %lld,\n", (long long) report.nnz_U );
+    fprintf( fp, "  \"nnz_max\": %lld,\n", (long long) report.nnz_max );
+    fprintf( fp, "  \"nnz_candidates\": %lld,\n", (long long) report.nnz_candidates );
+    fprintf( fp, "  \"nnz_removed\": %lld,\n", (long long) report.nnz_removed );
+    fprintf( fp, "  \"nnz_swept\": %.0f,\n", (double) report.nnz_swept );
+    // JSON has no representation for NaN and Inf
+    if( magma_z_isnan_inf( MAGMA_Z_MAKE( report.ilu_norm, 0.0 ) ) ){
+        fprintf( fp, "  \"ilu_norm\": null,\n" );
+    } else {
+        fprintf( fp, "  \"ilu_norm\": %.6e,\n", (double) report.ilu_norm );
+    }
+    fprintf( fp, "  \"num_alloc\": %lld,\n", (long long) report.num_alloc );
+    fprintf( fp, "  \"bytes_alloc\": %llu,\n", (unsigned long long) report.bytes_alloc );
+    fprintf( fp, "  \"time\": {\n" );
+    fprintf( fp, "    \"transpose\": %.6e,\n", report.t_transpose );
+    fprintf( fp, "    \"candidates\": %.6e,\n", report.t_candidates );
+    fprintf( fp, "    \"residuals\": %.6e,\n", report.t_residuals );
+    fprintf( fp, "    \"norm\": %.6e,\n", report.t_norm );
+    fprintf( fp, "    \"sort\": %.6e,\n", report.t_sort );
+    fprintf( fp, "    \"transpose_candidates\": %.6e,\n", report.t_transpose_cand );
+    fprintf( fp, "    \"add\": %.6e,\n", report.t_add );
+    fprintf( fp, "    \"sweep1\": %.6e,\n", report.t_sweep1 );
+    fprintf( fp, "    \"select\": %.6e,\n", report.t_select );
+    fprintf( fp, "    \"remove\": %.6e,\n", report.t_remove );
+    fprintf( fp, "    \"sweep2\": %.6e,\n", report.t_sweep2 );
+    fprintf( fp, "    \"total\": %.6e\n", report.t_total );
+    fprintf( fp, "  }\n" );
+    fprintf( fp, "}\n" );
+    
+cleanup:
+    if( fp != NULL ){
+        fclose( fp );
+    }
+    return info;
+}
@@ -12,7 +12,13 @@
 //  in this file, many routines are taken from
 //  the IO functions provided by MatrixMarket
 
+#include <algorithm>
+
 #include "magmasparse_internal.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #define SWAP(a, b)  { tmp = a; a = b; b = tmp; }
 
 
@@ -227,3 +233,470 @@ magma_zselectrandom(
     }
     return info;
 }
+
+
+// number of sampled magnitudes per level of the bucket select
+#define BUCKETSELECT_SAMPLE   4096
+// number of buckets per level; must be a power of two
+#define BUCKETSELECT_BUCKETS  256
+// arrays up to this size are selected from directly
+#define BUCKETSELECT_BASE     8192
+
+
+static bool
+magma_zbucketselect_less(
+    const magmaDoubleComplex &a,
+    const magmaDoubleComplex &b )
+{
+    return MAGMA_Z_ABS(a) < MAGMA_Z_ABS(b);
+}
+
+
+/*
+    Writes the result for the rank in output slot p: the element e, its
+    magnitude, and the number of elements of magnitude smaller equal, which
+    is below plus the le elements of the current level.
+*/
+static inline void
+magma_zbucketselect_set(
+    magma_int_t p,
+    magmaDoubleComplex e,
+    magma_int_t below,
+    magma_int_t le,
+    magmaDoubleComplex *element,
+    double *thrs,
+    magma_int_t *num_le )
+{
+    if (element != NULL) {
+        element[p] = e;
+    }
+    if (thrs != NULL) {
+        thrs[p] = MAGMA_Z_ABS( e );
+    }
+    if (num_le != NULL) {
+        num_le[p] = below + le;
+    }
+}
+
+
+/*
+    Exact selection for small arrays: copies a and places the ranks
+    k[0] <= k[1] <= ... one after the other with nth_element, each on the
+    part of the copy right of the previous rank.
+*/
+static magma_int_t
+magma_zbucketselect_base(
+    const magmaDoubleComplex *a,
+    magma_int_t size,
+    magma_int_t num_k,
+    const magma_int_t *k,
+    const magma_int_t *pos,
+    magma_int_t below,
+    magmaDoubleComplex *element,
+    double *thrs,
+    magma_int_t *num_le,
+    magma_z_workspace *ws,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+    magmaDoubleComplex *val = NULL;
+    magma_int_t first = 0;
+
+    CHECK( magma_zworkspace_malloc( ws, (void**) &val,
+        size*sizeof(magmaDoubleComplex), queue ));
+    for (magma_int_t i=0; i < size; i++) {
+        val[i] = a[i];
+    }
+    for (magma_int_t r=0; r < num_k; r++) {
+        std::nth_element( val + first, val + k[r], val + size,
+                          magma_zbucketselect_less );
+        magma_int_t le = k[r] + 1;
+        if (num_le != NULL) {
+            // the elements left of k[r] are smaller equal
+            double e = MAGMA_Z_ABS( val[ k[r] ] );
+            for (magma_int_t i=k[r]+1; i < size; i++) {
+                le += ( MAGMA_Z_ABS( val[i] ) <= e ) ? 1 : 0;
+            }
+        }
+        magma_zbucketselect_set( pos[r], val[ k[r] ], below, le,
+                                 element, thrs, num_le );
+        first = k[r];
+    }
+
+cleanup:
+    magma_zworkspace_free( ws, val, queue );
+    return info;
+}
+
+
+/*
+    One level of the bucket select: the ranks k[0] <= k[1] <= ... are
+    located in the buckets defined by splitters drawn from a sample of a.
+    The elements of the buckets holding at least one rank are gathered
+    in one parallel pass and processed recursively, all other elements
+    are never touched again. A target bucket of at most tol_size elements
+    is not refined, its bound is returned instead. below is the number
+    of elements of the input smaller than all elements of a.
+*/
+static magma_int_t
+magma_zbucketselect_level(
+    const magmaDoubleComplex *a,
+    magma_int_t size,
+    magma_int_t num_k,
+    const magma_int_t *k,
+    const magma_int_t *pos,
+    double tol_size,
+    magma_int_t below,
+    magmaDoubleComplex *element,
+    double *thrs,
+    magma_int_t *num_le,
+    magma_z_workspace *ws,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+
+    const magma_int_t num_buckets = BUCKETSELECT_BUCKETS;
+    const magma_int_t sample_size = BUCKETSELECT_SAMPLE;
+    magma_int_t num_threads = 1, total = 0;
+    double *sample = NULL, *splitters = NULL;
+    magma_int_t *counts = NULL, *bstart = NULL, *gstart = NULL, *lk = NULL;
+    magmaDoubleComplex *buf = NULL;
+
+    if (size <= BUCKETSELECT_BASE) {
+        return magma_zbucketselect_base( a, size, num_k, k, pos, below,
+            element, thrs, num_le, ws, queue );
+    }
+#ifdef _OPENMP
+    num_threads = omp_get_max_threads();
+#endif
+    CHECK( magma_zworkspace_malloc( ws, (void**) &sample,
+        sample_size*sizeof(double), queue ));
+    CHECK( magma_zworkspace_malloc( ws, (void**) &splitters,
+        num_buckets*sizeof(double), queue ));
+    CHECK( magma_zworkspace_malloc( ws, (void**) &counts,
+        num_threads*num_buckets*sizeof(magma_int_t), queue ));
+    CHECK( magma_zworkspace_malloc( ws, (void**) &bstart,
+        (num_buckets+1)*sizeof(magma_int_t), queue ));
+    CHECK( magma_zworkspace_malloc( ws, (void**) &gstart,
+        (num_buckets+1)*sizeof(magma_int_t), queue ));
+    CHECK( magma_zworkspace_malloc( ws, (void**) &lk,
+        num_k*sizeof(magma_int_t), queue ));
+
+    // splitters[0..num_buckets-2] from a sorted sample, bucket b holds
+    // the magnitudes in (splitters[b-1], splitters[b]]
+    for (magma_int_t i=0; i < sample_size; i++) {
+        magma_int_t j = ( (double) i + 0.5 ) * size / sample_size;
+        sample[i] = MAGMA_Z_ABS( a[j] );
+    }
+    std::sort( sample, sample + sample_size );
+    for (magma_int_t b=0; b < num_buckets-1; b++) {
+        splitters[b] = sample[ (b+1) * (sample_size / num_buckets) ];
+    }
+    splitters[ num_buckets-1 ] = HUGE_VAL;
+
+    #pragma omp parallel num_threads(num_threads)
+    {
+        magma_int_t id = 0, nt = 1;
+#ifdef _OPENMP
+        id = omp_get_thread_num();
+        nt = omp_get_num_threads();
+#endif
+        magma_int_t start = ( size * id ) / nt;
+        magma_int_t end = ( size * (id+1) ) / nt;
+        magma_int_t *lcounts = counts + id * num_buckets;
+        for (magma_int_t b=0; b < num_buckets; b++) {
+            lcounts[b] = 0;
+        }
+        // bucket of v is the number of splitters smaller than v,
+        // found with a branch-free binary search
+        for (magma_int_t i=start; i < end; i++) {
+            double v = MAGMA_Z_ABS( a[i] );
+            magma_int_t b = 0;
+            for (magma_int_t step=num_buckets/2; step > 0; step /= 2) {
+                b += ( splitters[ b+step-1 ] < v ) ? step : 0;
+            }
+            lcounts[b]++;
+        }
+        #pragma omp barrier
+        #pragma omp single
+        {
+            // bucket offsets, and the gather offsets of the target buckets
+            // for every thread in place of its counts
+            magma_int_t r = 0;
+            bstart[0] = 0;
+            gstart[0] = 0;
+            for (magma_int_t b=0; b < num_buckets; b++) {
+                magma_int_t c = 0;
+                for (magma_int_t t=0; t < nt; t++) {
+                    c += counts[ t*num_buckets+b ];
+                }
+                bstart[b+1] = bstart[b] + c;
+                magma_int_t r0 = r;
+                while (r < num_k && k[r] < bstart[b+1]) {
+                    r++;
+                }
+                magma_int_t target = ( r > r0 ) ? 1 : 0;
+                if (target && c <= tol_size) {
+                    // approximate: all elements up to this bucket are
+                    // smaller equal its upper bound, except for the open
+                    // last bucket, where the lower bound is used
+                    for (magma_int_t s=r0; s < r; s++) {
+                        if (b < num_buckets-1 || b == 0) {
+                            magma_zbucketselect_set( pos[s],
+                                MAGMA_Z_MAKE( splitters[b], 0.0 ), below,
+                                bstart[b+1], element, thrs, num_le );
+                        } else {
+                            magma_zbucketselect_set( pos[s],
+                                MAGMA_Z_MAKE( splitters[b-1], 0.0 ), below,
+                                bstart[b], element, thrs, num_le );
+                        }
+                    }
+                    target = 0;
+                }
+                gstart[b+1] = gstart[b] + ( target ? c : 0 );
+                magma_int_t off = gstart[b];
+                for (magma_int_t t=0; t < nt; t++) {
+                    magma_int_t ct = counts[ t*num_buckets+b ];
+                    counts[ t*num_buckets+b ] = target ? off : -1;
+                    off += ct;
+                }
+            }
+            total = gstart[ num_buckets ];
+            if (total > 0 && total < size) {
+                if (magma_zworkspace_malloc( ws, (void**) &buf,
+                        total*sizeof(magmaDoubleComplex), queue )
+                        != MAGMA_SUCCESS) {
+                    info = MAGMA_ERR_HOST_ALLOC;
+                }
+            }
+        }
+        // gather the elements of the target buckets
+        if (info == 0 && total > 0 && total < size) {
+            for (magma_int_t i=start; i < end; i++) {
+                double v = MAGMA_Z_ABS( a[i] );
+                magma_int_t b = 0;
+                for (magma_int_t step=num_buckets/2; step > 0; step /= 2) {
+                    b += ( splitters[ b+step-1 ] < v ) ? step : 0;
+                }
+                if (lcounts[b] >= 0) {
+                    buf[ lcounts[b]++ ] = a[i];
+                }
+            }
+        }
+    }
+    if (info != 0 || total == 0) {
+        goto cleanup;
+    }
+    if (total == size) {
+        // no progress, e.g. all elements of the same magnitude
+        CHECK( magma_zbucketselect_base( a, size, num_k, k, pos, below,
+            element, thrs, num_le, ws, queue ));
+        goto cleanup;
+    }
+
+    // recurse on every target bucket with the ranks relative to it
+    for (magma_int_t b=0, r=0; b < num_buckets && r < num_k; b++) {
+        magma_int_t r0 = r;
+        while (r < num_k && k[r] < bstart[b+1]) {
+            lk[r] = k[r] - bstart[b];
+            r++;
+        }
+        if (r > r0 && gstart[b+1] > gstart[b]) {
+            CHECK( magma_zbucketselect_level( buf + gstart[b],
+                bstart[b+1] - bstart[b], r - r0, lk + r0, pos + r0,
+                tol_size, below + bstart[b], element, thrs, num_le,
+                ws, queue ));
+        }
+    }
+
+cleanup:
+    magma_zworkspace_free( ws, sample, queue );
+    magma_zworkspace_free( ws, splitters, queue );
+    magma_zworkspace_free( ws, counts, queue );
+    magma_zworkspace_free( ws, bstart, queue );
+    magma_zworkspace_free( ws, gstart, queue );
+    magma_zworkspace_free( ws, lk, queue );
+    magma_zworkspace_free( ws, buf, queue );
+    return info;
+}
+
+
+/**
+    Purpose
+    -------
+
+    Bucket select: identifies the k[i]-th smallest elements (by magnitude)
+    of an array for several ranks at once. The array is not modified and
+    not copied. In every level, the magnitudes are counted in 256 buckets
+    defined by splitters taken from a sorted sample, in one parallel pass
+    over the array. Only the elements of the buckets holding a requested
+    rank are gathered and processed further, small buckets are selected
+    from directly.
+
+    For tol > 0, a bucket holding a rank is not refined once it contains
+    at most tol*size elements, and a bucket bound is returned instead of
+    the element, i.e., the number of elements smaller equal the returned
+    magnitude differs by at most tol*size from k[i]+1.
+
+    This is the engine of magma_zmultiselect and of the ParILUT threshold
+    selection magma_zparilut_set_thrs_sampleselect.
+
+    Arguments
+    ---------
+
+    @param[in]
+    a           magmaDoubleComplex*
+                array to select from
+
+    @param[in]
+    size        magma_int_t
+                size of array
+
+    @param[in]
+    num_k       magma_int_t
+                number of ranks
+
+    @param[in]
+    k           magma_int_t*
+                ranks 0 <= k[i] < size, in any order
+
+    @param[in]
+    tol         double
+                relative rank tolerance, 0.0 gives the exact elements
+
+    @param[out]
+    element     magmaDoubleComplex*
+                element[i] is the k[i]-th smallest element, or the bucket
+                bound for an approximate selection. Can be NULL.
+
+    @param[out]
+    thrs        double*
+                thrs[i] is the magnitude of element[i]. Can be NULL.
+
+    @param[out]
+    num_le      magma_int_t*
+                num_le[i] is the number of elements with magnitude smaller
+                equal thrs[i]. Can be NULL.
+
+    @param[in,out]
+    ws          magma_z_workspace*
+                Workspace the temporary arrays are drawn from. May be NULL.
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_zaux
+    ********************************************************************/
+
+extern "C"
+magma_int_t
+magma_zbucketselect(
+    const magmaDoubleComplex *a,
+    magma_int_t size,
+    magma_int_t num_k,
+    const magma_int_t *k,
+    double tol,
+    magmaDoubleComplex *element,
+    double *thrs,
+    magma_int_t *num_le,
+    magma_z_workspace *ws,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+    magma_int_t *sk = NULL, *pos = NULL;
+
+    if (num_k < 1) {
+        return info;
+    }
+    for (magma_int_t r=0; r < num_k; r++) {
+        if (k[r] < 0 || k[r] >= size) {
+            info = MAGMA_ERR_ILLEGAL_VALUE;
+            goto cleanup;
+        }
+    }
+    CHECK( magma_zworkspace_malloc( ws, (void**) &sk,
+        num_k*sizeof(magma_int_t), queue ));
+    CHECK( magma_zworkspace_malloc( ws, (void**) &pos,
+        num_k*sizeof(magma_int_t), queue ));
+    // ranks in increasing order, pos[r] is the output slot of sk[r]
+    for (magma_int_t r=0; r < num_k; r++) {
+        sk[r] = k[r];
+        pos[r] = r;
+    }
+    for (magma_int_t r=1; r < num_k; r++) {
+        magma_int_t tk = sk[r], tp = pos[r], s = r;
+        while (s > 0 && sk[s-1] > tk) {
+            sk[s] = sk[s-1];
+            pos[s] = pos[s-1];
+            s--;
+        }
+        sk[s] = tk;
+        pos[s] = tp;
+    }
+    // a tolerance of less than one element is exact
+    CHECK( magma_zbucketselect_level( a, size, num_k, sk, pos,
+        ( tol*size >= 1.0 ) ? tol*size : -1.0, 0, element, thrs, num_le,
+        ws, queue ));
+
+cleanup:
+    magma_zworkspace_free( ws, sk, queue );
+    magma_zworkspace_free( ws, pos, queue );
+    return info;
+}
+
+
+/**
+    Purpose
+    -------
+
+    Multi-select: identifies the k[i]-th smallest elements (by magnitude)
+    of an array for several ranks at once, using magma_zbucketselect. The
+    array is not modified and not copied. The magnitudes of the selected
+    elements are the same as the ones of a[k[i]] after
+    magma_zselect( a, size, k[i], queue ). For the k-th largest element,
+    request the rank size-1-k.
+
+    Arguments
+    ---------
+
+    @param[in]
+    a           magmaDoubleComplex*
+                array to select from
+
+    @param[in]
+    size        magma_int_t
+                size of array
+
+    @param[in]
+    num_k       magma_int_t
+                number of ranks
+
+    @param[in]
+    k           magma_int_t*
+                ranks 0 <= k[i] < size, in any order
+
+    @param[out]
+    element     magmaDoubleComplex*
+                element[i] is the k[i]-th smallest element
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_zaux
+    ********************************************************************/
+
+extern "C"
+magma_int_t
+magma_zmultiselect(
+    const magmaDoubleComplex *a,
+    magma_int_t size,
+    magma_int_t num_k,
+    const magma_int_t *k,
+    magmaDoubleComplex *element,
+    magma_queue_t queue )
+{
+    return magma_zbucketselect( a, size, num_k, k, 0.0, element, NULL, NULL,
+        NULL, queue );
+}
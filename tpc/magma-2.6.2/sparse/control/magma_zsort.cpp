@@ -23,11 +23,508 @@
 #define UP 0
 #define DOWN 1
 
+// arrays shorter than this are sorted with insertion sort
+#define SORT_INSERTION  16
+// arrays of at least this length are sorted with a radix sort, if the
+// workspace can be allocated
+#define SORT_RADIX      4096
+
+
+/*
+    Helpers for the sorts by magnitude. The entries of col and row are
+    permuted along with x if they are not NULL.
+*/
+static inline void
+magma_zsort_swap(
+    magmaDoubleComplex *x,
+    magma_index_t *col,
+    magma_index_t *row,
+    magma_int_t a,
+    magma_int_t b )
+{
+    magmaDoubleComplex tmp = x[a];
+    x[a] = x[b];
+    x[b] = tmp;
+    if (col != NULL) {
+        magma_index_t tc = col[a];
+        col[a] = col[b];
+        col[b] = tc;
+    }
+    if (row != NULL) {
+        magma_index_t tr = row[a];
+        row[a] = row[b];
+        row[b] = tr;
+    }
+}
+
+
+static void
+magma_zsort_insertion(
+    magmaDoubleComplex *x,
+    magma_index_t *col,
+    magma_index_t *row,
+    magma_int_t first,
+    magma_int_t last )
+{
+    for (magma_int_t i=first+1; i <= last; i++) {
+        for (magma_int_t j=i; j > first
+                && MAGMA_Z_ABS(x[j-1]) > MAGMA_Z_ABS(x[j]); j--) {
+            magma_zsort_swap( x, col, row, j-1, j );
+        }
+    }
+}
+
+
+static void
+magma_zsort_heap(
+    magmaDoubleComplex *x,
+    magma_index_t *col,
+    magma_index_t *row,
+    magma_int_t first,
+    magma_int_t last )
+{
+    magma_int_t n = last - first + 1;
+    // heapify
+    for (magma_int_t s=n/2-1; s >= 0; s--) {
+        magma_int_t r = s;
+        while (2*r+1 < n) {
+            magma_int_t c = 2*r+1;
+            if (c+1 < n && MAGMA_Z_ABS(x[first+c]) < MAGMA_Z_ABS(x[first+c+1])) {
+                c++;
+            }
+            if (MAGMA_Z_ABS(x[first+r]) >= MAGMA_Z_ABS(x[first+c])) {
+                break;
+            }
+            magma_zsort_swap( x, col, row, first+r, first+c );
+            r = c;
+        }
+    }
+    // move the largest element behind the heap and restore the heap
+    for (magma_int_t end=n-1; end > 0; end--) {
+        magma_zsort_swap( x, col, row, first, first+end );
+        magma_int_t r = 0;
+        while (2*r+1 < end) {
+            magma_int_t c = 2*r+1;
+            if (c+1 < end && MAGMA_Z_ABS(x[first+c]) < MAGMA_Z_ABS(x[first+c+1])) {
+                c++;
+            }
+            if (MAGMA_Z_ABS(x[first+r]) >= MAGMA_Z_ABS(x[first+c])) {
+                break;
+            }
+            magma_zsort_swap( x, col, row, first+r, first+c );
+            r = c;
+        }
+    }
+}
+
+
+/*
+    Introsort: quicksort with median-of-three pivot, insertion sort for
+    short ranges and heapsort once the recursion depth exceeds depth.
+    Recurses on the smaller part only.
+*/
+static void
+magma_zsort_intro(
+    magmaDoubleComplex *x,
+    magma_index_t *col,
+    magma_index_t *row,
+    magma_int_t first,
+    magma_int_t last,
+    magma_int_t depth )
+{
+    while (last - first + 1 > SORT_INSERTION) {
+        if (depth == 0) {
+            magma_zsort_heap( x, col, row, first, last );
+            return;
+        }
+        depth--;
+
+        magma_int_t mid = first + (last - first) / 2;
+        if (MAGMA_Z_ABS(x[mid]) < MAGMA_Z_ABS(x[first])) {
+            magma_zsort_swap( x, col, row, mid, first );
+        }
+        if (MAGMA_Z_ABS(x[last]) < MAGMA_Z_ABS(x[first])) {
+            magma_zsort_swap( x, col, row, last, first );
+        }
+        if (MAGMA_Z_ABS(x[last]) < MAGMA_Z_ABS(x[mid])) {
+            magma_zsort_swap( x, col, row, last, mid );
+        }
+        double pivot = MAGMA_Z_ABS(x[mid]);
+
+        magma_int_t i = first, j = last;
+        while (i <= j) {
+            while (MAGMA_Z_ABS(x[i]) < pivot) {
+                i++;
+            }
+            while (MAGMA_Z_ABS(x[j]) > pivot) {
+                j--;
+            }
+            if (i <= j) {
+                magma_zsort_swap( x, col, row, i, j );
+                i++;
+                j--;
+            }
+        }
+        if (j - first < last - i) {
+            magma_zsort_intro( x, col, row, first, j, depth );
+            first = i;
+        } else {
+            magma_zsort_intro( x, col, row, i, last, depth );
+            last = j;
+        }
+    }
+    magma_zsort_insertion( x, col, row, first, last );
+}
+
+
+/*
+    LSD radix sort by magnitude: the bit pattern of a non-negative double
+    orders like the value, hence |x| is sorted as 64-bit key in 8-bit
+    digits. Passes where all keys have the same digit are skipped.
+    Returns MAGMA_ERR_HOST_ALLOC if the workspace cannot be allocated.
+*/
+static magma_int_t
+magma_zsort_radix(
+    magmaDoubleComplex *x,
+    magma_index_t *col,
+    magma_index_t *row,
+    magma_int_t first,
+    magma_int_t last )
+{
+    magma_int_t info = 0;
+    magma_int_t n = last - first + 1;
+
+    unsigned long long *key = NULL, *key2 = NULL;
+    magmaDoubleComplex *x2 = NULL;
+    magma_index_t *col2 = NULL, *row2 = NULL;
+    magma_int_t count[257];
+
+    CHECK( magma_malloc_cpu( (void**) &key, 2 * n * sizeof(unsigned long long) ));
+    CHECK( magma_zmalloc_cpu( &x2, n ));
+    if (col != NULL) {
+        CHECK( magma_index_malloc_cpu( &col2, n ));
+    }
+    if (row != NULL) {
+        CHECK( magma_index_malloc_cpu( &row2, n ));
+    }
+    key2 = key + n;
+    x += first;
+    col = ( col == NULL ) ? NULL : col + first;
+    row = ( row == NULL ) ? NULL : row + first;
+
+    for (magma_int_t i=0; i < n; i++) {
+        double a = MAGMA_Z_ABS(x[i]);
+        // the magnitude of a zero may be -0.0
+        a = ( a == 0.0 ) ? 0.0 : a;
+        // clear the key, a magnitude of less than 64 bits sets only part of it
+        key[i] = 0;
+        memcpy( &key[i], &a, sizeof(double) );
+    }
+
+    {
+        unsigned long long *sk = key, *dk = key2, *tk;
+        magmaDoubleComplex *sx = x, *dx = x2, *tx;
+        magma_index_t *sc = col, *dc = col2, *sr = row, *dr = row2, *ti;
+        for (int shift=0; shift < 64; shift += 8) {
+            for (int d=0; d < 257; d++) {
+                count[d] = 0;
+            }
+            for (magma_int_t i=0; i < n; i++) {
+                count[ ((sk[i] >> shift) & 0xff) + 1 ]++;
+            }
+            if (count[ ((sk[0] >> shift) & 0xff) + 1 ] == n) {
+                continue;   // all keys have the same digit
+            }
+            for (int d=0; d < 256; d++) {
+                count[d+1] += count[d];
+            }
+            for (magma_int_t i=0; i < n; i++) {
+                int d = (sk[i] >> shift) & 0xff;
+                magma_int_t p = count[d]++;
+                dk[p] = sk[i];
+                dx[p] = sx[i];
+                if (sc != NULL) {
+                    dc[p] = sc[i];
+                }
+                if (sr != NULL) {
+                    dr[p] = sr[i];
+                }
+            }
+            tk = sk; sk = dk; dk = tk;
+            tx = sx; sx = dx; dx = tx;
+            ti = sc; sc = dc; dc = ti;
+            ti = sr; sr = dr; dr = ti;
+        }
+        if (sx != x) {
+            memcpy( x, sx, n * sizeof(magmaDoubleComplex) );
+            if (col != NULL) {
+                memcpy( col, sc, n * sizeof(magma_index_t) );
+            }
+            if (row != NULL) {
+                memcpy( row, sr, n * sizeof(magma_index_t) );
+            }
+        }
+    }
+
+cleanup:
+    magma_free_cpu( key );
+    magma_free_cpu( x2 );
+    magma_free_cpu( col2 );
+    magma_free_cpu( row2 );
+    return info;
+}
+
+
+/*
+    Sorts x[first..last] by magnitude, dispatching to the radix sort for
+    long arrays and to introsort otherwise.
+*/
+static void
+magma_zsort_dispatch(
+    magmaDoubleComplex *x,
+    magma_index_t *col,
+    magma_index_t *row,
+    magma_int_t first,
+    magma_int_t last )
+{
+    magma_int_t n = last - first + 1, depth = 0;
+    if (n < 2) {
+        return;
+    }
+    if (n >= SORT_RADIX && magma_zsort_radix( x, col, row, first, last ) == 0) {
+        return;
+    }
+    for (magma_int_t m=n; m > 1; m /= 2) {
+        depth += 2;
+    }
+    magma_zsort_intro( x, col, row, first, last, depth );
+}
+
+
+/*
+    Helpers for the index sorts. The entries of y are permuted along with
+    x if y is not NULL.
+*/
+static inline void
+magma_zindexsort_swap(
+    magma_index_t *x,
+    magmaDoubleComplex *y,
+    magma_int_t a,
+    magma_int_t b )
+{
+    magma_index_t tmp = x[a];
+    x[a] = x[b];
+    x[b] = tmp;
+    if (y != NULL) {
+        magmaDoubleComplex tv = y[a];
+        y[a] = y[b];
+        y[b] = tv;
+    }
+}
+
+
+static void
+magma_zindexsort_heap(
+    magma_index_t *x,
+    magmaDoubleComplex *y,
+    magma_int_t first,
+    magma_int_t last )
+{
+    magma_int_t n = last - first + 1;
+    // heapify
+    for (magma_int_t s=n/2-1; s >= 0; s--) {
+        magma_int_t r = s;
+        while (2*r+1 < n) {
+            magma_int_t c = 2*r+1;
+            if (c+1 < n && x[first+c] < x[first+c+1]) {
+                c++;
+            }
+            if (x[first+r] >= x[first+c]) {
+                break;
+            }
+            magma_zindexsort_swap( x, y, first+r, first+c );
+            r = c;
+        }
+    }
+    // move the largest element behind the heap and restore the heap
+    for (magma_int_t end=n-1; end > 0; end--) {
+        magma_zindexsort_swap( x, y, first, first+end );
+        magma_int_t r = 0;
+        while (2*r+1 < end) {
+            magma_int_t c = 2*r+1;
+            if (c+1 < end && x[first+c] < x[first+c+1]) {
+                c++;
+            }
+            if (x[first+r] >= x[first+c]) {
+                break;
+            }
+            magma_zindexsort_swap( x, y, first+r, first+c );
+            r = c;
+        }
+    }
+}
+
+
+static void
+magma_zindexsort_intro(
+    magma_index_t *x,
+    magmaDoubleComplex *y,
+    magma_int_t first,
+    magma_int_t last,
+    magma_int_t depth )
+{
+    while (last - first + 1 > SORT_INSERTION) {
+        if (depth == 0) {
+            magma_zindexsort_heap( x, y, first, last );
+            return;
+        }
+        depth--;
+
+        magma_int_t mid = first + (last - first) / 2;
+        if (x[mid] < x[first]) {
+            magma_zindexsort_swap( x, y, mid, first );
+        }
+        if (x[last] < x[first]) {
+            magma_zindexsort_swap( x, y, last, first );
+        }
+        if (x[last] < x[mid]) {
+            magma_zindexsort_swap( x, y, last, mid );
+        }
+        magma_index_t pivot = x[mid];
+
+        magma_int_t i = first, j = last;
+        while (i <= j) {
+            while (x[i] < pivot) {
+                i++;
+            }
+            while (x[j] > pivot) {
+                j--;
+            }
+            if (i <= j) {
+                magma_zindexsort_swap( x, y, i, j );
+                i++;
+                j--;
+            }
+        }
+        if (j - first < last - i) {
+            magma_zindexsort_intro( x, y, first, j, depth );
+            first = i;
+        } else {
+            magma_zindexsort_intro( x, y, i, last, depth );
+            last = j;
+        }
+    }
+    for (magma_int_t i=first+1; i <= last; i++) {
+        for (magma_int_t j=i; j > first && x[j-1] > x[j]; j--) {
+            magma_zindexsort_swap( x, y, j-1, j );
+        }
+    }
+}
+
+
+/*
+    LSD radix sort of integer keys on x-min(x), 8-bit digits, only as many
+    passes as the range of the keys requires.
+    Returns MAGMA_ERR_HOST_ALLOC if the workspace cannot be allocated.
+*/
+static magma_int_t
+magma_zindexsort_radix(
+    magma_index_t *x,
+    magmaDoubleComplex *y,
+    magma_int_t first,
+    magma_int_t last )
+{
+    magma_int_t info = 0;
+    magma_int_t n = last - first + 1;
+
+    magma_index_t *x2 = NULL;
+    magmaDoubleComplex *y2 = NULL;
+    magma_index_t xmin, xmax;
+    magma_int_t count[257];
+
+    CHECK( magma_index_malloc_cpu( &x2, n ));
+    if (y != NULL) {
+        CHECK( magma_zmalloc_cpu( &y2, n ));
+    }
+    x += first;
+    y = ( y == NULL ) ? NULL : y + first;
+
+    xmin = x[0];
+    xmax = x[0];
+    for (magma_int_t i=1; i < n; i++) {
+        xmin = ( x[i] < xmin ) ? x[i] : xmin;
+        xmax = ( x[i] > xmax ) ? x[i] : xmax;
+    }
+
+    {
+        unsigned long long range = (unsigned long long) ((long long) xmax - (long long) xmin);
+        magma_index_t *sx = x, *dx = x2, *tx;
+        magmaDoubleComplex *sy = y, *dy = y2, *ty;
+        for (int shift=0; shift < 64 && (range >> shift) > 0; shift += 8) {
+            for (int d=0; d < 257; d++) {
+                count[d] = 0;
+            }
+            for (magma_int_t i=0; i < n; i++) {
+                count[ ((((unsigned long long) ((long long) sx[i] - xmin)) >> shift) & 0xff) + 1 ]++;
+            }
+            for (int d=0; d < 256; d++) {
+                count[d+1] += count[d];
+            }
+            for (magma_int_t i=0; i < n; i++) {
+                int d = (((unsigned long long) ((long long) sx[i] - xmin)) >> shift) & 0xff;
+                magma_int_t p = count[d]++;
+                dx[p] = sx[i];
+                if (sy != NULL) {
+                    dy[p] = sy[i];
+                }
+            }
+            tx = sx; sx = dx; dx = tx;
+            ty = sy; sy = dy; dy = ty;
+        }
+        if (sx != x) {
+            memcpy( x, sx, n * sizeof(magma_index_t) );
+            if (y != NULL) {
+                memcpy( y, sy, n * sizeof(magmaDoubleComplex) );
+            }
+        }
+    }
+
+cleanup:
+    magma_free_cpu( x2 );
+    magma_free_cpu( y2 );
+    return info;
+}
+
+
+static void
+magma_zindexsort_dispatch(
+    magma_index_t *x,
+    magmaDoubleComplex *y,
+    magma_int_t first,
+    magma_int_t last )
+{
+    magma_int_t n = last - first + 1, depth = 0;
+    if (n < 2) {
+        return;
+    }
+    if (n >= SORT_RADIX && magma_zindexsort_radix( x, y, first, last ) == 0) {
+        return;
+    }
+    for (magma_int_t m=n; m > 1; m /= 2) {
+        depth += 2;
+    }
+    magma_zindexsort_intro( x, y, first, last, depth );
+}
+
+
 /**
     Purpose
     -------
 
-    Sorts an array of values in increasing order.
+    Sorts an array of values for increasing magnitude. Uses an LSD radix
+    sort on the magnitude for long arrays, otherwise introsort (quicksort
+    with median-of-three pivot, insertion sort for short ranges and
+    heapsort as fallback for deep recursion).
 
     Arguments
     ---------
@@ -61,33 +558,8 @@ magma_zsort(
 {
     magma_int_t info = 0;
 
-    magmaDoubleComplex temp;
-    magma_index_t pivot,j,i;
-
-    if(first<last){
-         pivot=first;
-         i=first;
-         j=last;
+    magma_zsort_dispatch( x, NULL, NULL, first, last );
 
-        while(i<j){
-            while( MAGMA_Z_ABS(x[i]) <= MAGMA_Z_ABS(x[pivot]) && i<last )
-                i++;
-            while( MAGMA_Z_ABS(x[j]) > MAGMA_Z_ABS(x[pivot]) )
-                j--;
-            if( i<j ){
-                temp = x[i];
-                x[i] = x[j];
-                x[j] = temp;
-            }
-        }
-
-        temp=x[pivot];
-        x[pivot]=x[j];
-        x[j]=temp;
-        CHECK( magma_zsort( x, first, j-1, queue ));
-        CHECK( magma_zsort( x, j+1, last, queue ));
-    }
-cleanup:
     return info;
 }
 
@@ -96,7 +568,8 @@ cleanup:
     Purpose
     -------
 
-    Sorts an array of values in increasing order.
+    Sorts an array of values for increasing magnitude, the entries of col
+    and row are permuted along. Same algorithm as magma_zsort.
 
     Arguments
     ---------
@@ -140,39 +613,8 @@ magma_zmsort(
 {
     magma_int_t info = 0;
 
-    magmaDoubleComplex temp;
-    magma_index_t pivot,j,i, tmpcol, tmprow;
-
-    if(first<last){
-         pivot=first;
-         i=first;
-         j=last;
-
-        while(i<j){
-            while( MAGMA_Z_ABS(x[i]) <= MAGMA_Z_ABS(x[pivot]) && i<last )
-                i++;
-            while( MAGMA_Z_ABS(x[j]) > MAGMA_Z_ABS(x[pivot]) )
-                j--;
-            if( i<j ){
-                temp = x[i];
-                x[i] = x[j];
-                x[j] = temp;
-                tmpcol = col[i];
-                col[i] = col[j];
-                col[j] = tmpcol;
-                tmprow = row[i];
-                row[i] = row[j];
-                row[j] = tmprow;
-            }
-        }
+    magma_zsort_dispatch( x, col, row, first, last );
 
-        temp=x[pivot];
-        x[pivot]=x[j];
-        x[j]=temp;
-        CHECK( magma_zmsort( x, col, row, first, j-1, queue ));
-        CHECK( magma_zmsort( x, col, row, j+1, last, queue ));
-    }
-cleanup:
     return info;
 }
 
@@ -181,7 +623,8 @@ cleanup:
     Purpose
     -------
 
-    Sorts an array of integers in increasing order.
+    Sorts an array of integers in increasing order. Uses an LSD radix sort
+    on x-min(x) for long arrays, otherwise introsort.
 
     Arguments
     ---------
@@ -215,32 +658,8 @@ magma_zindexsort(
 {
     magma_int_t info = 0;
 
-    magma_index_t pivot,j,temp,i;
-
-    if(first<last){
-         pivot=first;
-         i=first;
-         j=last;
+    magma_zindexsort_dispatch( x, NULL, first, last );
 
-        while(i<j){
-            while( x[i]<=x[pivot] && i<last )
-                i++;
-            while( x[j]>x[pivot] )
-                j--;
-            if( i<j ){
-                temp = x[i];
-                x[i] = x[j];
-                x[j] = temp;
-            }
-        }
-
-        temp=x[pivot];
-        x[pivot]=x[j];
-        x[j]=temp;
-        CHECK( magma_zindexsort( x, first, j-1, queue ));
-        CHECK( magma_zindexsort( x, j+1, last, queue ));
-    }
-cleanup:
     return info;
 }
 
@@ -250,6 +669,7 @@ cleanup:
     -------
 
     Sorts an array of integers, updates a respective array of values.
+    Same algorithm as magma_zindexsort.
 
     Arguments
     ---------
@@ -288,40 +708,8 @@ magma_zindexsortval(
 {
     magma_int_t info = 0;
 
-    magma_index_t pivot,j,temp,i;
-    magmaDoubleComplex tempval;
-
-    if(first<last){
-         pivot=first;
-         i=first;
-         j=last;
+    magma_zindexsort_dispatch( x, y, first, last );
 
-        while(i<j){
-            while( x[i]<=x[pivot] && i<last )
-                i++;
-            while( x[j]>x[pivot] )
-                j--;
-            if( i<j ){
-                temp = x[i];
-                x[i] = x[j];
-                x[j] = temp;
-                tempval = y[i];
-                y[i] = y[j];
-                y[j] = tempval;
-            }
-        }
-
-        temp=x[pivot];
-        x[pivot]=x[j];
-        x[j]=temp;
-
-        tempval=y[pivot];
-        y[pivot]=y[j];
-        y[j]=tempval;
-        CHECK( magma_zindexsortval( x, y, first, j-1, queue ));
-        CHECK( magma_zindexsortval( x, y, j+1, last, queue ));
-    }
-cleanup:
     return info;
 }
 
@@ -670,12 +1058,84 @@ cleanup:
 
 
 
-void swap(magmaDoubleComplex *a, magmaDoubleComplex *b)
+// blocks of this length are sorted with a bitonic network, the sorted
+// blocks are then merged; must be a power of two
+#define BITONIC_BLOCK   32
+
+
+/*
+    Sorts the n <= BITONIC_BLOCK elements of x for increasing magnitude,
+    key holds the magnitudes on input and the sorted magnitudes on output.
+    The keys are extended to BITONIC_BLOCK with +inf, so every stage of the
+    network is a fixed-length loop of branch-free compare-exchanges that
+    the compiler vectorizes. Only the keys and a permutation move through
+    the network, the values are permuted once at the end.
+*/
+static void
+magma_zbitonic_block(
+    magma_int_t n,
+    magmaDoubleComplex *x,
+    double *key )
+{
+    double k[ BITONIC_BLOCK ];
+    int p[ BITONIC_BLOCK ];
+    magmaDoubleComplex t[ BITONIC_BLOCK ];
+
+    for (int i=0; i < BITONIC_BLOCK; i++) {
+        k[i] = ( i < n ) ? key[i] : HUGE_VAL;
+        p[i] = i;
+    }
+    for (int size=2; size <= BITONIC_BLOCK; size *= 2) {
+        for (int stride=size/2; stride > 0; stride /= 2) {
+            #pragma omp simd
+            for (int h=0; h < BITONIC_BLOCK/2; h++) {
+                // h-th pair (i, i+stride) of this stage
+                int i = 2*h - (h & (stride-1));
+                int l = i + stride;
+                double a = k[i], b = k[l];
+                int pa = p[i], pb = p[l];
+                bool sw = ( (i & size) == 0 ) ? ( a > b ) : ( a < b );
+                k[i] = sw ? b : a;
+                k[l] = sw ? a : b;
+                p[i] = sw ? pb : pa;
+                p[l] = sw ? pa : pb;
+            }
+        }
+    }
+    for (int i=0; i < n; i++) {
+        t[i] = x[ p[i] ];
+        key[i] = k[i];
+    }
+    for (int i=0; i < n; i++) {
+        x[i] = t[i];
+    }
+}
+
+
+/*
+    Merge path: returns the number of elements taken from a (length na)
+    among the first d elements of the merge of a and b (length nb).
+    Equal keys are taken from a first.
+*/
+static inline magma_int_t
+magma_zbitonic_corank(
+    magma_int_t d,
+    const double *a,
+    magma_int_t na,
+    const double *b,
+    magma_int_t nb )
 {
-    magmaDoubleComplex t;
-    t = *a;
-    *a = *b;
-    *b = t;
+    magma_int_t lo = ( d > nb ) ? d - nb : 0;
+    magma_int_t hi = ( d < na ) ? d : na;
+    while (lo < hi) {
+        magma_int_t i = (lo + hi) / 2;
+        if (a[i] <= b[d-i-1]) {
+            lo = i+1;
+        } else {
+            hi = i;
+        }
+    }
+    return lo;
 }
 
 
@@ -683,8 +1143,17 @@ void swap(magmaDoubleComplex *a, magmaDoubleComplex *b)
     Purpose
     -------
 
-    Approximates the k-th smallest element in an array by
-    using order-statistics with step-size inc.
+    Sorts seq[start..start+length-1] by magnitude. The array is split into
+    blocks of 32 elements which are sorted with a vectorized bitonic
+    network, the sorted blocks are merged in log2(length/32) rounds of
+    pairwise merges. In every merge round, the output is split into equal
+    parts for the threads via merge-path partitioning, so all threads are
+    busy also in the last rounds with few, long merges. Any length is
+    supported.
+
+    The ParILUT thresholds only need one order statistic and use
+    magma_zbucketselect instead of a full sort; this routine is kept as a
+    general host sort by magnitude.
 
     Arguments
     ---------
@@ -699,11 +1168,11 @@ void swap(magmaDoubleComplex *a, magmaDoubleComplex *b)
 
     @param[in,out]
     seq         magmaDoubleComplex*
-                Target array, will be modified during operation.
+                Target array, sorted on output.
 
     @param[in]
     flag        magma_int_t
-                ???
+                0: increasing magnitude, 1: decreasing magnitude.
 
     @param[in]
     queue       magma_queue_t
@@ -721,57 +1190,336 @@ magma_zbitonic_sort(
     magma_int_t flag,
     magma_queue_t queue )
 {
+    magma_int_t info = 0;
 
-    magma_int_t info =0;
+    magmaDoubleComplex *x = seq + start, *x2 = NULL;
+    double *key = NULL, *key2 = NULL;
+    double lkey[ BITONIC_BLOCK ];
+    magma_int_t n = length;
+    magma_int_t num_blocks = magma_ceildiv( n, BITONIC_BLOCK );
 
-    magma_int_t m, i, num_threads=1;
-    magma_int_t split_length;
+    if (n < 2) {
+        return info;
+    }
+    if (n <= BITONIC_BLOCK) {
+        for (magma_int_t i=0; i < n; i++) {
+            lkey[i] = MAGMA_Z_ABS( x[i] );
+        }
+        magma_zbitonic_block( n, x, lkey );
+    } else {
+        CHECK( magma_dmalloc_cpu( &key, 2 * n ));
+        CHECK( magma_zmalloc_cpu( &x2, n ));
+        key2 = key + n;
 
+        #pragma omp parallel
+        {
+            magma_int_t nt = 1, tid = 0;
 #ifdef _OPENMP
-    #pragma omp parallel
-    {
-        num_threads = omp_get_max_threads();
-    }
+            nt = omp_get_num_threads();
+            tid = omp_get_thread_num();
 #endif
+            double *sk = key, *dk = key2, *tk;
+            magmaDoubleComplex *sx = x, *dx = x2, *tx;
+
+            #pragma omp for schedule(static)
+            for (magma_int_t b=0; b < num_blocks; b++) {
+                magma_int_t first = b * BITONIC_BLOCK;
+                magma_int_t len = min( BITONIC_BLOCK, n - first );
+                #pragma omp simd
+                for (magma_int_t i=first; i < first + len; i++) {
+                    key[i] = MAGMA_Z_ABS( x[i] );
+                }
+                magma_zbitonic_block( len, x + first, key + first );
+            }
 
-    m = length/num_threads;
-
+            for (magma_int_t w=BITONIC_BLOCK; w < n; w *= 2) {
+                // this thread writes the output positions [lo, hi)
+                magma_int_t lo = (magma_int_t) ((double) n * tid / nt);
+                magma_int_t hi = (magma_int_t) ((double) n * (tid+1) / nt);
+                for (magma_int_t s=(lo / (2*w)) * (2*w); s < hi; s += 2*w) {
+                    magma_int_t mid = min( s + w, n ), end = min( s + 2*w, n );
+                    magma_int_t na = mid - s, nb = end - mid;
+                    magma_int_t d = max( lo, s ) - s, dend = min( hi, end ) - s;
+                    magma_int_t i = magma_zbitonic_corank( d, sk+s, na, sk+mid, nb );
+                    magma_int_t j = d - i;
+                    for (magma_int_t o=s+d; o < s+dend; o++) {
+                        if (j >= nb || (i < na && sk[s+i] <= sk[mid+j])) {
+                            dk[o] = sk[s+i];
+                            dx[o] = sx[s+i];
+                            i++;
+                        } else {
+                            dk[o] = sk[mid+j];
+                            dx[o] = sx[mid+j];
+                            j++;
+                        }
+                    }
+                }
+                tk = sk; sk = dk; dk = tk;
+                tx = sx; sx = dx; dx = tx;
+                #pragma omp barrier
+            }
 
-    if (length == 1)
-        return 0;
+            if (sx != x) {
+                #pragma omp for schedule(static)
+                for (magma_int_t i=0; i < n; i++) {
+                    x[i] = sx[i];
+                }
+            }
+        }
+    }
 
-    if (length % 2 !=0 )
-    {
-        printf("The length of a (sub)sequence can not be divided by 2.\n");
-        info = MAGMA_ERR;
-        goto cleanup;
+    if (flag == DOWN) {
+        #pragma omp parallel for schedule(static)
+        for (magma_int_t i=0; i < n/2; i++) {
+            magmaDoubleComplex tmp = x[i];
+            x[i] = x[n-1-i];
+            x[n-1-i] = tmp;
+        }
     }
 
-    split_length = length / 2;
+cleanup:
+    magma_free_cpu( key );
+    magma_free_cpu( x2 );
+    return info;
+}
 
-    // bitonic split
-    #pragma omp parallel for shared(seq, flag, start, split_length) private(i)
-    for (i = start; i < start + split_length; i++)
-    {
-        if (flag == UP)
-        {
-            if (MAGMA_Z_ABS(seq[i]) > MAGMA_Z_ABS(seq[i + split_length]))
-                swap(&seq[i], &seq[i + split_length]);
+
+// rows up to this length are sorted with a sorting network
+#define SEGSORT_NETWORK    8
+// rows up to this length are sorted with insertion sort, longer rows
+// with a radix sort
+#define SEGSORT_INSERTION  64
+
+// comparators of the sorting networks for 2 to 8 elements, the network for
+// n elements is segsort_net[ segsort_net_ptr[n] : segsort_net_ptr[n+1] ]
+static const int segsort_net_ptr[ SEGSORT_NETWORK+2 ] =
+    { 0, 0, 0, 1, 4, 9, 18, 30, 46, 65 };
+static const int segsort_net[][2] = {
+    // 2
+    {0,1},
+    // 3
+    {0,2}, {0,1}, {1,2},
+    // 4
+    {0,2}, {1,3}, {0,1}, {2,3}, {1,2},
+    // 5
+    {0,3}, {1,4}, {0,2}, {1,3}, {0,1}, {2,4}, {1,2}, {3,4}, {2,3},
+    // 6
+    {0,5}, {1,3}, {2,4}, {1,2}, {3,4}, {0,3}, {2,5}, {0,1}, {2,3}, {4,5},
+    {1,2}, {3,4},
+    // 7
+    {0,6}, {2,3}, {4,5}, {0,2}, {1,4}, {3,6}, {0,1}, {2,5}, {3,4}, {1,2},
+    {4,6}, {2,3}, {4,5}, {1,2}, {3,4}, {5,6},
+    // 8
+    {0,2}, {1,3}, {4,6}, {5,7}, {0,4}, {1,5}, {2,6}, {3,7}, {0,1}, {2,3},
+    {4,5}, {6,7}, {2,4}, {3,5}, {1,4}, {3,6}, {1,2}, {3,4}, {5,6}
+};
+
+
+/*
+    Sorts one segment of (col, val) pairs of length len by col. tcol and tval
+    are workspace of size len, only used for long segments.
+*/
+static void
+magma_zsegsortval_segment(
+    magma_int_t len,
+    magma_index_t *col,
+    magmaDoubleComplex *val,
+    magma_index_t *tcol,
+    magmaDoubleComplex *tval )
+{
+    magma_index_t cmin, cmax, tc;
+    magmaDoubleComplex tv;
+    magma_int_t sorted = 1;
+
+    if (len < 2) {
+        return;
+    }
+    // rows are often sorted already, e.g. after a conversion
+    cmin = col[0];
+    cmax = col[0];
+    for (magma_int_t i=1; i < len; i++) {
+        sorted = ( col[i] < col[i-1] ) ? 0 : sorted;
+        cmin = ( col[i] < cmin ) ? col[i] : cmin;
+        cmax = ( col[i] > cmax ) ? col[i] : cmax;
+    }
+    if (sorted) {
+        return;
+    }
+
+    if (len <= SEGSORT_NETWORK) {
+        for (int c=segsort_net_ptr[len]; c < segsort_net_ptr[len+1]; c++) {
+            int a = segsort_net[c][0];
+            int b = segsort_net[c][1];
+            if (col[a] > col[b]) {
+                tc = col[a]; col[a] = col[b]; col[b] = tc;
+                tv = val[a]; val[a] = val[b]; val[b] = tv;
+            }
         }
-        else
-        {
-            if (MAGMA_Z_ABS(seq[i]) < MAGMA_Z_ABS(seq[i + split_length]))
-                swap(&seq[i], &seq[i + split_length]);
+    }
+    else if (len <= SEGSORT_INSERTION) {
+        for (magma_int_t i=1; i < len; i++) {
+            tc = col[i];
+            tv = val[i];
+            magma_int_t j = i-1;
+            while (j >= 0 && col[j] > tc) {
+                col[j+1] = col[j];
+                val[j+1] = val[j];
+                j--;
+            }
+            col[j+1] = tc;
+            val[j+1] = tv;
+        }
+    }
+    else {
+        // LSD radix sort on col-cmin, 8 bits per pass, only as many passes
+        // as the column range of the row requires
+        magma_index_t *src_c = col, *dst_c = tcol, *swp_c;
+        magmaDoubleComplex *src_v = val, *dst_v = tval, *swp_v;
+        unsigned int range = (unsigned int) (cmax - cmin);
+        for (int shift=0; shift < 32 && (range >> shift) > 0; shift += 8) {
+            magma_int_t count[257];
+            for (int d=0; d < 257; d++) {
+                count[d] = 0;
+            }
+            for (magma_int_t i=0; i < len; i++) {
+                count[ (((unsigned int) (src_c[i]-cmin) >> shift) & 0xff) + 1 ]++;
+            }
+            for (int d=0; d < 256; d++) {
+                count[d+1] += count[d];
+            }
+            for (magma_int_t i=0; i < len; i++) {
+                int d = ((unsigned int) (src_c[i]-cmin) >> shift) & 0xff;
+                dst_c[ count[d] ] = src_c[i];
+                dst_v[ count[d] ] = src_v[i];
+                count[d]++;
+            }
+            swp_c = src_c; src_c = dst_c; dst_c = swp_c;
+            swp_v = src_v; src_v = dst_v; dst_v = swp_v;
         }
+        if (src_c != col) {
+            for (magma_int_t i=0; i < len; i++) {
+                col[i] = src_c[i];
+                val[i] = src_v[i];
+            }
+        }
+    }
+}
+
+
+/**
+    Purpose
+    -------
+
+    Segmented key-value sort: sorts the (col, val) pairs of every row of a
+    CSR structure for increasing column index. All rows are sorted in one
+    parallel pass; the rows are distributed in chunks of equal nonzero count
+    to balance the load. Rows that are already sorted are skipped, rows of
+    up to 8 elements are sorted with a sorting network, rows up to 64
+    elements with insertion sort and longer rows with a radix sort on the
+    column index.
+
+    Arguments
+    ---------
+
+    @param[in]
+    num_rows    magma_int_t
+                Number of rows. For an empty structure (num_rows = 0 or
+                row = NULL), nothing is done.
+
+    @param[in]
+    row         magma_index_t*
+                Row pointer of size num_rows+1.
+
+    @param[in,out]
+    col         magma_index_t*
+                Column indices, sorted within every row on output.
+
+    @param[in,out]
+    val         magmaDoubleComplex*
+                Values, permuted along with col.
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_zaux
+    ********************************************************************/
+
+extern "C"
+magma_int_t
+magma_zsegsortval(
+    magma_int_t num_rows,
+    magma_index_t *row,
+    magma_index_t *col,
+    magmaDoubleComplex *val,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+
+    magma_index_t *tcol = NULL;
+    magmaDoubleComplex *tval = NULL;
+    magma_int_t maxlen = 0, num_threads = 1, num_chunks;
+    magma_int_t nnz;
+
+    // e.g. a matrix released with magma_zmfree
+    if (num_rows <= 0 || row == NULL) {
+        return info;
+    }
+    nnz = row[num_rows] - row[0];
+
+#ifdef _OPENMP
+    num_threads = omp_get_max_threads();
+#endif
+
+    // workspace for the radix sort of the long rows
+    #pragma omp parallel for reduction(max:maxlen)
+    for (magma_int_t i=0; i < num_rows; i++) {
+        magma_int_t len = row[i+1] - row[i];
+        maxlen = ( len > maxlen ) ? len : maxlen;
+    }
+    if (maxlen > SEGSORT_INSERTION) {
+        CHECK( magma_index_malloc_cpu( &tcol, num_threads * maxlen ));
+        CHECK( magma_zmalloc_cpu( &tval, num_threads * maxlen ));
     }
 
-    if (split_length > m)
+    // chunks of rows with about the same number of nonzeros
+    num_chunks = min( 4 * num_threads, num_rows );
+    #pragma omp parallel
     {
-        // m is the size of sub part-> n/numThreads
-        magma_zbitonic_sort(start, split_length, seq, flag, queue);
-        magma_zbitonic_sort(start + split_length, split_length, seq, flag, queue);
+        magma_int_t tid = 0;
+#ifdef _OPENMP
+        tid = omp_get_thread_num();
+#endif
+        magma_index_t *my_tcol = ( tcol == NULL ) ? NULL : tcol + tid * maxlen;
+        magmaDoubleComplex *my_tval = ( tval == NULL ) ? NULL : tval + tid * maxlen;
+
+        #pragma omp for schedule(dynamic,1)
+        for (magma_int_t c=0; c < num_chunks; c++) {
+            // first row starting at or after the nonzero offset of chunk c
+            magma_index_t target = row[0] + (magma_index_t) ((double) nnz * c / num_chunks);
+            magma_index_t target_end = row[0] + (magma_index_t) ((double) nnz * (c+1) / num_chunks);
+            magma_int_t lo = 0, hi = num_rows, start, end;
+            while (lo < hi) {
+                magma_int_t mid = (lo + hi) / 2;
+                if (row[mid] < target) lo = mid+1; else hi = mid;
+            }
+            start = lo;
+            lo = 0;
+            hi = num_rows;
+            while (lo < hi) {
+                magma_int_t mid = (lo + hi) / 2;
+                if (row[mid] < target_end) lo = mid+1; else hi = mid;
+            }
+            end = ( c == num_chunks-1 ) ? num_rows : lo;
+            for (magma_int_t i=start; i < end; i++) {
+                magma_zsegsortval_segment( row[i+1]-row[i], col+row[i],
+                    val+row[i], my_tcol, my_tval );
+            }
+        }
     }
 
 cleanup:
+    magma_free_cpu( tcol );
+    magma_free_cpu( tval );
     return info;
 }
@@ -93,6 +93,8 @@ magma_zvinit(
     x->ld = num_rows;
     if ( mem_loc == Magma_CPU ) {
         CHECK( magma_zmalloc_cpu( &x->val, x->nnz ));
+        // static schedule: first touch matches the host solver kernels
+        #pragma omp parallel for schedule(static)
         for( magma_int_t i=0; i<x->nnz; i++) {
              x->val[i] = values;
         }
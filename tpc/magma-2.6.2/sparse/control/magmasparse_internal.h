@@ -74,6 +74,47 @@ magma_int_t cusparse2magma_error( cusparseStatus_t status );
     } while(0)
 
 
+/**
+    Column map of the host sparse kernels: maps the column indices of one
+    row to values (e.g., positions) in a hash table with open addressing
+    and linear probing. The table has a power of two size of at least twice
+    the number of keys, so it needs memory in the order of the row length
+    instead of the number of columns. Empty slots hold the key -1.
+
+    magma_colmap_size returns the table size for up to num_keys keys,
+    magma_colmap_clear empties the first size slots, and magma_colmap_slot
+    returns the slot holding col or, if col is not in the table, the empty
+    slot where it is to be inserted.
+    ********************************************************************/
+static inline magma_int_t
+magma_colmap_size( magma_int_t num_keys )
+{
+    magma_int_t size = 2;
+    while ( size < 2*num_keys ) {
+        size *= 2;
+    }
+    return size;
+}
+
+static inline void
+magma_colmap_clear( magma_index_t *key, magma_int_t size )
+{
+    for ( magma_int_t i=0; i < size; i++ ) {
+        key[i] = -1;
+    }
+}
+
+static inline magma_int_t
+magma_colmap_slot( const magma_index_t *key, magma_int_t size, magma_index_t col )
+{
+    magma_int_t slot = ( (unsigned int) col * 2654435761u ) & ( size-1 );
+    while ( key[slot] != col && key[slot] != -1 ) {
+        slot = ( slot + 1 ) & ( size-1 );
+    }
+    return slot;
+}
+
+
 #ifdef __cplusplus
 } // extern C
 #endif
@@ -5,7 +5,7 @@
  Univ. of Colorado, Denver
  @date April 2022
 
- @generated from sparse/include/magmasparse_z.h, normal z -> c, Wed Apr 20 17:38:08 2022
+ @generated from sparse/include/magmasparse_z.h, normal z -> c, Sun Oct 18 22:20:41 2026
  @author Hartwig Anzt
 */
 
@@ -368,6 +368,14 @@ magma_cindexsortval(
     magma_int_t last,
     magma_queue_t queue );
 
+magma_int_t
+magma_csegsortval(
+    magma_int_t num_rows,
+    magma_index_t *row,
+    magma_index_t *col,
+    magmaFloatComplex *val,
+    magma_queue_t queue );
+
 magma_int_t
 magma_corderstatistics(
     magmaFloatComplex *val,
@@ -424,6 +432,28 @@ magma_cselectrandom(
     magma_int_t k,
     magma_queue_t queue );
 
+magma_int_t
+magma_cmultiselect(
+    const magmaFloatComplex *a,
+    magma_int_t size,
+    magma_int_t num_k,
+    const magma_int_t *k,
+    magmaFloatComplex *element,
+    magma_queue_t queue );
+
+magma_int_t
+magma_cbucketselect(
+    const magmaFloatComplex *a,
+    magma_int_t size,
+    magma_int_t num_k,
+    const magma_int_t *k,
+    float tol,
+    magmaFloatComplex *element,
+    float *thrs,
+    magma_int_t *num_le,
+    magma_c_workspace *ws,
+    magma_queue_t queue );
+
 magma_int_t
 magma_cdomainoverlap(
     magma_index_t num_rows,
@@ -582,6 +612,37 @@ magma_crowentries(
     magma_c_matrix *A,
     magma_queue_t queue );
 
+magma_int_t
+magma_crcm(
+    magma_c_matrix A,
+    magma_index_t **perm,
+    magma_index_t **iperm,
+    magma_queue_t queue );
+
+magma_int_t
+magma_cmcolor(
+    magma_c_matrix A,
+    magma_index_t **perm,
+    magma_index_t **iperm,
+    magma_index_t **colorptr,
+    magma_int_t *ncolors,
+    magma_queue_t queue );
+
+magma_int_t
+magma_cmpermute(
+    magma_c_matrix A,
+    magma_c_matrix *B,
+    magma_index_t *perm,
+    magma_index_t *iperm,
+    magma_queue_t queue );
+
+magma_int_t
+magma_cvpermute(
+    magma_c_matrix x,
+    magma_c_matrix *y,
+    magma_index_t *perm,
+    magma_queue_t queue );
+
 magma_int_t
 magma_cmfree(
     magma_c_matrix *A,
@@ -694,6 +755,43 @@ magma_cparilu_cpu(
     magma_c_preconditioner *precond,
     magma_queue_t queue );
 
+magma_int_t
+magma_cilusetup_cpu(
+    magma_c_matrix A,
+    magma_c_preconditioner *precond,
+    magma_queue_t queue );
+
+magma_int_t
+magma_cparilusetup_cpu(
+    magma_c_matrix A,
+    magma_c_preconditioner *precond,
+    magma_queue_t queue );
+
+magma_int_t
+magma_cparilu_block_cpu(
+    magma_c_matrix A,
+    magma_c_matrix b,
+    magma_c_preconditioner *precond,
+    magma_queue_t queue );
+
+magma_int_t
+magma_cparilu_blocksetup_cpu(
+    magma_c_matrix A,
+    magma_c_preconditioner *precond,
+    magma_queue_t queue );
+
+magma_int_t
+magma_cmcilusetup_cpu(
+    magma_c_matrix A,
+    magma_c_preconditioner *precond,
+    magma_queue_t queue );
+
+magma_int_t
+magma_cmcsgssetup_cpu(
+    magma_c_matrix A,
+    magma_c_preconditioner *precond,
+    magma_queue_t queue );
+
 magma_int_t
 magma_cparic_gpu( 
     magma_c_matrix A, 
@@ -825,6 +923,30 @@ magma_cmLdiagadd(
 */
 // #ifdef _OPENMP
 
+magma_int_t
+magma_cworkspace_malloc(
+    magma_c_workspace *ws,
+    void **ptr,
+    size_t size,
+    magma_queue_t queue );
+
+magma_int_t
+magma_cworkspace_free(
+    magma_c_workspace *ws,
+    void *ptr,
+    magma_queue_t queue );
+
+magma_int_t
+magma_cworkspace_mfree(
+    magma_c_workspace *ws,
+    magma_c_matrix *A,
+    magma_queue_t queue );
+
+magma_int_t
+magma_cworkspace_destroy(
+    magma_c_workspace *ws,
+    magma_queue_t queue );
+
 magma_int_t
 magma_cmatrix_tril(
     magma_c_matrix A,
@@ -837,11 +959,22 @@ magma_cmatrix_triu(
     magma_c_matrix *U,
     magma_queue_t queue );
 
+magma_int_t
+magma_cmatrix_split(
+    magma_c_matrix A,
+    magma_c_matrix *L,
+    magma_diagorder_t ldiag,
+    magma_c_matrix *U,
+    magma_diagorder_t udiag,
+    magma_c_matrix *D,
+    magma_queue_t queue );
+
 magma_int_t
 magma_cmatrix_cup(
     magma_c_matrix A,
     magma_c_matrix B,
     magma_c_matrix *U,
+    magma_c_workspace *ws,
     magma_queue_t queue );
 
 magma_int_t
@@ -879,6 +1012,14 @@ magma_cmatrix_triu_negcap(
     magma_c_matrix *U,
     magma_queue_t queue );
 
+magma_int_t
+magma_cfirsttouch_cpu(
+    magma_int_t nnz,
+    magmaFloatComplex *val,
+    magma_index_t *col,
+    magma_index_t *rowidx,
+    magma_queue_t queue );
+
 magma_int_t
 magma_cmatrix_addrowindex(
     magma_c_matrix *A,
@@ -895,6 +1036,7 @@ magma_cparilut_thrsrm(
     magma_int_t order,
     magma_c_matrix *A,
     float *thrs,
+    magma_c_workspace *ws,
     magma_queue_t queue );
 
 magma_int_t
@@ -959,6 +1101,7 @@ magma_int_t
 magma_ccsrcoo_transpose(
     magma_c_matrix A,
     magma_c_matrix *B,
+    magma_c_workspace *ws,
     magma_queue_t queue );
 
 magma_int_t
@@ -1015,6 +1158,17 @@ magma_cparilut_set_thrs_randomselect_approx(
     float *thrs,
     magma_queue_t queue );
 
+magma_int_t
+magma_cparilut_set_thrs_sampleselect(
+    magma_int_t num_rm,
+    magma_c_matrix *LU,
+    magma_int_t order,
+    float tol,
+    float *thrs,
+    magma_int_t *num_le,
+    magma_c_workspace *ws,
+    magma_queue_t queue );
+
 magma_int_t
 magma_cparilut_set_thrs_randomselect_factors(
     magma_int_t num_rm,
@@ -1079,6 +1233,18 @@ magma_cparilu_sweep_sync(
     magma_c_matrix *U,
     magma_queue_t queue );
 
+magma_int_t
+magma_cparilu_sweep_adaptive(
+    magma_c_matrix A,
+    magma_c_matrix *L,
+    magma_c_matrix *U,
+    float tol,
+    magma_index_t *active,
+    magma_index_t *changed,
+    magma_int_t *num_active,
+    magma_int_t *nnz_active,
+    magma_queue_t queue );
+
 magma_int_t
 magma_cparic_sweep(
     magma_c_matrix A,
@@ -1095,6 +1261,7 @@ magma_int_t
 magma_cparict_sweep_sync(
     magma_c_matrix *A,
     magma_c_matrix *L,
+    magma_c_workspace *ws,
     magma_queue_t queue );
 
 magma_int_t
@@ -1104,6 +1271,25 @@ magma_cparilut_sweep_sync(
     magma_c_matrix *U,
     magma_queue_t queue );
 
+magma_int_t
+magma_cparilut_amap(
+    magma_c_matrix A,
+    magma_c_matrix F,
+    magma_index_t **amap,
+    magma_c_workspace *ws,
+    magma_queue_t queue );
+
+magma_int_t
+magma_cparilut_sweep_sync_map(
+    magma_c_matrix *A,
+    magma_c_matrix *AT,
+    magma_c_matrix *L,
+    magma_c_matrix *U,
+    magma_index_t *Lmap,
+    magma_index_t *Umap,
+    magma_c_workspace *ws,
+    magma_queue_t queue );
+
 magma_int_t
 magma_cparilut_sweep_gpu( 
     magma_c_matrix *A,
@@ -1178,6 +1364,15 @@ magma_cparilut_residuals(
     magma_c_matrix *L_new,
     magma_queue_t queue );
 
+magma_int_t
+magma_cparilut_residuals_map(
+    magma_c_matrix A,
+    magma_c_matrix L,
+    magma_c_matrix U,
+    magma_index_t *Rmap,
+    magma_c_matrix *R,
+    magma_queue_t queue );
+
 magma_int_t
 magma_cparilut_residuals_transpose(
     magma_c_matrix A,
@@ -1271,6 +1466,13 @@ magma_cparilut_cpu(
     magma_c_preconditioner *precond,
     magma_queue_t queue );
 
+magma_int_t
+magma_cparilut_warmstart_cpu(
+    magma_c_matrix A,
+    magma_c_matrix b,
+    magma_c_preconditioner *precond,
+    magma_queue_t queue );
+
 magma_int_t
 magma_cparilut_gpu(
     magma_c_matrix A,
@@ -1312,6 +1514,21 @@ magma_cparilut_candidates(
     magma_c_matrix U,
     magma_c_matrix *L_new,
     magma_c_matrix *U_new,
+    magma_c_workspace *ws,
+    magma_queue_t queue );
+
+magma_int_t
+magma_cparilut_report_write(
+    magma_c_parilut_report report,
+    magma_queue_t queue );
+
+magma_int_t
+magma_cparilut_transpose_update(
+    magma_c_matrix U,
+    magma_c_matrix U_cand,
+    float thrs,
+    magma_c_matrix *UT,
+    magma_c_workspace *ws,
     magma_queue_t queue );
 
 magma_int_t
@@ -1330,6 +1547,7 @@ magma_cparict_candidates(
     magma_c_matrix L,
     magma_c_matrix LT,
     magma_c_matrix *L_new,
+    magma_c_workspace *ws,
     magma_queue_t queue );
 
 magma_int_t
@@ -1393,6 +1611,7 @@ magma_cparilut_preselect(
     magma_int_t order,
     magma_c_matrix *A,
     magma_c_matrix *oneA,
+    magma_c_workspace *ws,
     magma_queue_t queue );
 
 magma_int_t
@@ -1484,6 +1703,38 @@ magma_cmbackinsert_batched(
     magmaFloatComplex *rhs,    
     magma_queue_t queue );
 
+magma_int_t
+magma_cmprepare_vbatched(
+    magma_uplo_t uplotype,
+    magma_trans_t transtype,
+    magma_diag_t diagtype,
+    magma_c_matrix L,
+    magma_c_matrix LC,
+    size_t **sysptr,
+    magmaFloatComplex **trisystems,
+    magmaFloatComplex **rhs,
+    magma_queue_t queue );
+
+magma_int_t
+magma_cmtrisolve_vbatched(
+    magma_uplo_t uplotype,
+    magma_trans_t transtype,
+    magma_diag_t diagtype,
+    magma_c_matrix LC,
+    size_t *sysptr,
+    magmaFloatComplex *trisystems,
+    magmaFloatComplex *rhs,
+    magma_queue_t queue );
+
+magma_int_t
+magma_cmbackinsert_vbatched(
+    magma_uplo_t uplotype,
+    magma_trans_t transtype,
+    magma_diag_t diagtype,
+    magma_c_matrix *M,
+    magmaFloatComplex *rhs,
+    magma_queue_t queue );
+
 magma_int_t
 magma_cmprepare_batched_gpu(
     magma_uplo_t uplotype,
@@ -1536,6 +1787,20 @@ magma_ciluisaisetup_upper(
     magma_c_matrix *ISAIU,
     magma_queue_t queue );
 
+magma_int_t
+magma_ciluisaisetup_lower_cpu(
+    magma_c_matrix L,
+    magma_c_matrix S,
+    magma_c_matrix *ISAIL,
+    magma_queue_t queue );
+
+magma_int_t
+magma_ciluisaisetup_upper_cpu(
+    magma_c_matrix U,
+    magma_c_matrix S,
+    magma_c_matrix *ISAIU,
+    magma_queue_t queue );
+
 magma_int_t
 magma_cicisaisetup(
     magma_c_matrix A,
@@ -1557,6 +1822,20 @@ magma_cisai_r(
     magma_c_preconditioner *precond,
     magma_queue_t queue );
 
+magma_int_t
+magma_cisai_l_cpu(
+    magma_c_matrix b,
+    magma_c_matrix *x,
+    magma_c_preconditioner *precond,
+    magma_queue_t queue );
+
+magma_int_t
+magma_cisai_r_cpu(
+    magma_c_matrix b,
+    magma_c_matrix *x,
+    magma_c_preconditioner *precond,
+    magma_queue_t queue );
+
 magma_int_t
 magma_cisai_l_t(
     magma_c_matrix b,
@@ -1593,6 +1872,15 @@ magma_cisai_generator_regs(
     magma_c_matrix *M,
     magma_queue_t queue );
 
+magma_int_t
+magma_cisai_generator_cpu(
+    magma_uplo_t uplotype,
+    magma_trans_t transtype,
+    magma_diag_t diagtype,
+    magma_c_matrix L,
+    magma_c_matrix *M,
+    magma_queue_t queue );
+
 magma_int_t
 magma_ccsr_sort(
     magma_c_matrix *A,
@@ -1634,6 +1922,64 @@ magma_cmvarsizeblockstruct(
  -- MAGMA_SPARSE function definitions / Data on CPU / Multi-GPU
 */
 
+/* ////////////////////////////////////////////////////////////////////////////
+ -- MAGMA_SPARSE iterative solvers (Data on CPU)
+*/
+
+magma_int_t
+magma_cpcg_cpu(
+    magma_c_matrix A, magma_c_matrix b, 
+    magma_c_matrix *x, magma_c_solver_par *solver_par, 
+    magma_c_preconditioner *precond_par,
+    magma_queue_t queue );
+
+magma_int_t
+magma_cpbicgstab_cpu(
+    magma_c_matrix A, magma_c_matrix b, 
+    magma_c_matrix *x, magma_c_solver_par *solver_par, 
+    magma_c_preconditioner *precond_par,
+    magma_queue_t queue );
+
+magma_int_t
+magma_cfgmres_cpu(
+    magma_c_matrix A, magma_c_matrix b, 
+    magma_c_matrix *x, magma_c_solver_par *solver_par, 
+    magma_c_preconditioner *precond_par,
+    magma_queue_t queue );
+
+magma_int_t
+magma_cpidr_cpu(
+    magma_c_matrix A, magma_c_matrix b,
+    magma_c_matrix *x, magma_c_solver_par *solver_par,
+    magma_c_preconditioner *precond_par,
+    magma_queue_t queue );
+
+magma_int_t
+magma_cpcg_merge_cpu(
+    magma_c_matrix A, magma_c_matrix b,
+    magma_c_matrix *x, magma_c_solver_par *solver_par,
+    magma_c_preconditioner *precond_par,
+    magma_queue_t queue );
+
+magma_int_t
+magma_cbicgstab_merge_cpu(
+    magma_c_matrix A, magma_c_matrix b,
+    magma_c_matrix *x, magma_c_solver_par *solver_par,
+    magma_queue_t queue );
+
+magma_int_t
+magma_cpipecg_cpu(
+    magma_c_matrix A, magma_c_matrix b,
+    magma_c_matrix *x, magma_c_solver_par *solver_par,
+    magma_c_preconditioner *precond_par,
+    magma_queue_t queue );
+
+magma_int_t
+magma_csstepcg_cpu(
+    magma_c_matrix A, magma_c_matrix b,
+    magma_c_matrix *x, magma_c_solver_par *solver_par,
+    magma_queue_t queue );
+
 /* ////////////////////////////////////////////////////////////////////////////
  -- MAGMA_SPARSE iterative solvers (Data on GPU)
 */
@@ -2368,6 +2714,27 @@ magma_c_applyprecond_right(
     magma_c_matrix *x, magma_c_preconditioner *precond,
     magma_queue_t queue );
 
+magma_int_t
+magma_c_precondsetup_cpu(
+    magma_c_matrix A, magma_c_matrix b, 
+    magma_c_solver_par *solver,
+    magma_c_preconditioner *precond,
+    magma_queue_t queue );
+
+magma_int_t
+magma_c_applyprecond_left_cpu(
+    magma_trans_t trans,
+    magma_c_matrix A, magma_c_matrix b, 
+    magma_c_matrix *x, magma_c_preconditioner *precond,
+    magma_queue_t queue );
+
+magma_int_t
+magma_c_applyprecond_right_cpu(
+    magma_trans_t trans,
+    magma_c_matrix A, magma_c_matrix b, 
+    magma_c_matrix *x, magma_c_preconditioner *precond,
+    magma_queue_t queue );
+
 magma_int_t
 magma_c_initP2P(
     magma_int_t *bandwidth_benchmark,
@@ -2461,6 +2828,191 @@ magma_cgecsrmv(
     magmaFloatComplex_ptr dy,
     magma_queue_t queue );
 
+magma_int_t 
+magma_cgecsrmv_cpu(
+    magma_trans_t transA,
+    magma_int_t m, magma_int_t n,
+    magmaFloatComplex alpha,
+    magmaFloatComplex *val,
+    magma_index_t *rowptr,
+    magma_index_t *colind,
+    magmaFloatComplex *x,
+    magmaFloatComplex beta,
+    magmaFloatComplex *y,
+    magma_queue_t queue );
+
+magma_int_t
+magma_ccsrtrsv_cpu(
+    magma_uplo_t uplo,
+    magma_c_matrix A,
+    magmaFloatComplex *b,
+    magmaFloatComplex *x,
+    magma_queue_t queue );
+
+magma_int_t
+magma_ccsrtrsv_mc_cpu(
+    magma_uplo_t uplo,
+    magma_c_matrix A,
+    magma_int_t ncolors,
+    magma_index_t *colorptr,
+    magmaFloatComplex *b,
+    magmaFloatComplex *x,
+    magma_queue_t queue );
+
+magma_int_t
+magma_cspgemm_symbolic_cpu(
+    magma_c_matrix A,
+    magma_c_matrix B,
+    magma_c_matrix *C,
+    magma_queue_t queue );
+
+magma_int_t
+magma_cspgemm_numeric_cpu(
+    magmaFloatComplex alpha,
+    magma_c_matrix A,
+    magma_c_matrix B,
+    magma_c_matrix *C,
+    magma_queue_t queue );
+
+magma_int_t
+magma_cspgemm_cpu(
+    magmaFloatComplex alpha,
+    magma_c_matrix A,
+    magma_c_matrix B,
+    magma_c_matrix *C,
+    magma_queue_t queue );
+
+magma_int_t
+magma_cspgemm_masked_cpu(
+    magmaFloatComplex alpha,
+    magma_c_matrix A,
+    magma_c_matrix B,
+    magma_c_matrix M,
+    magma_c_matrix *C,
+    magma_queue_t queue );
+
+magmaFloatComplex
+magma_cdotc_cpu(
+    magma_int_t n,
+    const magmaFloatComplex *x, magma_int_t incx,
+    const magmaFloatComplex *y, magma_int_t incy,
+    magma_queue_t queue );
+
+float
+magma_scnrm2_cpu(
+    magma_int_t n,
+    const magmaFloatComplex *x, magma_int_t incx,
+    magma_queue_t queue );
+
+void
+magma_caxpy_cpu(
+    magma_int_t n,
+    magmaFloatComplex alpha,
+    const magmaFloatComplex *x, magma_int_t incx,
+    magmaFloatComplex *y, magma_int_t incy,
+    magma_queue_t queue );
+
+void
+magma_cscal_cpu(
+    magma_int_t n,
+    magmaFloatComplex alpha,
+    magmaFloatComplex *x, magma_int_t incx,
+    magma_queue_t queue );
+
+void
+magma_ccopy_cpu(
+    magma_int_t n,
+    const magmaFloatComplex *x, magma_int_t incx,
+    magmaFloatComplex *y, magma_int_t incy,
+    magma_queue_t queue );
+
+magma_int_t
+magma_ccgmerge_spmv1_cpu(
+    magma_c_matrix A,
+    magmaFloatComplex *d,
+    magmaFloatComplex *z,
+    magmaFloatComplex *den,
+    magma_queue_t queue );
+
+magma_int_t
+magma_ccgmerge_xr_cpu(
+    magma_int_t n,
+    magmaFloatComplex alpha,
+    magmaFloatComplex *d,
+    magmaFloatComplex *z,
+    magmaFloatComplex *x,
+    magmaFloatComplex *r,
+    float *nrm2,
+    magma_queue_t queue );
+
+magma_int_t
+magma_ccgmerge_d_cpu(
+    magma_int_t n,
+    magmaFloatComplex beta,
+    magmaFloatComplex *h,
+    magmaFloatComplex *d,
+    magma_queue_t queue );
+
+magma_int_t
+magma_ccgmerge_rh_cpu(
+    magma_int_t n,
+    magmaFloatComplex *r,
+    magmaFloatComplex *h,
+    magmaFloatComplex *rh,
+    magma_queue_t queue );
+
+magma_int_t
+magma_cbicgmerge1_cpu(
+    magma_int_t n,
+    magmaFloatComplex beta,
+    magmaFloatComplex omega,
+    magmaFloatComplex *r,
+    magmaFloatComplex *v,
+    magmaFloatComplex *p,
+    magma_queue_t queue );
+
+magma_int_t
+magma_cbicgmerge_spmv1_cpu(
+    magma_c_matrix A,
+    magmaFloatComplex *rr,
+    magmaFloatComplex *p,
+    magmaFloatComplex *v,
+    magmaFloatComplex *rrv,
+    magma_queue_t queue );
+
+magma_int_t
+magma_cbicgmerge2_cpu(
+    magma_int_t n,
+    magmaFloatComplex alpha,
+    magmaFloatComplex *r,
+    magmaFloatComplex *v,
+    magmaFloatComplex *s,
+    magma_queue_t queue );
+
+magma_int_t
+magma_cbicgmerge_spmv2_cpu(
+    magma_c_matrix A,
+    magmaFloatComplex *s,
+    magmaFloatComplex *t,
+    magmaFloatComplex *ts,
+    float *tt,
+    magma_queue_t queue );
+
+magma_int_t
+magma_cbicgmerge_xrbeta_cpu(
+    magma_int_t n,
+    magmaFloatComplex alpha,
+    magmaFloatComplex omega,
+    magmaFloatComplex *rr,
+    magmaFloatComplex *p,
+    magmaFloatComplex *s,
+    magmaFloatComplex *t,
+    magmaFloatComplex *x,
+    magmaFloatComplex *r,
+    magmaFloatComplex *rho,
+    float *nrm2,
+    magma_queue_t queue );
+
 magma_int_t 
 magma_cgecsrmv_shift(
     magma_trans_t transA,
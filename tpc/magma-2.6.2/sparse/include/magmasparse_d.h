@@ -5,7 +5,7 @@
  Univ. of Colorado, Denver
  @date April 2022
 
- @generated from sparse/include/magmasparse_z.h, normal z -> d, Wed Apr 20 17:38:08 2022
+ @generated from sparse/include/magmasparse_z.h, normal z -> d, Sun Oct 18 22:20:41 2026
  @author Hartwig Anzt
 */
 
@@ -368,6 +368,14 @@ magma_dindexsortval(
     magma_int_t last,
     magma_queue_t queue );
 
+magma_int_t
+magma_dsegsortval(
+    magma_int_t num_rows,
+    magma_index_t *row,
+    magma_index_t *col,
+    double *val,
+    magma_queue_t queue );
+
 magma_int_t
 magma_dorderstatistics(
     double *val,
@@ -424,6 +432,28 @@ magma_dselectrandom(
     magma_int_t k,
     magma_queue_t queue );
 
+magma_int_t
+magma_dmultiselect(
+    const double *a,
+    magma_int_t size,
+    magma_int_t num_k,
+    const magma_int_t *k,
+    double *element,
+    magma_queue_t queue );
+
+magma_int_t
+magma_dbucketselect(
+    const double *a,
+    magma_int_t size,
+    magma_int_t num_k,
+    const magma_int_t *k,
+    double tol,
+    double *element,
+    double *thrs,
+    magma_int_t *num_le,
+    magma_d_workspace *ws,
+    magma_queue_t queue );
+
 magma_int_t
 magma_ddomainoverlap(
     magma_index_t num_rows,
@@ -582,6 +612,37 @@ magma_drowentries(
     magma_d_matrix *A,
     magma_queue_t queue );
 
+magma_int_t
+magma_drcm(
+    magma_d_matrix A,
+    magma_index_t **perm,
+    magma_index_t **iperm,
+    magma_queue_t queue );
+
+magma_int_t
+magma_dmcolor(
+    magma_d_matrix A,
+    magma_index_t **perm,
+    magma_index_t **iperm,
+    magma_index_t **colorptr,
+    magma_int_t *ncolors,
+    magma_queue_t queue );
+
+magma_int_t
+magma_dmpermute(
+    magma_d_matrix A,
+    magma_d_matrix *B,
+    magma_index_t *perm,
+    magma_index_t *iperm,
+    magma_queue_t queue );
+
+magma_int_t
+magma_dvpermute(
+    magma_d_matrix x,
+    magma_d_matrix *y,
+    magma_index_t *perm,
+    magma_queue_t queue );
+
 magma_int_t
 magma_dmfree(
     magma_d_matrix *A,
@@ -694,6 +755,43 @@ magma_dparilu_cpu(
     magma_d_preconditioner *precond,
     magma_queue_t queue );
 
+magma_int_t
+magma_dilusetup_cpu(
+    magma_d_matrix A,
+    magma_d_preconditioner *precond,
+    magma_queue_t queue );
+
+magma_int_t
+magma_dparilusetup_cpu(
+    magma_d_matrix A,
+    magma_d_preconditioner *precond,
+    magma_queue_t queue );
+
+magma_int_t
+magma_dparilu_block_cpu(
+    magma_d_matrix A,
+    magma_d_matrix b,
+    magma_d_preconditioner *precond,
+    magma_queue_t queue );
+
+magma_int_t
+magma_dparilu_blocksetup_cpu(
+    magma_d_matrix A,
+    magma_d_preconditioner *precond,
+    magma_queue_t queue );
+
+magma_int_t
+magma_dmcilusetup_cpu(
+    magma_d_matrix A,
+    magma_d_preconditioner *precond,
+    magma_queue_t queue );
+
+magma_int_t
+magma_dmcsgssetup_cpu(
+    magma_d_matrix A,
+    magma_d_preconditioner *precond,
+    magma_queue_t queue );
+
 magma_int_t
 magma_dparic_gpu( 
     magma_d_matrix A, 
@@ -825,6 +923,30 @@ magma_dmLdiagadd(
 */
 // #ifdef _OPENMP
 
+magma_int_t
+magma_dworkspace_malloc(
+    magma_d_workspace *ws,
+    void **ptr,
+    size_t size,
+    magma_queue_t queue );
+
+magma_int_t
+magma_dworkspace_free(
+    magma_d_workspace *ws,
+    void *ptr,
+    magma_queue_t queue );
+
+magma_int_t
+magma_dworkspace_mfree(
+    magma_d_workspace *ws,
+    magma_d_matrix *A,
+    magma_queue_t queue );
+
+magma_int_t
+magma_dworkspace_destroy(
+    magma_d_workspace *ws,
+    magma_queue_t queue );
+
 magma_int_t
 magma_dmatrix_tril(
     magma_d_matrix A,
@@ -837,11 +959,22 @@ magma_dmatrix_triu(
     magma_d_matrix *U,
     magma_queue_t queue );
 
+magma_int_t
+magma_dmatrix_split(
+    magma_d_matrix A,
+    magma_d_matrix *L,
+    magma_diagorder_t ldiag,
+    magma_d_matrix *U,
+    magma_diagorder_t udiag,
+    magma_d_matrix *D,
+    magma_queue_t queue );
+
 magma_int_t
 magma_dmatrix_cup(
     magma_d_matrix A,
     magma_d_matrix B,
     magma_d_matrix *U,
+    magma_d_workspace *ws,
     magma_queue_t queue );
 
 magma_int_t
@@ -879,6 +1012,14 @@ magma_dmatrix_triu_negcap(
     magma_d_matrix *U,
     magma_queue_t queue );
 
+magma_int_t
+magma_dfirsttouch_cpu(
+    magma_int_t nnz,
+    double *val,
+    magma_index_t *col,
+    magma_index_t *rowidx,
+    magma_queue_t queue );
+
 magma_int_t
 magma_dmatrix_addrowindex(
     magma_d_matrix *A,
@@ -895,6 +1036,7 @@ magma_dparilut_thrsrm(
     magma_int_t order,
     magma_d_matrix *A,
     double *thrs,
+    magma_d_workspace *ws,
     magma_queue_t queue );
 
 magma_int_t
@@ -959,6 +1101,7 @@ magma_int_t
 magma_dcsrcoo_transpose(
     magma_d_matrix A,
     magma_d_matrix *B,
+    magma_d_workspace *ws,
     magma_queue_t queue );
 
 magma_int_t
@@ -1015,6 +1158,17 @@ magma_dparilut_set_thrs_randomselect_approx(
     double *thrs,
     magma_queue_t queue );
 
+magma_int_t
+magma_dparilut_set_thrs_sampleselect(
+    magma_int_t num_rm,
+    magma_d_matrix *LU,
+    magma_int_t order,
+    double tol,
+    double *thrs,
+    magma_int_t *num_le,
+    magma_d_workspace *ws,
+    magma_queue_t queue );
+
 magma_int_t
 magma_dparilut_set_thrs_randomselect_factors(
     magma_int_t num_rm,
@@ -1079,6 +1233,18 @@ magma_dparilu_sweep_sync(
     magma_d_matrix *U,
     magma_queue_t queue );
 
+magma_int_t
+magma_dparilu_sweep_adaptive(
+    magma_d_matrix A,
+    magma_d_matrix *L,
+    magma_d_matrix *U,
+    double tol,
+    magma_index_t *active,
+    magma_index_t *changed,
+    magma_int_t *num_active,
+    magma_int_t *nnz_active,
+    magma_queue_t queue );
+
 magma_int_t
 magma_dparic_sweep(
     magma_d_matrix A,
@@ -1095,6 +1261,7 @@ magma_int_t
 magma_dparict_sweep_sync(
     magma_d_matrix *A,
     magma_d_matrix *L,
+    magma_d_workspace *ws,
     magma_queue_t queue );
 
 magma_int_t
@@ -1104,6 +1271,25 @@ magma_dparilut_sweep_sync(
     magma_d_matrix *U,
     magma_queue_t queue );
 
+magma_int_t
+magma_dparilut_amap(
+    magma_d_matrix A,
+    magma_d_matrix F,
+    magma_index_t **amap,
+    magma_d_workspace *ws,
+    magma_queue_t queue );
+
+magma_int_t
+magma_dparilut_sweep_sync_map(
+    magma_d_matrix *A,
+    magma_d_matrix *AT,
+    magma_d_matrix *L,
+    magma_d_matrix *U,
+    magma_index_t *Lmap,
+    magma_index_t *Umap,
+    magma_d_workspace *ws,
+    magma_queue_t queue );
+
 magma_int_t
 magma_dparilut_sweep_gpu( 
     magma_d_matrix *A,
@@ -1178,6 +1364,15 @@ magma_dparilut_residuals(
     magma_d_matrix *L_new,
     magma_queue_t queue );
 
+magma_int_t
+magma_dparilut_residuals_map(
+    magma_d_matrix A,
+    magma_d_matrix L,
+    magma_d_matrix U,
+    magma_index_t *Rmap,
+    magma_d_matrix *R,
+    magma_queue_t queue );
+
 magma_int_t
 magma_dparilut_residuals_transpose(
     magma_d_matrix A,
@@ -1271,6 +1466,13 @@ magma_dparilut_cpu(
     magma_d_preconditioner *precond,
     magma_queue_t queue );
 
+magma_int_t
+magma_dparilut_warmstart_cpu(
+    magma_d_matrix A,
+    magma_d_matrix b,
+    magma_d_preconditioner *precond,
+    magma_queue_t queue );
+
 magma_int_t
 magma_dparilut_gpu(
     magma_d_matrix A,
@@ -1312,6 +1514,21 @@ magma_dparilut_candidates(
     magma_d_matrix U,
     magma_d_matrix *L_new,
     magma_d_matrix *U_new,
+    magma_d_workspace *ws,
+    magma_queue_t queue );
+
+magma_int_t
+magma_dparilut_report_write(
+    magma_d_parilut_report report,
+    magma_queue_t queue );
+
+magma_int_t
+magma_dparilut_transpose_update(
+    magma_d_matrix U,
+    magma_d_matrix U_cand,
+    double thrs,
+    magma_d_matrix *UT,
+    magma_d_workspace *ws,
     magma_queue_t queue );
 
 magma_int_t
@@ -1330,6 +1547,7 @@ magma_dparict_candidates(
     magma_d_matrix L,
     magma_d_matrix LT,
     magma_d_matrix *L_new,
+    magma_d_workspace *ws,
     magma_queue_t queue );
 
 magma_int_t
@@ -1393,6 +1611,7 @@ magma_dparilut_preselect(
     magma_int_t order,
     magma_d_matrix *A,
     magma_d_matrix *oneA,
+    magma_d_workspace *ws,
     magma_queue_t queue );
 
 magma_int_t
@@ -1484,6 +1703,38 @@ magma_dmbackinsert_batched(
     double *rhs,    
     magma_queue_t queue );
 
+magma_int_t
+magma_dmprepare_vbatched(
+    magma_uplo_t uplotype,
+    magma_trans_t transtype,
+    magma_diag_t diagtype,
+    magma_d_matrix L,
+    magma_d_matrix LC,
+    size_t **sysptr,
+    double **trisystems,
+    double **rhs,
+    magma_queue_t queue );
+
+magma_int_t
+magma_dmtrisolve_vbatched(
+    magma_uplo_t uplotype,
+    magma_trans_t transtype,
+    magma_diag_t diagtype,
+    magma_d_matrix LC,
+    size_t *sysptr,
+    double *trisystems,
+    double *rhs,
+    magma_queue_t queue );
+
+magma_int_t
+magma_dmbackinsert_vbatched(
+    magma_uplo_t uplotype,
+    magma_trans_t transtype,
+    magma_diag_t diagtype,
+    magma_d_matrix *M,
+    double *rhs,
+    magma_queue_t queue );
+
 magma_int_t
 magma_dmprepare_batched_gpu(
     magma_uplo_t uplotype,
@@ -1536,6 +1787,20 @@ magma_diluisaisetup_upper(
     magma_d_matrix *ISAIU,
     magma_queue_t queue );
 
+magma_int_t
+magma_diluisaisetup_lower_cpu(
+    magma_d_matrix L,
+    magma_d_matrix S,
+    magma_d_matrix *ISAIL,
+    magma_queue_t queue );
+
+magma_int_t
+magma_diluisaisetup_upper_cpu(
+    magma_d_matrix U,
+    magma_d_matrix S,
+    magma_d_matrix *ISAIU,
+    magma_queue_t queue );
+
 magma_int_t
 magma_dicisaisetup(
     magma_d_matrix A,
@@ -1557,6 +1822,20 @@ magma_disai_r(
     magma_d_preconditioner *precond,
     magma_queue_t queue );
 
+magma_int_t
+magma_disai_l_cpu(
+    magma_d_matrix b,
+    magma_d_matrix *x,
+    magma_d_preconditioner *precond,
+    magma_queue_t queue );
+
+magma_int_t
+magma_disai_r_cpu(
+    magma_d_matrix b,
+    magma_d_matrix *x,
+    magma_d_preconditioner *precond,
+    magma_queue_t queue );
+
 magma_int_t
 magma_disai_l_t(
     magma_d_matrix b,
@@ -1593,6 +1872,15 @@ magma_disai_generator_regs(
     magma_d_matrix *M,
     magma_queue_t queue );
 
+magma_int_t
+magma_disai_generator_cpu(
+    magma_uplo_t uplotype,
+    magma_trans_t transtype,
+    magma_diag_t diagtype,
+    magma_d_matrix L,
+    magma_d_matrix *M,
+    magma_queue_t queue );
+
 magma_int_t
 magma_dcsr_sort(
     magma_d_matrix *A,
@@ -1634,6 +1922,64 @@ magma_dmvarsizeblockstruct(
  -- MAGMA_SPARSE function definitions / Data on CPU / Multi-GPU
 */
 
+/* ////////////////////////////////////////////////////////////////////////////
+ -- MAGMA_SPARSE iterative solvers (Data on CPU)
+*/
+
+magma_int_t
+magma_dpcg_cpu(
+    magma_d_matrix A, magma_d_matrix b, 
+    magma_d_matrix *x, magma_d_solver_par *solver_par, 
+    magma_d_preconditioner *precond_par,
+    magma_queue_t queue );
+
+magma_int_t
+magma_dpbicgstab_cpu(
+    magma_d_matrix A, magma_d_matrix b, 
+    magma_d_matrix *x, magma_d_solver_par *solver_par, 
+    magma_d_preconditioner *precond_par,
+    magma_queue_t queue );
+
+magma_int_t
+magma_dfgmres_cpu(
+    magma_d_matrix A, magma_d_matrix b, 
+    magma_d_matrix *x, magma_d_solver_par *solver_par, 
+    magma_d_preconditioner *precond_par,
+    magma_queue_t queue );
+
+magma_int_t
+magma_dpidr_cpu(
+    magma_d_matrix A, magma_d_matrix b,
+    magma_d_matrix *x, magma_d_solver_par *solver_par,
+    magma_d_preconditioner *precond_par,
+    magma_queue_t queue );
+
+magma_int_t
+magma_dpcg_merge_cpu(
+    magma_d_matrix A, magma_d_matrix b,
+    magma_d_matrix *x, magma_d_solver_par *solver_par,
+    magma_d_preconditioner *precond_par,
+    magma_queue_t queue );
+
+magma_int_t
+magma_dbicgstab_merge_cpu(
+    magma_d_matrix A, magma_d_matrix b,
+    magma_d_matrix *x, magma_d_solver_par *solver_par,
+    magma_queue_t queue );
+
+magma_int_t
+magma_dpipecg_cpu(
+    magma_d_matrix A, magma_d_matrix b,
+    magma_d_matrix *x, magma_d_solver_par *solver_par,
+    magma_d_preconditioner *precond_par,
+    magma_queue_t queue );
+
+magma_int_t
+magma_dsstepcg_cpu(
+    magma_d_matrix A, magma_d_matrix b,
+    magma_d_matrix *x, magma_d_solver_par *solver_par,
+    magma_queue_t queue );
+
 /* ////////////////////////////////////////////////////////////////////////////
  -- MAGMA_SPARSE iterative solvers (Data on GPU)
 */
@@ -2368,6 +2714,27 @@ magma_d_applyprecond_right(
     magma_d_matrix *x, magma_d_preconditioner *precond,
     magma_queue_t queue );
 
+magma_int_t
+magma_d_precondsetup_cpu(
+    magma_d_matrix A, magma_d_matrix b, 
+    magma_d_solver_par *solver,
+    magma_d_preconditioner *precond,
+    magma_queue_t queue );
+
+magma_int_t
+magma_d_applyprecond_left_cpu(
+    magma_trans_t trans,
+    magma_d_matrix A, magma_d_matrix b, 
+    magma_d_matrix *x, magma_d_preconditioner *precond,
+    magma_queue_t queue );
+
+magma_int_t
+magma_d_applyprecond_right_cpu(
+    magma_trans_t trans,
+    magma_d_matrix A, magma_d_matrix b, 
+    magma_d_matrix *x, magma_d_preconditioner *precond,
+    magma_queue_t queue );
+
 magma_int_t
 magma_d_initP2P(
     magma_int_t *bandwidth_benchmark,
@@ -2461,6 +2828,191 @@ magma_dgecsrmv(
     magmaDouble_ptr dy,
     magma_queue_t queue );
 
+magma_int_t 
+magma_dgecsrmv_cpu(
+    magma_trans_t transA,
+    magma_int_t m, magma_int_t n,
+    double alpha,
+    double *val,
+    magma_index_t *rowptr,
+    magma_index_t *colind,
+    double *x,
+    double beta,
+    double *y,
+    magma_queue_t queue );
+
+magma_int_t
+magma_dcsrtrsv_cpu(
+    magma_uplo_t uplo,
+    magma_d_matrix A,
+    double *b,
+    double *x,
+    magma_queue_t queue );
+
+magma_int_t
+magma_dcsrtrsv_mc_cpu(
+    magma_uplo_t uplo,
+    magma_d_matrix A,
+    magma_int_t ncolors,
+    magma_index_t *colorptr,
+    double *b,
+    double *x,
+    magma_queue_t queue );
+
+magma_int_t
+magma_dspgemm_symbolic_cpu(
+    magma_d_matrix A,
+    magma_d_matrix B,
+    magma_d_matrix *C,
+    magma_queue_t queue );
+
+magma_int_t
+magma_dspgemm_numeric_cpu(
+    double alpha,
+    magma_d_matrix A,
+    magma_d_matrix B,
+    magma_d_matrix *C,
+    magma_queue_t queue );
+
+magma_int_t
+magma_dspgemm_cpu(
+    double alpha,
+    magma_d_matrix A,
+    magma_d_matrix B,
+    magma_d_matrix *C,
+    magma_queue_t queue );
+
+magma_int_t
+magma_dspgemm_masked_cpu(
+    double alpha,
+    magma_d_matrix A,
+    magma_d_matrix B,
+    magma_d_matrix M,
+    magma_d_matrix *C,
+    magma_queue_t queue );
+
+double
+magma_ddot_cpu(
+    magma_int_t n,
+    const double *x, magma_int_t incx,
+    const double *y, magma_int_t incy,
+    magma_queue_t queue );
+
+double
+magma_dnrm2_cpu(
+    magma_int_t n,
+    const double *x, magma_int_t incx,
+    magma_queue_t queue );
+
+void
+magma_daxpy_cpu(
+    magma_int_t n,
+    double alpha,
+    const double *x, magma_int_t incx,
+    double *y, magma_int_t incy,
+    magma_queue_t queue );
+
+void
+magma_dscal_cpu(
+    magma_int_t n,
+    double alpha,
+    double *x, magma_int_t incx,
+    magma_queue_t queue );
+
+void
+magma_dcopy_cpu(
+    magma_int_t n,
+    const double *x, magma_int_t incx,
+    double *y, magma_int_t incy,
+    magma_queue_t queue );
+
+magma_int_t
+magma_dcgmerge_spmv1_cpu(
+    magma_d_matrix A,
+    double *d,
+    double *z,
+    double *den,
+    magma_queue_t queue );
+
+magma_int_t
+magma_dcgmerge_xr_cpu(
+    magma_int_t n,
+    double alpha,
+    double *d,
+    double *z,
+    double *x,
+    double *r,
+    double *nrm2,
+    magma_queue_t queue );
+
+magma_int_t
+magma_dcgmerge_d_cpu(
+    magma_int_t n,
+    double beta,
+    double *h,
+    double *d,
+    magma_queue_t queue );
+
+magma_int_t
+magma_dcgmerge_rh_cpu(
+    magma_int_t n,
+    double *r,
+    double *h,
+    double *rh,
+    magma_queue_t queue );
+
+magma_int_t
+magma_dbicgmerge1_cpu(
+    magma_int_t n,
+    double beta,
+    double omega,
+    double *r,
+    double *v,
+    double *p,
+    magma_queue_t queue );
+
+magma_int_t
+magma_dbicgmerge_spmv1_cpu(
+    magma_d_matrix A,
+    double *rr,
+    double *p,
+    double *v,
+    double *rrv,
+    magma_queue_t queue );
+
+magma_int_t
+magma_dbicgmerge2_cpu(
+    magma_int_t n,
+    double alpha,
+    double *r,
+    double *v,
+    double *s,
+    magma_queue_t queue );
+
+magma_int_t
+magma_dbicgmerge_spmv2_cpu(
+    magma_d_matrix A,
+    double *s,
+    double *t,
+    double *ts,
+    double *tt,
+    magma_queue_t queue );
+
+magma_int_t
+magma_dbicgmerge_xrbeta_cpu(
+    magma_int_t n,
+    double alpha,
+    double omega,
+    double *rr,
+    double *p,
+    double *s,
+    double *t,
+    double *x,
+    double *r,
+    double *rho,
+    double *nrm2,
+    magma_queue_t queue );
+
 magma_int_t 
 magma_dgecsrmv_shift(
     magma_trans_t transA,
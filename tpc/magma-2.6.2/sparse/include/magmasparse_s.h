@@ -5,7 +5,7 @@
  Univ. of Colorado, Denver
  @date April 2022
 
- @generated from sparse/include/magmasparse_z.h, normal z -> s, Wed Apr 20 17:38:08 2022
+ @generated from sparse/include/magmasparse_z.h, normal z -> s, Sun Oct 18 22:20:41 2026
  @author Hartwig Anzt
 */
 
@@ -368,6 +368,14 @@ magma_sindexsortval(
     magma_int_t last,
     magma_queue_t queue );
 
+magma_int_t
+magma_ssegsortval(
+    magma_int_t num_rows,
+    magma_index_t *row,
+    magma_index_t *col,
+    float *val,
+    magma_queue_t queue );
+
 magma_int_t
 magma_sorderstatistics(
     float *val,
@@ -424,6 +432,28 @@ magma_sselectrandom(
     magma_int_t k,
     magma_queue_t queue );
 
+magma_int_t
+magma_smultiselect(
+    const float *a,
+    magma_int_t size,
+    magma_int_t num_k,
+    const magma_int_t *k,
+    float *element,
+    magma_queue_t queue );
+
+magma_int_t
+magma_sbucketselect(
+    const float *a,
+    magma_int_t size,
+    magma_int_t num_k,
+    const magma_int_t *k,
+    float tol,
+    float *element,
+    float *thrs,
+    magma_int_t *num_le,
+    magma_s_workspace *ws,
+    magma_queue_t queue );
+
 magma_int_t
 magma_sdomainoverlap(
     magma_index_t num_rows,
@@ -582,6 +612,37 @@ magma_srowentries(
     magma_s_matrix *A,
     magma_queue_t queue );
 
+magma_int_t
+magma_srcm(
+    magma_s_matrix A,
+    magma_index_t **perm,
+    magma_index_t **iperm,
+    magma_queue_t queue );
+
+magma_int_t
+magma_smcolor(
+    magma_s_matrix A,
+    magma_index_t **perm,
+    magma_index_t **iperm,
+    magma_index_t **colorptr,
+    magma_int_t *ncolors,
+    magma_queue_t queue );
+
+magma_int_t
+magma_smpermute(
+    magma_s_matrix A,
+    magma_s_matrix *B,
+    magma_index_t *perm,
+    magma_index_t *iperm,
+    magma_queue_t queue );
+
+magma_int_t
+magma_svpermute(
+    magma_s_matrix x,
+    magma_s_matrix *y,
+    magma_index_t *perm,
+    magma_queue_t queue );
+
 magma_int_t
 magma_smfree(
     magma_s_matrix *A,
@@ -694,6 +755,43 @@ magma_sparilu_cpu(
     magma_s_preconditioner *precond,
     magma_queue_t queue );
 
+magma_int_t
+magma_silusetup_cpu(
+    magma_s_matrix A,
+    magma_s_preconditioner *precond,
+    magma_queue_t queue );
+
+magma_int_t
+magma_sparilusetup_cpu(
+    magma_s_matrix A,
+    magma_s_preconditioner *precond,
+    magma_queue_t queue );
+
+magma_int_t
+magma_sparilu_block_cpu(
+    magma_s_matrix A,
+    magma_s_matrix b,
+    magma_s_preconditioner *precond,
+    magma_queue_t queue );
+
+magma_int_t
+magma_sparilu_blocksetup_cpu(
+    magma_s_matrix A,
+    magma_s_preconditioner *precond,
+    magma_queue_t queue );
+
+magma_int_t
+magma_smcilusetup_cpu(
+    magma_s_matrix A,
+    magma_s_preconditioner *precond,
+    magma_queue_t queue );
+
+magma_int_t
+magma_smcsgssetup_cpu(
+    magma_s_matrix A,
+    magma_s_preconditioner *precond,
+    magma_queue_t queue );
+
 magma_int_t
 magma_sparic_gpu( 
     magma_s_matrix A, 
@@ -825,6 +923,30 @@ magma_smLdiagadd(
 */
 // #ifdef _OPENMP
 
+magma_int_t
+magma_sworkspace_malloc(
+    magma_s_workspace *ws,
+    void **ptr,
+    size_t size,
+    magma_queue_t queue );
+
+magma_int_t
+magma_sworkspace_free(
+    magma_s_workspace *ws,
+    void *ptr,
+    magma_queue_t queue );
+
+magma_int_t
+magma_sworkspace_mfree(
+    magma_s_workspace *ws,
+    magma_s_matrix *A,
+    magma_queue_t queue );
+
+magma_int_t
+magma_sworkspace_destroy(
+    magma_s_workspace *ws,
+    magma_queue_t queue );
+
 magma_int_t
 magma_smatrix_tril(
     magma_s_matrix A,
@@ -837,11 +959,22 @@ magma_smatrix_triu(
     magma_s_matrix *U,
     magma_queue_t queue );
 
+magma_int_t
+magma_smatrix_split(
+    magma_s_matrix A,
+    magma_s_matrix *L,
+    magma_diagorder_t ldiag,
+    magma_s_matrix *U,
+    magma_diagorder_t udiag,
+    magma_s_matrix *D,
+    magma_queue_t queue );
+
 magma_int_t
 magma_smatrix_cup(
     magma_s_matrix A,
     magma_s_matrix B,
     magma_s_matrix *U,
+    magma_s_workspace *ws,
     magma_queue_t queue );
 
 magma_int_t
@@ -879,6 +1012,14 @@ magma_smatrix_triu_negcap(
     magma_s_matrix *U,
     magma_queue_t queue );
 
+magma_int_t
+magma_sfirsttouch_cpu(
+    magma_int_t nnz,
+    float *val,
+    magma_index_t *col,
+    magma_index_t *rowidx,
+    magma_queue_t queue );
+
 magma_int_t
 magma_smatrix_addrowindex(
     magma_s_matrix *A,
@@ -895,6 +1036,7 @@ magma_sparilut_thrsrm(
     magma_int_t order,
     magma_s_matrix *A,
     float *thrs,
+    magma_s_workspace *ws,
     magma_queue_t queue );
 
 magma_int_t
@@ -959,6 +1101,7 @@ magma_int_t
 magma_scsrcoo_transpose(
     magma_s_matrix A,
     magma_s_matrix *B,
+    magma_s_workspace *ws,
     magma_queue_t queue );
 
 magma_int_t
@@ -1015,6 +1158,17 @@ magma_sparilut_set_thrs_randomselect_approx(
     float *thrs,
     magma_queue_t queue );
 
+magma_int_t
+magma_sparilut_set_thrs_sampleselect(
+    magma_int_t num_rm,
+    magma_s_matrix *LU,
+    magma_int_t order,
+    float tol,
+    float *thrs,
+    magma_int_t *num_le,
+    magma_s_workspace *ws,
+    magma_queue_t queue );
+
 magma_int_t
 magma_sparilut_set_thrs_randomselect_factors(
     magma_int_t num_rm,
@@ -1079,6 +1233,18 @@ magma_sparilu_sweep_sync(
     magma_s_matrix *U,
     magma_queue_t queue );
 
+magma_int_t
+magma_sparilu_sweep_adaptive(
+    magma_s_matrix A,
+    magma_s_matrix *L,
+    magma_s_matrix *U,
+    float tol,
+    magma_index_t *active,
+    magma_index_t *changed,
+    magma_int_t *num_active,
+    magma_int_t *nnz_active,
+    magma_queue_t queue );
+
 magma_int_t
 magma_sparic_sweep(
     magma_s_matrix A,
@@ -1095,6 +1261,7 @@ magma_int_t
 magma_sparict_sweep_sync(
     magma_s_matrix *A,
     magma_s_matrix *L,
+    magma_s_workspace *ws,
     magma_queue_t queue );
 
 magma_int_t
@@ -1104,6 +1271,25 @@ magma_sparilut_sweep_sync(
     magma_s_matrix *U,
     magma_queue_t queue );
 
+magma_int_t
+magma_sparilut_amap(
+    magma_s_matrix A,
+    magma_s_matrix F,
+    magma_index_t **amap,
+    magma_s_workspace *ws,
+    magma_queue_t queue );
+
+magma_int_t
+magma_sparilut_sweep_sync_map(
+    magma_s_matrix *A,
+    magma_s_matrix *AT,
+    magma_s_matrix *L,
+    magma_s_matrix *U,
+    magma_index_t *Lmap,
+    magma_index_t *Umap,
+    magma_s_workspace *ws,
+    magma_queue_t queue );
+
 magma_int_t
 magma_sparilut_sweep_gpu( 
     magma_s_matrix *A,
@@ -1178,6 +1364,15 @@ magma_sparilut_residuals(
     magma_s_matrix *L_new,
     magma_queue_t queue );
 
+magma_int_t
+magma_sparilut_residuals_map(
+    magma_s_matrix A,
+    magma_s_matrix L,
+    magma_s_matrix U,
+    magma_index_t *Rmap,
+    magma_s_matrix *R,
+    magma_queue_t queue );
+
 magma_int_t
 magma_sparilut_residuals_transpose(
     magma_s_matrix A,
@@ -1271,6 +1466,13 @@ magma_sparilut_cpu(
     magma_s_preconditioner *precond,
     magma_queue_t queue );
 
+magma_int_t
+magma_sparilut_warmstart_cpu(
+    magma_s_matrix A,
+    magma_s_matrix b,
+    magma_s_preconditioner *precond,
+    magma_queue_t queue );
+
 magma_int_t
 magma_sparilut_gpu(
     magma_s_matrix A,
@@ -1312,6 +1514,21 @@ magma_sparilut_candidates(
     magma_s_matrix U,
     magma_s_matrix *L_new,
     magma_s_matrix *U_new,
+    magma_s_workspace *ws,
+    magma_queue_t queue );
+
+magma_int_t
+magma_sparilut_report_write(
+    magma_s_parilut_report report,
+    magma_queue_t queue );
+
+magma_int_t
+magma_sparilut_transpose_update(
+    magma_s_matrix U,
+    magma_s_matrix U_cand,
+    float thrs,
+    magma_s_matrix *UT,
+    magma_s_workspace *ws,
     magma_queue_t queue );
 
 magma_int_t
@@ -1330,6 +1547,7 @@ magma_sparict_candidates(
     magma_s_matrix L,
     magma_s_matrix LT,
     magma_s_matrix *L_new,
+    magma_s_workspace *ws,
     magma_queue_t queue );
 
 magma_int_t
@@ -1393,6 +1611,7 @@ magma_sparilut_preselect(
     magma_int_t order,
     magma_s_matrix *A,
     magma_s_matrix *oneA,
+    magma_s_workspace *ws,
     magma_queue_t queue );
 
 magma_int_t
@@ -1484,6 +1703,38 @@ magma_smbackinsert_batched(
     float *rhs,    
     magma_queue_t queue );
 
+magma_int_t
+magma_smprepare_vbatched(
+    magma_uplo_t uplotype,
+    magma_trans_t transtype,
+    magma_diag_t diagtype,
+    magma_s_matrix L,
+    magma_s_matrix LC,
+    size_t **sysptr,
+    float **trisystems,
+    float **rhs,
+    magma_queue_t queue );
+
+magma_int_t
+magma_smtrisolve_vbatched(
+    magma_uplo_t uplotype,
+    magma_trans_t transtype,
+    magma_diag_t diagtype,
+    magma_s_matrix LC,
+    size_t *sysptr,
+    float *trisystems,
+    float *rhs,
+    magma_queue_t queue );
+
+magma_int_t
+magma_smbackinsert_vbatched(
+    magma_uplo_t uplotype,
+    magma_trans_t transtype,
+    magma_diag_t diagtype,
+    magma_s_matrix *M,
+    float *rhs,
+    magma_queue_t queue );
+
 magma_int_t
 magma_smprepare_batched_gpu(
     magma_uplo_t uplotype,
@@ -1536,6 +1787,20 @@ magma_siluisaisetup_upper(
     magma_s_matrix *ISAIU,
     magma_queue_t queue );
 
+magma_int_t
+magma_siluisaisetup_lower_cpu(
+    magma_s_matrix L,
+    magma_s_matrix S,
+    magma_s_matrix *ISAIL,
+    magma_queue_t queue );
+
+magma_int_t
+magma_siluisaisetup_upper_cpu(
+    magma_s_matrix U,
+    magma_s_matrix S,
+    magma_s_matrix *ISAIU,
+    magma_queue_t queue );
+
 magma_int_t
 magma_sicisaisetup(
     magma_s_matrix A,
@@ -1557,6 +1822,20 @@ magma_sisai_r(
     magma_s_preconditioner *precond,
     magma_queue_t queue );
 
+magma_int_t
+magma_sisai_l_cpu(
+    magma_s_matrix b,
+    magma_s_matrix *x,
+    magma_s_preconditioner *precond,
+    magma_queue_t queue );
+
+magma_int_t
+magma_sisai_r_cpu(
+    magma_s_matrix b,
+    magma_s_matrix *x,
+    magma_s_preconditioner *precond,
+    magma_queue_t queue );
+
 magma_int_t
 magma_sisai_l_t(
     magma_s_matrix b,
@@ -1593,6 +1872,15 @@ magma_sisai_generator_regs(
     magma_s_matrix *M,
     magma_queue_t queue );
 
+magma_int_t
+magma_sisai_generator_cpu(
+    magma_uplo_t uplotype,
+    magma_trans_t transtype,
+    magma_diag_t diagtype,
+    magma_s_matrix L,
+    magma_s_matrix *M,
+    magma_queue_t queue );
+
 magma_int_t
 magma_scsr_sort(
     magma_s_matrix *A,
@@ -1634,6 +1922,64 @@ magma_smvarsizeblockstruct(
  -- MAGMA_SPARSE function definitions / Data on CPU / Multi-GPU
 */
 
+/* ////////////////////////////////////////////////////////////////////////////
+ -- MAGMA_SPARSE iterative solvers (Data on CPU)
+*/
+
+magma_int_t
+magma_spcg_cpu(
+    magma_s_matrix A, magma_s_matrix b, 
+    magma_s_matrix *x, magma_s_solver_par *solver_par, 
+    magma_s_preconditioner *precond_par,
+    magma_queue_t queue );
+
+magma_int_t
+magma_spbicgstab_cpu(
+    magma_s_matrix A, magma_s_matrix b, 
+    magma_s_matrix *x, magma_s_solver_par *solver_par, 
+    magma_s_preconditioner *precond_par,
+    magma_queue_t queue );
+
+magma_int_t
+magma_sfgmres_cpu(
+    magma_s_matrix A, magma_s_matrix b, 
+    magma_s_matrix *x, magma_s_solver_par *solver_par, 
+    magma_s_preconditioner *precond_par,
+    magma_queue_t queue );
+
+magma_int_t
+magma_spidr_cpu(
+    magma_s_matrix A, magma_s_matrix b,
+    magma_s_matrix *x, magma_s_solver_par *solver_par,
+    magma_s_preconditioner *precond_par,
+    magma_queue_t queue );
+
+magma_int_t
+magma_spcg_merge_cpu(
+    magma_s_matrix A, magma_s_matrix b,
+    magma_s_matrix *x, magma_s_solver_par *solver_par,
+    magma_s_preconditioner *precond_par,
+    magma_queue_t queue );
+
+magma_int_t
+magma_sbicgstab_merge_cpu(
+    magma_s_matrix A, magma_s_matrix b,
+    magma_s_matrix *x, magma_s_solver_par *solver_par,
+    magma_queue_t queue );
+
+magma_int_t
+magma_spipecg_cpu(
+    magma_s_matrix A, magma_s_matrix b,
+    magma_s_matrix *x, magma_s_solver_par *solver_par,
+    magma_s_preconditioner *precond_par,
+    magma_queue_t queue );
+
+magma_int_t
+magma_ssstepcg_cpu(
+    magma_s_matrix A, magma_s_matrix b,
+    magma_s_matrix *x, magma_s_solver_par *solver_par,
+    magma_queue_t queue );
+
 /* ////////////////////////////////////////////////////////////////////////////
  -- MAGMA_SPARSE iterative solvers (Data on GPU)
 */
@@ -2368,6 +2714,27 @@ magma_s_applyprecond_right(
     magma_s_matrix *x, magma_s_preconditioner *precond,
     magma_queue_t queue );
 
+magma_int_t
+magma_s_precondsetup_cpu(
+    magma_s_matrix A, magma_s_matrix b, 
+    magma_s_solver_par *solver,
+    magma_s_preconditioner *precond,
+    magma_queue_t queue );
+
+magma_int_t
+magma_s_applyprecond_left_cpu(
+    magma_trans_t trans,
+    magma_s_matrix A, magma_s_matrix b, 
+    magma_s_matrix *x, magma_s_preconditioner *precond,
+    magma_queue_t queue );
+
+magma_int_t
+magma_s_applyprecond_right_cpu(
+    magma_trans_t trans,
+    magma_s_matrix A, magma_s_matrix b, 
+    magma_s_matrix *x, magma_s_preconditioner *precond,
+    magma_queue_t queue );
+
 magma_int_t
 magma_s_initP2P(
     magma_int_t *bandwidth_benchmark,
@@ -2461,6 +2828,191 @@ magma_sgecsrmv(
     magmaFloat_ptr dy,
     magma_queue_t queue );
 
+magma_int_t 
+magma_sgecsrmv_cpu(
+    magma_trans_t transA,
+    magma_int_t m, magma_int_t n,
+    float alpha,
+    float *val,
+    magma_index_t *rowptr,
+    magma_index_t *colind,
+    float *x,
+    float beta,
+    float *y,
+    magma_queue_t queue );
+
+magma_int_t
+magma_scsrtrsv_cpu(
+    magma_uplo_t uplo,
+    magma_s_matrix A,
+    float *b,
+    float *x,
+    magma_queue_t queue );
+
+magma_int_t
+magma_scsrtrsv_mc_cpu(
+    magma_uplo_t uplo,
+    magma_s_matrix A,
+    magma_int_t ncolors,
+    magma_index_t *colorptr,
+    float *b,
+    float *x,
+    magma_queue_t queue );
+
+magma_int_t
+magma_sspgemm_symbolic_cpu(
+    magma_s_matrix A,
+    magma_s_matrix B,
+    magma_s_matrix *C,
+    magma_queue_t queue );
+
+magma_int_t
+magma_sspgemm_numeric_cpu(
+    float alpha,
+    magma_s_matrix A,
+    magma_s_matrix B,
+    magma_s_matrix *C,
+    magma_queue_t queue );
+
+magma_int_t
+magma_sspgemm_cpu(
+    float alpha,
+    magma_s_matrix A,
+    magma_s_matrix B,
+    magma_s_matrix *C,
+    magma_queue_t queue );
+
+magma_int_t
+magma_sspgemm_masked_cpu(
+    float alpha,
+    magma_s_matrix A,
+    magma_s_matrix B,
+    magma_s_matrix M,
+    magma_s_matrix *C,
+    magma_queue_t queue );
+
+float
+magma_sdot_cpu(
+    magma_int_t n,
+    const float *x, magma_int_t incx,
+    const float *y, magma_int_t incy,
+    magma_queue_t queue );
+
+float
+magma_snrm2_cpu(
+    magma_int_t n,
+    const float *x, magma_int_t incx,
+    magma_queue_t queue );
+
+void
+magma_saxpy_cpu(
+    magma_int_t n,
+    float alpha,
+    const float *x, magma_int_t incx,
+    float *y, magma_int_t incy,
+    magma_queue_t queue );
+
+void
+magma_sscal_cpu(
+    magma_int_t n,
+    float alpha,
+    float *x, magma_int_t incx,
+    magma_queue_t queue );
+
+void
+magma_scopy_cpu(
+    magma_int_t n,
+    const float *x, magma_int_t incx,
+    float *y, magma_int_t incy,
+    magma_queue_t queue );
+
+magma_int_t
+magma_scgmerge_spmv1_cpu(
+    magma_s_matrix A,
+    float *d,
+    float *z,
+    float *den,
+    magma_queue_t queue );
+
+magma_int_t
+magma_scgmerge_xr_cpu(
+    magma_int_t n,
+    float alpha,
+    float *d,
+    float *z,
+    float *x,
+    float *r,
+    float *nrm2,
+    magma_queue_t queue );
+
+magma_int_t
+magma_scgmerge_d_cpu(
+    magma_int_t n,
+    float beta,
+    float *h,
+    float *d,
+    magma_queue_t queue );
+
+magma_int_t
+magma_scgmerge_rh_cpu(
+    magma_int_t n,
+    float *r,
+    float *h,
+    float *rh,
+    magma_queue_t queue );
+
+magma_int_t
+magma_sbicgmerge1_cpu(
+    magma_int_t n,
+    float beta,
+    float omega,
+    float *r,
+    float *v,
+    float *p,
+    magma_queue_t queue );
+
+magma_int_t
+magma_sbicgmerge_spmv1_cpu(
+    magma_s_matrix A,
+    float *rr,
+    float *p,
+    float *v,
+    float *rrv,
+    magma_queue_t queue );
+
+magma_int_t
+magma_sbicgmerge2_cpu(
+    magma_int_t n,
+    float alpha,
+    float *r,
+    float *v,
+    float *s,
+    magma_queue_t queue );
+
+magma_int_t
+magma_sbicgmerge_spmv2_cpu(
+    magma_s_matrix A,
+    float *s,
+    float *t,
+    float *ts,
+    float *tt,
+    magma_queue_t queue );
+
+magma_int_t
+magma_sbicgmerge_xrbeta_cpu(
+    magma_int_t n,
+    float alpha,
+    float omega,
+    float *rr,
+    float *p,
+    float *s,
+    float *t,
+    float *x,
+    float *r,
+    float *rho,
+    float *nrm2,
+    magma_queue_t queue );
+
 magma_int_t 
 magma_sgecsrmv_shift(
     magma_trans_t transA,
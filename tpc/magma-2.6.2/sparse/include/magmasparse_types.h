@@ -602,6 +602,134 @@ typedef struct magma_s_solver_par
 
 
 
+//************            ParILUT performance report       *******************//
+
+typedef struct magma_z_parilut_report
+{
+    magma_int_t        level;                   // 0: off, 1: collect timings, 2: also print the iteration table
+    const char         *json;                   // if not NULL, the report is written to this file as JSON
+    magma_int_t        num_threads;             // OpenMP threads
+    magma_int_t        iters;                   // iterations performed
+    magma_int_t        warm_start;              // 0: cold start, 1: warm start, -1: warm start rejected
+    magma_int_t        nnz_A;                   // nonzeros of the system matrix
+    magma_int_t        nnz_L;                   // nonzeros of the final L
+    magma_int_t        nnz_U;                   // nonzeros of the final U
+    int64_t            nnz_max;                 // largest nnz(L)+nnz(U) after adding candidates
+    int64_t            nnz_candidates;          // candidates generated, all iterations
+    int64_t            nnz_removed;             // elements removed, all iterations
+    real_Double_t      nnz_swept;               // nonzeros updated in the sweeps, all iterations
+    double             ilu_norm;                // ILU residual norm of the candidates, last iteration
+    magma_int_t        num_alloc;               // host allocations of the iteration workspace
+    size_t             bytes_alloc;             // bytes held by the iteration workspace
+    real_Double_t      t_transpose;             // feedback: time spent in the phases, all iterations
+    real_Double_t      t_candidates;
+    real_Double_t      t_residuals;
+    real_Double_t      t_norm;
+    real_Double_t      t_sort;
+    real_Double_t      t_transpose_cand;
+    real_Double_t      t_add;
+    real_Double_t      t_sweep1;
+    real_Double_t      t_select;
+    real_Double_t      t_remove;
+    real_Double_t      t_sweep2;
+    real_Double_t      t_total;
+} magma_z_parilut_report;
+
+typedef struct magma_c_parilut_report
+{
+    magma_int_t        level;                   // 0: off, 1: collect timings, 2: also print the iteration table
+    const char         *json;                   // if not NULL, the report is written to this file as JSON
+    magma_int_t        num_threads;             // OpenMP threads
+    magma_int_t        iters;                   // iterations performed
+    magma_int_t        warm_start;              // 0: cold start, 1: warm start, -1: warm start rejected
+    magma_int_t        nnz_A;                   // nonzeros of the system matrix
+    magma_int_t        nnz_L;                   // nonzeros of the final L
+    magma_int_t        nnz_U;                   // nonzeros of the final U
+    int64_t            nnz_max;                 // largest nnz(L)+nnz(U) after adding candidates
+    int64_t            nnz_candidates;          // candidates generated, all iterations
+    int64_t            nnz_removed;             // elements removed, all iterations
+    real_Double_t      nnz_swept;               // nonzeros updated in the sweeps, all iterations
+    float              ilu_norm;                // ILU residual norm of the candidates, last iteration
+    magma_int_t        num_alloc;               // host allocations of the iteration workspace
+    size_t             bytes_alloc;             // bytes held by the iteration workspace
+    real_Double_t      t_transpose;             // feedback: time spent in the phases, all iterations
+    real_Double_t      t_candidates;
+    real_Double_t      t_residuals;
+    real_Double_t      t_norm;
+    real_Double_t      t_sort;
+    real_Double_t      t_transpose_cand;
+    real_Double_t      t_add;
+    real_Double_t      t_sweep1;
+    real_Double_t      t_select;
+    real_Double_t      t_remove;
+    real_Double_t      t_sweep2;
+    real_Double_t      t_total;
+} magma_c_parilut_report;
+
+typedef struct magma_d_parilut_report
+{
+    magma_int_t        level;                   // 0: off, 1: collect timings, 2: also print the iteration table
+    const char         *json;                   // if not NULL, the report is written to this file as JSON
+    magma_int_t        num_threads;             // OpenMP threads
+    magma_int_t        iters;                   // iterations performed
+    magma_int_t        warm_start;              // 0: cold start, 1: warm start, -1: warm start rejected
+    magma_int_t        nnz_A;                   // nonzeros of the system matrix
+    magma_int_t        nnz_L;                   // nonzeros of the final L
+    magma_int_t        nnz_U;                   // nonzeros of the final U
+    int64_t            nnz_max;                 // largest nnz(L)+nnz(U) after adding candidates
+    int64_t            nnz_candidates;          // candidates generated, all iterations
+    int64_t            nnz_removed;             // elements removed, all iterations
+    real_Double_t      nnz_swept;               // nonzeros updated in the sweeps, all iterations
+    double             ilu_norm;                // ILU residual norm of the candidates, last iteration
+    magma_int_t        num_alloc;               // host allocations of the iteration workspace
+    size_t             bytes_alloc;             // bytes held by the iteration workspace
+    real_Double_t      t_transpose;             // feedback: time spent in the phases, all iterations
+    real_Double_t      t_candidates;
+    real_Double_t      t_residuals;
+    real_Double_t      t_norm;
+    real_Double_t      t_sort;
+    real_Double_t      t_transpose_cand;
+    real_Double_t      t_add;
+    real_Double_t      t_sweep1;
+    real_Double_t      t_select;
+    real_Double_t      t_remove;
+    real_Double_t      t_sweep2;
+    real_Double_t      t_total;
+} magma_d_parilut_report;
+
+typedef struct magma_s_parilut_report
+{
+    magma_int_t        level;                   // 0: off, 1: collect timings, 2: also print the iteration table
+    const char         *json;                   // if not NULL, the report is written to this file as JSON
+    magma_int_t        num_threads;             // OpenMP threads
+    magma_int_t        iters;                   // iterations performed
+    magma_int_t        warm_start;              // 0: cold start, 1: warm start, -1: warm start rejected
+    magma_int_t        nnz_A;                   // nonzeros of the system matrix
+    magma_int_t        nnz_L;                   // nonzeros of the final L
+    magma_int_t        nnz_U;                   // nonzeros of the final U
+    int64_t            nnz_max;                 // largest nnz(L)+nnz(U) after adding candidates
+    int64_t            nnz_candidates;          // candidates generated, all iterations
+    int64_t            nnz_removed;             // elements removed, all iterations
+    real_Double_t      nnz_swept;               // nonzeros updated in the sweeps, all iterations
+    float              ilu_norm;                // ILU residual norm of the candidates, last iteration
+    magma_int_t        num_alloc;               // host allocations of the iteration workspace
+    size_t             bytes_alloc;             // bytes held by the iteration workspace
+    real_Double_t      t_transpose;             // feedback: time spent in the phases, all iterations
+    real_Double_t      t_candidates;
+    real_Double_t      t_residuals;
+    real_Double_t      t_norm;
+    real_Double_t      t_sort;
+    real_Double_t      t_transpose_cand;
+    real_Double_t      t_add;
+    real_Double_t      t_sweep1;
+    real_Double_t      t_select;
+    real_Double_t      t_remove;
+    real_Double_t      t_sweep2;
+    real_Double_t      t_total;
+} magma_s_parilut_report;
+
+
+
 //************            preconditioner parameters       ********************//
 
 #if CUDA_VERSION < 11000
@@ -625,6 +753,8 @@ typedef struct magma_z_preconditioner
     magma_precision         format;
     double                  atol;                
     double                  rtol;    
+    double                  adaptive_tol;           // ParILU: row-adaptive sweeps if > 0
+    double                  warmstart_tol;          // ParILUT warm start: accepted relative change
     magma_int_t             maxiter;
     magma_int_t             restart; 
     magma_int_t             numiter;
@@ -658,6 +788,9 @@ typedef struct magma_z_preconditioner
     magma_index_t*            L_dgraphindegree_bak; // for sync-free trisolve
     magma_index_t*            U_dgraphindegree;     // for sync-free trisolve
     magma_index_t*            U_dgraphindegree_bak; // for sync-free trisolve
+    magma_index_t*            perm;                 // for multicolor: color ordering (new -> old)
+    magma_index_t*            colorptr;             // for multicolor: first row of each color
+    magma_int_t               ncolors;              // for multicolor: number of colors
     
     /* was merge conflict, assume master */
     magma_solve_info_t cuinfo;
@@ -667,6 +800,7 @@ typedef struct magma_z_preconditioner
     magma_solve_info_t cuinfoUT;
     
     magma_bool_t            transpose;                 // need the transpose for the solver?
+    magma_z_parilut_report  report;                    // feedback: ParILUT performance report
 #if defined(MAGMA_HAVE_PASTIX)
     pastix_data_t*          pastix_data;
     magma_int_t*            iparm;
@@ -686,6 +820,8 @@ typedef struct magma_c_preconditioner
     magma_precision         format;
     float                   atol;                
     float                   rtol;               
+    float                   adaptive_tol;           // ParILU: row-adaptive sweeps if > 0
+    float                   warmstart_tol;          // ParILUT warm start: accepted relative change
     magma_int_t             maxiter;
     magma_int_t             restart; 
     magma_int_t             numiter;
@@ -719,6 +855,9 @@ typedef struct magma_c_preconditioner
     magma_index_t*            L_dgraphindegree_bak; // for sync-free trisolve
     magma_index_t*            U_dgraphindegree;     // for sync-free trisolve
     magma_index_t*            U_dgraphindegree_bak; // for sync-free trisolve
+    magma_index_t*            perm;                 // for multicolor: color ordering (new -> old)
+    magma_index_t*            colorptr;             // for multicolor: first row of each color
+    magma_int_t               ncolors;              // for multicolor: number of colors
     
 
     magma_solve_info_t cuinfo;
@@ -729,6 +868,7 @@ typedef struct magma_c_preconditioner
     
     
     magma_bool_t            transpose;                 // need the transpose for the solver?
+    magma_c_parilut_report  report;                    // feedback: ParILUT performance report
 #if defined(MAGMA_HAVE_PASTIX)
     pastix_data_t*          pastix_data;
     magma_int_t*            iparm;
@@ -749,6 +889,8 @@ typedef struct magma_d_preconditioner
     magma_precision         format;
     double                  atol;                
     double                  rtol; 
+    double                  adaptive_tol;           // ParILU: row-adaptive sweeps if > 0
+    double                  warmstart_tol;          // ParILUT warm start: accepted relative change
     magma_int_t             maxiter;
     magma_int_t             restart; 
     magma_int_t             numiter;
@@ -782,6 +924,9 @@ typedef struct magma_d_preconditioner
     magma_index_t*            L_dgraphindegree_bak; // for sync-free trisolve
     magma_index_t*            U_dgraphindegree;     // for sync-free trisolve
     magma_index_t*            U_dgraphindegree_bak; // for sync-free trisolve
+    magma_index_t*            perm;                 // for multicolor: color ordering (new -> old)
+    magma_index_t*            colorptr;             // for multicolor: first row of each color
+    magma_int_t               ncolors;              // for multicolor: number of colors
 
     magma_solve_info_t cuinfo;
     magma_solve_info_t cuinfoL;
@@ -790,6 +935,7 @@ typedef struct magma_d_preconditioner
     magma_solve_info_t cuinfoUT;
     
     magma_bool_t            transpose;                 // need the transpose for the solver?
+    magma_d_parilut_report  report;                    // feedback: ParILUT performance report
 #if defined(MAGMA_HAVE_PASTIX)
     pastix_data_t*          pastix_data;
     magma_int_t*            iparm;
@@ -810,6 +956,8 @@ typedef struct magma_s_preconditioner
     magma_precision         format;
     float                   atol;                
     float                   rtol;    
+    float                   adaptive_tol;           // ParILU: row-adaptive sweeps if > 0
+    float                   warmstart_tol;          // ParILUT warm start: accepted relative change
     magma_int_t             maxiter;
     magma_int_t             restart; 
     magma_int_t             numiter;
@@ -843,6 +991,9 @@ typedef struct magma_s_preconditioner
     magma_index_t*            L_dgraphindegree_bak; // for sync-free trisolve
     magma_index_t*            U_dgraphindegree;     // for sync-free trisolve
     magma_index_t*            U_dgraphindegree_bak; // for sync-free trisolve
+    magma_index_t*            perm;                 // for multicolor: color ordering (new -> old)
+    magma_index_t*            colorptr;             // for multicolor: first row of each color
+    magma_int_t               ncolors;              // for multicolor: number of colors
     
     magma_solve_info_t cuinfo;
     magma_solve_info_t cuinfoL;
@@ -851,6 +1002,7 @@ typedef struct magma_s_preconditioner
     magma_solve_info_t cuinfoUT;
     
     magma_bool_t            transpose;                 // need the transpose for the solver?
+    magma_s_parilut_report  report;                    // feedback: ParILUT performance report
 #if defined(MAGMA_HAVE_PASTIX)
     pastix_data_t*          pastix_data;
     magma_int_t*            iparm;
@@ -859,6 +1011,54 @@ typedef struct magma_s_preconditioner
 } magma_s_preconditioner;
 
 
+//************            iteration workspace             ********************//
+
+typedef struct magma_z_workspace
+{
+    magma_int_t        num_buffers;             // number of buffers held
+    magma_int_t        max_buffers;             // size of the buffer table
+    magma_int_t        num_alloc;               // host allocations performed so far
+    size_t             footprint;               // bytes held by all buffers
+    void               **buffer;                // host buffers
+    size_t             *capacity;               // capacity of the buffers in bytes
+    magma_int_t        *in_use;                 // buffer currently handed out
+} magma_z_workspace;
+
+typedef struct magma_c_workspace
+{
+    magma_int_t        num_buffers;             // number of buffers held
+    magma_int_t        max_buffers;             // size of the buffer table
+    magma_int_t        num_alloc;               // host allocations performed so far
+    size_t             footprint;               // bytes held by all buffers
+    void               **buffer;                // host buffers
+    size_t             *capacity;               // capacity of the buffers in bytes
+    magma_int_t        *in_use;                 // buffer currently handed out
+} magma_c_workspace;
+
+typedef struct magma_d_workspace
+{
+    magma_int_t        num_buffers;             // number of buffers held
+    magma_int_t        max_buffers;             // size of the buffer table
+    magma_int_t        num_alloc;               // host allocations performed so far
+    size_t             footprint;               // bytes held by all buffers
+    void               **buffer;                // host buffers
+    size_t             *capacity;               // capacity of the buffers in bytes
+    magma_int_t        *in_use;                 // buffer currently handed out
+} magma_d_workspace;
+
+typedef struct magma_s_workspace
+{
+    magma_int_t        num_buffers;             // number of buffers held
+    magma_int_t        max_buffers;             // size of the buffer table
+    magma_int_t        num_alloc;               // host allocations performed so far
+    size_t             footprint;               // bytes held by all buffers
+    void               **buffer;                // host buffers
+    size_t             *capacity;               // capacity of the buffers in bytes
+    magma_int_t        *in_use;                 // buffer currently handed out
+} magma_s_workspace;
+
+
+
 //##############################################################################
 //
 //              opts for the testers
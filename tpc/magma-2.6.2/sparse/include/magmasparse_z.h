@@ -368,6 +368,14 @@ magma_zindexsortval(
     magma_int_t last,
     magma_queue_t queue );
 
+magma_int_t
+magma_zsegsortval(
+    magma_int_t num_rows,
+    magma_index_t *row,
+    magma_index_t *col,
+    magmaDoubleComplex *val,
+    magma_queue_t queue );
+
 magma_int_t
 magma_zorderstatistics(
     magmaDoubleComplex *val,
@@ -424,6 +432,28 @@ magma_zselectrandom(
     magma_int_t k,
     magma_queue_t queue );
 
+magma_int_t
+magma_zmultiselect(
+    const magmaDoubleComplex *a,
+    magma_int_t size,
+    magma_int_t num_k,
+    const magma_int_t *k,
+    magmaDoubleComplex *element,
+    magma_queue_t queue );
+
+magma_int_t
+magma_zbucketselect(
+    const magmaDoubleComplex *a,
+    magma_int_t size,
+    magma_int_t num_k,
+    const magma_int_t *k,
+    double tol,
+    magmaDoubleComplex *element,
+    double *thrs,
+    magma_int_t *num_le,
+    magma_z_workspace *ws,
+    magma_queue_t queue );
+
 magma_int_t
 magma_zdomainoverlap(
     magma_index_t num_rows,
@@ -582,6 +612,37 @@ magma_zrowentries(
     magma_z_matrix *A,
     magma_queue_t queue );
 
+magma_int_t
+magma_zrcm(
+    magma_z_matrix A,
+    magma_index_t **perm,
+    magma_index_t **iperm,
+    magma_queue_t queue );
+
+magma_int_t
+magma_zmcolor(
+    magma_z_matrix A,
+    magma_index_t **perm,
+    magma_index_t **iperm,
+    magma_index_t **colorptr,
+    magma_int_t *ncolors,
+    magma_queue_t queue );
+
+magma_int_t
+magma_zmpermute(
+    magma_z_matrix A,
+    magma_z_matrix *B,
+    magma_index_t *perm,
+    magma_index_t *iperm,
+    magma_queue_t queue );
+
+magma_int_t
+magma_zvpermute(
+    magma_z_matrix x,
+    magma_z_matrix *y,
+    magma_index_t *perm,
+    magma_queue_t queue );
+
 magma_int_t
 magma_zmfree(
     magma_z_matrix *A,
@@ -694,6 +755,43 @@ magma_zparilu_cpu(
     magma_z_preconditioner *precond,
     magma_queue_t queue );
 
+magma_int_t
+magma_zilusetup_cpu(
+    magma_z_matrix A,
+    magma_z_preconditioner *precond,
+    magma_queue_t queue );
+
+magma_int_t
+magma_zparilusetup_cpu(
+    magma_z_matrix A,
+    magma_z_preconditioner *precond,
+    magma_queue_t queue );
+
+magma_int_t
+magma_zparilu_block_cpu(
+    magma_z_matrix A,
+    magma_z_matrix b,
+    magma_z_preconditioner *precond,
+    magma_queue_t queue );
+
+magma_int_t
+magma_zparilu_blocksetup_cpu(
+    magma_z_matrix A,
+    magma_z_preconditioner *precond,
+    magma_queue_t queue );
+
+magma_int_t
+magma_zmcilusetup_cpu(
+    magma_z_matrix A,
+    magma_z_preconditioner *precond,
+    magma_queue_t queue );
+
+magma_int_t
+magma_zmcsgssetup_cpu(
+    magma_z_matrix A,
+    magma_z_preconditioner *precond,
+    magma_queue_t queue );
+
 magma_int_t
 magma_zparic_gpu( 
     magma_z_matrix A, 
@@ -825,6 +923,30 @@ magma_zmLdiagadd(
 */
 // #ifdef _OPENMP
 
+magma_int_t
+magma_zworkspace_malloc(
+    magma_z_workspace *ws,
+    void **ptr,
+    size_t size,
+    magma_queue_t queue );
+
+magma_int_t
+magma_zworkspace_free(
+    magma_z_workspace *ws,
+    void *ptr,
+    magma_queue_t queue );
+
+magma_int_t
+magma_zworkspace_mfree(
+    magma_z_workspace *ws,
+    magma_z_matrix *A,
+    magma_queue_t queue );
+
+magma_int_t
+magma_zworkspace_destroy(
+    magma_z_workspace *ws,
+    magma_queue_t queue );
+
 magma_int_t
 magma_zmatrix_tril(
     magma_z_matrix A,
@@ -837,11 +959,22 @@ magma_zmatrix_triu(
     magma_z_matrix *U,
     magma_queue_t queue );
 
+magma_int_t
+magma_zmatrix_split(
+    magma_z_matrix A,
+    magma_z_matrix *L,
+    magma_diagorder_t ldiag,
+    magma_z_matrix *U,
+    magma_diagorder_t udiag,
+    magma_z_matrix *D,
+    magma_queue_t queue );
+
 magma_int_t
 magma_zmatrix_cup(
     magma_z_matrix A,
     magma_z_matrix B,
     magma_z_matrix *U,
+    magma_z_workspace *ws,
     magma_queue_t queue );
 
 magma_int_t
@@ -879,6 +1012,14 @@ magma_zmatrix_triu_negcap(
     magma_z_matrix *U,
     magma_queue_t queue );
 
+magma_int_t
+magma_zfirsttouch_cpu(
+    magma_int_t nnz,
+    magmaDoubleComplex *val,
+    magma_index_t *col,
+    magma_index_t *rowidx,
+    magma_queue_t queue );
+
 magma_int_t
 magma_zmatrix_addrowindex(
     magma_z_matrix *A,
@@ -895,6 +1036,7 @@ magma_zparilut_thrsrm(
     magma_int_t order,
     magma_z_matrix *A,
     double *thrs,
+    magma_z_workspace *ws,
     magma_queue_t queue );
 
 magma_int_t
@@ -959,6 +1101,7 @@ magma_int_t
 magma_zcsrcoo_transpose(
     magma_z_matrix A,
     magma_z_matrix *B,
+    magma_z_workspace *ws,
     magma_queue_t queue );
 
 magma_int_t
@@ -1015,6 +1158,17 @@ magma_zparilut_set_thrs_randomselect_approx(
     double *thrs,
     magma_queue_t queue );
 
+magma_int_t
+magma_zparilut_set_thrs_sampleselect(
+    magma_int_t num_rm,
+    magma_z_matrix *LU,
+    magma_int_t order,
+    double tol,
+    double *thrs,
+    magma_int_t *num_le,
+    magma_z_workspace *ws,
+    magma_queue_t queue );
+
 magma_int_t
 magma_zparilut_set_thrs_randomselect_factors(
     magma_int_t num_rm,
@@ -1079,6 +1233,18 @@ magma_zparilu_sweep_sync(
     magma_z_matrix *U,
     magma_queue_t queue );
 
+magma_int_t
+magma_zparilu_sweep_adaptive(
+    magma_z_matrix A,
+    magma_z_matrix *L,
+    magma_z_matrix *U,
+    double tol,
+    magma_index_t *active,
+    magma_index_t *changed,
+    magma_int_t *num_active,
+    magma_int_t *nnz_active,
+    magma_queue_t queue );
+
 magma_int_t
 magma_zparic_sweep(
     magma_z_matrix A,
@@ -1095,6 +1261,7 @@ magma_int_t
 magma_zparict_sweep_sync(
     magma_z_matrix *A,
     magma_z_matrix *L,
+    magma_z_workspace *ws,
     magma_queue_t queue );
 
 magma_int_t
@@ -1104,6 +1271,25 @@ magma_zparilut_sweep_sync(
     magma_z_matrix *U,
     magma_queue_t queue );
 
+magma_int_t
+magma_zparilut_amap(
+    magma_z_matrix A,
+    magma_z_matrix F,
+    magma_index_t **amap,
+    magma_z_workspace *ws,
+    magma_queue_t queue );
+
+magma_int_t
+magma_zparilut_sweep_sync_map(
+    magma_z_matrix *A,
+    magma_z_matrix *AT,
+    magma_z_matrix *L,
+    magma_z_matrix *U,
+    magma_index_t *Lmap,
+    magma_index_t *Umap,
+    magma_z_workspace *ws,
+    magma_queue_t queue );
+
 magma_int_t
 magma_zparilut_sweep_gpu( 
     magma_z_matrix *A,
@@ -1178,6 +1364,15 @@ magma_zparilut_residuals(
     magma_z_matrix *L_new,
     magma_queue_t queue );
 
+magma_int_t
+magma_zparilut_residuals_map(
+    magma_z_matrix A,
+    magma_z_matrix L,
+    magma_z_matrix U,
+    magma_index_t *Rmap,
+    magma_z_matrix *R,
+    magma_queue_t queue );
+
 magma_int_t
 magma_zparilut_residuals_transpose(
     magma_z_matrix A,
@@ -1271,6 +1466,13 @@ magma_zparilut_cpu(
     magma_z_preconditioner *precond,
     magma_queue_t queue );
 
+magma_int_t
+magma_zparilut_warmstart_cpu(
+    magma_z_matrix A,
+    magma_z_matrix b,
+    magma_z_preconditioner *precond,
+    magma_queue_t queue );
+
 magma_int_t
 magma_zparilut_gpu(
     magma_z_matrix A,
@@ -1312,6 +1514,21 @@ magma_zparilut_candidates(
     magma_z_matrix U,
     magma_z_matrix *L_new,
     magma_z_matrix *U_new,
+    magma_z_workspace *ws,
+    magma_queue_t queue );
+
+magma_int_t
+magma_zparilut_report_write(
+    magma_z_parilut_report report,
+    magma_queue_t queue );
+
+magma_int_t
+magma_zparilut_transpose_update(
+    magma_z_matrix U,
+    magma_z_matrix U_cand,
+    double thrs,
+    magma_z_matrix *UT,
+    magma_z_workspace *ws,
     magma_queue_t queue );
 
 magma_int_t
@@ -1330,6 +1547,7 @@ magma_zparict_candidates(
     magma_z_matrix L,
     magma_z_matrix LT,
     magma_z_matrix *L_new,
+    magma_z_workspace *ws,
     magma_queue_t queue );
 
 magma_int_t
@@ -1393,6 +1611,7 @@ magma_zparilut_preselect(
     magma_int_t order,
     magma_z_matrix *A,
     magma_z_matrix *oneA,
+    magma_z_workspace *ws,
     magma_queue_t queue );
 
 magma_int_t
@@ -1484,6 +1703,38 @@ magma_zmbackinsert_batched(
     magmaDoubleComplex *rhs,    
     magma_queue_t queue );
 
+magma_int_t
+magma_zmprepare_vbatched(
+    magma_uplo_t uplotype,
+    magma_trans_t transtype,
+    magma_diag_t diagtype,
+    magma_z_matrix L,
+    magma_z_matrix LC,
+    size_t **sysptr,
+    magmaDoubleComplex **trisystems,
+    magmaDoubleComplex **rhs,
+    magma_queue_t queue );
+
+magma_int_t
+magma_zmtrisolve_vbatched(
+    magma_uplo_t uplotype,
+    magma_trans_t transtype,
+    magma_diag_t diagtype,
+    magma_z_matrix LC,
+    size_t *sysptr,
+    magmaDoubleComplex *trisystems,
+    magmaDoubleComplex *rhs,
+    magma_queue_t queue );
+
+magma_int_t
+magma_zmbackinsert_vbatched(
+    magma_uplo_t uplotype,
+    magma_trans_t transtype,
+    magma_diag_t diagtype,
+    magma_z_matrix *M,
+    magmaDoubleComplex *rhs,
+    magma_queue_t queue );
+
 magma_int_t
 magma_zmprepare_batched_gpu(
     magma_uplo_t uplotype,
@@ -1536,6 +1787,20 @@ magma_ziluisaisetup_upper(
     magma_z_matrix *ISAIU,
     magma_queue_t queue );
 
+magma_int_t
+magma_ziluisaisetup_lower_cpu(
+    magma_z_matrix L,
+    magma_z_matrix S,
+    magma_z_matrix *ISAIL,
+    magma_queue_t queue );
+
+magma_int_t
+magma_ziluisaisetup_upper_cpu(
+    magma_z_matrix U,
+    magma_z_matrix S,
+    magma_z_matrix *ISAIU,
+    magma_queue_t queue );
+
 magma_int_t
 magma_zicisaisetup(
     magma_z_matrix A,
@@ -1557,6 +1822,20 @@ magma_zisai_r(
     magma_z_preconditioner *precond,
     magma_queue_t queue );
 
+magma_int_t
+magma_zisai_l_cpu(
+    magma_z_matrix b,
+    magma_z_matrix *x,
+    magma_z_preconditioner *precond,
+    magma_queue_t queue );
+
+magma_int_t
+magma_zisai_r_cpu(
+    magma_z_matrix b,
+    magma_z_matrix *x,
+    magma_z_preconditioner *precond,
+    magma_queue_t queue );
+
 magma_int_t
 magma_zisai_l_t(
     magma_z_matrix b,
@@ -1593,6 +1872,15 @@ magma_zisai_generator_regs(
     magma_z_matrix *M,
     magma_queue_t queue );
 
+magma_int_t
+magma_zisai_generator_cpu(
+    magma_uplo_t uplotype,
+    magma_trans_t transtype,
+    magma_diag_t diagtype,
+    magma_z_matrix L,
+    magma_z_matrix *M,
+    magma_queue_t queue );
+
 magma_int_t
 magma_zcsr_sort(
     magma_z_matrix *A,
@@ -1634,6 +1922,64 @@ magma_zmvarsizeblockstruct(
  -- MAGMA_SPARSE function definitions / Data on CPU / Multi-GPU
 */
 
+/* ////////////////////////////////////////////////////////////////////////////
+ -- MAGMA_SPARSE iterative solvers (Data on CPU)
+*/
+
+magma_int_t
+magma_zpcg_cpu(
+    magma_z_matrix A, magma_z_matrix b, 
+    magma_z_matrix *x, magma_z_solver_par *solver_par, 
+    magma_z_preconditioner *precond_par,
+    magma_queue_t queue );
+
+magma_int_t
+magma_zpbicgstab_cpu(
+    magma_z_matrix A, magma_z_matrix b, 
+    magma_z_matrix *x, magma_z_solver_par *solver_par, 
+    magma_z_preconditioner *precond_par,
+    magma_queue_t queue );
+
+magma_int_t
+magma_zfgmres_cpu(
+    magma_z_matrix A, magma_z_matrix b, 
+    magma_z_matrix *x, magma_z_solver_par *solver_par, 
+    magma_z_preconditioner *precond_par,
+    magma_queue_t queue );
+
+magma_int_t
+magma_zpidr_cpu(
+    magma_z_matrix A, magma_z_matrix b,
+    magma_z_matrix *x, magma_z_solver_par *solver_par,
+    magma_z_preconditioner *precond_par,
+    magma_queue_t queue );
+
+magma_int_t
+magma_zpcg_merge_cpu(
+    magma_z_matrix A, magma_z_matrix b,
+    magma_z_matrix *x, magma_z_solver_par *solver_par,
+    magma_z_preconditioner *precond_par,
+    magma_queue_t queue );
+
+magma_int_t
+magma_zbicgstab_merge_cpu(
+    magma_z_matrix A, magma_z_matrix b,
+    magma_z_matrix *x, magma_z_solver_par *solver_par,
+    magma_queue_t queue );
+
+magma_int_t
+magma_zpipecg_cpu(
+    magma_z_matrix A, magma_z_matrix b,
+    magma_z_matrix *x, magma_z_solver_par *solver_par,
+    magma_z_preconditioner *precond_par,
+    magma_queue_t queue );
+
+magma_int_t
+magma_zsstepcg_cpu(
+    magma_z_matrix A, magma_z_matrix b,
+    magma_z_matrix *x, magma_z_solver_par *solver_par,
+    magma_queue_t queue );
+
 /* ////////////////////////////////////////////////////////////////////////////
  -- MAGMA_SPARSE iterative solvers (Data on GPU)
 */
@@ -2368,6 +2714,27 @@ magma_z_applyprecond_right(
     magma_z_matrix *x, magma_z_preconditioner *precond,
     magma_queue_t queue );
 
+magma_int_t
+magma_z_precondsetup_cpu(
+    magma_z_matrix A, magma_z_matrix b, 
+    magma_z_solver_par *solver,
+    magma_z_preconditioner *precond,
+    magma_queue_t queue );
+
+magma_int_t
+magma_z_applyprecond_left_cpu(
+    magma_trans_t trans,
+    magma_z_matrix A, magma_z_matrix b, 
+    magma_z_matrix *x, magma_z_preconditioner *precond,
+    magma_queue_t queue );
+
+magma_int_t
+magma_z_applyprecond_right_cpu(
+    magma_trans_t trans,
+    magma_z_matrix A, magma_z_matrix b, 
+    magma_z_matrix *x, magma_z_preconditioner *precond,
+    magma_queue_t queue );
+
 magma_int_t
 magma_z_initP2P(
     magma_int_t *bandwidth_benchmark,
@@ -2461,6 +2828,191 @@ magma_zgecsrmv(
     magmaDoubleComplex_ptr dy,
     magma_queue_t queue );
 
+magma_int_t 
+magma_zgecsrmv_cpu(
+    magma_trans_t transA,
+    magma_int_t m, magma_int_t n,
+    magmaDoubleComplex alpha,
+    magmaDoubleComplex *val,
+    magma_index_t *rowptr,
+    magma_index_t *colind,
+    magmaDoubleComplex *x,
+    magmaDoubleComplex beta,
+    magmaDoubleComplex *y,
+    magma_queue_t queue );
+
+magma_int_t
+magma_zcsrtrsv_cpu(
+    magma_uplo_t uplo,
+    magma_z_matrix A,
+    magmaDoubleComplex *b,
+    magmaDoubleComplex *x,
+    magma_queue_t queue );
+
+magma_int_t
+magma_zcsrtrsv_mc_cpu(
+    magma_uplo_t uplo,
+    magma_z_matrix A,
+    magma_int_t ncolors,
+    magma_index_t *colorptr,
+    magmaDoubleComplex *b,
+    magmaDoubleComplex *x,
+    magma_queue_t queue );
+
+magma_int_t
+magma_zspgemm_symbolic_cpu(
+    magma_z_matrix A,
+    magma_z_matrix B,
+    magma_z_matrix *C,
+    magma_queue_t queue );
+
+magma_int_t
+magma_zspgemm_numeric_cpu(
+    magmaDoubleComplex alpha,
+    magma_z_matrix A,
+    magma_z_matrix B,
+    magma_z_matrix *C,
+    magma_queue_t queue );
+
+magma_int_t
+magma_zspgemm_cpu(
+    magmaDoubleComplex alpha,
+    magma_z_matrix A,
+    magma_z_matrix B,
+    magma_z_matrix *C,
+    magma_queue_t queue );
+
+magma_int_t
+magma_zspgemm_masked_cpu(
+    magmaDoubleComplex alpha,
+    magma_z_matrix A,
+    magma_z_matrix B,
+    magma_z_matrix M,
+    magma_z_matrix *C,
+    magma_queue_t queue );
+
+magmaDoubleComplex
+magma_zdotc_cpu(
+    magma_int_t n,
+    const magmaDoubleComplex *x, magma_int_t incx,
+    const magmaDoubleComplex *y, magma_int_t incy,
+    magma_queue_t queue );
+
+double
+magma_dznrm2_cpu(
+    magma_int_t n,
+    const magmaDoubleComplex *x, magma_int_t incx,
+    magma_queue_t queue );
+
+void
+magma_zaxpy_cpu(
+    magma_int_t n,
+    magmaDoubleComplex alpha,
+    const magmaDoubleComplex *x, magma_int_t incx,
+    magmaDoubleComplex *y, magma_int_t incy,
+    magma_queue_t queue );
+
+void
+magma_zscal_cpu(
+    magma_int_t n,
+    magmaDoubleComplex alpha,
+    magmaDoubleComplex *x, magma_int_t incx,
+    magma_queue_t queue );
+
+void
+magma_zcopy_cpu(
+    magma_int_t n,
+    const magmaDoubleComplex *x, magma_int_t incx,
+    magmaDoubleComplex *y, magma_int_t incy,
+    magma_queue_t queue );
+
+magma_int_t
+magma_zcgmerge_spmv1_cpu(
+    magma_z_matrix A,
+    magmaDoubleComplex *d,
+    magmaDoubleComplex *z,
+    magmaDoubleComplex *den,
+    magma_queue_t queue );
+
+magma_int_t
+magma_zcgmerge_xr_cpu(
+    magma_int_t n,
+    magmaDoubleComplex alpha,
+    magmaDoubleComplex *d,
+    magmaDoubleComplex *z,
+    magmaDoubleComplex *x,
+    magmaDoubleComplex *r,
+    double *nrm2,
+    magma_queue_t queue );
+
+magma_int_t
+magma_zcgmerge_d_cpu(
+    magma_int_t n,
+    magmaDoubleComplex beta,
+    magmaDoubleComplex *h,
+    magmaDoubleComplex *d,
+    magma_queue_t queue );
+
+magma_int_t
+magma_zcgmerge_rh_cpu(
+    magma_int_t n,
+    magmaDoubleComplex *r,
+    magmaDoubleComplex *h,
+    magmaDoubleComplex *rh,
+    magma_queue_t queue );
+
+magma_int_t
+magma_zbicgmerge1_cpu(
+    magma_int_t n,
+    magmaDoubleComplex beta,
+    magmaDoubleComplex omega,
+    magmaDoubleComplex *r,
+    magmaDoubleComplex *v,
+    magmaDoubleComplex *p,
+    magma_queue_t queue );
+
+magma_int_t
+magma_zbicgmerge_spmv1_cpu(
+    magma_z_matrix A,
+    magmaDoubleComplex *rr,
+    magmaDoubleComplex *p,
+    magmaDoubleComplex *v,
+    magmaDoubleComplex *rrv,
+    magma_queue_t queue );
+
+magma_int_t
+magma_zbicgmerge2_cpu(
+    magma_int_t n,
+    magmaDoubleComplex alpha,
+    magmaDoubleComplex *r,
+    magmaDoubleComplex *v,
+    magmaDoubleComplex *s,
+    magma_queue_t queue );
+
+magma_int_t
+magma_zbicgmerge_spmv2_cpu(
+    magma_z_matrix A,
+    magmaDoubleComplex *s,
+    magmaDoubleComplex *t,
+    magmaDoubleComplex *ts,
+    double *tt,
+    magma_queue_t queue );
+
+magma_int_t
+magma_zbicgmerge_xrbeta_cpu(
+    magma_int_t n,
+    magmaDoubleComplex alpha,
+    magmaDoubleComplex omega,
+    magmaDoubleComplex *rr,
+    magmaDoubleComplex *p,
+    magmaDoubleComplex *s,
+    magmaDoubleComplex *t,
+    magmaDoubleComplex *x,
+    magmaDoubleComplex *r,
+    magmaDoubleComplex *rho,
+    double *nrm2,
+    magma_queue_t queue );
+
 magma_int_t 
 magma_zgecsrmv_shift(
     magma_trans_t transA,
@@ -7,7 +7,7 @@
 
        @author Hartwig Anzt
 
-       @generated from sparse/src/zparict.cpp, normal z -> c, Wed Apr 20 17:38:07 2022
+       @generated from sparse/src/zparict.cpp, normal z -> c, Sun Oct 18 21:03:06 2026
 */
 
 #include "magmasparse_internal.h"
@@ -186,14 +186,11 @@ magma_cparict(
         num_rmL = max( (L_new.nnz-L0nnz*(1+precond->atol*(iters+1)/precond->sweeps)), 0 );
         start = magma_sync_wtime( queue );
         magma_cmfree(&LT, queue );
-        magma_ccsrcoo_transpose( L, &LT, queue );
+        magma_ccsrcoo_transpose( L, &LT, NULL, queue );
         end = magma_sync_wtime( queue ); t_transpose1+=end-start;
         start = magma_sync_wtime( queue ); 
-        magma_cparict_candidates( L0, L, LT, &hL, queue );
-        #pragma omp parallel        
-        for(int row=0; row<hL.num_rows; row++){
-            magma_cindexsort( &hL.col[hL.row[row]], 0, hL.row[row+1]-hL.row[row]-1, queue );
-        }
+        magma_cparict_candidates( L0, L, LT, &hL, NULL, queue );
+        CHECK( magma_csegsortval( hL.num_rows, hL.row, hL.col, hL.val, queue ));
         end = magma_sync_wtime( queue ); t_cand=+end-start;
         
         start = magma_sync_wtime( queue );
@@ -205,16 +202,16 @@ magma_cparict(
         end = magma_sync_wtime( queue ); t_nrm+=end-start;
         
         start = magma_sync_wtime( queue );
-        CHECK( magma_cmatrix_cup(  L, hL, &L_new, queue ) );  
+        CHECK( magma_cmatrix_cup(  L, hL, &L_new, NULL, queue ) );  
         end = magma_sync_wtime( queue ); t_add=+end-start;
         magma_cmfree( &hL, queue );
        
         start = magma_sync_wtime( queue );
-         CHECK( magma_cparict_sweep_sync( &A0, &L_new, queue ) );
+         CHECK( magma_cparict_sweep_sync( &A0, &L_new, NULL, queue ) );
         end = magma_sync_wtime( queue ); t_sweep1+=end-start;
         num_rmL = max( (L_new.nnz-L0nnz*(1+(precond->atol-1.)*(iters+1)/precond->sweeps)), 0 );
         start = magma_sync_wtime( queue );
-        magma_cparilut_preselect( 0, &L_new, &oneL, queue );
+        magma_cparilut_preselect( 0, &L_new, &oneL, NULL, queue );
         //#pragma omp parallel
         {
             if( num_rmL>0 ){
@@ -226,13 +223,13 @@ magma_cparict(
         end = magma_sync_wtime( queue ); t_selectrm=end-start;
         magma_cmfree( &oneL, queue );
         start = magma_sync_wtime( queue );
-        magma_cparilut_thrsrm( 1, &L_new, &thrsL, queue );//printf("done...");fflush(stdout);
+        magma_cparilut_thrsrm( 1, &L_new, &thrsL, NULL, queue );//printf("done...");fflush(stdout);
         CHECK( magma_cmatrix_swap( &L_new, &L, queue) );
         magma_cmfree( &L_new, queue );
         end = magma_sync_wtime( queue ); t_rm=end-start;
         
         start = magma_sync_wtime( queue );
-        CHECK( magma_cparict_sweep_sync( &A0, &L, queue ) );
+        CHECK( magma_cparict_sweep_sync( &A0, &L, NULL, queue ) );
         end = magma_sync_wtime( queue ); t_sweep2+=end-start;
 
         if( timing == 1 ){
@@ -7,7 +7,7 @@
 
        @author Hartwig Anzt
 
-       @generated from sparse/src/zparilut.cpp, normal z -> c, Wed Apr 20 17:38:07 2022
+       @generated from sparse/src/zparilut.cpp, normal z -> c, Sun Oct 18 21:03:05 2026
 */
 
 #include "magmasparse_internal.h"
@@ -199,10 +199,10 @@ magma_cparilut(
         start = magma_sync_wtime( queue );
         magma_cmfree(&UT, queue );
         //magma_cmtransposestruct_cpu( U, &UT, queue );
-        magma_ccsrcoo_transpose( U, &UT, queue );
+        magma_ccsrcoo_transpose( U, &UT, NULL, queue );
         end = magma_sync_wtime( queue ); t_transpose1+=end-start;
         start = magma_sync_wtime( queue );
-        magma_cparilut_candidates( L0, U0, L, UT, &hL, &hU, queue );
+        magma_cparilut_candidates( L0, U0, L, UT, &hL, &hU, NULL, queue );
         end = magma_sync_wtime( queue ); t_cand=+end-start;
         
         if( precond->rtol == 1.0 ){
@@ -247,7 +247,7 @@ magma_cparilut(
                 for(magma_int_t z=0; z<hU.nnz; z++)
                     hU.val[z] = MAGMA_C_ZERO;
             }
-            magma_ccsrcoo_transpose( hU, &oneU, queue );
+            magma_ccsrcoo_transpose( hU, &oneU, NULL, queue );
             end = magma_sync_wtime( queue ); t_transpose2+=end-start;
             magma_cmfree(&hU, queue );
             magma_cmfree(&UT, queue );
@@ -309,25 +309,18 @@ magma_cparilut(
                     }
                 //}
             }
-            magma_cparilut_thrsrm( 1, &oneL, &thrsL, queue );
-            magma_cparilut_thrsrm( 1, &oneU, &thrsU, queue );
+            magma_cparilut_thrsrm( 1, &oneL, &thrsL, NULL, queue );
+            magma_cparilut_thrsrm( 1, &oneU, &thrsU, NULL, queue );
             
         }
         
         end = magma_sync_wtime( queue ); t_selectadd+=end-start;
         
         start = magma_sync_wtime( queue );
-        #pragma omp parallel        
-        for(int row=0; row<hL.num_rows; row++){
-            magma_cindexsort( &hL.col[hL.row[row]], 0, hL.row[row+1]-hL.row[row]-1, queue );
-        }
-
-        #pragma omp parallel  
-        for(int row=0; row<hL.num_rows; row++){
-            magma_cindexsort( &hU.col[hU.row[row]], 0, hU.row[row+1]-hU.row[row]-1, queue );
-        }
-        CHECK( magma_cmatrix_cup(  L, oneL, &L_new, queue ) );   
-        CHECK( magma_cmatrix_cup(  U, oneU, &U_new, queue ) );
+        CHECK( magma_csegsortval( hL.num_rows, hL.row, hL.col, hL.val, queue ));
+        CHECK( magma_csegsortval( hU.num_rows, hU.row, hU.col, hU.val, queue ));
+        CHECK( magma_cmatrix_cup(  L, oneL, &L_new, NULL, queue ) );   
+        CHECK( magma_cmatrix_cup(  U, oneU, &U_new, NULL, queue ) );
         //magma_cmatrix_addrowindex( &U, queue );
         end = magma_sync_wtime( queue ); t_add=+end-start;
         magma_cmfree( &oneL, queue );
@@ -348,8 +341,8 @@ magma_cparilut(
         num_rmU = max( (U_new.nnz-U0nnz*(1+(precond->atol-1.)*(iters+1)/precond->sweeps)), 0 );
         start = magma_sync_wtime( queue );
         // pre-select: ignore the diagonal entries
-        magma_cparilut_preselect( 0, &L_new, &oneL, queue );
-        magma_cparilut_preselect( 0, &U_new, &oneU, queue );
+        magma_cparilut_preselect( 0, &L_new, &oneL, NULL, queue );
+        magma_cparilut_preselect( 0, &U_new, &oneU, NULL, queue );
         //#pragma omp parallel
         {
           //  magma_int_t id = omp_get_thread_num();
@@ -387,8 +380,8 @@ magma_cparilut(
         magma_cmfree( &oneU, queue );
         start = magma_sync_wtime( queue );
         
-        magma_cparilut_thrsrm( 1, &L_new, &thrsL, queue );//printf("done...");fflush(stdout);
-        magma_cparilut_thrsrm( 1, &U_new, &thrsU, queue );//printf("done...");fflush(stdout);
+        magma_cparilut_thrsrm( 1, &L_new, &thrsL, NULL, queue );//printf("done...");fflush(stdout);
+        magma_cparilut_thrsrm( 1, &U_new, &thrsU, NULL, queue );//printf("done...");fflush(stdout);
 
         
         // magma_cparilut_thrsrm_U( 1, L_new, &U_new, &thrsU, queue );
@@ -454,7 +447,7 @@ magma_cparilut(
 
     // for CUSPARSE
     CHECK( magma_cmtransfer( L, &precond->L, Magma_CPU, Magma_DEV , queue ));
-    magma_ccsrcoo_transpose( U, &UT, queue );
+    magma_ccsrcoo_transpose( U, &UT, NULL, queue );
     //magma_cmtranspose(U, &UT, queue );
     CHECK( magma_cmtransfer( UT, &precond->U, Magma_CPU, Magma_DEV , queue ));
 
@@ -8,7 +8,7 @@
        @author Hartwig Anzt
        @author Cade Brown
 
-       @generated from sparse/src/zparilut_gpu_nodp.cpp, normal z -> c, Wed Apr 20 17:38:07 2022
+       @generated from sparse/src/zparilut_gpu_nodp.cpp, normal z -> c, Sun Oct 18 21:20:40 2026
 */
 
 #include "magmasparse_internal.h"
@@ -103,8 +103,8 @@ magma_cparilut_gpu_nodp(
         magma_cmfree(&hL, queue);
     }
     CHECK(magma_cmtransfer(hA, &dA, Magma_CPU, Magma_DEV, queue));
-    CHECK(magma_cmatrix_tril(hA, &L0, queue));
-    CHECK(magma_cmatrix_triu(hA, &U0, queue));
+    CHECK(magma_cmatrix_split(hA, &L0, Magma_VALUE, &U0, Magma_VALUE, NULL, 
+        queue));
     CHECK(magma_cmtransfer(L0, &dL0, Magma_CPU, Magma_DEV, queue));
     CHECK(magma_cmtransfer(U0, &dU0, Magma_CPU, Magma_DEV, queue));
     magma_cmfree(&hU, queue);
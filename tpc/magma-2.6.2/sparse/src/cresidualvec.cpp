@@ -5,7 +5,7 @@
        Univ. of Colorado, Denver
        @date April 2022
 
-       @generated from sparse/src/zresidualvec.cpp, normal z -> c, Wed Apr 20 17:38:07 2022
+       @generated from sparse/src/zresidualvec.cpp, normal z -> c, Sun Oct 18 19:32:00 2026
        @author Hartwig Anzt
 
 */
@@ -64,7 +64,11 @@ magma_cresidualvec(
                                             mone = MAGMA_C_NEG_ONE;
     magma_int_t dofs = A.num_rows;
     
-    if ( A.num_rows == b.num_rows ) {
+    if ( A.num_rows == b.num_rows && A.memory_location == Magma_CPU ) {
+        CHECK( magma_c_spmv( mone, A, x, zero, *r, queue ));      // r = A x
+        magma_caxpy_cpu( dofs, one, b.val, 1, r->val, 1, queue );     // r = r - b
+        *res =  magma_scnrm2_cpu( dofs, r->val, 1, queue );       // res = ||r||
+    } else if ( A.num_rows == b.num_rows ) {
         CHECK( magma_c_spmv( mone, A, x, zero, *r, queue ));      // r = A x
         magma_caxpy( dofs, one, b.dval, 1, r->dval, 1, queue );          // r = r - b
         *res =  magma_scnrm2( dofs, r->dval, 1, queue );            // res = ||r||
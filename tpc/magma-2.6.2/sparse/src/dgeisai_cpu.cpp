@@ -0,0 +1,267 @@
+/*
+    -- MAGMA (version 2.6.2) --
+       Univ. of Tennessee, Knoxville
+       Univ. of California, Berkeley
+       Univ. of Colorado, Denver
+       @date April 2022
+
+       @author Hartwig Anzt
+
+       @generated from sparse/src/zgeisai_cpu.cpp, normal z -> d, Sun Oct 18 21:46:28 2026
+*/
+#include "magmasparse_internal.h"
+
+#define PRECISION_d
+
+
+/*
+    CSR transpose on the CPU, the column indices of B are sorted.
+*/
+static magma_int_t
+magma_disai_transpose_cpu(
+    magma_d_matrix A,
+    magma_d_matrix *B,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+
+    magma_dmfree( B, queue );
+    B->storage_type = Magma_CSR;
+    B->memory_location = Magma_CPU;
+    CHECK( d_transpose_csr( A.num_rows, A.num_cols, A.nnz, A.val, A.row, A.col,
+                            &B->num_rows, &B->num_cols, &B->nnz,
+                            &B->val, &B->row, &B->col, queue ));
+
+cleanup:
+    return info;
+}
+
+
+/***************************************************************************//**
+    Purpose
+    -------
+
+    Prepares the ISAI preconditioner for the lower triangular factor on the
+    CPU: the host counterpart of magma_diluisaisetup_lower. All data stays
+    in CPU memory, and there is no limit on the number of nonzeros per
+    column of the pattern.
+
+    Arguments
+    ---------
+
+    @param[in]
+    L           magma_d_matrix
+                lower triangular factor in CSR on the CPU
+
+    @param[in]
+    S           magma_d_matrix
+                pattern for the ISAI preconditioner for L
+
+    @param[out]
+    ISAIL       magma_d_matrix*
+                ISAI preconditioner for L
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_dgepr
+    ********************************************************************/
+extern "C"
+magma_int_t
+magma_diluisaisetup_lower_cpu(
+    magma_d_matrix L,
+    magma_d_matrix S,
+    magma_d_matrix *ISAIL,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+
+    magma_d_matrix MT={Magma_CSR};
+
+    // the ISAI matrix is generated in transpose fashion
+    CHECK( magma_disai_transpose_cpu( S, &MT, queue ));
+    CHECK( magma_disai_generator_cpu( MagmaLower, MagmaNoTrans, MagmaNonUnit,
+                                      L, &MT, queue ));
+    CHECK( magma_disai_transpose_cpu( MT, ISAIL, queue ));
+
+cleanup:
+    magma_dmfree( &MT, queue );
+    return info;
+}
+
+
+/***************************************************************************//**
+    Purpose
+    -------
+
+    Prepares the ISAI preconditioner for the upper triangular factor on the
+    CPU: the host counterpart of magma_diluisaisetup_upper. All data stays
+    in CPU memory, and there is no limit on the number of nonzeros per
+    column of the pattern.
+
+    Arguments
+    ---------
+
+    @param[in]
+    U           magma_d_matrix
+                upper triangular factor in CSR on the CPU
+
+    @param[in]
+    S           magma_d_matrix
+                pattern for the ISAI preconditioner for U
+
+    @param[out]
+    ISAIU       magma_d_matrix*
+                ISAI preconditioner for U
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_dgepr
+    ********************************************************************/
+extern "C"
+magma_int_t
+magma_diluisaisetup_upper_cpu(
+    magma_d_matrix U,
+    magma_d_matrix S,
+    magma_d_matrix *ISAIU,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+
+    magma_d_matrix MT={Magma_CSR};
+
+    // the ISAI matrix is generated in transpose fashion
+    CHECK( magma_disai_transpose_cpu( S, &MT, queue ));
+    CHECK( magma_disai_generator_cpu( MagmaUpper, MagmaNoTrans, MagmaNonUnit,
+                                      U, &MT, queue ));
+    CHECK( magma_disai_transpose_cpu( MT, ISAIU, queue ));
+
+cleanup:
+    magma_dmfree( &MT, queue );
+    return info;
+}
+
+
+/***************************************************************************//**
+    Purpose
+    -------
+
+    Left-hand-side application of ISAI preconditioner on the CPU: a sparse
+    matrix vector product with precond->LD, followed by precond->maxiter
+    relaxation steps x = LD b + x - LD L x.
+
+    Arguments
+    ---------
+
+    @param[in]
+    b           magma_d_matrix
+                input RHS b
+
+    @param[in,out]
+    x           magma_d_matrix
+                solution x
+
+    @param[in,out]
+    precond     magma_d_preconditioner*
+                preconditioner parameters
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_dgepr
+    ********************************************************************/
+extern "C"
+magma_int_t
+magma_disai_l_cpu(
+    magma_d_matrix b,
+    magma_d_matrix *x,
+    magma_d_preconditioner *precond,
+    magma_queue_t queue ){
+    magma_int_t info = 0;
+
+    magma_d_matrix LD = precond->LD, L = precond->L;
+    magma_int_t n = b.num_rows*b.num_cols;
+
+    CHECK( magma_dgecsrmv_cpu( MagmaNoTrans, LD.num_rows, LD.num_cols, MAGMA_D_ONE,
+                LD.val, LD.row, LD.col, b.val, MAGMA_D_ZERO, x->val, queue )); // SPAI
+    if( precond->maxiter > 0 ){
+        magma_dcopy_cpu( n, x->val, 1, precond->d.val, 1, queue );             // d = L_d^(-1)b
+        for( int z=0; z<precond->maxiter; z++ ){
+            CHECK( magma_dgecsrmv_cpu( MagmaNoTrans, L.num_rows, L.num_cols, MAGMA_D_ONE,
+                L.val, L.row, L.col, x->val, MAGMA_D_ZERO, precond->work1.val, queue )); // work1 = L * x
+            CHECK( magma_dgecsrmv_cpu( MagmaNoTrans, LD.num_rows, LD.num_cols, MAGMA_D_ONE,
+                LD.val, LD.row, LD.col, precond->work1.val, MAGMA_D_ZERO,
+                precond->work2.val, queue ));                                   // work2 = L_d^(-1)work1
+            magma_daxpy_cpu( n, -MAGMA_D_ONE, precond->work2.val, 1, x->val, 1, queue ); // x = x - work2
+            magma_daxpy_cpu( n, MAGMA_D_ONE, precond->d.val, 1, x->val, 1, queue );     // x = d + x
+        }
+    }
+
+cleanup:
+    return info;
+}
+
+
+/***************************************************************************//**
+    Purpose
+    -------
+
+    Right-hand-side application of ISAI preconditioner on the CPU: a sparse
+    matrix vector product with precond->UD, followed by precond->maxiter
+    relaxation steps x = UD b + x - UD U x.
+
+    Arguments
+    ---------
+
+    @param[in]
+    b           magma_d_matrix
+                input RHS b
+
+    @param[in,out]
+    x           magma_d_matrix
+                solution x
+
+    @param[in,out]
+    precond     magma_d_preconditioner*
+                preconditioner parameters
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_dgepr
+    ********************************************************************/
+extern "C"
+magma_int_t
+magma_disai_r_cpu(
+    magma_d_matrix b,
+    magma_d_matrix *x,
+    magma_d_preconditioner *precond,
+    magma_queue_t queue ){
+    magma_int_t info = 0;
+
+    magma_d_matrix UD = precond->UD, U = precond->U;
+    magma_int_t n = b.num_rows*b.num_cols;
+
+    CHECK( magma_dgecsrmv_cpu( MagmaNoTrans, UD.num_rows, UD.num_cols, MAGMA_D_ONE,
+                UD.val, UD.row, UD.col, b.val, MAGMA_D_ZERO, x->val, queue )); // SPAI
+    if( precond->maxiter > 0 ){
+        magma_dcopy_cpu( n, x->val, 1, precond->d.val, 1, queue );             // d = U_d^(-1)b
+        for( int z=0; z<precond->maxiter; z++ ){
+            CHECK( magma_dgecsrmv_cpu( MagmaNoTrans, U.num_rows, U.num_cols, MAGMA_D_ONE,
+                U.val, U.row, U.col, x->val, MAGMA_D_ZERO, precond->work1.val, queue )); // work1 = U * x
+            CHECK( magma_dgecsrmv_cpu( MagmaNoTrans, UD.num_rows, UD.num_cols, MAGMA_D_ONE,
+                UD.val, UD.row, UD.col, precond->work1.val, MAGMA_D_ZERO,
+                precond->work2.val, queue ));                                   // work2 = U_d^(-1)work1
+            magma_daxpy_cpu( n, -MAGMA_D_ONE, precond->work2.val, 1, x->val, 1, queue ); // x = x - work2
+            magma_daxpy_cpu( n, MAGMA_D_ONE, precond->d.val, 1, x->val, 1, queue );     // x = d + x
+        }
+    }
+
+cleanup:
+    return info;
+}
@@ -0,0 +1,464 @@
+/*
+    -- MAGMA (version 2.6.2) --
+       Univ. of Tennessee, Knoxville
+       Univ. of California, Berkeley
+       Univ. of Colorado, Denver
+       @date April 2022
+
+       @author Hartwig Anzt
+
+       @generated from sparse/src/zilu_cpu.cpp, normal z -> d, Sun Oct 18 21:20:39 2026
+*/
+
+#include "magmasparse_internal.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#define PRECISION_d
+
+
+/***************************************************************************//**
+    Purpose
+    -------
+
+    Generates an ILU(levels) preconditioner on the CPU and keeps the
+    incomplete factors in CPU memory. The symbolic phase uses magma_dsymbilu,
+    the numeric phase is a row-wise (IKJ) Gaussian elimination restricted
+    to the sparsity pattern.
+
+    On output, precond->L is the unit lower triangular factor in CSR (the
+    diagonal is stored as last element of each row), precond->U is the upper
+    triangular factor in CSR (the diagonal is stored as first element of
+    each row).
+
+    For symmetric A, the product L U coincides with the IC(levels) product,
+    hence the same routine is used for the host ICC preconditioner.
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_d_matrix
+                input matrix A
+
+    @param[in,out]
+    precond     magma_d_preconditioner*
+                preconditioner parameters
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_dgepr
+*******************************************************************************/
+
+extern "C"
+magma_int_t
+magma_dilusetup_cpu(
+    magma_d_matrix A,
+    magma_d_preconditioner *precond,
+    magma_queue_t queue)
+{
+    magma_int_t info = 0;
+
+    magma_d_matrix hAT={Magma_CSR}, hA={Magma_CSR}, hL={Magma_CSR},
+                   hU={Magma_CSR};
+    magma_index_t *diag = NULL, *pos = NULL;
+
+    if (A.memory_location != Magma_CPU || A.storage_type != Magma_CSR) {
+        CHECK(magma_dmtransfer(A, &hAT, A.memory_location, Magma_CPU, queue));
+        CHECK(magma_dmconvert(hAT, &hA, hAT.storage_type, Magma_CSR, queue));
+        magma_dmfree(&hAT, queue);
+    } else {
+        CHECK(magma_dmtransfer(A, &hA, A.memory_location, Magma_CPU, queue));
+    }
+
+    // symbolic phase: also sorts the column indices of every row
+    CHECK(magma_dsymbilu(&hA, precond->levels, &hL, &hU, queue));
+    magma_dmfree(&hL, queue);
+    magma_dmfree(&hU, queue);
+
+    CHECK(magma_index_malloc_cpu(&diag, hA.num_rows));
+    CHECK(magma_index_malloc_cpu(&pos, hA.num_cols));
+
+    #pragma omp parallel for
+    for (magma_int_t i=0; i < hA.num_rows; i++) {
+        diag[i] = -1;
+        for (magma_int_t j=hA.row[i]; j < hA.row[i+1]; j++) {
+            if (hA.col[j] == i) {
+                diag[i] = j;
+            }
+        }
+    }
+    for (magma_int_t i=0; i < hA.num_cols; i++) {
+        pos[i] = -1;
+    }
+
+    // numeric phase
+    for (magma_int_t i=0; i < hA.num_rows; i++) {
+        if (diag[i] < 0) {
+            printf("%% error: missing diagonal element in row %d.\n", int(i));
+            info = MAGMA_ERR_BADPRECOND;
+            goto cleanup;
+        }
+        for (magma_int_t j=hA.row[i]; j < hA.row[i+1]; j++) {
+            pos[hA.col[j]] = j;
+        }
+        for (magma_int_t j=hA.row[i]; j < diag[i]; j++) {
+            magma_index_t k = hA.col[j];
+            hA.val[j] = hA.val[j] / hA.val[diag[k]];
+            for (magma_int_t jj=diag[k]+1; jj < hA.row[k+1]; jj++) {
+                magma_index_t p = pos[hA.col[jj]];
+                if (p >= 0) {
+                    hA.val[p] = hA.val[p] - hA.val[j] * hA.val[jj];
+                }
+            }
+        }
+        for (magma_int_t j=hA.row[i]; j < hA.row[i+1]; j++) {
+            pos[hA.col[j]] = -1;
+        }
+        if (MAGMA_D_EQUAL(hA.val[diag[i]], MAGMA_D_ZERO)) {
+            printf("%% error: zero pivot in row %d.\n", int(i));
+            info = MAGMA_ERR_BADPRECOND;
+            goto cleanup;
+        }
+    }
+
+    // split into the factors
+    magma_dmfree(&precond->L, queue);
+    magma_dmfree(&precond->U, queue);
+    // we need 1 on the main diagonal of L
+    CHECK(magma_dmatrix_split(hA, &precond->L, Magma_UNITY, 
+        &precond->U, Magma_VALUE, NULL, queue));
+
+cleanup:
+    magma_free_cpu(diag);
+    magma_free_cpu(pos);
+    magma_dmfree(&hAT, queue);
+    magma_dmfree(&hA, queue);
+    magma_dmfree(&hL, queue);
+    magma_dmfree(&hU, queue);
+    return info;
+}
+
+
+/***************************************************************************//**
+    Purpose
+    -------
+
+    Generates an ILU(levels) preconditioner via ParILU fixed-point sweeps on
+    the CPU. In contrast to magma_dparilu_cpu, the incomplete factors are
+    kept in CPU memory, with the same layout as in magma_dilusetup_cpu.
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_d_matrix
+                input matrix A
+
+    @param[in,out]
+    precond     magma_d_preconditioner*
+                preconditioner parameters
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_dgepr
+*******************************************************************************/
+
+extern "C"
+magma_int_t
+magma_dparilusetup_cpu(
+    magma_d_matrix A,
+    magma_d_preconditioner *precond,
+    magma_queue_t queue)
+{
+    magma_int_t info = 0;
+
+    magma_d_matrix hAT={Magma_CSR}, hA={Magma_CSR}, hAL={Magma_CSR},
+                   hAU={Magma_CSR}, hACOO={Magma_CSR};
+
+    if (A.memory_location != Magma_CPU || A.storage_type != Magma_CSR) {
+        CHECK(magma_dmtransfer(A, &hAT, A.memory_location, Magma_CPU, queue));
+        CHECK(magma_dmconvert(hAT, &hA, hAT.storage_type, Magma_CSR, queue));
+        magma_dmfree(&hAT, queue);
+    } else {
+        CHECK(magma_dmtransfer(A, &hA, A.memory_location, Magma_CPU, queue));
+    }
+
+    // in case using fill-in
+    if (precond->levels > 0) {
+        CHECK(magma_dsymbilu(&hA, precond->levels, &hAL, &hAU, queue));
+        magma_dmfree(&hAL, queue);
+        magma_dmfree(&hAU, queue);
+    }
+    CHECK(magma_dmconvert(hA, &hACOO, hA.storage_type, Magma_CSRCOO, queue));
+
+    // get L
+    CHECK(magma_dmatrix_tril(hA, &hAL, queue));
+    #pragma omp parallel for
+    for (magma_int_t k=0; k < hAL.num_rows; k++) {
+        hAL.val[hAL.row[k+1]-1] = MAGMA_D_ONE;
+    }
+
+    // get U transpose, i.e. U in CSC
+    CHECK(magma_dmtranspose(hA, &hAT, queue));
+    CHECK(magma_dmatrix_tril(hAT, &hAU, queue));
+    magma_dmfree(&hAT, queue);
+
+    for (magma_int_t i=0; i < precond->sweeps; i++) {
+        CHECK(magma_dparilu_sweep(hACOO, &hAL, &hAU, queue));
+    }
+
+    magma_dmfree(&precond->L, queue);
+    magma_dmfree(&precond->U, queue);
+    CHECK(magma_dmtransfer(hAL, &precond->L, Magma_CPU, Magma_CPU, queue));
+    CHECK(magma_dmtranspose(hAU, &precond->U, queue));
+
+cleanup:
+    magma_dmfree(&hAT, queue);
+    magma_dmfree(&hA, queue);
+    magma_dmfree(&hAL, queue);
+    magma_dmfree(&hAU, queue);
+    magma_dmfree(&hACOO, queue);
+    return info;
+}
+
+
+/*
+    Colors A, stores the color ordering in precond and returns the permuted
+    matrix in CSR with sorted rows. Also allocates the workspace needed to
+    apply the multicolor preconditioners.
+*/
+static magma_int_t
+magma_dmcsetup_cpu(
+    magma_d_matrix A,
+    magma_d_matrix *Ap,
+    magma_d_preconditioner *precond,
+    magma_queue_t queue)
+{
+    magma_int_t info = 0;
+
+    magma_d_matrix hAT={Magma_CSR}, hA={Magma_CSR};
+    magma_index_t *iperm = NULL;
+
+    if (A.memory_location != Magma_CPU || A.storage_type != Magma_CSR) {
+        CHECK(magma_dmtransfer(A, &hAT, A.memory_location, Magma_CPU, queue));
+        CHECK(magma_dmconvert(hAT, &hA, hAT.storage_type, Magma_CSR, queue));
+        magma_dmfree(&hAT, queue);
+    } else {
+        CHECK(magma_dmtransfer(A, &hA, A.memory_location, Magma_CPU, queue));
+    }
+
+    magma_free_cpu(precond->perm);
+    magma_free_cpu(precond->colorptr);
+    precond->perm = NULL;
+    precond->colorptr = NULL;
+    CHECK(magma_dmcolor(hA, &precond->perm, &iperm, &precond->colorptr,
+                        &precond->ncolors, queue));
+    CHECK(magma_dmpermute(hA, Ap, precond->perm, iperm, queue));
+
+    magma_dmfree(&precond->work1, queue);
+    magma_dmfree(&precond->work2, queue);
+    CHECK(magma_dvinit(&precond->work1, Magma_CPU, hA.num_rows, 1,
+                       MAGMA_D_ZERO, queue));
+    CHECK(magma_dvinit(&precond->work2, Magma_CPU, hA.num_rows, 1,
+                       MAGMA_D_ZERO, queue));
+
+cleanup:
+    magma_free_cpu(iperm);
+    magma_dmfree(&hAT, queue);
+    magma_dmfree(&hA, queue);
+    return info;
+}
+
+
+/***************************************************************************//**
+    Purpose
+    -------
+
+    Generates a multicolor ILU(0) preconditioner on the CPU. A is reordered
+    with the coloring of magma_dmcolor, and the ILU(0) factorization of the
+    reordered matrix is computed color by color: rows of the same color do
+    not depend on each other, hence they are eliminated in parallel. The
+    triangular solves in magma_d_applyprecond_left_cpu and
+    magma_d_applyprecond_right_cpu are parallel within every color as well.
+
+    On output, precond->L (unit lower) and precond->U hold the factors of the
+    reordered matrix, precond->perm the color ordering. Note that the
+    reordering changes the ILU(0) factorization compared to
+    magma_dilusetup_cpu; for symmetric A, the factors give the IC(0)
+    product of the reordered matrix.
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_d_matrix
+                input matrix A
+
+    @param[in,out]
+    precond     magma_d_preconditioner*
+                preconditioner parameters
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_dgepr
+*******************************************************************************/
+
+extern "C"
+magma_int_t
+magma_dmcilusetup_cpu(
+    magma_d_matrix A,
+    magma_d_preconditioner *precond,
+    magma_queue_t queue)
+{
+    magma_int_t info = 0;
+
+    magma_d_matrix hA={Magma_CSR};
+    magma_index_t *diag = NULL;
+    magma_int_t badrow = -1;
+
+    CHECK(magma_dmcsetup_cpu(A, &hA, precond, queue));
+
+    CHECK(magma_index_malloc_cpu(&diag, hA.num_rows));
+    #pragma omp parallel for
+    for (magma_int_t i=0; i < hA.num_rows; i++) {
+        diag[i] = -1;
+        for (magma_int_t j=hA.row[i]; j < hA.row[i+1]; j++) {
+            if (hA.col[j] == i) {
+                diag[i] = j;
+            }
+        }
+    }
+    for (magma_int_t i=0; i < hA.num_rows; i++) {
+        if (diag[i] < 0) {
+            printf("%% error: missing diagonal element in row %d.\n", int(i));
+            info = MAGMA_ERR_BADPRECOND;
+            goto cleanup;
+        }
+    }
+
+    // numeric phase, IKJ variant; the rows are sorted, so the update of
+    // row i with row k is a merge of the two index lists
+    for (magma_int_t c=0; c < precond->ncolors; c++) {
+        #pragma omp parallel for schedule(dynamic,64) reduction(max:badrow)
+        for (magma_int_t i=precond->colorptr[c]; i < precond->colorptr[c+1]; i++) {
+            for (magma_int_t j=hA.row[i]; j < diag[i]; j++) {
+                magma_index_t k = hA.col[j];
+                hA.val[j] = hA.val[j] / hA.val[diag[k]];
+                magma_int_t p = j+1, q = diag[k]+1;
+                while (p < hA.row[i+1] && q < hA.row[k+1]) {
+                    if (hA.col[p] < hA.col[q]) {
+                        p++;
+                    } else if (hA.col[p] > hA.col[q]) {
+                        q++;
+                    } else {
+                        hA.val[p] = hA.val[p] - hA.val[j] * hA.val[q];
+                        p++;
+                        q++;
+                    }
+                }
+            }
+            if (MAGMA_D_EQUAL(hA.val[diag[i]], MAGMA_D_ZERO)) {
+                badrow = max(badrow, i);
+            }
+        }
+        if (badrow >= 0) {
+            printf("%% error: zero pivot in row %d.\n", int(badrow));
+            info = MAGMA_ERR_BADPRECOND;
+            goto cleanup;
+        }
+    }
+
+    // split into the factors
+    magma_dmfree(&precond->L, queue);
+    magma_dmfree(&precond->U, queue);
+    // we need 1 on the main diagonal of L
+    CHECK(magma_dmatrix_split(hA, &precond->L, Magma_UNITY, 
+        &precond->U, Magma_VALUE, NULL, queue));
+
+cleanup:
+    magma_free_cpu(diag);
+    magma_dmfree(&hA, queue);
+    return info;
+}
+
+
+/***************************************************************************//**
+    Purpose
+    -------
+
+    Generates a multicolor symmetric Gauss-Seidel preconditioner on the CPU,
+    M = (D + L) D^{-1} (D + U) for the splitting A = L + D + U of the matrix
+    reordered with magma_dmcolor. Every color of the forward and backward
+    sweep is processed in parallel.
+
+    On output, precond->L holds D + L, precond->U holds D + U, precond->d the
+    diagonal D (all of the reordered matrix), and precond->perm the color
+    ordering.
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_d_matrix
+                input matrix A
+
+    @param[in,out]
+    precond     magma_d_preconditioner*
+                preconditioner parameters
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_dgepr
+*******************************************************************************/
+
+extern "C"
+magma_int_t
+magma_dmcsgssetup_cpu(
+    magma_d_matrix A,
+    magma_d_preconditioner *precond,
+    magma_queue_t queue)
+{
+    magma_int_t info = 0;
+
+    magma_d_matrix hA={Magma_CSR};
+
+    CHECK(magma_dmcsetup_cpu(A, &hA, precond, queue));
+
+    magma_dmfree(&precond->d, queue);
+    CHECK(magma_dvinit(&precond->d, Magma_CPU, hA.num_rows, 1,
+                       MAGMA_D_ZERO, queue));
+    #pragma omp parallel for
+    for (magma_int_t i=0; i < hA.num_rows; i++) {
+        for (magma_int_t j=hA.row[i]; j < hA.row[i+1]; j++) {
+            if (hA.col[j] == i) {
+                precond->d.val[i] = hA.val[j];
+            }
+        }
+    }
+    for (magma_int_t i=0; i < hA.num_rows; i++) {
+        if (MAGMA_D_EQUAL(precond->d.val[i], MAGMA_D_ZERO)) {
+            printf("%% error: zero diagonal element in row %d.\n", int(i));
+            info = MAGMA_ERR_BADPRECOND;
+            goto cleanup;
+        }
+    }
+
+    magma_dmfree(&precond->L, queue);
+    magma_dmfree(&precond->U, queue);
+    CHECK(magma_dmatrix_split(hA, &precond->L, Magma_VALUE, 
+        &precond->U, Magma_VALUE, NULL, queue));
+
+cleanup:
+    magma_dmfree(&hA, queue);
+    return info;
+}
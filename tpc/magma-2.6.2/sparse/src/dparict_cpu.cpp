@@ -7,7 +7,7 @@
 
        @author Hartwig Anzt
 
-       @generated from sparse/src/zparict_cpu.cpp, normal z -> d, Wed Apr 20 17:38:07 2022
+       @generated from sparse/src/zparict_cpu.cpp, normal z -> d, Sun Oct 18 22:04:08 2026
 */
 
 #include "magmasparse_internal.h"
@@ -18,6 +18,16 @@
 #define PRECISION_d
 
 
+// wall clock time for the performance report, only taken if it is collected
+static inline real_Double_t
+magma_dparict_wtime(
+    magma_int_t timing,
+    magma_queue_t queue )
+{
+    return ( timing > 0 ) ? magma_sync_wtime( queue ) : 0.0;
+}
+
+
 /***************************************************************************//**
     Purpose
     -------
@@ -36,12 +46,24 @@
     This version uses the default setting which adds all candidates to the
     sparsity pattern. It is the variant for SPD systems.
 
+    All temporaries of the iterations are drawn from a magma_d_workspace, so
+    once the buffers have grown to the size of the factor, the iterations
+    do not allocate host memory.
+
+    The transpose of L used to find the candidates is not recomputed in
+    every iteration: it is updated with the added candidates and the removed
+    elements by magma_dparilut_transpose_update.
+
     This function requires OpenMP, and is only available if OpenMP is activated.
     
     The parameter list is:
     
     precond.sweeps : number of ParILUT steps
     precond.atol   : absolute fill ratio (1.0 keeps nnz count constant)
+    precond.report : performance report, filled in on every run. Timings are
+                     only taken for report.level > 0, and the iteration
+                     table is printed for report.level > 1. If report.json
+                     is set, the report is written to this file as JSON.
 
     Arguments
     ---------
@@ -79,37 +101,45 @@ magma_dparict_cpu(
     real_Double_t start, end;
     real_Double_t t_rm=0.0, t_add=0.0, t_res=0.0, t_sweep1=0.0, t_sweep2=0.0, 
         t_cand=0.0, t_transpose1=0.0, t_transpose2=0.0, t_selectrm=0.0,
-        t_selectadd=0.0, t_nrm=0.0, t_total = 0.0, accum=0.0;
+        t_selectadd=0.0, t_nrm=0.0, t_total = 0.0, accum=0.0, nnz_sweeps=0.0;
                     
-    double sum, sumL;
+    double sum = 0.0, sumL;
 
     magma_d_matrix hA={Magma_CSR},
-        hL={Magma_CSR}, oneL={Magma_CSR}, LT={Magma_CSR},
+        hL={Magma_CSR}, oneL={Magma_CSR}, LT={Magma_CSR}, hLT={Magma_CSR},
         L={Magma_CSR}, L_new={Magma_CSR}, L0={Magma_CSR};  
-    magma_int_t num_rmL;
+    magma_d_workspace ws = {0};
+    magma_d_parilut_report report = {0};
+    magma_int_t num_rmL, nnz_old;
     double thrsL = 0.0;
 
-    magma_int_t num_threads = 1, timing = 1; // 1 = print timing
+    magma_int_t num_threads = 1;
+    magma_int_t timing = precond->report.level; // 1: collect timings, 2: print
     magma_int_t L0nnz;
 
     #pragma omp parallel
     {
         num_threads = omp_get_max_threads();
     }
+    report.level = precond->report.level;
+    report.json = precond->report.json;
     CHECK(magma_dmtransfer(A, &hA, A.memory_location, Magma_CPU, queue));
 
     // in case using fill-in
     if (precond->levels > 0) {
         CHECK(magma_dsymbilu(&hA, precond->levels, &hL, &LT , queue));
-        magma_dmfree(&LT, queue);
+        magma_dworkspace_mfree(&ws, &hL, queue);
+        magma_dworkspace_mfree(&ws, &LT, queue);
     }
     
     CHECK(magma_dmatrix_tril(hA, &L, queue));
     CHECK(magma_dmtransfer(L, &L0, A.memory_location, Magma_CPU, queue));
     CHECK(magma_dmatrix_addrowindex(&L, queue)); 
     L0nnz=L.nnz;
+    // the transpose of L is built once, and then updated along with L
+    CHECK(magma_dcsrcoo_transpose(L, &LT, &ws, queue));
     
-    if (timing == 1) {
+    if (timing > 1) {
         printf("ilut_fill_ratio = %.6f;\n\n", precond->atol); 
 
         printf("performance_%d = [\n%%iter L.nnz U.nnz    ILU-Norm     candidat  resid     ILU-norm  selectad  add       transp1   sweep1    selectrm  remove    sweep2    transp2   total       accum\n", (int) num_threads);
@@ -123,68 +153,90 @@ magma_dparict_cpu(
         t_selectadd=0.0; t_nrm=0.0; t_total = 0.0;
 
         // step 1: find candidates
-        start = magma_sync_wtime(queue);
-        magma_dmfree(&LT, queue);
-        magma_dcsrcoo_transpose(L, &LT, queue);
-        end = magma_sync_wtime(queue); t_transpose1+=end-start;
-        start = magma_sync_wtime(queue); 
-        magma_dparict_candidates(L0, L, LT, &hL, queue);
-        end = magma_sync_wtime(queue); t_cand=+end-start;
+        start = magma_dparict_wtime(timing, queue); 
+        magma_dparict_candidates(L0, L, LT, &hL, &ws, queue);
+        report.nnz_candidates += hL.nnz;
+        end = magma_dparict_wtime(timing, queue); t_cand=+end-start;
 
         // step 2: compute residuals (optional when adding all candidates)
-        start = magma_sync_wtime(queue);
+        start = magma_dparict_wtime(timing, queue);
         magma_dparilut_residuals(hA, L, L, &hL, queue);
-        end = magma_sync_wtime(queue); t_res=+end-start;
-        start = magma_sync_wtime(queue);
+        end = magma_dparict_wtime(timing, queue); t_res=+end-start;
+        start = magma_dparict_wtime(timing, queue);
         magma_dmatrix_abssum(hL, &sumL, queue);
         sum = sumL*2;
-        end = magma_sync_wtime(queue); t_nrm+=end-start;
+        end = magma_dparict_wtime(timing, queue); t_nrm+=end-start;
 
         // step 3: add candidates
-        start = magma_sync_wtime(queue);
+        start = magma_dparict_wtime(timing, queue);
         CHECK(magma_dcsr_sort(&hL, queue));
-        end = magma_sync_wtime(queue); t_selectadd+=end-start;
-        start = magma_sync_wtime(queue);
-        CHECK(magma_dmatrix_cup( L, hL, &L_new, queue));  
-        end = magma_sync_wtime(queue); t_add=+end-start;
-        magma_dmfree(&hL, queue);
+        end = magma_dparict_wtime(timing, queue); t_selectadd+=end-start;
+        start = magma_dparict_wtime(timing, queue);
+        CHECK(magma_dmatrix_cup( L, hL, &L_new, &ws, queue));  
+        report.nnz_max = max(report.nnz_max, 2 * (int64_t) L_new.nnz);
+        end = magma_dparict_wtime(timing, queue); t_add=+end-start;
+        start = magma_dparict_wtime(timing, queue);
+        CHECK(magma_dcsrcoo_transpose(hL, &hLT, &ws, queue));
+        magma_dworkspace_mfree(&ws, &hL, queue);
+        end = magma_dparict_wtime(timing, queue); t_transpose1+=end-start;
 
         // step 4: sweep
-        start = magma_sync_wtime(queue);
-        CHECK(magma_dparict_sweep_sync(&hA, &L_new, queue));
-        end = magma_sync_wtime(queue); t_sweep1+=end-start;
+        start = magma_dparict_wtime(timing, queue);
+        CHECK(magma_dparict_sweep_sync(&hA, &L_new, &ws, queue));
+        nnz_sweeps += L_new.nnz;
+        end = magma_dparict_wtime(timing, queue); t_sweep1+=end-start;
 
         // step 5: select threshold to remove elements
-        start = magma_sync_wtime(queue);
+        start = magma_dparict_wtime(timing, queue);
         num_rmL = max((L_new.nnz-L0nnz*(1+(precond->atol-1.)
             *(iters+1)/precond->sweeps)), 0);
         // pre-select: ignore the diagonal entries
-        CHECK(magma_dparilut_preselect(0, &L_new, &oneL, queue));
+        CHECK(magma_dparilut_preselect(0, &L_new, &oneL, &ws, queue));
         if (num_rmL>0) {
-            CHECK(magma_dparilut_set_thrs_randomselect(num_rmL, 
-                &oneL, 0, &thrsL, queue));
+            CHECK(magma_dparilut_set_thrs_sampleselect(num_rmL, 
+                &oneL, 0, 0.0, &thrsL, NULL, &ws, queue));
         } else {
             thrsL = 0.0;
         }
-        magma_dmfree(&oneL, queue);
-        end = magma_sync_wtime(queue); t_selectrm=end-start;
+        magma_dworkspace_mfree(&ws, &oneL, queue);
+        end = magma_dparict_wtime(timing, queue); t_selectrm=end-start;
         
-        // step 6: remove elements
-        start = magma_sync_wtime(queue);
-        CHECK(magma_dparilut_thrsrm(1, &L_new, &thrsL, queue));
+        // step 6: remove elements, and update the transpose of L
+        start = magma_dparict_wtime(timing, queue);
+        CHECK(magma_dparilut_transpose_update(L_new, hLT, thrsL, &LT, 
+            &ws, queue));
+        magma_dworkspace_mfree(&ws, &hLT, queue);
+        end = magma_dparict_wtime(timing, queue); t_transpose2+=end-start;
+        start = magma_dparict_wtime(timing, queue);
+        nnz_old = L_new.nnz;
+        CHECK(magma_dparilut_thrsrm(1, &L_new, &thrsL, &ws, queue));
         CHECK(magma_dmatrix_swap(&L_new, &L, queue));
-        magma_dmfree(&L_new, queue);
-        end = magma_sync_wtime(queue); t_rm=end-start;
+        magma_dworkspace_mfree(&ws, &L_new, queue);
+        report.nnz_removed += nnz_old - L.nnz;
+        end = magma_dparict_wtime(timing, queue); t_rm=end-start;
         
         // step 7: sweep
-        start = magma_sync_wtime(queue);
-        CHECK(magma_dparict_sweep_sync(&hA, &L, queue));
-        end = magma_sync_wtime(queue); t_sweep2+=end-start;
-
-        if (timing == 1) {
-            t_total = t_cand+t_res+t_nrm+t_selectadd+t_add+t_transpose1
-            +t_sweep1+t_selectrm+t_rm+t_sweep2+t_transpose2;
-            accum = accum + t_total;
+        start = magma_dparict_wtime(timing, queue);
+        CHECK(magma_dparict_sweep_sync(&hA, &L, &ws, queue));
+        end = magma_dparict_wtime(timing, queue); t_sweep2+=end-start;
+        nnz_sweeps += L.nnz;
+        t_total = t_cand+t_res+t_nrm+t_selectadd+t_add+t_transpose1
+        +t_sweep1+t_selectrm+t_rm+t_sweep2+t_transpose2;
+        accum = accum + t_total;
+        report.t_transpose += t_transpose2;
+        report.t_candidates += t_cand;
+        report.t_residuals += t_res;
+        report.t_norm += t_nrm;
+        report.t_sort += t_selectadd;
+        report.t_transpose_cand += t_transpose1;
+        report.t_add += t_add;
+        report.t_sweep1 += t_sweep1;
+        report.t_select += t_selectrm;
+        report.t_remove += t_rm;
+        report.t_sweep2 += t_sweep2;
+        report.iters++;
+
+        if (timing > 1) {
             printf("%5lld %5lld %5lld  %.4e   %.2e  %.2e  %.2e  %.2e  %.2e  %.2e  %.2e  %.2e  %.2e  %.2e  %.2e  %.2e    %.2e\n",
                     (long long) iters, (long long) L.nnz, (long long) L.nnz, 
                     (double) sum, t_cand, t_res, t_nrm, t_selectadd, t_add, 
@@ -194,8 +246,24 @@ magma_dparict_cpu(
         }
     }
 
-    if (timing == 1) {
+    report.num_threads = num_threads;
+    report.nnz_A = hA.nnz;
+    report.nnz_L = L.nnz;
+    report.nnz_U = L.nnz;
+    report.nnz_swept = nnz_sweeps;
+    report.ilu_norm = sum;
+    report.num_alloc = ws.num_alloc;
+    report.bytes_alloc = ws.footprint;
+    report.t_total = accum;
+    precond->report = report;
+    if (report.json != NULL) {
+        CHECK(magma_dparilut_report_write(report, queue));
+    }
+
+    if (timing > 1) {
         printf("]; \n");
+        printf("%% workspace: %lld host allocations, %.2f MB\n\n", 
+            (long long) ws.num_alloc, (double) ws.footprint/1.0e6);
         fflush(stdout);
     }
     //##########################################################################
@@ -224,11 +292,14 @@ magma_dparict_cpu(
 cleanup:
     magma_dmfree(&hA, queue);
     magma_dmfree(&L0, queue);
-    magma_dmfree(&hL, queue);
-    magma_dmfree(&oneL, queue);
-    magma_dmfree(&L, queue);
-    magma_dmfree(&LT, queue);
-    magma_dmfree(&L_new, queue);
+    // the factor and temporaries are recycled through the workspace
+    magma_dworkspace_mfree(&ws, &hL, queue);
+    magma_dworkspace_mfree(&ws, &oneL, queue);
+    magma_dworkspace_mfree(&ws, &L, queue);
+    magma_dworkspace_mfree(&ws, &LT, queue);
+    magma_dworkspace_mfree(&ws, &hLT, queue);
+    magma_dworkspace_mfree(&ws, &L_new, queue);
+    magma_dworkspace_destroy(&ws, queue);
 #endif
     return info;
 }
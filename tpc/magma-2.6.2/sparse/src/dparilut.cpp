@@ -7,7 +7,7 @@
 
        @author Hartwig Anzt
 
-       @generated from sparse/src/zparilut.cpp, normal z -> d, Wed Apr 20 17:38:07 2022
+       @generated from sparse/src/zparilut.cpp, normal z -> d, Sun Oct 18 21:03:05 2026
 */
 
 #include "magmasparse_internal.h"
@@ -199,10 +199,10 @@ magma_dparilut(
         start = magma_sync_wtime( queue );
         magma_dmfree(&UT, queue );
         //magma_dmtransposestruct_cpu( U, &UT, queue );
-        magma_dcsrcoo_transpose( U, &UT, queue );
+        magma_dcsrcoo_transpose( U, &UT, NULL, queue );
         end = magma_sync_wtime( queue ); t_transpose1+=end-start;
         start = magma_sync_wtime( queue );
-        magma_dparilut_candidates( L0, U0, L, UT, &hL, &hU, queue );
+        magma_dparilut_candidates( L0, U0, L, UT, &hL, &hU, NULL, queue );
         end = magma_sync_wtime( queue ); t_cand=+end-start;
         
         if( precond->rtol == 1.0 ){
@@ -247,7 +247,7 @@ magma_dparilut(
                 for(magma_int_t z=0; z<hU.nnz; z++)
                     hU.val[z] = MAGMA_D_ZERO;
             }
-            magma_dcsrcoo_transpose( hU, &oneU, queue );
+            magma_dcsrcoo_transpose( hU, &oneU, NULL, queue );
             end = magma_sync_wtime( queue ); t_transpose2+=end-start;
             magma_dmfree(&hU, queue );
             magma_dmfree(&UT, queue );
@@ -309,25 +309,18 @@ magma_dparilut(
                     }
                 //}
             }
-            magma_dparilut_thrsrm( 1, &oneL, &thrsL, queue );
-            magma_dparilut_thrsrm( 1, &oneU, &thrsU, queue );
+            magma_dparilut_thrsrm( 1, &oneL, &thrsL, NULL, queue );
+            magma_dparilut_thrsrm( 1, &oneU, &thrsU, NULL, queue );
             
         }
         
         end = magma_sync_wtime( queue ); t_selectadd+=end-start;
         
         start = magma_sync_wtime( queue );
-        #pragma omp parallel        
-        for(int row=0; row<hL.num_rows; row++){
-            magma_dindexsort( &hL.col[hL.row[row]], 0, hL.row[row+1]-hL.row[row]-1, queue );
-        }
-
-        #pragma omp parallel  
-        for(int row=0; row<hL.num_rows; row++){
-            magma_dindexsort( &hU.col[hU.row[row]], 0, hU.row[row+1]-hU.row[row]-1, queue );
-        }
-        CHECK( magma_dmatrix_cup(  L, oneL, &L_new, queue ) );   
-        CHECK( magma_dmatrix_cup(  U, oneU, &U_new, queue ) );
+        CHECK( magma_dsegsortval( hL.num_rows, hL.row, hL.col, hL.val, queue ));
+        CHECK( magma_dsegsortval( hU.num_rows, hU.row, hU.col, hU.val, queue ));
+        CHECK( magma_dmatrix_cup(  L, oneL, &L_new, NULL, queue ) );   
+        CHECK( magma_dmatrix_cup(  U, oneU, &U_new, NULL, queue ) );
         //magma_dmatrix_addrowindex( &U, queue );
         end = magma_sync_wtime( queue ); t_add=+end-start;
         magma_dmfree( &oneL, queue );
@@ -348,8 +341,8 @@ magma_dparilut(
         num_rmU = max( (U_new.nnz-U0nnz*(1+(precond->atol-1.)*(iters+1)/precond->sweeps)), 0 );
         start = magma_sync_wtime( queue );
         // pre-select: ignore the diagonal entries
-        magma_dparilut_preselect( 0, &L_new, &oneL, queue );
-        magma_dparilut_preselect( 0, &U_new, &oneU, queue );
+        magma_dparilut_preselect( 0, &L_new, &oneL, NULL, queue );
+        magma_dparilut_preselect( 0, &U_new, &oneU, NULL, queue );
         //#pragma omp parallel
         {
           //  magma_int_t id = omp_get_thread_num();
@@ -387,8 +380,8 @@ magma_dparilut(
         magma_dmfree( &oneU, queue );
         start = magma_sync_wtime( queue );
         
-        magma_dparilut_thrsrm( 1, &L_new, &thrsL, queue );//printf("done...");fflush(stdout);
-        magma_dparilut_thrsrm( 1, &U_new, &thrsU, queue );//printf("done...");fflush(stdout);
+        magma_dparilut_thrsrm( 1, &L_new, &thrsL, NULL, queue );//printf("done...");fflush(stdout);
+        magma_dparilut_thrsrm( 1, &U_new, &thrsU, NULL, queue );//printf("done...");fflush(stdout);
 
         
         // magma_dparilut_thrsrm_U( 1, L_new, &U_new, &thrsU, queue );
@@ -454,7 +447,7 @@ magma_dparilut(
 
     // for CUSPARSE
     CHECK( magma_dmtransfer( L, &precond->L, Magma_CPU, Magma_DEV , queue ));
-    magma_dcsrcoo_transpose( U, &UT, queue );
+    magma_dcsrcoo_transpose( U, &UT, NULL, queue );
     //magma_dmtranspose(U, &UT, queue );
     CHECK( magma_dmtransfer( UT, &precond->U, Magma_CPU, Magma_DEV , queue ));
 
@@ -0,0 +1,260 @@
+/*
+    -- MAGMA (version 2.6.2) --
+       Univ. of Tennessee, Knoxville
+       Univ. of California, Berkeley
+       Univ. of Colorado, Denver
+       @date April 2022
+
+       @generated from sparse/src/zpbicgstab_cpu.cpp, normal z -> d, Sun Oct 18 19:32:01 2026
+       @author Hartwig Anzt
+
+*/
+#include "magmasparse_internal.h"
+
+
+#define RTOLERANCE     lapackf77_dlamch( "E" )
+#define ATOLERANCE     lapackf77_dlamch( "E" )
+
+
+/**
+    Purpose
+    -------
+
+    Solves a system of linear equations
+       A * X = B
+    where A is a real N-by-N general matrix.
+    This is a CPU implementation of the preconditioned
+    Biconjugate Gradient Stabelized method: A, b, and x are expected in CPU
+    memory, the preconditioner has to be generated via
+    magma_d_precondsetup_cpu. The BLAS-1 operations and the SpMV are
+    OpenMP-parallel. For precond_par->solver == Magma_NONE, this is the
+    plain BiCGSTAB.
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_d_matrix
+                input matrix A
+
+    @param[in]
+    b           magma_d_matrix
+                RHS b
+
+    @param[in,out]
+    x           magma_d_matrix*
+                solution approximation
+
+    @param[in,out]
+    solver_par  magma_d_solver_par*
+                solver parameters
+
+    @param[in]
+    precond_par magma_d_preconditioner*
+                preconditioner parameters
+                
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_dgesv
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_dpbicgstab_cpu(
+    magma_d_matrix A, magma_d_matrix b, magma_d_matrix *x,
+    magma_d_solver_par *solver_par,
+    magma_d_preconditioner *precond_par,
+    magma_queue_t queue )
+{
+    magma_int_t info = MAGMA_NOTCONVERGED;
+    
+    // prepare solver feedback
+    solver_par->solver = ( precond_par->solver == Magma_NONE ) ?
+                                        Magma_BICGSTAB : Magma_PBICGSTAB;
+    solver_par->numiter = 0;
+    solver_par->spmv_count = 0;
+
+    // some useful variables
+    double c_zero = MAGMA_D_ZERO;
+    double c_one  = MAGMA_D_ONE;
+    double c_neg_one = MAGMA_D_NEG_ONE;
+    
+    magma_int_t dofs = A.num_rows*b.num_cols;
+
+    // workspace
+    magma_d_matrix r={Magma_CSR}, rr={Magma_CSR}, p={Magma_CSR}, v={Magma_CSR}, s={Magma_CSR}, t={Magma_CSR}, ms={Magma_CSR}, mt={Magma_CSR}, y={Magma_CSR}, z={Magma_CSR};
+    CHECK( magma_dvinit( &r, Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+    CHECK( magma_dvinit( &rr,Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+    CHECK( magma_dvinit( &p, Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+    CHECK( magma_dvinit( &v, Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+    CHECK( magma_dvinit( &s, Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+    CHECK( magma_dvinit( &t, Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+    CHECK( magma_dvinit( &ms,Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+    CHECK( magma_dvinit( &mt,Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+    CHECK( magma_dvinit( &y, Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+    CHECK( magma_dvinit( &z, Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+
+    
+    // solver variables
+    double alpha, beta, omega, rho_old, rho_new;
+    double betanom, nom0, r0, res, nomb;
+    res=0;
+    //double den;
+
+    // solver setup
+    CHECK(  magma_dresidualvec( A, b, *x, &r, &nom0, queue));
+    magma_dcopy_cpu( dofs, r.val, 1, rr.val, 1, queue );                  // rr = r
+    betanom = nom0;
+    rho_new = omega = alpha = MAGMA_D_MAKE( 1.0, 0. );
+    solver_par->init_res = nom0;
+
+    nomb = magma_dnrm2_cpu( dofs, b.val, 1, queue );
+    if ( nomb == 0.0 ){
+        nomb=1.0;
+    }       
+    if ( (r0 = nomb * solver_par->rtol) < ATOLERANCE ){
+        r0 = ATOLERANCE;
+    }
+    
+    solver_par->final_res = solver_par->init_res;
+    solver_par->iter_res = solver_par->init_res;
+    if ( solver_par->verbose > 0 ) {
+        solver_par->res_vec[0] = nom0;
+        solver_par->timing[0] = 0.0;
+    }
+    if ( nom0 < r0 ) {
+        info = MAGMA_SUCCESS;
+        goto cleanup;
+    }
+
+    //Chronometry
+    real_Double_t tempo1, tempo2;
+    tempo1 = magma_wtime();
+
+    solver_par->numiter = 0;
+    solver_par->spmv_count = 0;
+    // start iteration
+    do
+    {
+        solver_par->numiter++;
+        rho_old = rho_new;                                    // rho_old=rho
+
+        rho_new = magma_ddot_cpu( dofs, rr.val, 1, r.val, 1, queue );  // rho=<rr,r>
+        beta = rho_new/rho_old * alpha/omega;   // beta=rho/rho_old *alpha/omega
+        if( magma_d_isnan_inf( beta ) ){
+            info = MAGMA_DIVERGENCE;
+            break;
+        }
+        magma_dscal_cpu( dofs, beta, p.val, 1, queue );                 // p = beta*p
+        magma_daxpy_cpu( dofs, c_neg_one * omega * beta, v.val, 1 , p.val, 1, queue );
+                                                        // p = p-omega*beta*v
+        magma_daxpy_cpu( dofs, c_one, r.val, 1, p.val, 1, queue );      // p = p+r
+
+        // preconditioner
+        CHECK( magma_d_applyprecond_left_cpu( MagmaNoTrans, A, p, &mt, precond_par, queue ));
+        CHECK( magma_d_applyprecond_right_cpu( MagmaNoTrans, A, mt, &y, precond_par, queue ));
+        
+        CHECK( magma_d_spmv( c_one, A, y, c_zero, v, queue ));      // v = Ap
+        solver_par->spmv_count++;
+        alpha = rho_new / magma_ddot_cpu( dofs, rr.val, 1, v.val, 1, queue );
+        if( magma_d_isnan_inf( alpha ) ){
+            info = MAGMA_DIVERGENCE;
+            break;
+        }
+        magma_dcopy_cpu( dofs, r.val, 1 , s.val, 1, queue );            // s=r
+        magma_daxpy_cpu( dofs, c_neg_one * alpha, v.val, 1 , s.val, 1, queue ); // s=s-alpha*v
+
+        // preconditioner
+        CHECK( magma_d_applyprecond_left_cpu( MagmaNoTrans, A, s, &ms, precond_par, queue ));
+        CHECK( magma_d_applyprecond_right_cpu( MagmaNoTrans, A, ms, &z, precond_par, queue ));
+        
+        CHECK( magma_d_spmv( c_one, A, z, c_zero, t, queue ));       // t=As
+        solver_par->spmv_count++;                  
+       // omega = <s,t>/<t,t>
+        omega = magma_ddot_cpu( dofs, t.val, 1, s.val, 1, queue )
+                   / magma_ddot_cpu( dofs, t.val, 1, t.val, 1, queue );
+
+        magma_daxpy_cpu( dofs, alpha, y.val, 1 , x->val, 1, queue );     // x=x+alpha*p
+        if( magma_d_isnan_inf( omega ) ){
+                res = magma_dnrm2_cpu( dofs, r.val, 1, queue );
+            if ( res/nomb <= solver_par->rtol || res <= solver_par->atol ){
+                info = MAGMA_SUCCESS;
+            } else {
+                info = MAGMA_DIVERGENCE;
+            }
+            break;
+        }
+        magma_daxpy_cpu( dofs, omega, z.val, 1 , x->val, 1, queue );     // x=x+omega*s
+
+        magma_dcopy_cpu( dofs, s.val, 1 , r.val, 1, queue );             // r=s
+        magma_daxpy_cpu( dofs, c_neg_one * omega, t.val, 1 , r.val, 1, queue ); // r=r-omega*t
+        res = betanom = magma_dnrm2_cpu( dofs, r.val, 1, queue );
+
+        if ( solver_par->verbose > 0 ) {
+            tempo2 = magma_wtime();
+            if ( (solver_par->numiter)%solver_par->verbose==0 ) {
+                solver_par->res_vec[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) res;
+                solver_par->timing[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) tempo2-tempo1;
+            }
+        }
+
+        if ( res/nomb <= solver_par->rtol || res <= solver_par->atol ){
+            break;
+        }
+    }
+    while ( solver_par->numiter+1 <= solver_par->maxiter );
+    
+    tempo2 = magma_wtime();
+    solver_par->runtime = (real_Double_t) tempo2-tempo1;
+    double residual;
+    CHECK(  magma_dresidualvec( A, b, *x, &r, &residual, queue));
+    solver_par->final_res = residual;
+    solver_par->iter_res = res;
+
+    if ( solver_par->numiter < solver_par->maxiter && info == MAGMA_SUCCESS ) {
+        info = MAGMA_SUCCESS;
+    } else if ( solver_par->init_res > solver_par->final_res ) {
+        if ( solver_par->verbose > 0 ) {
+            if ( (solver_par->numiter)%solver_par->verbose==0 ) {
+                solver_par->res_vec[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) betanom;
+                solver_par->timing[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) tempo2-tempo1;
+            }
+        }
+        info = MAGMA_SLOW_CONVERGENCE;
+        if( solver_par->iter_res < solver_par->rtol*nomb ||
+            solver_par->iter_res < solver_par->atol ) {
+            info = MAGMA_SUCCESS;
+        }
+    }
+    else {
+        if ( solver_par->verbose > 0 ) {
+            if ( (solver_par->numiter)%solver_par->verbose==0 ) {
+                solver_par->res_vec[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) betanom;
+                solver_par->timing[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) tempo2-tempo1;
+            }
+        }
+        info = MAGMA_DIVERGENCE;
+    }
+    
+cleanup:
+    magma_dmfree(&r, queue );
+    magma_dmfree(&rr, queue );
+    magma_dmfree(&p, queue );
+    magma_dmfree(&v, queue );
+    magma_dmfree(&s, queue );
+    magma_dmfree(&t, queue );
+    magma_dmfree(&ms, queue );
+    magma_dmfree(&mt, queue );
+    magma_dmfree(&y, queue );
+    magma_dmfree(&z, queue );
+
+    solver_par->info = info;
+    return info;
+}   /* magma_dpbicgstab_cpu */
@@ -0,0 +1,400 @@
+/*
+    -- MAGMA (version 2.6.2) --
+       Univ. of Tennessee, Knoxville
+       Univ. of California, Berkeley
+       Univ. of Colorado, Denver
+       @date April 2022
+
+       @author Hartwig Anzt
+
+       @generated from sparse/src/zpipecg_cpu.cpp, normal z -> d, Sun Oct 18 19:42:20 2026
+*/
+
+#include "magmasparse_internal.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// partial sums of a thread are padded to a cache line
+#define PIPECG_STRIDE 8
+
+
+/*******************************************************************************
+    Purpose
+    -------
+
+    Solves a system of linear equations
+       A * X = B
+    where A is a real symmetric N-by-N positive definite matrix A.
+    This is a CPU implementation of the pipelined (preconditioned) Conjugate
+    Gradient method by Ghysels and Vanroose: the recurrences for
+    u = M^{-1} r and w = A u decouple the SpMV and the preconditioner from
+    the dot products. The whole iteration runs in a single OpenMP parallel
+    region: the partial sums of the dot products are computed in the vector
+    update sweep and combined while the SpMV of the next iteration is
+    computed, so an iteration needs only two barriers and no separate
+    reduction. The partial sums are combined in thread order, the
+    iterates are reproducible for a fixed number of threads.
+
+    A Jacobi preconditioner is fused into the update sweep, other
+    preconditioners (generated via magma_d_precondsetup_cpu) are applied
+    by one thread in between. For precond_par->solver == Magma_NONE, this
+    is the unpreconditioned pipelined CG.
+
+    The convergence check uses the residual norm available one SpMV later,
+    hence the SpMV count exceeds the iteration count by one.
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_d_matrix
+                input matrix A
+
+    @param[in]
+    b           magma_d_matrix
+                RHS b
+
+    @param[in,out]
+    x           magma_d_matrix*
+                solution approximation
+
+    @param[in,out]
+    solver_par  magma_d_solver_par*
+                solver parameters
+
+    @param[in]
+    precond_par magma_d_preconditioner*
+                preconditioner
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_dposv
+*******************************************************************************/
+
+extern "C" magma_int_t
+magma_dpipecg_cpu(
+    magma_d_matrix A, magma_d_matrix b, magma_d_matrix *x,
+    magma_d_solver_par *solver_par,
+    magma_d_preconditioner *precond_par,
+    magma_queue_t queue )
+{
+    magma_int_t info = MAGMA_NOTCONVERGED;
+
+    magma_int_t precond = ( precond_par->solver != Magma_NONE );
+    magma_int_t jacobi = ( precond_par->solver == Magma_JACOBI );
+
+    // prepare solver feedback
+    solver_par->solver = Magma_PIPECG;
+    solver_par->numiter = 0;
+    solver_par->spmv_count = 0;
+
+    // solver variables
+    double nom0, nomb, res=0.0;
+    double c_zero = MAGMA_D_ZERO;
+    magma_int_t dofs = A.num_rows* b.num_cols;
+    magma_int_t num_threads = 1, numiter = 0, spmv_count = 0;
+    real_Double_t tempo1, tempo2;
+    double *partial = NULL;
+
+    magma_d_matrix C={Magma_CSR}, r={Magma_CSR}, u={Magma_CSR}, w={Magma_CSR},
+                   m={Magma_CSR}, nv={Magma_CSR}, z={Magma_CSR}, q={Magma_CSR},
+                   s={Magma_CSR}, p={Magma_CSR}, rt={Magma_CSR};
+    double *val, *uval, *mval, *qval, *dinv = NULL;
+    magma_index_t *row, *col;
+
+    // the fused SpMV needs CSR
+    if ( A.storage_type == Magma_CSR || A.storage_type == Magma_CUCSR ) {
+        val = A.val;
+        row = A.row;
+        col = A.col;
+    } else {
+        CHECK( magma_dmconvert( A, &C, A.storage_type, Magma_CSR, queue ));
+        val = C.val;
+        row = C.row;
+        col = C.col;
+    }
+
+    // CPU workspace, for the unpreconditioned method u = r, m = w, q = s
+    CHECK( magma_dvinit( &r, Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+    CHECK( magma_dvinit( &w, Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+    CHECK( magma_dvinit( &nv,Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+    CHECK( magma_dvinit( &z, Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+    CHECK( magma_dvinit( &s, Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+    CHECK( magma_dvinit( &p, Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+    if ( precond ) {
+        CHECK( magma_dvinit( &u, Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+        CHECK( magma_dvinit( &m, Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+        CHECK( magma_dvinit( &q, Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+        CHECK( magma_dvinit( &rt,Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+        uval = u.val;
+        mval = m.val;
+        qval = q.val;
+    } else {
+        uval = r.val;
+        mval = w.val;
+        qval = s.val;
+    }
+    if ( jacobi ) {
+        dinv = precond_par->d.val;
+    }
+
+    #ifdef _OPENMP
+    num_threads = omp_get_max_threads();
+    #endif
+    CHECK( magma_dmalloc_cpu( &partial, PIPECG_STRIDE*num_threads ));
+
+    // solver setup: r = b - A x, u = M^{-1} r, w = A u
+    CHECK(  magma_dresidualvec( A, b, *x, &r, &nom0, queue));
+    if ( precond ) {
+        CHECK( magma_d_applyprecond_left_cpu( MagmaNoTrans, A, r, &rt, precond_par, queue ));
+        CHECK( magma_d_applyprecond_right_cpu( MagmaNoTrans, A, rt, &u, precond_par, queue ));
+        CHECK( magma_d_spmv( MAGMA_D_ONE, A, u, c_zero, w, queue ));
+    } else {
+        CHECK( magma_d_spmv( MAGMA_D_ONE, A, r, c_zero, w, queue ));
+    }
+    spmv_count++;
+    solver_par->init_res = nom0;
+
+    nomb = magma_dnrm2_cpu( dofs, b.val, 1, queue );
+    if ( nomb == 0.0 ){
+        nomb=1.0;
+    }
+    solver_par->final_res = solver_par->init_res;
+    solver_par->iter_res = solver_par->init_res;
+    if ( solver_par->verbose > 0 ) {
+        solver_par->res_vec[0] = (real_Double_t)nom0;
+        solver_par->timing[0] = 0.0;
+    }
+    if ( nom0 < solver_par->atol ||
+         nom0/nomb < solver_par->rtol ) {
+        info = MAGMA_SUCCESS;
+        goto cleanup;
+    }
+
+    //Chronometry
+    tempo1 = magma_wtime();
+
+    #pragma omp parallel
+    {
+        magma_int_t tid = 0, nt = 1, it = 0;
+        double alpha = c_zero, beta, gamma, delta,
+                           alphaold = c_zero, gammaold = c_zero;
+        double rr, lres, lg_re, lg_im, ld_re, ld_im, lrr;
+        #ifdef _OPENMP
+        tid = omp_get_thread_num();
+        nt = omp_get_num_threads();
+        #endif
+        double *lp = partial + PIPECG_STRIDE*tid;
+
+        // initial partial sums: gamma = <r,u>, delta = <u,w>, rr = <r,r>
+        lg_re = lg_im = ld_re = ld_im = lrr = 0.0;
+        #pragma omp for schedule(static) nowait
+        for( magma_int_t i=0; i<dofs; i++ ){
+            double g = MAGMA_D_CONJ( r.val[i] ) * uval[i];
+            double d = MAGMA_D_CONJ( uval[i] ) * w.val[i];
+            lg_re += MAGMA_D_REAL( g );
+            lg_im += MAGMA_D_IMAG( g );
+            ld_re += MAGMA_D_REAL( d );
+            ld_im += MAGMA_D_IMAG( d );
+            lrr += MAGMA_D_REAL( r.val[i] ) * MAGMA_D_REAL( r.val[i] )
+                 + MAGMA_D_IMAG( r.val[i] ) * MAGMA_D_IMAG( r.val[i] );
+            if ( jacobi ) {
+                mval[i] = dinv[i] * w.val[i];
+            }
+        }
+        lp[0] = lg_re; lp[1] = lg_im; lp[2] = ld_re; lp[3] = ld_im; lp[4] = lrr;
+        #pragma omp barrier
+
+        while( 1 ) {
+            // m = M^{-1} w, Jacobi is applied in the update sweep
+            if ( precond && !jacobi ) {
+                #pragma omp single
+                {
+                    magma_int_t pinfo;
+                    pinfo = magma_d_applyprecond_left_cpu( MagmaNoTrans, A, w, &rt, precond_par, queue );
+                    if ( pinfo == MAGMA_SUCCESS ) {
+                        pinfo = magma_d_applyprecond_right_cpu( MagmaNoTrans, A, rt, &m, precond_par, queue );
+                    }
+                    if ( pinfo != MAGMA_SUCCESS ) {
+                        info = pinfo;
+                    }
+                }
+            }
+
+            // n = A m; no barrier before combining the partial sums of the
+            // previous sweep, the reduction overlaps with the SpMV
+            #pragma omp for schedule(static) nowait
+            for( magma_int_t i=0; i<dofs; i++ ){
+                double dot = c_zero;
+                for( magma_int_t j=row[i]; j<row[i+1]; j++ ){
+                    dot += val[j] * mval[ col[j] ];
+                }
+                nv.val[i] = dot;
+            }
+            lg_re = lg_im = ld_re = ld_im = rr = 0.0;
+            for( magma_int_t t=0; t<nt; t++ ){
+                lg_re += partial[PIPECG_STRIDE*t+0];
+                lg_im += partial[PIPECG_STRIDE*t+1];
+                ld_re += partial[PIPECG_STRIDE*t+2];
+                ld_im += partial[PIPECG_STRIDE*t+3];
+                rr    += partial[PIPECG_STRIDE*t+4];
+            }
+            gamma = MAGMA_D_MAKE( lg_re, lg_im );
+            delta = MAGMA_D_MAKE( ld_re, ld_im );
+            #pragma omp master
+            {
+                spmv_count++;
+            }
+            #pragma omp barrier
+
+            // all threads hold the same values, hence take the same branch
+            lres = sqrt( rr );
+            if ( it > 0 ) {
+                #pragma omp master
+                {
+                    res = lres;
+                    if ( solver_par->verbose > 0 ) {
+                        tempo2 = magma_wtime();
+                        if ( (it)%solver_par->verbose == 0 ) {
+                            solver_par->res_vec[(it)/solver_par->verbose]
+                                    = (real_Double_t) lres;
+                            solver_par->timing[(it)/solver_par->verbose]
+                                    = (real_Double_t) tempo2-tempo1;
+                        }
+                    }
+                }
+                if ( lres/nomb <= solver_par->rtol || lres <= solver_par->atol ){
+                    break;
+                }
+            }
+            if ( it+1 > solver_par->maxiter || info != MAGMA_NOTCONVERGED ) {
+                break;
+            }
+
+            if ( it == 0 ) {
+                beta = c_zero;
+                alpha = gamma / delta;
+            } else {
+                beta = gamma / gammaold;
+                alpha = gamma / ( delta - beta * gamma / alphaold );
+            }
+            if ( magma_d_isnan_inf( alpha ) || magma_d_isnan_inf( beta ) ) {
+                #pragma omp master
+                {
+                    info = MAGMA_DIVERGENCE;
+                }
+                break;
+            }
+            gammaold = gamma;
+            alphaold = alpha;
+            it++;
+
+            // vector updates and partial sums for the next iteration
+            lg_re = lg_im = ld_re = ld_im = lrr = 0.0;
+            if ( precond ) {
+                #pragma omp for schedule(static) nowait
+                for( magma_int_t i=0; i<dofs; i++ ){
+                    double zi = nv.val[i] + beta * z.val[i];
+                    double qi = mval[i] + beta * qval[i];
+                    double si = w.val[i] + beta * s.val[i];
+                    double pi = uval[i] + beta * p.val[i];
+                    double ri = r.val[i] - alpha * si;
+                    double ui = uval[i] - alpha * qi;
+                    double wi = w.val[i] - alpha * zi;
+                    z.val[i] = zi;
+                    qval[i] = qi;
+                    s.val[i] = si;
+                    p.val[i] = pi;
+                    x->val[i] = x->val[i] + alpha * pi;
+                    r.val[i] = ri;
+                    uval[i] = ui;
+                    w.val[i] = wi;
+                    if ( jacobi ) {
+                        mval[i] = dinv[i] * wi;
+                    }
+                    double g = MAGMA_D_CONJ( ri ) * ui;
+                    double d = MAGMA_D_CONJ( ui ) * wi;
+                    lg_re += MAGMA_D_REAL( g );
+                    lg_im += MAGMA_D_IMAG( g );
+                    ld_re += MAGMA_D_REAL( d );
+                    ld_im += MAGMA_D_IMAG( d );
+                    lrr += MAGMA_D_REAL( ri ) * MAGMA_D_REAL( ri )
+                         + MAGMA_D_IMAG( ri ) * MAGMA_D_IMAG( ri );
+                }
+                lp[0] = lg_re; lp[1] = lg_im; lp[2] = ld_re; lp[3] = ld_im; lp[4] = lrr;
+            } else {
+                #pragma omp for schedule(static) nowait
+                for( magma_int_t i=0; i<dofs; i++ ){
+                    double zi = nv.val[i] + beta * z.val[i];
+                    double si = w.val[i] + beta * s.val[i];
+                    double pi = r.val[i] + beta * p.val[i];
+                    double ri = r.val[i] - alpha * si;
+                    double wi = w.val[i] - alpha * zi;
+                    z.val[i] = zi;
+                    s.val[i] = si;
+                    p.val[i] = pi;
+                    x->val[i] = x->val[i] + alpha * pi;
+                    r.val[i] = ri;
+                    w.val[i] = wi;
+                    double d = MAGMA_D_CONJ( ri ) * wi;
+                    ld_re += MAGMA_D_REAL( d );
+                    ld_im += MAGMA_D_IMAG( d );
+                    lrr += MAGMA_D_REAL( ri ) * MAGMA_D_REAL( ri )
+                         + MAGMA_D_IMAG( ri ) * MAGMA_D_IMAG( ri );
+                }
+                lp[0] = lrr; lp[1] = 0.0; lp[2] = ld_re; lp[3] = ld_im; lp[4] = lrr;
+            }
+            #pragma omp barrier
+        }
+        #pragma omp master
+        {
+            numiter = it;
+        }
+    }
+    solver_par->numiter = numiter;
+    solver_par->spmv_count = spmv_count;
+    if ( info != MAGMA_NOTCONVERGED && info != MAGMA_DIVERGENCE ) {
+        goto cleanup;
+    }
+
+    tempo2 = magma_wtime();
+    solver_par->runtime = (real_Double_t) tempo2-tempo1;
+    double residual;
+    CHECK(  magma_dresidualvec( A, b, *x, &r, &residual, queue));
+    solver_par->iter_res = res;
+    solver_par->final_res = residual;
+
+    if ( info == MAGMA_DIVERGENCE ) {
+        // keep the error code
+    } else if ( solver_par->numiter < solver_par->maxiter ) {
+        info = MAGMA_SUCCESS;
+    } else if ( solver_par->init_res > solver_par->final_res ) {
+        info = MAGMA_SLOW_CONVERGENCE;
+        if( solver_par->iter_res < solver_par->rtol*nomb ||
+            solver_par->iter_res < solver_par->atol ) {
+            info = MAGMA_SUCCESS;
+        }
+    }
+    else {
+        info = MAGMA_DIVERGENCE;
+    }
+
+cleanup:
+    magma_dmfree(&C, queue );
+    magma_dmfree(&r, queue );
+    magma_dmfree(&u, queue );
+    magma_dmfree(&w, queue );
+    magma_dmfree(&m, queue );
+    magma_dmfree(&nv, queue );
+    magma_dmfree(&z, queue );
+    magma_dmfree(&q, queue );
+    magma_dmfree(&s, queue );
+    magma_dmfree(&p, queue );
+    magma_dmfree(&rt, queue );
+    magma_free_cpu( partial );
+
+    solver_par->info = info;
+    return info;
+}   /* magma_dpipecg_cpu */
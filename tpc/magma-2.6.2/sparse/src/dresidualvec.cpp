@@ -5,7 +5,7 @@
        Univ. of Colorado, Denver
        @date April 2022
 
-       @generated from sparse/src/zresidualvec.cpp, normal z -> d, Wed Apr 20 17:38:07 2022
+       @generated from sparse/src/zresidualvec.cpp, normal z -> d, Sun Oct 18 19:32:00 2026
        @author Hartwig Anzt
 
 */
@@ -64,7 +64,11 @@ magma_dresidualvec(
                                             mone = MAGMA_D_NEG_ONE;
     magma_int_t dofs = A.num_rows;
     
-    if ( A.num_rows == b.num_rows ) {
+    if ( A.num_rows == b.num_rows && A.memory_location == Magma_CPU ) {
+        CHECK( magma_d_spmv( mone, A, x, zero, *r, queue ));      // r = A x
+        magma_daxpy_cpu( dofs, one, b.val, 1, r->val, 1, queue );     // r = r - b
+        *res =  magma_dnrm2_cpu( dofs, r->val, 1, queue );       // res = ||r||
+    } else if ( A.num_rows == b.num_rows ) {
         CHECK( magma_d_spmv( mone, A, x, zero, *r, queue ));      // r = A x
         magma_daxpy( dofs, one, b.dval, 1, r->dval, 1, queue );          // r = r - b
         *res =  magma_dnrm2( dofs, r->dval, 1, queue );            // res = ||r||
@@ -5,7 +5,7 @@
        Univ. of Colorado, Denver
        @date April 2022
 
-       @generated from sparse/src/magma_z_precond_wrapper.cpp, normal z -> c, Wed Apr 20 17:38:07 2022
+       @generated from sparse/src/magma_z_precond_wrapper.cpp, normal z -> c, Sun Oct 18 21:46:28 2026
        @author Hartwig Anzt
 
 */
@@ -65,6 +65,7 @@ magma_c_precond(
     magma_c_preconditioner pprecond;
     pprecond.solver = Magma_NONE;
     pprecond.maxiter = 3;
+    magma_c_matrix t={Magma_CSR};
 
     switch( precond->solver ) {
         case  Magma_CG:
@@ -87,10 +88,21 @@ magma_c_precond(
                 CHECK( magma_ctfqmr( A, b, x, &psolver_par, queue )); break;
         case  Magma_BAITERO:
                 CHECK( magma_cbaiter_overlap( A, b, x, &psolver_par, &pprecond, queue )); break;
+        case  Magma_MCILU:
+        case  Magma_MCSGS:
+                // one application of the multicolor preconditioner, CPU only
+                if ( precond->perm == NULL ) {
+                    CHECK( magma_c_precondsetup_cpu( A, b, &psolver_par, precond, queue ));
+                }
+                CHECK( magma_cvinit( &t, Magma_CPU, b.num_rows, b.num_cols, MAGMA_C_ZERO, queue ));
+                CHECK( magma_c_applyprecond_left_cpu( MagmaNoTrans, A, b, &t, precond, queue ));
+                CHECK( magma_c_applyprecond_right_cpu( MagmaNoTrans, A, t, x, precond, queue ));
+                break;
         default:
                 CHECK( magma_ccg_res( A, b, x, &psolver_par, queue )); break;
     }
 cleanup:
+    magma_cmfree( &t, queue );
     return info;
 }
 
@@ -189,6 +201,25 @@ magma_c_precondsetup(
              }
         }
     }
+    else if ( precond->solver == Magma_PARILUB ) {
+        #ifdef _OPENMP
+            info = magma_cparilu_block_cpu( A, b, precond, queue );
+            if ( precond->trisolver == Magma_ISAI  ||
+                precond->trisolver == Magma_JACOBI ||
+                precond->trisolver == Magma_VBJACOBI ){
+                info = magma_ciluisaisetup_lower( precond->L, precond->L, &precond->LD, queue );
+                info = magma_ciluisaisetup_upper( precond->U, precond->U, &precond->UD, queue );
+                if (info == Magma_CUSOLVE) {
+                    precond->trisolver = Magma_CUSOLVE;
+                    info = 0;
+                }
+            }
+            precond->solver = Magma_PARILU; // handle as PARILU
+        #else
+            printf( "error: preconditioner requires OpenMP.\n" );
+            info = MAGMA_ERR_NOT_SUPPORTED;
+        #endif
+    }
     else if ( precond->solver == Magma_ILUT ) {
         printf( "error: preconditioner requires OpenMP.\n" );
         info = MAGMA_ERR_NOT_SUPPORTED;
@@ -703,3 +734,363 @@ magma_c_applyprecond_right(
 cleanup:
     return info;
 }
+
+
+
+/**
+    Purpose
+    -------
+
+    For a given input matrix A and the preconditioner parameters, the
+    respective preconditioner is generated on the CPU. In contrast to
+    magma_c_precondsetup, all preconditioner data is kept in CPU memory,
+    so it can be used by the host solvers called from magma_c_solver for
+    host-resident linear systems. Supported preconditioners are
+    Jacobi, ILU / ICC (exact incomplete factorization) and
+    ParILU / ParIC (fixed-point sweeps). For the latter, precond->trisolver
+    = Magma_ISAI replaces the triangular solves by sparse approximate
+    inverses of the factors that are applied as sparse matrix vector
+    products.
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_c_matrix
+                sparse matrix M
+
+    @param[in]
+    b           magma_c_matrix
+                input vector y
+    
+    @param[in]
+    solver      magma_c_solver_par
+                solver structure using the preconditioner
+                
+    @param[in,out]
+    precond     magma_c_preconditioner
+                preconditioner
+                
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_caux
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_c_precondsetup_cpu(
+    magma_c_matrix A, magma_c_matrix b,
+    magma_c_solver_par *solver,
+    magma_c_preconditioner *precond,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+    
+    magma_c_matrix hA={Magma_CSR}, hAT={Magma_CSR};
+
+    //Chronometry
+    real_Double_t tempo1, tempo2;
+    
+    tempo1 = magma_sync_wtime( queue );
+    
+    if( A.num_rows != A.num_cols ){
+        printf("%% warning: non-square matrix.\n");
+        printf("%% Fallback: no preconditioner.\n");
+        precond->solver = Magma_NONE;
+    } 
+    
+    if ( precond->solver == Magma_JACOBI ) {
+        if ( A.memory_location != Magma_CPU || A.storage_type != Magma_CSR ) {
+            CHECK( magma_cmtransfer( A, &hAT, A.memory_location, Magma_CPU, queue ));
+            CHECK( magma_cmconvert( hAT, &hA, hAT.storage_type, Magma_CSR, queue ));
+        } else {
+            CHECK( magma_cmtransfer( A, &hA, Magma_CPU, Magma_CPU, queue ));
+        }
+        magma_cmfree( &precond->d, queue );
+        CHECK( magma_cvinit( &precond->d, Magma_CPU, hA.num_rows, 1,
+                                                    MAGMA_C_ZERO, queue ));
+        #pragma omp parallel for
+        for( magma_int_t i=0; i<hA.num_rows; i++ ) {
+            for( magma_int_t j=hA.row[i]; j<hA.row[i+1]; j++ ) {
+                if ( hA.col[j] == i ) {
+                    precond->d.val[i] = MAGMA_C_ONE / hA.val[j];
+                }
+            }
+        }
+        for( magma_int_t i=0; i<hA.num_rows; i++ ) {
+            if ( MAGMA_C_EQUAL( precond->d.val[i], MAGMA_C_ZERO ) ) {
+                printf(" error: zero diagonal element in row %d!\n", int(i));
+                info = MAGMA_ERR_BADPRECOND;
+                goto cleanup;
+            }
+        }
+    }
+    // ILU and related, for symmetric A the ILU factors give the IC product
+    else if ( precond->solver == Magma_ILU ||
+              precond->solver == Magma_ICC ) {
+        CHECK( magma_cilusetup_cpu( A, precond, queue ));
+    }
+    else if ( precond->solver == Magma_PARILU ||
+              precond->solver == Magma_PARIC ) {
+        CHECK( magma_cparilusetup_cpu( A, precond, queue ));
+    }
+    else if ( precond->solver == Magma_PARILUB ) {
+        CHECK( magma_cparilu_blocksetup_cpu( A, precond, queue ));
+        precond->solver = Magma_PARILU; // handle as PARILU
+    }
+    // multicolor ILU(0) and symmetric Gauss-Seidel
+    else if ( precond->solver == Magma_MCILU ) {
+        CHECK( magma_cmcilusetup_cpu( A, precond, queue ));
+    }
+    else if ( precond->solver == Magma_MCSGS ) {
+        CHECK( magma_cmcsgssetup_cpu( A, precond, queue ));
+    }
+    // none case
+    else if ( precond->solver == Magma_NONE ) {
+        info = MAGMA_SUCCESS;
+    }
+    else {
+        printf( "error: preconditioner type not supported on the CPU.\n" );
+        info = MAGMA_ERR_NOT_SUPPORTED;
+    }
+    
+    // ISAI for the incomplete factors, with the pattern of the factors
+    if ( info == 0 && precond->trisolver == Magma_ISAI &&
+         ( precond->solver == Magma_ILU    ||
+           precond->solver == Magma_PARILU ||
+           precond->solver == Magma_ICC    ||
+           precond->solver == Magma_PARIC ) ) {
+        CHECK( magma_ciluisaisetup_lower_cpu( precond->L, precond->L,
+                                              &precond->LD, queue ));
+        CHECK( magma_ciluisaisetup_upper_cpu( precond->U, precond->U,
+                                              &precond->UD, queue ));
+        if ( precond->maxiter > 0 ) {
+            magma_cmfree( &precond->d, queue );
+            magma_cmfree( &precond->work1, queue );
+            magma_cmfree( &precond->work2, queue );
+            CHECK( magma_cvinit( &precond->d, Magma_CPU, A.num_rows, 1,
+                                                    MAGMA_C_ZERO, queue ));
+            CHECK( magma_cvinit( &precond->work1, Magma_CPU, A.num_rows, 1,
+                                                    MAGMA_C_ZERO, queue ));
+            CHECK( magma_cvinit( &precond->work2, Magma_CPU, A.num_rows, 1,
+                                                    MAGMA_C_ZERO, queue ));
+        }
+    }
+    
+    tempo2 = magma_sync_wtime( queue );
+    precond->setuptime = tempo2-tempo1;
+    
+cleanup:
+    magma_cmfree( &hA, queue );
+    magma_cmfree( &hAT, queue );
+    return info;
+}
+
+
+/**
+    Purpose
+    -------
+
+    For a given input matrix A and vectors x, y and the
+    preconditioner parameters, the respective left preconditioner
+    is applied on the CPU. The preconditioner has to be generated by
+    magma_c_precondsetup_cpu, and b, x have to be located in CPU memory.
+    E.g. for Jacobi: the scaling-vetor, for ILU the left triangular solve.
+
+    Arguments
+    ---------
+
+    @param[in]
+    trans       magma_trans_t
+                mode of the preconditioner: only MagmaNoTrans
+                
+    @param[in]
+    A           magma_c_matrix
+                sparse matrix A
+
+    @param[in]
+    b           magma_c_matrix
+                input vector b
+
+    @param[in,out]
+    x           magma_c_matrix*
+                output vector x
+
+    @param[in]
+    precond     magma_c_preconditioner
+                preconditioner
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_caux
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_c_applyprecond_left_cpu(
+    magma_trans_t trans,
+    magma_c_matrix A,
+    magma_c_matrix b,
+    magma_c_matrix *x,
+    magma_c_preconditioner *precond,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+    
+    //Chronometry
+    real_Double_t tempo1, tempo2;
+    
+    tempo1 = magma_wtime();
+    
+    if ( trans != MagmaNoTrans ) {
+        printf( "error: preconditioner type not yet supported.\n" );
+        info = MAGMA_ERR_NOT_SUPPORTED;
+    }
+    else if ( precond->solver == Magma_JACOBI ) {
+        #pragma omp parallel for
+        for( magma_int_t i=0; i<b.num_rows; i++ ) {
+            x->val[i] = precond->d.val[i] * b.val[i];
+        }
+    }
+    else if ( precond->solver == Magma_ILU    ||
+              precond->solver == Magma_PARILU ||
+              precond->solver == Magma_ICC    ||
+              precond->solver == Magma_PARIC ) {
+        if ( precond->trisolver == Magma_ISAI ) {
+            CHECK( magma_cisai_l_cpu( b, x, precond, queue ));
+        } else {
+            CHECK( magma_ccsrtrsv_cpu( MagmaLower, precond->L, b.val, x->val, queue ));
+        }
+    }
+    else if ( precond->solver == Magma_MCILU ||
+              precond->solver == Magma_MCSGS ) {
+        // x is in the color ordering, magma_c_applyprecond_right_cpu
+        // maps back
+        #pragma omp parallel for
+        for( magma_int_t i=0; i<b.num_rows; i++ ) {
+            precond->work1.val[i] = b.val[precond->perm[i]];
+        }
+        CHECK( magma_ccsrtrsv_mc_cpu( MagmaLower, precond->L, precond->ncolors,
+                    precond->colorptr, precond->work1.val, x->val, queue ));
+    }
+    else if ( precond->solver == Magma_NONE ) {
+        magma_ccopy_cpu( b.num_rows*b.num_cols, b.val, 1, x->val, 1, queue );      //  x = b
+    }
+    else {
+        printf( "error: preconditioner type not yet supported.\n" );
+        info = MAGMA_ERR_NOT_SUPPORTED; 
+    }
+    
+    tempo2 = magma_wtime();
+    precond->runtime += tempo2-tempo1;
+    
+cleanup:
+    return info;
+}
+
+
+/**
+    Purpose
+    -------
+
+    For a given input matrix A and vectors x, y and the
+    preconditioner parameters, the respective right-preconditioner
+    is applied on the CPU. The preconditioner has to be generated by
+    magma_c_precondsetup_cpu, and b, x have to be located in CPU memory.
+    E.g. for Jacobi: the scaling-vetor, for ILU the right triangular solve.
+
+    Arguments
+    ---------
+    
+    @param[in]
+    trans       magma_trans_t
+                mode of the preconditioner: only MagmaNoTrans
+
+    @param[in]
+    A           magma_c_matrix
+                sparse matrix A
+
+    @param[in]
+    b           magma_c_matrix
+                input vector b
+
+    @param[in,out]
+    x           magma_c_matrix*
+                output vector x
+
+    @param[in]
+    precond     magma_c_preconditioner
+                preconditioner
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_caux
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_c_applyprecond_right_cpu(
+    magma_trans_t trans,
+    magma_c_matrix A,
+    magma_c_matrix b,
+    magma_c_matrix *x,
+    magma_c_preconditioner *precond,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+    
+    //Chronometry
+    real_Double_t tempo1, tempo2;
+    
+    tempo1 = magma_wtime();
+    
+    if ( trans != MagmaNoTrans ) {
+        printf( "error: preconditioner type not yet supported.\n" );
+        info = MAGMA_ERR_NOT_SUPPORTED;
+    }
+    else if ( precond->solver == Magma_ILU    ||
+              precond->solver == Magma_PARILU ||
+              precond->solver == Magma_ICC    ||
+              precond->solver == Magma_PARIC ) {
+        if ( precond->trisolver == Magma_ISAI ) {
+            CHECK( magma_cisai_r_cpu( b, x, precond, queue ));
+        } else {
+            CHECK( magma_ccsrtrsv_cpu( MagmaUpper, precond->U, b.val, x->val, queue ));
+        }
+    }
+    else if ( precond->solver == Magma_MCILU ||
+              precond->solver == Magma_MCSGS ) {
+        // b is in the color ordering, for SGS scale with the diagonal
+        if ( precond->solver == Magma_MCSGS ) {
+            #pragma omp parallel for
+            for( magma_int_t i=0; i<b.num_rows; i++ ) {
+                precond->work2.val[i] = precond->d.val[i] * b.val[i];
+            }
+        } else {
+            magma_ccopy_cpu( b.num_rows, b.val, 1, precond->work2.val, 1, queue );
+        }
+        CHECK( magma_ccsrtrsv_mc_cpu( MagmaUpper, precond->U, precond->ncolors,
+                    precond->colorptr, precond->work2.val, precond->work1.val, queue ));
+        #pragma omp parallel for
+        for( magma_int_t i=0; i<b.num_rows; i++ ) {
+            x->val[precond->perm[i]] = precond->work1.val[i];
+        }
+    }
+    else if ( precond->solver == Magma_JACOBI ||
+              precond->solver == Magma_NONE ) {
+        magma_ccopy_cpu( b.num_rows*b.num_cols, b.val, 1, x->val, 1, queue );      //  x = b
+    }
+    else {
+        printf( "error: preconditioner type not yet supported.\n" );
+        info = MAGMA_ERR_NOT_SUPPORTED;
+    }
+    
+    tempo2 = magma_wtime();
+    precond->runtime += tempo2-tempo1;
+        
+cleanup:
+    return info;
+}
@@ -5,7 +5,7 @@
        Univ. of Colorado, Denver
        @date April 2022
 
-       @generated from sparse/src/magma_z_solver_wrapper.cpp, normal z -> s, Wed Apr 20 17:38:07 2022
+       @generated from sparse/src/magma_z_solver_wrapper.cpp, normal z -> s, Sun Oct 18 19:42:21 2026
        @author Hartwig Anzt
 
 */
@@ -20,6 +20,9 @@
     system Ax = b. All linear algebra objects are expected to be on the device,
     the linear algebra objects are MAGMA-sparse specific structures 
     (dense matrix b, dense matrix x, sparse/dense matrix A).
+    If A and b are located in CPU memory, the OpenMP host implementation of
+    the solver is used instead (CG, BiCGSTAB, GMRES, and IDR families); the
+    preconditioner then has to be generated via magma_s_precondsetup_cpu.
     The additional parameter zopts contains information about the solver
     and the preconditioner.
     * the type of solver
@@ -68,7 +71,41 @@ magma_s_solver(
         printf( "error: sparse RHS not yet supported.\n" );
         return MAGMA_ERR_NOT_SUPPORTED;
     }
-    if( b.num_cols == 1 ){
+    if( b.num_cols == 1 && A.memory_location == Magma_CPU
+                        && b.memory_location == Magma_CPU ){
+        // CG and BiCGSTAB have merged host variants using fused OpenMP
+        // kernels, the remaining merged variants map to the basic ones
+        switch( zopts->solver_par.solver ) {
+            case  Magma_CG:
+            case  Magma_PCG:
+                    CHECK( magma_spcg_cpu( A, b, x, &zopts->solver_par, &zopts->precond_par, queue )); break;
+            case  Magma_CGMERGE:
+            case  Magma_PCGMERGE:
+                    CHECK( magma_spcg_merge_cpu( A, b, x, &zopts->solver_par, &zopts->precond_par, queue )); break;
+            case  Magma_BICGSTABMERGE:
+                    CHECK( magma_sbicgstab_merge_cpu( A, b, x, &zopts->solver_par, queue )); break;
+            case  Magma_BICGSTAB:
+            case  Magma_PBICGSTAB:
+            case  Magma_PBICGSTABMERGE:
+                    CHECK( magma_spbicgstab_cpu( A, b, x, &zopts->solver_par, &zopts->precond_par, queue )); break;
+            case  Magma_GMRES:
+            case  Magma_PGMRES:
+                    CHECK( magma_sfgmres_cpu( A, b, x, &zopts->solver_par, &zopts->precond_par, queue )); break;
+            case  Magma_IDR:
+            case  Magma_IDRMERGE:
+            case  Magma_PIDR:
+            case  Magma_PIDRMERGE:
+                    CHECK( magma_spidr_cpu( A, b, x, &zopts->solver_par, &zopts->precond_par, queue )); break;
+            case  Magma_PIPECG:
+                    CHECK( magma_spipecg_cpu( A, b, x, &zopts->solver_par, &zopts->precond_par, queue )); break;
+            case  Magma_SSTEPCG:
+                    CHECK( magma_ssstepcg_cpu( A, b, x, &zopts->solver_par, queue )); break;
+            default:
+                    printf("error: solver class not supported on the CPU.\n");
+                    info = MAGMA_ERR_NOT_SUPPORTED; break;
+        }
+    }
+    else if( b.num_cols == 1 ){
         switch( zopts->solver_par.solver ) {
             case  Magma_BICG:
                     CHECK( magma_sbicg( A, b, x, &zopts->solver_par, queue )); break;
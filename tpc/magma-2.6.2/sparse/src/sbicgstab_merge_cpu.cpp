@@ -0,0 +1,220 @@
+/*
+    -- MAGMA (version 2.6.2) --
+       Univ. of Tennessee, Knoxville
+       Univ. of California, Berkeley
+       Univ. of Colorado, Denver
+       @date April 2022
+
+       @generated from sparse/src/zbicgstab_merge_cpu.cpp, normal z -> s, Sun Oct 18 19:36:21 2026
+       @author Hartwig Anzt
+
+*/
+#include "magmasparse_internal.h"
+
+
+/**
+    Purpose
+    -------
+
+    Solves a system of linear equations
+       A * X = B
+    where A is a general matrix.
+    This is a CPU implementation of the Biconjugate Gradient Stabilized
+    method, where the vector updates and dot products are merged into fused
+    OpenMP kernels: per iteration, the vectors are swept five times (two of
+    the sweeps being the SpMVs) instead of ten times in magma_spbicgstab_cpu.
+    A, b, and x are expected in CPU memory.
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_s_matrix
+                input matrix A
+
+    @param[in]
+    b           magma_s_matrix
+                RHS b
+
+    @param[in,out]
+    x           magma_s_matrix*
+                solution approximation
+
+    @param[in,out]
+    solver_par  magma_s_solver_par*
+                solver parameters
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_sgesv
+    ********************************************************************/
+
+extern "C" magma_int_t
+magma_sbicgstab_merge_cpu(
+    magma_s_matrix A, magma_s_matrix b, magma_s_matrix *x,
+    magma_s_solver_par *solver_par,
+    magma_queue_t queue )
+{
+    magma_int_t info = MAGMA_NOTCONVERGED;
+
+    // prepare solver feedback
+    solver_par->solver = Magma_BICGSTABMERGE;
+    solver_par->numiter = 0;
+    solver_par->spmv_count = 0;
+
+    // some useful variables
+    float c_zero = MAGMA_S_ZERO;
+
+    magma_int_t dofs = A.num_rows * b.num_cols;
+
+    // workspace
+    magma_s_matrix r={Magma_CSR}, rr={Magma_CSR}, p={Magma_CSR}, v={Magma_CSR},
+    s={Magma_CSR}, t={Magma_CSR};
+    CHECK( magma_svinit( &r, Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+    CHECK( magma_svinit( &rr,Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+    CHECK( magma_svinit( &p, Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+    CHECK( magma_svinit( &v, Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+    CHECK( magma_svinit( &s, Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+    CHECK( magma_svinit( &t, Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+
+    // solver variables
+    float alpha, beta, omega, rho_old, rho_new, rrv, ts;
+    float nom0, nrm2, tt, res, nomb;
+    res=0;
+
+    // solver setup
+    CHECK(  magma_sresidualvec( A, b, *x, &r, &nom0, queue));
+    magma_scopy_cpu( dofs, r.val, 1, rr.val, 1, queue );                // rr = r
+    rho_new = MAGMA_S_MAKE( nom0*nom0, 0.0 );                           // rho=<rr,r>
+    rho_old = omega = alpha = MAGMA_S_MAKE( 1.0, 0. );
+    solver_par->init_res = nom0;
+
+    nomb = magma_snrm2_cpu( dofs, b.val, 1, queue );
+    if ( nomb == 0.0 ){
+        nomb=1.0;
+    }
+
+    solver_par->final_res = solver_par->init_res;
+    solver_par->iter_res = solver_par->init_res;
+    if ( solver_par->verbose > 0 ) {
+        solver_par->res_vec[0] = nom0;
+        solver_par->timing[0] = 0.0;
+    }
+    if ( nom0 < solver_par->atol ||
+         nom0/nomb < solver_par->rtol ) {
+        info = MAGMA_SUCCESS;
+        goto cleanup;
+    }
+
+    //Chronometry
+    real_Double_t tempo1, tempo2;
+    tempo1 = magma_wtime();
+
+    solver_par->numiter = 0;
+    solver_par->spmv_count = 0;
+    // start iteration
+    do
+    {
+        solver_par->numiter++;
+
+        // rho_new = <rr,r> was computed in the previous sweep
+        beta = rho_new/rho_old * alpha/omega;   // beta=rho/rho_old *alpha/omega
+        if( magma_s_isnan_inf( beta ) ){
+            info = MAGMA_DIVERGENCE;
+            break;
+        }
+
+        // p = r + beta * ( p - omega * v )
+        CHECK( magma_sbicgmerge1_cpu( dofs, beta, omega, r.val, v.val, p.val, queue ));
+
+        // v = Ap, rrv = <rr,v>
+        CHECK( magma_sbicgmerge_spmv1_cpu( A, rr.val, p.val, v.val, &rrv, queue ));
+        solver_par->spmv_count++;
+        alpha = rho_new / rrv;
+        if( magma_s_isnan_inf( alpha ) ){
+            info = MAGMA_DIVERGENCE;
+            break;
+        }
+
+        // s = r - alpha v
+        CHECK( magma_sbicgmerge2_cpu( dofs, alpha, r.val, v.val, s.val, queue ));
+
+        // t = As, ts = <t,s>, tt = <t,t>
+        CHECK( magma_sbicgmerge_spmv2_cpu( A, s.val, t.val, &ts, &tt, queue ));
+        solver_par->spmv_count++;
+        omega = ts / MAGMA_S_MAKE( tt, 0.0 );             // omega = <s,t>/<t,t>
+
+        // x = x + alpha * p + omega * s
+        // r = s - omega * t
+        // rho = <rr,r>, nrm2 = <r,r>
+        rho_old = rho_new;
+        CHECK( magma_sbicgmerge_xrbeta_cpu( dofs, alpha, omega, rr.val, p.val,
+                    s.val, t.val, x->val, r.val, &rho_new, &nrm2, queue ));
+
+        res = sqrt( nrm2 );
+
+        if ( solver_par->verbose > 0 ) {
+            tempo2 = magma_wtime();
+            if ( (solver_par->numiter)%solver_par->verbose==0 ) {
+                solver_par->res_vec[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) res;
+                solver_par->timing[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) tempo2-tempo1;
+            }
+        }
+
+        if ( res/nomb <= solver_par->rtol || res <= solver_par->atol ){
+            info = MAGMA_SUCCESS;
+            break;
+        }
+    }
+    while ( solver_par->numiter+1 <= solver_par->maxiter );
+
+    tempo2 = magma_wtime();
+    solver_par->runtime = (real_Double_t) tempo2-tempo1;
+    float residual;
+    CHECK(  magma_sresidualvec( A, b, *x, &r, &residual, queue));
+    solver_par->iter_res = res;
+    solver_par->final_res = residual;
+
+    if ( solver_par->numiter < solver_par->maxiter && info == MAGMA_SUCCESS ) {
+        info = MAGMA_SUCCESS;
+    } else if ( solver_par->init_res > solver_par->final_res ) {
+        if ( solver_par->verbose > 0 ) {
+            if ( (solver_par->numiter)%solver_par->verbose==0 ) {
+                solver_par->res_vec[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) res;
+                solver_par->timing[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) tempo2-tempo1;
+            }
+        }
+        info = MAGMA_SLOW_CONVERGENCE;
+        if( solver_par->iter_res < solver_par->rtol*nomb ||
+            solver_par->iter_res < solver_par->atol ) {
+            info = MAGMA_SUCCESS;
+        }
+    }
+    else {
+        if ( solver_par->verbose > 0 ) {
+            if ( (solver_par->numiter)%solver_par->verbose==0 ) {
+                solver_par->res_vec[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) res;
+                solver_par->timing[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) tempo2-tempo1;
+            }
+        }
+        info = MAGMA_DIVERGENCE;
+    }
+
+cleanup:
+    magma_smfree(&r, queue );
+    magma_smfree(&rr, queue );
+    magma_smfree(&p, queue );
+    magma_smfree(&v, queue );
+    magma_smfree(&s, queue );
+    magma_smfree(&t, queue );
+
+    solver_par->info = info;
+    return info;
+}   /* magma_sbicgstab_merge_cpu */
@@ -7,7 +7,7 @@
 
        @author Hartwig Anzt
 
-       @generated from sparse/src/zparilu_cpu.cpp, normal z -> s, Wed Apr 20 17:38:07 2022
+       @generated from sparse/src/zparilu_cpu.cpp, normal z -> s, Sun Oct 18 22:03:42 2026
 */
 
 #include "magmasparse_internal.h"
@@ -29,6 +29,14 @@
     
     This is the CPU implementation of the ParILU
 
+    If precond->adaptive_tol > 0, the sweeps are row-adaptive: rows whose
+    relative change fell below precond->adaptive_tol are skipped until one of
+    the rows they depend on changes again, and the iteration stops once no
+    row is active, at the latest after precond->sweeps sweeps. With
+    precond->report.level > 1, the number of nonzeros updated in every sweep
+    is printed. With precond->adaptive_tol = 0 (default), every sweep
+    updates all nonzeros.
+
     Arguments
     ---------
 
@@ -66,6 +74,9 @@ magma_sparilu_cpu(
 
     magma_s_matrix hAT={Magma_CSR}, hA={Magma_CSR}, hAL={Magma_CSR}, 
     hAU={Magma_CSR}, hAUT={Magma_CSR}, hAtmp={Magma_CSR}, hACOO={Magma_CSR};
+    magma_index_t *active = NULL, *changed = NULL;
+    magma_int_t num_active, nnz_active;
+    float nnz_total = 0.0;
 
     // copy original matrix as COO to device
     if (A.memory_location != Magma_CPU || A.storage_type != Magma_CSR) {
@@ -104,8 +115,40 @@ magma_sparilu_cpu(
     // - hAU is the upper triangular in CSC on the CPU (U transpose in CSR)
     // The kernel is located in sparse/control/magma_sparilu_kernels.cpp
     //
-    for (int i=0; i<precond->sweeps; i++) {
-        CHECK(magma_sparilu_sweep(hACOO, &hAL, &hAU, queue));
+    if (precond->adaptive_tol > 0.0) {
+        CHECK(magma_index_malloc_cpu(&active, hACOO.num_rows));
+        CHECK(magma_index_malloc_cpu(&changed, hACOO.num_rows));
+        #pragma omp parallel for
+        for (magma_int_t k=0; k < hACOO.num_rows; k++) {
+            active[k] = 1;
+        }
+        num_active = hACOO.num_rows;
+        if (precond->report.level > 1) {
+            printf("parilu_adaptive = [\n%%sweep  active rows  updated nnz    saved\n");
+        }
+        for (int i=0; i<precond->sweeps && num_active > 0; i++) {
+            magma_int_t num_active_sweep = num_active;
+            CHECK(magma_sparilu_sweep_adaptive(hACOO, &hAL, &hAU, 
+                precond->adaptive_tol, active, changed, &num_active, 
+                &nnz_active, queue));
+            nnz_total += nnz_active;
+            if (precond->report.level > 1) {
+                printf("%5d %12lld %12lld   %5.1f%%\n", i, 
+                    (long long) num_active_sweep, (long long) nnz_active, 
+                    100.0 * (1.0 - (float) nnz_active / hACOO.nnz));
+            }
+        }
+        if (precond->report.level > 1) {
+            printf("];\n%% work saved: %.1f%% of %lld sweeps over %lld nonzeros\n\n", 
+                100.0 * (1.0 - nnz_total 
+                / ((float) precond->sweeps * hACOO.nnz)), 
+                (long long) precond->sweeps, (long long) hACOO.nnz);
+            fflush(stdout);
+        }
+    } else {
+        for (int i=0; i<precond->sweeps; i++) {
+            CHECK(magma_sparilu_sweep(hACOO, &hAL, &hAU, queue));
+        }
     }
     CHECK(magma_s_cucsrtranspose(hAU, &hAUT, queue));
 
@@ -136,6 +179,8 @@ cleanup:
     magma_smfree(&hAUT, queue);
     magma_smfree(&hAtmp, queue);
     magma_smfree(&hACOO, queue);
+    magma_free_cpu(active);
+    magma_free_cpu(changed);
 
 #endif
     return info;
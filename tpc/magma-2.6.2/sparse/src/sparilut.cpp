@@ -7,7 +7,7 @@
 
        @author Hartwig Anzt
 
-       @generated from sparse/src/zparilut.cpp, normal z -> s, Wed Apr 20 17:38:07 2022
+       @generated from sparse/src/zparilut.cpp, normal z -> s, Sun Oct 18 21:03:05 2026
 */
 
 #include "magmasparse_internal.h"
@@ -199,10 +199,10 @@ magma_sparilut(
         start = magma_sync_wtime( queue );
         magma_smfree(&UT, queue );
         //magma_smtransposestruct_cpu( U, &UT, queue );
-        magma_scsrcoo_transpose( U, &UT, queue );
+        magma_scsrcoo_transpose( U, &UT, NULL, queue );
         end = magma_sync_wtime( queue ); t_transpose1+=end-start;
         start = magma_sync_wtime( queue );
-        magma_sparilut_candidates( L0, U0, L, UT, &hL, &hU, queue );
+        magma_sparilut_candidates( L0, U0, L, UT, &hL, &hU, NULL, queue );
         end = magma_sync_wtime( queue ); t_cand=+end-start;
         
         if( precond->rtol == 1.0 ){
@@ -247,7 +247,7 @@ magma_sparilut(
                 for(magma_int_t z=0; z<hU.nnz; z++)
                     hU.val[z] = MAGMA_S_ZERO;
             }
-            magma_scsrcoo_transpose( hU, &oneU, queue );
+            magma_scsrcoo_transpose( hU, &oneU, NULL, queue );
             end = magma_sync_wtime( queue ); t_transpose2+=end-start;
             magma_smfree(&hU, queue );
             magma_smfree(&UT, queue );
@@ -309,25 +309,18 @@ magma_sparilut(
                     }
                 //}
             }
-            magma_sparilut_thrsrm( 1, &oneL, &thrsL, queue );
-            magma_sparilut_thrsrm( 1, &oneU, &thrsU, queue );
+            magma_sparilut_thrsrm( 1, &oneL, &thrsL, NULL, queue );
+            magma_sparilut_thrsrm( 1, &oneU, &thrsU, NULL, queue );
             
         }
         
         end = magma_sync_wtime( queue ); t_selectadd+=end-start;
         
         start = magma_sync_wtime( queue );
-        #pragma omp parallel        
-        for(int row=0; row<hL.num_rows; row++){
-            magma_sindexsort( &hL.col[hL.row[row]], 0, hL.row[row+1]-hL.row[row]-1, queue );
-        }
-
-        #pragma omp parallel  
-        for(int row=0; row<hL.num_rows; row++){
-            magma_sindexsort( &hU.col[hU.row[row]], 0, hU.row[row+1]-hU.row[row]-1, queue );
-        }
-        CHECK( magma_smatrix_cup(  L, oneL, &L_new, queue ) );   
-        CHECK( magma_smatrix_cup(  U, oneU, &U_new, queue ) );
+        CHECK( magma_ssegsortval( hL.num_rows, hL.row, hL.col, hL.val, queue ));
+        CHECK( magma_ssegsortval( hU.num_rows, hU.row, hU.col, hU.val, queue ));
+        CHECK( magma_smatrix_cup(  L, oneL, &L_new, NULL, queue ) );   
+        CHECK( magma_smatrix_cup(  U, oneU, &U_new, NULL, queue ) );
         //magma_smatrix_addrowindex( &U, queue );
         end = magma_sync_wtime( queue ); t_add=+end-start;
         magma_smfree( &oneL, queue );
@@ -348,8 +341,8 @@ magma_sparilut(
         num_rmU = max( (U_new.nnz-U0nnz*(1+(precond->atol-1.)*(iters+1)/precond->sweeps)), 0 );
         start = magma_sync_wtime( queue );
         // pre-select: ignore the diagonal entries
-        magma_sparilut_preselect( 0, &L_new, &oneL, queue );
-        magma_sparilut_preselect( 0, &U_new, &oneU, queue );
+        magma_sparilut_preselect( 0, &L_new, &oneL, NULL, queue );
+        magma_sparilut_preselect( 0, &U_new, &oneU, NULL, queue );
         //#pragma omp parallel
         {
           //  magma_int_t id = omp_get_thread_num();
@@ -387,8 +380,8 @@ magma_sparilut(
         magma_smfree( &oneU, queue );
         start = magma_sync_wtime( queue );
         
-        magma_sparilut_thrsrm( 1, &L_new, &thrsL, queue );//printf("done...");fflush(stdout);
-        magma_sparilut_thrsrm( 1, &U_new, &thrsU, queue );//printf("done...");fflush(stdout);
+        magma_sparilut_thrsrm( 1, &L_new, &thrsL, NULL, queue );//printf("done...");fflush(stdout);
+        magma_sparilut_thrsrm( 1, &U_new, &thrsU, NULL, queue );//printf("done...");fflush(stdout);
 
         
         // magma_sparilut_thrsrm_U( 1, L_new, &U_new, &thrsU, queue );
@@ -454,7 +447,7 @@ magma_sparilut(
 
     // for CUSPARSE
     CHECK( magma_smtransfer( L, &precond->L, Magma_CPU, Magma_DEV , queue ));
-    magma_scsrcoo_transpose( U, &UT, queue );
+    magma_scsrcoo_transpose( U, &UT, NULL, queue );
     //magma_smtranspose(U, &UT, queue );
     CHECK( magma_smtransfer( UT, &precond->U, Magma_CPU, Magma_DEV , queue ));
 
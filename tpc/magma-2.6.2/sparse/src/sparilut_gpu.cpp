@@ -7,7 +7,7 @@
 
        @author Hartwig Anzt
 
-       @generated from sparse/src/zparilut_gpu.cpp, normal z -> s, Wed Apr 20 17:38:07 2022
+       @generated from sparse/src/zparilut_gpu.cpp, normal z -> s, Sun Oct 18 21:20:40 2026
 */
 
 #include "magmasparse_internal.h"
@@ -101,8 +101,8 @@ magma_sparilut_gpu(
         magma_smfree(&hL, queue);
     }
     CHECK(magma_smtransfer(hA, &dA, Magma_CPU, Magma_DEV, queue));
-    CHECK(magma_smatrix_tril(hA, &L0, queue));
-    CHECK(magma_smatrix_triu(hA, &U0, queue));
+    CHECK(magma_smatrix_split(hA, &L0, Magma_VALUE, &U0, Magma_VALUE, NULL, 
+        queue));
     CHECK(magma_smtransfer(L0, &dL0, Magma_CPU, Magma_DEV, queue));
     CHECK(magma_smtransfer(U0, &dU0, Magma_CPU, Magma_DEV, queue));
     magma_smfree(&hU, queue);
@@ -0,0 +1,228 @@
+/*
+    -- MAGMA (version 2.6.2) --
+       Univ. of Tennessee, Knoxville
+       Univ. of California, Berkeley
+       Univ. of Colorado, Denver
+       @date April 2022
+
+       @author Hartwig Anzt
+
+       @generated from sparse/src/zpcg_cpu.cpp, normal z -> s, Sun Oct 18 19:32:01 2026
+*/
+
+#include "magmasparse_internal.h"
+
+#define RTOLERANCE     lapackf77_slamch( "E" )
+#define ATOLERANCE     lapackf77_slamch( "E" )
+
+
+/*******************************************************************************
+    Purpose
+    -------
+
+    Solves a system of linear equations
+       A * X = B
+    where A is a real symmetric N-by-N positive definite matrix A.
+    This is a CPU implementation of the preconditioned Conjugate
+    Gradient method: A, b, and x are expected in CPU memory, the
+    preconditioner has to be generated via magma_s_precondsetup_cpu.
+    The BLAS-1 operations and the SpMV are OpenMP-parallel.
+    For precond_par->solver == Magma_NONE, this is the plain CG.
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_s_matrix
+                input matrix A
+
+    @param[in]
+    b           magma_s_matrix
+                RHS b
+
+    @param[in,out]
+    x           magma_s_matrix*
+                solution approximation
+
+    @param[in,out]
+    solver_par  magma_s_solver_par*
+                solver parameters
+
+    @param[in]
+    precond_par magma_s_preconditioner*
+                preconditioner
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_sposv
+*******************************************************************************/
+
+extern "C" magma_int_t
+magma_spcg_cpu(
+    magma_s_matrix A, magma_s_matrix b, magma_s_matrix *x,
+    magma_s_solver_par *solver_par,
+    magma_s_preconditioner *precond_par,
+    magma_queue_t queue )
+{
+    magma_int_t info = MAGMA_NOTCONVERGED;
+
+    // prepare solver feedback
+    solver_par->solver = ( precond_par->solver == Magma_NONE ) ?
+                                                    Magma_CG : Magma_PCG;
+    solver_par->numiter = 0;
+    solver_par->spmv_count = 0;
+
+    // solver variables
+    float alpha, beta;
+    float nom0, r0,  res=0.0, nomb;
+    float den, gammanew, gammaold = MAGMA_S_MAKE(1.0,0.0);
+    // local variables
+    float c_zero = MAGMA_S_ZERO, c_one = MAGMA_S_ONE;
+
+    magma_int_t dofs = A.num_rows* b.num_cols;
+
+    // CPU workspace
+    magma_s_matrix r={Magma_CSR}, rt={Magma_CSR}, p={Magma_CSR}, q={Magma_CSR}, h={Magma_CSR};
+    CHECK( magma_svinit( &r, Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+    CHECK( magma_svinit( &rt,Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+    CHECK( magma_svinit( &p, Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+    CHECK( magma_svinit( &q, Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+    CHECK( magma_svinit( &h, Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+
+
+    // solver setup
+    CHECK(  magma_sresidualvec( A, b, *x, &r, &nom0, queue));
+
+    // preconditioner
+    CHECK( magma_s_applyprecond_left_cpu( MagmaNoTrans, A, r, &rt, precond_par, queue ));
+    CHECK( magma_s_applyprecond_right_cpu( MagmaNoTrans, A, rt, &h, precond_par, queue ));
+
+    magma_scopy_cpu( dofs, h.val, 1, p.val, 1, queue );                    // p = h
+    CHECK( magma_s_spmv( c_one, A, p, c_zero, q, queue ));             // q = A p
+    solver_par->spmv_count++;
+    den =  magma_sdot_cpu( dofs, p.val, 1, q.val, 1, queue ); // den = p dot q
+    solver_par->init_res = nom0;
+
+    nomb = magma_snrm2_cpu( dofs, b.val, 1, queue );
+    if ( nomb == 0.0 ){
+        nomb=1.0;
+    }
+    if ( (r0 = nomb * solver_par->rtol) < ATOLERANCE ){
+        r0 = ATOLERANCE;
+    }
+    solver_par->final_res = solver_par->init_res;
+    solver_par->iter_res = solver_par->init_res;
+    if ( solver_par->verbose > 0 ) {
+        solver_par->res_vec[0] = (real_Double_t)nom0;
+        solver_par->timing[0] = 0.0;
+    }
+    if ( nom0 < r0 ) {
+        info = MAGMA_SUCCESS;
+        goto cleanup;
+    }
+    // check positive definite
+    if ( MAGMA_S_ABS(den) <= 0.0 ) {
+        info = MAGMA_NONSPD;
+        goto cleanup;
+    }
+
+    //Chronometry
+    real_Double_t tempo1, tempo2;
+    tempo1 = magma_wtime();
+
+    solver_par->numiter = 0;
+    solver_par->spmv_count = 0;
+    // start iteration
+    do
+    {
+        solver_par->numiter++;
+
+        // preconditioner
+        CHECK( magma_s_applyprecond_left_cpu( MagmaNoTrans, A, r, &rt, precond_par, queue ));
+        CHECK( magma_s_applyprecond_right_cpu( MagmaNoTrans, A, rt, &h, precond_par, queue ));
+
+        gammanew = magma_sdot_cpu( dofs, r.val, 1, h.val, 1, queue );
+                                                            // gn = < r,h>
+
+        if ( solver_par->numiter == 1 ) {
+            magma_scopy_cpu( dofs, h.val, 1, p.val, 1, queue );                    // p = h
+        } else {
+            beta = (gammanew/gammaold);       // beta = gn/go
+            magma_sscal_cpu( dofs, beta, p.val, 1, queue );            // p = beta*p
+            magma_saxpy_cpu( dofs, c_one, h.val, 1, p.val, 1, queue ); // p = p + h
+        }
+
+        CHECK( magma_s_spmv( c_one, A, p, c_zero, q, queue ));   // q = A p
+        solver_par->spmv_count++;
+        den = magma_sdot_cpu( dofs, p.val, 1, q.val, 1, queue );
+                // den = p dot q
+
+        alpha = gammanew / den;
+        magma_saxpy_cpu( dofs,  alpha, p.val, 1, x->val, 1, queue );     // x = x + alpha p
+        magma_saxpy_cpu( dofs, -alpha, q.val, 1, r.val, 1, queue );      // r = r - alpha q
+        gammaold = gammanew;
+
+        res = magma_snrm2_cpu( dofs, r.val, 1, queue );
+        if ( solver_par->verbose > 0 ) {
+            tempo2 = magma_wtime();
+            if ( (solver_par->numiter)%solver_par->verbose == 0 ) {
+                solver_par->res_vec[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) res;
+                solver_par->timing[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) tempo2-tempo1;
+            }
+        }
+
+        if ( res/nomb <= solver_par->rtol || res <= solver_par->atol ){
+            break;
+        }
+    }
+    while ( solver_par->numiter+1 <= solver_par->maxiter );
+
+    tempo2 = magma_wtime();
+    solver_par->runtime = (real_Double_t) tempo2-tempo1;
+    float residual;
+    CHECK(  magma_sresidualvec( A, b, *x, &r, &residual, queue));
+    solver_par->iter_res = res;
+    solver_par->final_res = residual;
+
+    if ( solver_par->numiter < solver_par->maxiter ) {
+        info = MAGMA_SUCCESS;
+    } else if ( solver_par->init_res > solver_par->final_res ) {
+        if ( solver_par->verbose > 0 ) {
+            if ( (solver_par->numiter)%solver_par->verbose == 0 ) {
+                solver_par->res_vec[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) res;
+                solver_par->timing[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) tempo2-tempo1;
+            }
+        }
+        info = MAGMA_SLOW_CONVERGENCE;
+        if( solver_par->iter_res < solver_par->rtol*nomb ||
+            solver_par->iter_res < solver_par->atol ) {
+            info = MAGMA_SUCCESS;
+        }
+    }
+    else {
+        if ( solver_par->verbose > 0 ) {
+            if ( (solver_par->numiter)%solver_par->verbose == 0 ) {
+                solver_par->res_vec[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) res;
+                solver_par->timing[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) tempo2-tempo1;
+            }
+        }
+        info = MAGMA_DIVERGENCE;
+    }
+
+cleanup:
+    magma_smfree(&r, queue );
+    magma_smfree(&rt, queue );
+    magma_smfree(&p, queue );
+    magma_smfree(&q, queue );
+    magma_smfree(&h, queue );
+
+    solver_par->info = info;
+    return info;
+}   /* magma_spcg_cpu */
@@ -0,0 +1,221 @@
+/*
+    -- MAGMA (version 2.6.2) --
+       Univ. of Tennessee, Knoxville
+       Univ. of California, Berkeley
+       Univ. of Colorado, Denver
+       @date April 2022
+
+       @author Hartwig Anzt
+
+       @generated from sparse/src/zpcg_merge_cpu.cpp, normal z -> s, Sun Oct 18 19:36:21 2026
+*/
+
+#include "magmasparse_internal.h"
+
+
+/*******************************************************************************
+    Purpose
+    -------
+
+    Solves a system of linear equations
+       A * X = B
+    where A is a real symmetric N-by-N positive definite matrix A.
+    This is a CPU implementation of the (preconditioned) Conjugate Gradient
+    method in variant, where multiple operations are merged into fused
+    OpenMP kernels: the SpMV is merged with the dot product, and the update
+    of iterate and residual with the residual norm. Compared to
+    magma_spcg_cpu, this reduces the number of sweeps over the vectors per
+    iteration from eight to four (three without preconditioner).
+    A, b, and x are expected in CPU memory, the preconditioner has to be
+    generated via magma_s_precondsetup_cpu.
+    For precond_par->solver == Magma_NONE, this is the merged CG.
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_s_matrix
+                input matrix A
+
+    @param[in]
+    b           magma_s_matrix
+                RHS b
+
+    @param[in,out]
+    x           magma_s_matrix*
+                solution approximation
+
+    @param[in,out]
+    solver_par  magma_s_solver_par*
+                solver parameters
+
+    @param[in]
+    precond_par magma_s_preconditioner*
+                preconditioner
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_sposv
+*******************************************************************************/
+
+extern "C" magma_int_t
+magma_spcg_merge_cpu(
+    magma_s_matrix A, magma_s_matrix b, magma_s_matrix *x,
+    magma_s_solver_par *solver_par,
+    magma_s_preconditioner *precond_par,
+    magma_queue_t queue )
+{
+    magma_int_t info = MAGMA_NOTCONVERGED;
+
+    magma_int_t precond = ( precond_par->solver != Magma_NONE );
+
+    // prepare solver feedback
+    solver_par->solver = ( precond ) ? Magma_PCGMERGE : Magma_CGMERGE;
+    solver_par->numiter = 0;
+    solver_par->spmv_count = 0;
+
+    // solver variables
+    float alpha, beta, den, gammanew, gammaold = MAGMA_S_ONE;
+    float nom0, nrm2, res=0.0, nomb;
+    // local variables
+    float c_zero = MAGMA_S_ZERO;
+
+    magma_int_t dofs = A.num_rows* b.num_cols;
+
+    // CPU workspace
+    magma_s_matrix r={Magma_CSR}, rt={Magma_CSR}, d={Magma_CSR}, z={Magma_CSR}, h={Magma_CSR};
+    CHECK( magma_svinit( &r, Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+    CHECK( magma_svinit( &d, Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+    CHECK( magma_svinit( &z, Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+    if ( precond ) {
+        CHECK( magma_svinit( &rt,Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+        CHECK( magma_svinit( &h, Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+    }
+
+    // solver setup
+    CHECK(  magma_sresidualvec( A, b, *x, &r, &nom0, queue));
+    nrm2 = nom0 * nom0;
+    solver_par->init_res = nom0;
+
+    nomb = magma_snrm2_cpu( dofs, b.val, 1, queue );
+    if ( nomb == 0.0 ){
+        nomb=1.0;
+    }
+    solver_par->final_res = solver_par->init_res;
+    solver_par->iter_res = solver_par->init_res;
+    if ( solver_par->verbose > 0 ) {
+        solver_par->res_vec[0] = (real_Double_t)nom0;
+        solver_par->timing[0] = 0.0;
+    }
+    if ( nom0 < solver_par->atol ||
+         nom0/nomb < solver_par->rtol ) {
+        info = MAGMA_SUCCESS;
+        goto cleanup;
+    }
+
+    //Chronometry
+    real_Double_t tempo1, tempo2;
+    tempo1 = magma_wtime();
+
+    solver_par->numiter = 0;
+    solver_par->spmv_count = 0;
+    // start iteration
+    do
+    {
+        solver_par->numiter++;
+
+        // preconditioner, gn = < r,h>
+        if ( precond ) {
+            CHECK( magma_s_applyprecond_left_cpu( MagmaNoTrans, A, r, &rt, precond_par, queue ));
+            CHECK( magma_s_applyprecond_right_cpu( MagmaNoTrans, A, rt, &h, precond_par, queue ));
+            CHECK( magma_scgmerge_rh_cpu( dofs, r.val, h.val, &gammanew, queue ));
+        } else {
+            gammanew = MAGMA_S_MAKE( nrm2, 0.0 );
+        }
+
+        // d = h + beta d
+        beta = ( solver_par->numiter == 1 ) ? c_zero : gammanew/gammaold;
+        CHECK( magma_scgmerge_d_cpu( dofs, beta, ( precond ) ? h.val : r.val,
+                                     d.val, queue ));
+
+        // z = A d, den = d' z
+        CHECK( magma_scgmerge_spmv1_cpu( A, d.val, z.val, &den, queue ));
+        solver_par->spmv_count++;
+        // check positive definite
+        if ( MAGMA_S_ABS(den) <= 0.0 ) {
+            info = MAGMA_NONSPD;
+            break;
+        }
+
+        // x = x + alpha d, r = r - alpha z, nrm2 = r' r
+        alpha = gammanew / den;
+        CHECK( magma_scgmerge_xr_cpu( dofs, alpha, d.val, z.val, x->val, r.val,
+                                      &nrm2, queue ));
+        gammaold = gammanew;
+
+        res = sqrt( nrm2 );
+        if ( solver_par->verbose > 0 ) {
+            tempo2 = magma_wtime();
+            if ( (solver_par->numiter)%solver_par->verbose == 0 ) {
+                solver_par->res_vec[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) res;
+                solver_par->timing[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) tempo2-tempo1;
+            }
+        }
+
+        if ( res/nomb <= solver_par->rtol || res <= solver_par->atol ){
+            break;
+        }
+    }
+    while ( solver_par->numiter+1 <= solver_par->maxiter );
+
+    tempo2 = magma_wtime();
+    solver_par->runtime = (real_Double_t) tempo2-tempo1;
+    float residual;
+    CHECK(  magma_sresidualvec( A, b, *x, &r, &residual, queue));
+    solver_par->iter_res = res;
+    solver_par->final_res = residual;
+
+    if ( info == MAGMA_NONSPD ) {
+        // keep the error code
+    } else if ( solver_par->numiter < solver_par->maxiter ) {
+        info = MAGMA_SUCCESS;
+    } else if ( solver_par->init_res > solver_par->final_res ) {
+        if ( solver_par->verbose > 0 ) {
+            if ( (solver_par->numiter)%solver_par->verbose == 0 ) {
+                solver_par->res_vec[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) res;
+                solver_par->timing[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) tempo2-tempo1;
+            }
+        }
+        info = MAGMA_SLOW_CONVERGENCE;
+        if( solver_par->iter_res < solver_par->rtol*nomb ||
+            solver_par->iter_res < solver_par->atol ) {
+            info = MAGMA_SUCCESS;
+        }
+    }
+    else {
+        if ( solver_par->verbose > 0 ) {
+            if ( (solver_par->numiter)%solver_par->verbose == 0 ) {
+                solver_par->res_vec[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) res;
+                solver_par->timing[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) tempo2-tempo1;
+            }
+        }
+        info = MAGMA_DIVERGENCE;
+    }
+
+cleanup:
+    magma_smfree(&r, queue );
+    magma_smfree(&rt, queue );
+    magma_smfree(&d, queue );
+    magma_smfree(&z, queue );
+    magma_smfree(&h, queue );
+
+    solver_par->info = info;
+    return info;
+}   /* magma_spcg_merge_cpu */
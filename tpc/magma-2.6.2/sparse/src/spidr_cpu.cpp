@@ -0,0 +1,591 @@
+/*
+    -- MAGMA (version 2.6.2) --
+       Univ. of Tennessee, Knoxville
+       Univ. of California, Berkeley
+       Univ. of Colorado, Denver
+       @date April 2022
+
+       @author Hartwig Anzt
+       @author Eduardo Ponce
+       @author Stephen Wood
+
+       @generated from sparse/src/zpidr_cpu.cpp, normal z -> s, Sun Oct 18 19:32:01 2026
+*/
+
+#include "magmasparse_internal.h"
+
+#define RTOLERANCE     lapackf77_slamch( "E" )
+#define ATOLERANCE     lapackf77_slamch( "E" )
+
+
+// y = alpha op(A) x + beta y for the (small) dense shadow space blocks
+static void
+sgemv_cpu(
+    magma_trans_t trans, magma_int_t m, magma_int_t n,
+    float alpha, const float *A, magma_int_t lda,
+    const float *x, magma_int_t incx,
+    float beta, float *y, magma_int_t incy )
+{
+    blasf77_sgemv( lapack_trans_const( trans ), &m, &n, &alpha, A, &lda,
+                   x, &incx, &beta, y, &incy );
+}
+
+
+/*******************************************************************************
+    Purpose
+    -------
+
+    Solves a system of linear equations
+       A * X = B
+    where A is a real symmetric N-by-N positive definite matrix A.
+    This is a CPU implementation of the preconditioned Induced Dimension
+    Reduction method: A, b, and x are expected in CPU memory, the
+    preconditioner has to be generated via magma_s_precondsetup_cpu.
+    The operations on vectors of length n and the SpMV are OpenMP-parallel,
+    the operations on the small shadow space use host BLAS.
+    For precond_par->solver == Magma_NONE, this is the plain IDR.
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_s_matrix
+                input matrix A
+
+    @param[in]
+    b           magma_s_matrix
+                RHS b
+
+    @param[in,out]
+    x           magma_s_matrix*
+                solution approximation
+
+    @param[in,out]
+    solver_par  magma_s_solver_par*
+                solver parameters
+
+    @param[in]
+    precond_par magma_s_preconditioner*
+                preconditioner
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_sposv
+*******************************************************************************/
+
+
+extern "C" magma_int_t
+magma_spidr_cpu(
+    magma_s_matrix A, magma_s_matrix b, magma_s_matrix *x,
+    magma_s_solver_par *solver_par,
+    magma_s_preconditioner *precond_par,
+    magma_queue_t queue )
+{
+    magma_int_t info = MAGMA_NOTCONVERGED;
+
+    // prepare solver feedback
+    solver_par->solver = ( precond_par->solver == Magma_NONE ) ?
+                                                Magma_IDR : Magma_PIDR;
+    solver_par->numiter = 0;
+    solver_par->spmv_count = 0;
+    solver_par->init_res = 0.0;
+    solver_par->final_res = 0.0;
+    solver_par->iter_res = 0.0;
+    solver_par->runtime = 0.0;
+
+    // constants
+    const float c_zero = MAGMA_S_ZERO;
+    const float c_one = MAGMA_S_ONE;
+    const float c_n_one = MAGMA_S_NEG_ONE;
+
+    // internal user parameters
+    const magma_int_t smoothing = 1;   // 0 = disable, 1 = enable
+    const float angle = 0.7;          // [0-1]
+
+    // local variables
+    magma_int_t iseed[4] = {0, 0, 0, 1};
+    magma_int_t dof;
+    magma_int_t s;
+    magma_int_t distr;
+    magma_int_t k, i, sk;
+    magma_int_t innerflag;
+    float residual;
+    float nrm;
+    float nrmb;
+    float nrmr;
+    float nrmt;
+    float rho;
+    float om;
+    float tt;
+    float tr;
+    float gamma;
+    float alpha;
+    float mkk;
+    float fk;
+
+    // matrices and vectors
+    magma_s_matrix xs = {Magma_CSR};
+    magma_s_matrix r = {Magma_CSR}, rs = {Magma_CSR};
+    magma_s_matrix P = {Magma_CSR};
+    magma_s_matrix G = {Magma_CSR};
+    magma_s_matrix U = {Magma_CSR};
+    magma_s_matrix M = {Magma_CSR};
+    magma_s_matrix f = {Magma_CSR};
+    magma_s_matrix t = {Magma_CSR};
+    magma_s_matrix c = {Magma_CSR};
+    magma_s_matrix v = {Magma_CSR};
+    magma_s_matrix vtmp = {Magma_CSR};
+    magma_s_matrix hbeta = {Magma_CSR};
+    magma_s_matrix lu = {Magma_CSR};
+
+    // workspace for the orthonormalization of P
+    float *tau = NULL, *work = NULL;
+    magma_int_t lwork, ione = 1;
+
+    // chronometry
+    real_Double_t tempo1, tempo2;
+
+    // initial s space
+    // TODO: add option for 's' (shadow space number)
+    // Hack: uses '--restart' option as the shadow space number.
+    //       This is not a good idea because the default value of restart option is used to detect
+    //       if the user provided a custom restart. This means that if the default restart value
+    //       is changed then the code will think it was the user (unless the default value is
+    //       also updated in the 'if' statement below.
+    s = 1;
+    if ( solver_par->restart != 50 ) {
+        if ( solver_par->restart > A.num_cols ) {
+            s = A.num_cols;
+        } else {
+            s = solver_par->restart;
+        }
+    }
+    solver_par->restart = s;
+
+    // set max iterations
+    solver_par->maxiter = min( 2 * A.num_cols, solver_par->maxiter );
+
+    // check if matrix A is square
+    if ( A.num_rows != A.num_cols ) {
+        //printf("Matrix A is not square.\n");
+        info = MAGMA_ERR_NOT_SUPPORTED;
+        goto cleanup;
+    }
+
+    // |b|
+    nrmb = magma_snrm2_cpu( b.num_rows, b.val, 1, queue );
+    if ( nrmb == 0.0 ) {
+        magma_sscal_cpu( x->num_rows, MAGMA_S_ZERO, x->val, 1, queue );
+        info = MAGMA_SUCCESS;
+        goto cleanup;
+    }
+
+    // r = b - A x
+    CHECK( magma_svinit( &r, Magma_CPU, b.num_rows, 1, c_zero, queue ));
+    CHECK( magma_sresidualvec( A, b, *x, &r, &nrmr, queue ));
+    
+    // |r|
+    solver_par->init_res = nrmr;
+    solver_par->final_res = solver_par->init_res;
+    solver_par->iter_res = solver_par->init_res;
+    if ( solver_par->verbose > 0 ) {
+        solver_par->res_vec[0] = (real_Double_t)nrmr;
+    }
+
+    // check if initial is guess good enough
+    if ( nrmr <= solver_par->atol ||
+        nrmr/nrmb <= solver_par->rtol ) {
+        info = MAGMA_SUCCESS;
+        goto cleanup;
+    }
+
+    // P = randn(n, s)
+    // P = ortho(P)
+//---------------------------------------
+    // P = 0.0
+    CHECK( magma_svinit( &P, Magma_CPU, A.num_cols, s, c_zero, queue ));
+
+    // P = randn(n, s)
+    distr = 3;        // 1 = unif (0,1), 2 = unif (-1,1), 3 = normal (0,1) 
+    dof = P.num_rows * P.num_cols;
+    lapackf77_slarnv( &distr, iseed, &dof, P.val );
+
+    // P = ortho(P)
+    if ( P.num_cols > 1 ) {
+        // P = Q, with Q from the QR factorization of P
+        lwork = P.num_cols * magma_get_sgeqrf_nb( P.num_rows, P.num_cols );
+        CHECK( magma_smalloc_cpu( &tau, P.num_cols ));
+        CHECK( magma_smalloc_cpu( &work, lwork ));
+        lapackf77_sgeqrf( &P.num_rows, &P.num_cols, P.val, &P.ld,
+                          tau, work, &lwork, &info );
+        if ( info == 0 ) {
+            lapackf77_sorgqr( &P.num_rows, &P.num_cols, &P.num_cols,
+                              P.val, &P.ld, tau, work, &lwork, &info );
+        }
+        if ( info != 0 ) {
+            goto cleanup;
+        }
+        info = MAGMA_NOTCONVERGED;
+    } else {
+        // P = P / |P|
+        nrm = magma_snrm2_cpu( dof, P.val, 1, queue );
+        nrm = 1.0 / nrm;
+        magma_sscal_cpu( dof, MAGMA_S_MAKE( nrm, 0.0 ), P.val, 1, queue );
+    }
+//---------------------------------------
+
+    // allocate memory for the scalar products
+    CHECK( magma_svinit( &hbeta, Magma_CPU, s, 1, c_zero, queue ));
+
+    // smoothing enabled
+    if ( smoothing > 0 ) {
+        // set smoothing solution vector
+        CHECK( magma_smtransfer( *x, &xs, Magma_CPU, Magma_CPU, queue ));
+
+        // set smoothing residual vector
+        CHECK( magma_smtransfer( r, &rs, Magma_CPU, Magma_CPU, queue ));
+    }
+
+    // G(n,s) = 0
+    CHECK( magma_svinit( &G, Magma_CPU, A.num_cols, s, c_zero, queue ));
+
+    // U(n,s) = 0
+    CHECK( magma_svinit( &U, Magma_CPU, A.num_cols, s, c_zero, queue ));
+
+    // M(s,s) = I
+    CHECK( magma_svinit( &M, Magma_CPU, s, s, c_zero, queue ));
+    lapackf77_slaset( "F", &s, &s, &c_zero, &c_one, M.val, &s );
+
+    // f = 0
+    CHECK( magma_svinit( &f, Magma_CPU, P.num_cols, 1, c_zero, queue ));
+
+    // t = 0
+    CHECK( magma_svinit( &t, Magma_CPU, r.num_rows, 1, c_zero, queue ));
+
+    // c = 0
+    CHECK( magma_svinit( &c, Magma_CPU, M.num_cols, 1, c_zero, queue ));
+
+    // v = 0
+    CHECK( magma_svinit( &v, Magma_CPU, r.num_rows, 1, c_zero, queue ));
+    CHECK( magma_svinit( &vtmp, Magma_CPU, r.num_rows, 1, c_zero, queue ));
+
+    // lu = 0
+    CHECK( magma_svinit( &lu, Magma_CPU, A.num_rows, 1, c_zero, queue ));
+
+    //--------------START TIME---------------
+    // chronometry
+    tempo1 = magma_wtime();
+    if ( solver_par->verbose > 0 ) {
+        solver_par->timing[0] = 0.0;
+    }
+
+    om = MAGMA_S_ONE;
+    innerflag = 0;
+
+    // start iteration
+    do
+    {
+        solver_par->numiter++;
+    
+        // new RHS for small systems
+        // f = P' r
+        sgemv_cpu( MagmaConjTrans, P.num_rows, P.num_cols, c_one, P.val, P.ld, r.val, 1, c_zero, f.val, 1 );
+
+        // shadow space loop
+        for ( k = 0; k < s; ++k ) {
+            sk = s - k;
+    
+            // f(k:s) = M(k:s,k:s) c(k:s)
+            magma_scopy_cpu( sk, &f.val[k], 1, &c.val[k], 1, queue );
+            blasf77_strsv( "L", "N", "N", &sk, &M.val[k*M.ld+k], &M.ld, &c.val[k], &ione );
+
+            // v = r - G(:,k:s) c(k:s)
+            magma_scopy_cpu( r.num_rows, r.val, 1, v.val, 1, queue );
+            sgemv_cpu( MagmaNoTrans, G.num_rows, sk, c_n_one, &G.val[k*G.ld], G.ld, &c.val[k], 1, c_one, v.val, 1 );
+
+            // preconditioning operation 
+            // v = L \ v;
+            // v = U \ v;
+            CHECK( magma_s_applyprecond_left_cpu( MagmaNoTrans, A, v, &lu, precond_par, queue )); 
+            CHECK( magma_s_applyprecond_right_cpu( MagmaNoTrans, A, lu, &v, precond_par, queue )); 
+
+            // U(:,k) = om * v + U(:,k:s) c(k:s)
+            sgemv_cpu( MagmaNoTrans, U.num_rows, sk, c_one, &U.val[k*U.ld], U.ld, &c.val[k], 1, om, v.val, 1 );
+            magma_scopy_cpu( U.num_rows, v.val, 1, &U.val[k*U.ld], 1, queue );
+            magma_scopy_cpu( U.num_rows, v.val, 1, vtmp.val, 1, queue );
+
+            // G(:,k) = A U(:,k)
+            CHECK( magma_s_spmv( c_one, A, vtmp, c_zero, v, queue ));
+            solver_par->spmv_count++;
+            magma_scopy_cpu( G.num_rows, v.val, 1, &G.val[k*G.ld], 1, queue );
+
+            // bi-orthogonalize the new basis vectors
+            for ( i = 0; i < k; ++i ) {
+                // alpha = P(:,i)' G(:,k)
+                alpha = magma_sdot_cpu( P.num_rows, &P.val[i*P.ld], 1, &G.val[k*G.ld], 1, queue );
+
+                // alpha = alpha / M(i,i)
+                mkk = M.val[i*M.ld+i];
+                alpha = alpha / mkk;
+
+                // G(:,k) = G(:,k) - alpha * G(:,i)
+                magma_saxpy_cpu( G.num_rows, -alpha, &G.val[i*G.ld], 1, &G.val[k*G.ld], 1, queue );
+
+                // U(:,k) = U(:,k) - alpha * U(:,i)
+                magma_saxpy_cpu( U.num_rows, -alpha, &U.val[i*U.ld], 1, &U.val[k*U.ld], 1, queue );
+            }
+
+            // new column of M = P'G, first k-1 entries are zero
+            // M(k:s,k) = P(:,k:s)' G(:,k)
+            sgemv_cpu( MagmaConjTrans, P.num_rows, sk, c_one, &P.val[k*P.ld], P.ld, &G.val[k*G.ld], 1, c_zero, &M.val[k*M.ld+k], 1 );
+
+            // check M(k,k) == 0
+            mkk = M.val[k*M.ld+k];
+            if ( MAGMA_S_EQUAL(mkk, MAGMA_S_ZERO) ) {
+                innerflag = 1;
+                info = MAGMA_DIVERGENCE;
+                break;
+            }
+
+            // beta = f(k) / M(k,k)
+            fk = f.val[k];
+            hbeta.val[k] = fk / mkk;
+
+            // check for nan
+            if ( magma_s_isnan( hbeta.val[k] ) || magma_s_isinf( hbeta.val[k] )) {
+                innerflag = 1;
+                info = MAGMA_DIVERGENCE;
+                break;
+            }
+
+            // r = r - beta * G(:,k)
+            magma_saxpy_cpu( r.num_rows, -hbeta.val[k], &G.val[k*G.ld], 1, r.val, 1, queue );
+
+            // smoothing disabled
+            if ( smoothing <= 0 ) {
+                // |r|
+                nrmr = magma_snrm2_cpu( r.num_rows, r.val, 1, queue );
+
+            // smoothing enabled
+            } else {
+                // x = x + beta * U(:,k)
+                magma_saxpy_cpu( x->num_rows, hbeta.val[k], &U.val[k*U.ld], 1, x->val, 1, queue );
+
+                // smoothing operation
+//---------------------------------------
+                // t = rs - r
+                magma_scopy_cpu( rs.num_rows, rs.val, 1, t.val, 1, queue );
+                magma_saxpy_cpu( t.num_rows, c_n_one, r.val, 1, t.val, 1, queue );
+
+                // t't
+                // t'rs 
+                tt = magma_sdot_cpu( t.num_rows, t.val, 1, t.val, 1, queue );
+                tr = magma_sdot_cpu( t.num_rows, t.val, 1, rs.val, 1, queue );
+
+                // gamma = (t' * rs) / (t' * t)
+                gamma = tr / tt;
+
+                // rs = rs - gamma * (rs - r) 
+                magma_saxpy_cpu( rs.num_rows, -gamma, t.val, 1, rs.val, 1, queue );
+
+                // xs = xs - gamma * (xs - x) 
+                magma_scopy_cpu( xs.num_rows, xs.val, 1, t.val, 1, queue );
+                magma_saxpy_cpu( t.num_rows, c_n_one, x->val, 1, t.val, 1, queue );
+                magma_saxpy_cpu( xs.num_rows, -gamma, t.val, 1, xs.val, 1, queue );
+
+                // |rs|
+                nrmr = magma_snrm2_cpu( rs.num_rows, rs.val, 1, queue );           
+//---------------------------------------
+            }
+
+            // store current timing and residual
+            if ( solver_par->verbose > 0 ) {
+                tempo2 = magma_wtime();
+                if ( (solver_par->numiter) % solver_par->verbose == 0 ) {
+                    solver_par->res_vec[(solver_par->numiter) / solver_par->verbose]
+                            = (real_Double_t)nrmr;
+                    solver_par->timing[(solver_par->numiter) / solver_par->verbose]
+                            = (real_Double_t)tempo2 - tempo1;
+                }
+            }
+
+            // check convergence
+            if ( nrmr <= solver_par->atol ||
+                nrmr/nrmb <= solver_par->rtol ) {
+                s = k + 1; // for the x-update outside the loop
+                innerflag = 2;
+                info = MAGMA_SUCCESS;
+                break;
+            }
+
+            // non-last s iteration
+            if ( (k + 1) < s ) {
+                // f(k+1:s) = f(k+1:s) - beta * M(k+1:s,k)
+                magma_saxpy_cpu( sk-1, -hbeta.val[k], &M.val[k*M.ld+(k+1)], 1, &f.val[k+1], 1, queue );
+            }
+        }
+
+        // smoothing disabled
+        if ( smoothing <= 0 && innerflag != 1 ) {
+            // update solution approximation x
+            // x = x + U(:,1:s) * beta(1:s)
+            sgemv_cpu( MagmaNoTrans, U.num_rows, s, c_one, U.val, U.ld, hbeta.val, 1, c_one, x->val, 1 );
+        }
+
+        // check convergence or iteration limit or invalid result of inner loop
+        if ( innerflag > 0 ) {
+            break;
+        }
+
+        // v = r
+        magma_scopy_cpu( r.num_rows, r.val, 1, v.val, 1, queue );
+
+        // preconditioning operation 
+        // v = L \ v;
+        // v = U \ v;
+        CHECK( magma_s_applyprecond_left_cpu( MagmaNoTrans, A, v, &lu, precond_par, queue )); 
+        CHECK( magma_s_applyprecond_right_cpu( MagmaNoTrans, A, lu, &v, precond_par, queue )); 
+
+        // t = A v
+        CHECK( magma_s_spmv( c_one, A, v, c_zero, t, queue ));
+        solver_par->spmv_count++;
+
+        // computation of a new omega
+//---------------------------------------
+        // |t|
+        nrmt = magma_snrm2_cpu( t.num_rows, t.val, 1, queue );
+
+        // t'r 
+        tr = magma_sdot_cpu( t.num_rows, t.val, 1, r.val, 1, queue );
+
+        // rho = abs(t' * r) / (|t| * |r|))
+        rho = MAGMA_D_ABS( MAGMA_S_REAL(tr) / (nrmt * nrmr) );
+
+        // om = (t' * r) / (|t| * |t|)
+        om = tr / (nrmt * nrmt);
+        if ( rho < angle ) {
+            om = (om * angle) / rho;
+        }
+//---------------------------------------
+        if ( MAGMA_S_EQUAL(om, MAGMA_S_ZERO) ) {
+            info = MAGMA_DIVERGENCE;
+            break;
+        }
+
+        // update approximation vector
+        // x = x + om * v
+        magma_saxpy_cpu( x->num_rows, om, v.val, 1, x->val, 1, queue );
+
+        // update residual vector
+        // r = r - om * t
+        magma_saxpy_cpu( r.num_rows, -om, t.val, 1, r.val, 1, queue );
+
+        // smoothing disabled
+        if ( smoothing <= 0 ) {
+            // residual norm
+            nrmr = magma_snrm2_cpu( b.num_rows, r.val, 1, queue );
+
+        // smoothing enabled
+        } else {
+            // smoothing operation
+//---------------------------------------
+            // t = rs - r
+            magma_scopy_cpu( rs.num_rows, rs.val, 1, t.val, 1, queue );
+            magma_saxpy_cpu( t.num_rows, c_n_one, r.val, 1, t.val, 1, queue );
+
+            // t't
+            // t'rs
+            tt = magma_sdot_cpu( t.num_rows, t.val, 1, t.val, 1, queue );
+            tr = magma_sdot_cpu( t.num_rows, t.val, 1, rs.val, 1, queue );
+
+            // gamma = (t' * rs) / (|t| * |t|)
+            gamma = tr / tt;
+
+            // rs = rs - gamma * (rs - r) 
+            magma_saxpy_cpu( rs.num_rows, -gamma, t.val, 1, rs.val, 1, queue );
+
+            // xs = xs - gamma * (xs - x) 
+            magma_scopy_cpu( xs.num_rows, xs.val, 1, t.val, 1, queue );
+            magma_saxpy_cpu( t.num_rows, c_n_one, x->val, 1, t.val, 1, queue );
+            magma_saxpy_cpu( xs.num_rows, -gamma, t.val, 1, xs.val, 1, queue );
+
+            // |rs|
+            nrmr = magma_snrm2_cpu( b.num_rows, rs.val, 1, queue );           
+//---------------------------------------
+        }
+
+        // store current timing and residual
+        if ( solver_par->verbose > 0 ) {
+            tempo2 = magma_wtime();
+            if ( (solver_par->numiter) % solver_par->verbose == 0 ) {
+                solver_par->res_vec[(solver_par->numiter) / solver_par->verbose]
+                        = (real_Double_t)nrmr;
+                solver_par->timing[(solver_par->numiter) / solver_par->verbose]
+                        = (real_Double_t)tempo2 - tempo1;
+            }
+        }
+
+        // check convergence
+        if ( nrmr <= solver_par->atol ||
+            nrmr/nrmb <= solver_par->rtol ) { 
+            info = MAGMA_SUCCESS;
+            break;
+        }
+    }
+    while ( solver_par->numiter + 1 <= solver_par->maxiter );
+
+    // smoothing enabled
+    if ( smoothing > 0 ) {
+        // x = xs
+        magma_scopy_cpu( x->num_rows, xs.val, 1, x->val, 1, queue );
+
+        // r = rs
+        magma_scopy_cpu( r.num_rows, rs.val, 1, r.val, 1, queue );
+    }
+
+    // get last iteration timing
+    tempo2 = magma_wtime();
+    solver_par->runtime = (real_Double_t)tempo2 - tempo1;
+//--------------STOP TIME----------------
+
+    // get final stats
+    solver_par->iter_res = nrmr;
+    CHECK( magma_sresidualvec( A, b, *x, &r, &residual, queue ));
+    solver_par->final_res = residual;
+
+    // set solver conclusion
+    if ( info != MAGMA_SUCCESS && info != MAGMA_DIVERGENCE ) {
+        if ( solver_par->init_res > solver_par->final_res ) {
+            info = MAGMA_SLOW_CONVERGENCE;
+        }
+    }
+
+
+cleanup:
+    // free resources
+    // smoothing enabled
+    if ( smoothing > 0 ) {
+        magma_smfree( &xs, queue );
+        magma_smfree( &rs, queue );
+    }
+    magma_smfree( &r, queue );
+    magma_smfree( &P, queue );
+    magma_smfree( &G, queue );
+    magma_smfree( &U, queue );
+    magma_smfree( &M, queue );
+    magma_smfree( &f, queue );
+    magma_smfree( &t, queue );
+    magma_smfree( &c, queue );
+    magma_smfree( &v, queue );
+    magma_smfree( &vtmp, queue );
+    magma_smfree( &lu, queue);
+    magma_free_cpu( tau );
+    magma_free_cpu( work );
+    magma_smfree( &hbeta, queue );
+
+    solver_par->info = info;
+    return info;
+    /* magma_spidr_cpu */
+}
@@ -0,0 +1,640 @@
+/*
+    -- MAGMA (version 2.6.2) --
+       Univ. of Tennessee, Knoxville
+       Univ. of California, Berkeley
+       Univ. of Colorado, Denver
+       @date April 2022
+
+       @author Hartwig Anzt
+
+       @precisions normal z -> s d c
+*/
+
+#include "magmasparse_internal.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#define PRECISION_z
+
+#ifdef _OPENMP
+
+/*
+    Block structure of A with variable block sizes. Block row I covers the
+    rows bptr[I], ..., bptr[I+1]-1, the same partition is used for the
+    columns. Every nonzero block (I,J) is stored dense in column-major order
+    with leading dimension bptr[I+1]-bptr[I], starting at val[off[k]].
+*/
+typedef struct {
+    magma_int_t nb;             // number of block rows
+    magma_int_t nnzb;           // number of nonzero blocks
+    magma_int_t maxbs;          // size of the largest block
+    magma_index_t *bptr;        // first row of every block row, nb+1
+    magma_index_t *blk;         // block row of every scalar row, n
+    magma_index_t *row;         // block row pointer, nb+1
+    magma_index_t *rowidx;      // block row of every block, nnzb
+    magma_index_t *col;         // block column of every block, nnzb
+    magma_index_t *diag;        // position of the diagonal blocks, nb
+    magma_index_t *crow;        // block column pointer, nb+1
+    magma_index_t *cidx;        // block row of every block in column order
+    magma_index_t *cpos;        // position of every block in column order
+    magma_int_t *off;           // offset of every block in val, nnzb+1
+    magmaDoubleComplex *val;    // dense blocks of A
+} magma_zblockstruct_t;
+
+
+static void
+magma_zblockstruct_free(
+    magma_zblockstruct_t *B )
+{
+    magma_free_cpu( B->bptr );
+    magma_free_cpu( B->blk );
+    magma_free_cpu( B->row );
+    magma_free_cpu( B->rowidx );
+    magma_free_cpu( B->col );
+    magma_free_cpu( B->diag );
+    magma_free_cpu( B->crow );
+    magma_free_cpu( B->cidx );
+    magma_free_cpu( B->cpos );
+    magma_free_cpu( B->off );
+    magma_free_cpu( B->val );
+    B->bptr = NULL;
+    B->blk = NULL;
+    B->row = NULL;
+    B->rowidx = NULL;
+    B->col = NULL;
+    B->diag = NULL;
+    B->crow = NULL;
+    B->cidx = NULL;
+    B->cpos = NULL;
+    B->off = NULL;
+    B->val = NULL;
+}
+
+
+/*
+    Generates the block structure of the sorted CSR matrix A for the
+    supernodal row partition of magma_zmsupernodal, and scatters the values
+    of A into the dense blocks. Empty blocks of the partition are removed.
+*/
+static magma_int_t
+magma_zblockstruct_create(
+    magma_z_matrix A,
+    magma_int_t max_bs,
+    magma_zblockstruct_t *B,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+
+    magma_z_matrix S={Magma_CSR};
+    magma_index_t *tmp = NULL, *cnt = NULL;
+    magma_int_t nb = 0, nnzb = 0, maxbs = 0;
+
+    CHECK( magma_zmsupernodal( &max_bs, A, &S, queue ));
+
+    // block partition without empty blocks
+    CHECK( magma_index_malloc_cpu( &B->bptr, S.numblocks+1 ));
+    CHECK( magma_index_malloc_cpu( &B->blk, A.num_rows ));
+    B->bptr[0] = 0;
+    for (magma_int_t i=0; i < S.numblocks; i++) {
+        magma_int_t bs = S.tile_desc_offset_ptr[i+1] - S.tile_desc_offset_ptr[i];
+        if (bs > 0) {
+            B->bptr[nb+1] = S.tile_desc_offset_ptr[i+1];
+            maxbs = max( maxbs, bs );
+            nb++;
+        }
+    }
+    #pragma omp parallel for
+    for (magma_int_t I=0; I < nb; I++) {
+        for (magma_int_t r=B->bptr[I]; r < B->bptr[I+1]; r++) {
+            B->blk[r] = I;
+        }
+    }
+
+    // block columns of every block row: collect, sort and remove duplicates
+    CHECK( magma_index_malloc_cpu( &tmp, A.nnz ));
+    CHECK( magma_index_malloc_cpu( &cnt, nb+1 ));
+    #pragma omp parallel for schedule(dynamic,16)
+    for (magma_int_t I=0; I < nb; I++) {
+        magma_int_t start = A.row[B->bptr[I]];
+        magma_int_t end = start;
+        for (magma_int_t r=B->bptr[I]; r < B->bptr[I+1]; r++) {
+            // columns are sorted, skip repeated blocks within the row
+            magma_index_t last = -1;
+            for (magma_int_t k=A.row[r]; k < A.row[r+1]; k++) {
+                magma_index_t J = B->blk[A.col[k]];
+                if (J != last) {
+                    tmp[end++] = J;
+                    last = J;
+                }
+            }
+        }
+        magma_zindexsort( tmp, start, end-1, queue );
+        magma_int_t num = 0;
+        for (magma_int_t k=start; k < end; k++) {
+            if (num == 0 || tmp[k] != tmp[start+num-1]) {
+                tmp[start+num] = tmp[k];
+                num++;
+            }
+        }
+        cnt[I] = num;
+    }
+
+    CHECK( magma_index_malloc_cpu( &B->row, nb+1 ));
+    B->row[0] = 0;
+    for (magma_int_t I=0; I < nb; I++) {
+        B->row[I+1] = B->row[I] + cnt[I];
+    }
+    nnzb = B->row[nb];
+
+    CHECK( magma_index_malloc_cpu( &B->rowidx, nnzb ));
+    CHECK( magma_index_malloc_cpu( &B->col, nnzb ));
+    CHECK( magma_index_malloc_cpu( &B->diag, nb ));
+    #pragma omp parallel for
+    for (magma_int_t I=0; I < nb; I++) {
+        magma_int_t start = A.row[B->bptr[I]];
+        B->diag[I] = -1;
+        for (magma_int_t k=B->row[I]; k < B->row[I+1]; k++) {
+            B->rowidx[k] = I;
+            B->col[k] = tmp[start + k - B->row[I]];
+            if (B->col[k] == I) {
+                B->diag[I] = k;
+            }
+        }
+    }
+    for (magma_int_t I=0; I < nb; I++) {
+        if (B->diag[I] < 0) {
+            printf("%% error: block row %lld has no diagonal block.\n",
+                   (long long) I);
+            info = MAGMA_ERR_BADPRECOND;
+            goto cleanup;
+        }
+    }
+
+    // column access to the blocks
+    CHECK( magma_index_malloc_cpu( &B->crow, nb+1 ));
+    CHECK( magma_index_malloc_cpu( &B->cidx, nnzb ));
+    CHECK( magma_index_malloc_cpu( &B->cpos, nnzb ));
+    for (magma_int_t J=0; J < nb+1; J++) {
+        B->crow[J] = 0;
+    }
+    for (magma_int_t k=0; k < nnzb; k++) {
+        B->crow[B->col[k]+1]++;
+    }
+    for (magma_int_t J=0; J < nb; J++) {
+        B->crow[J+1] += B->crow[J];
+        cnt[J] = B->crow[J];
+    }
+    // block rows are visited in order, the columns stay sorted
+    for (magma_int_t k=0; k < nnzb; k++) {
+        magma_index_t J = B->col[k];
+        B->cidx[cnt[J]] = B->rowidx[k];
+        B->cpos[cnt[J]] = k;
+        cnt[J]++;
+    }
+
+    // dense block storage
+    CHECK( magma_imalloc_cpu( &B->off, nnzb+1 ));
+    B->off[0] = 0;
+    for (magma_int_t k=0; k < nnzb; k++) {
+        magma_int_t mI = B->bptr[B->rowidx[k]+1] - B->bptr[B->rowidx[k]];
+        magma_int_t mJ = B->bptr[B->col[k]+1] - B->bptr[B->col[k]];
+        B->off[k+1] = B->off[k] + mI * mJ;
+    }
+    CHECK( magma_zmalloc_cpu( &B->val, B->off[nnzb] ));
+    #pragma omp parallel for schedule(dynamic,16)
+    for (magma_int_t I=0; I < nb; I++) {
+        magma_int_t mI = B->bptr[I+1] - B->bptr[I];
+        for (magma_int_t k=B->off[B->row[I]]; k < B->off[B->row[I+1]]; k++) {
+            B->val[k] = MAGMA_Z_ZERO;
+        }
+        for (magma_int_t r=B->bptr[I]; r < B->bptr[I+1]; r++) {
+            magma_int_t kb = B->row[I];
+            for (magma_int_t k=A.row[r]; k < A.row[r+1]; k++) {
+                magma_index_t c = A.col[k];
+                magma_index_t J = B->blk[c];
+                while (B->col[kb] < J) {
+                    kb++;
+                }
+                B->val[B->off[kb] + (c - B->bptr[J]) * mI + (r - B->bptr[I])]
+                    = A.val[k];
+            }
+        }
+    }
+
+    B->nb = nb;
+    B->nnzb = nnzb;
+    B->maxbs = maxbs;
+
+cleanup:
+    magma_free_cpu( tmp );
+    magma_free_cpu( cnt );
+    magma_zmfree( &S, queue );
+    if (info != 0) {
+        magma_zblockstruct_free( B );
+    }
+    return info;
+}
+
+
+/*
+    One asynchronous block ParILU sweep, input and output array are
+    identical. F holds the factors in the block structure of B: the blocks
+    below the diagonal belong to L, the blocks above the diagonal to U, and
+    the diagonal blocks hold the dense LU factors (unit lower part of L and
+    upper part of U). For every block (I,J), with K < min(I,J),
+
+        S = A(I,J) - sum_K L(I,K) * U(K,J)
+
+    is computed with GEMM. Then L(I,J) = S * U(J,J)^{-1} if I > J and
+    U(I,J) = L(I,I)^{-1} * S if I < J (TRSM), while the diagonal blocks are
+    factorized S = L(I,I) * U(I,I) without pivoting.
+    work has to be of size maxbs*maxbs for every thread.
+*/
+static magma_int_t
+magma_zparilu_block_sweep(
+    magma_zblockstruct_t B,
+    magmaDoubleComplex *F,
+    magmaDoubleComplex *work,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+
+    const magmaDoubleComplex c_one     = MAGMA_Z_ONE;
+    const magmaDoubleComplex c_neg_one = MAGMA_Z_NEG_ONE;
+
+    #pragma omp parallel
+    {
+        magmaDoubleComplex *S = work + omp_get_thread_num() * B.maxbs * B.maxbs;
+
+        #pragma omp for schedule(dynamic,8)
+        for (magma_int_t k=0; k < B.nnzb; k++) {
+            magma_int_t I = B.rowidx[k];
+            magma_int_t J = B.col[k];
+            magma_int_t KM = min( I, J );
+            magma_int_t mI = B.bptr[I+1] - B.bptr[I];
+            magma_int_t mJ = B.bptr[J+1] - B.bptr[J];
+
+            for (magma_int_t l=0; l < mI * mJ; l++) {
+                S[l] = B.val[B.off[k] + l];
+            }
+
+            // merge block row I of L with block column J of U
+            magma_int_t il = B.row[I];
+            magma_int_t ic = B.crow[J];
+            while (il < B.row[I+1] && ic < B.crow[J+1]) {
+                magma_int_t K1 = B.col[il];
+                magma_int_t K2 = B.cidx[ic];
+                if (K1 >= KM || K2 >= KM) {
+                    break;
+                }
+                if (K1 == K2) {
+                    magma_int_t mK = B.bptr[K1+1] - B.bptr[K1];
+                    blasf77_zgemm( "N", "N", &mI, &mJ, &mK,
+                                   &c_neg_one, F + B.off[il], &mI,
+                                               F + B.off[B.cpos[ic]], &mK,
+                                   &c_one,     S, &mI );
+                    il++;
+                    ic++;
+                } else if (K1 < K2) {
+                    il++;
+                } else {
+                    ic++;
+                }
+            }
+
+            if (I > J) {        // L block
+                blasf77_ztrsm( "R", "U", "N", "N", &mI, &mJ, &c_one,
+                               F + B.off[B.diag[J]], &mJ, S, &mI );
+            } else if (I < J) { // U block
+                blasf77_ztrsm( "L", "L", "N", "U", &mI, &mJ, &c_one,
+                               F + B.off[B.diag[I]], &mI, S, &mI );
+            } else {            // diagonal block, LU without pivoting
+                for (magma_int_t p=0; p < mI; p++) {
+                    for (magma_int_t i=p+1; i < mI; i++) {
+                        S[i + p*mI] = S[i + p*mI] / S[p + p*mI];
+                    }
+                    for (magma_int_t j=p+1; j < mI; j++) {
+                        for (magma_int_t i=p+1; i < mI; i++) {
+                            S[i + j*mI] -= S[i + p*mI] * S[p + j*mI];
+                        }
+                    }
+                }
+            }
+
+            for (magma_int_t l=0; l < mI * mJ; l++) {
+                F[B.off[k] + l] = S[l];
+            }
+        }
+    }
+
+    return info;
+}
+
+
+/*
+    Extracts the scalar factors from the block factors F: L is unit lower
+    triangular, U upper triangular, both in sorted CSR on the CPU. All
+    entries of the dense blocks are kept, including numerical zeros.
+*/
+static magma_int_t
+magma_zparilu_block_extract(
+    magma_zblockstruct_t B,
+    magmaDoubleComplex *F,
+    magma_int_t n,
+    magma_z_matrix *L,
+    magma_z_matrix *U,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+
+    magma_zmfree( L, queue );
+    magma_zmfree( U, queue );
+    L->storage_type = Magma_CSR;
+    L->memory_location = Magma_CPU;
+    L->num_rows = n;
+    L->num_cols = n;
+    U->storage_type = Magma_CSR;
+    U->memory_location = Magma_CPU;
+    U->num_rows = n;
+    U->num_cols = n;
+
+    CHECK( magma_index_malloc_cpu( &L->row, n+1 ));
+    CHECK( magma_index_malloc_cpu( &U->row, n+1 ));
+    #pragma omp parallel for
+    for (magma_int_t I=0; I < B.nb; I++) {
+        magma_int_t lower = 0, upper = 0;
+        for (magma_int_t k=B.row[I]; k < B.diag[I]; k++) {
+            lower += B.bptr[B.col[k]+1] - B.bptr[B.col[k]];
+        }
+        for (magma_int_t k=B.diag[I]+1; k < B.row[I+1]; k++) {
+            upper += B.bptr[B.col[k]+1] - B.bptr[B.col[k]];
+        }
+        magma_int_t mI = B.bptr[I+1] - B.bptr[I];
+        for (magma_int_t i=0; i < mI; i++) {
+            L->row[B.bptr[I]+i+1] = lower + i + 1;
+            U->row[B.bptr[I]+i+1] = upper + mI - i;
+        }
+    }
+    L->row[0] = 0;
+    U->row[0] = 0;
+    for (magma_int_t r=0; r < n; r++) {
+        L->row[r+1] += L->row[r];
+        U->row[r+1] += U->row[r];
+    }
+    L->nnz = L->row[n];
+    U->nnz = U->row[n];
+    L->true_nnz = L->nnz;
+    U->true_nnz = U->nnz;
+
+    CHECK( magma_index_malloc_cpu( &L->col, L->nnz ));
+    CHECK( magma_zmalloc_cpu( &L->val, L->nnz ));
+    CHECK( magma_index_malloc_cpu( &U->col, U->nnz ));
+    CHECK( magma_zmalloc_cpu( &U->val, U->nnz ));
+
+    #pragma omp parallel for schedule(dynamic,16)
+    for (magma_int_t I=0; I < B.nb; I++) {
+        magma_int_t mI = B.bptr[I+1] - B.bptr[I];
+        magmaDoubleComplex *D = F + B.off[B.diag[I]];
+        for (magma_int_t i=0; i < mI; i++) {
+            magma_int_t r = B.bptr[I] + i;
+            magma_int_t el = L->row[r];
+            for (magma_int_t k=B.row[I]; k < B.diag[I]; k++) {
+                magma_int_t J = B.col[k];
+                for (magma_int_t j=0; j < B.bptr[J+1] - B.bptr[J]; j++) {
+                    L->col[el] = B.bptr[J] + j;
+                    L->val[el] = F[B.off[k] + j*mI + i];
+                    el++;
+                }
+            }
+            for (magma_int_t j=0; j < i; j++) {
+                L->col[el] = B.bptr[I] + j;
+                L->val[el] = D[j*mI + i];
+                el++;
+            }
+            L->col[el] = r;
+            L->val[el] = MAGMA_Z_ONE;
+
+            el = U->row[r];
+            for (magma_int_t j=i; j < mI; j++) {
+                U->col[el] = B.bptr[I] + j;
+                U->val[el] = D[j*mI + i];
+                el++;
+            }
+            for (magma_int_t k=B.diag[I]+1; k < B.row[I+1]; k++) {
+                magma_int_t J = B.col[k];
+                for (magma_int_t j=0; j < B.bptr[J+1] - B.bptr[J]; j++) {
+                    U->col[el] = B.bptr[J] + j;
+                    U->val[el] = F[B.off[k] + j*mI + i];
+                    el++;
+                }
+            }
+        }
+    }
+
+cleanup:
+    return info;
+}
+
+
+/*
+    Computes the block ParILU factors of the CSR matrix hA on the CPU.
+*/
+static magma_int_t
+magma_zparilu_block_factors(
+    magma_z_matrix hA,
+    magma_z_preconditioner *precond,
+    magma_z_matrix *L,
+    magma_z_matrix *U,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+
+    magma_zblockstruct_t B = {0};
+    magmaDoubleComplex *F = NULL, *work = NULL;
+    // the largest block, same parameter as for the block-Jacobi trisolver
+    magma_int_t max_bs = max( precond->pattern, 1 );
+
+    CHECK( magma_zblockstruct_create( hA, max_bs, &B, queue ));
+
+    // the initial guess are the blocks of A
+    CHECK( magma_zmalloc_cpu( &F, B.off[B.nnzb] ));
+    CHECK( magma_zmalloc_cpu( &work, omp_get_max_threads() * B.maxbs * B.maxbs ));
+    #pragma omp parallel for
+    for (magma_int_t k=0; k < B.off[B.nnzb]; k++) {
+        F[k] = B.val[k];
+    }
+
+    for (magma_int_t i=0; i < precond->sweeps; i++) {
+        CHECK( magma_zparilu_block_sweep( B, F, work, queue ));
+    }
+
+    CHECK( magma_zparilu_block_extract( B, F, hA.num_rows, L, U, queue ));
+
+cleanup:
+    magma_free_cpu( F );
+    magma_free_cpu( work );
+    magma_zblockstruct_free( &B );
+    return info;
+}
+
+#endif
+
+
+/***************************************************************************//**
+    Purpose
+    -------
+
+    Generates a block ILU preconditioner via fixed-point iterations on the
+    CPU. The rows are partitioned into supernodes with magma_zmsupernodal,
+    i.e., consecutive rows with the same sparsity pattern are grouped into
+    blocks of variable size, at most precond->pattern rows (the same
+    parameter as for the block-Jacobi trisolver). A is stored as dense
+    blocks on this partition, and the scalar ParILU updates of
+    magma_zparilu_cpu are replaced by block updates: per block, the
+    products of the L and U blocks are subtracted with GEMM, the off-diagonal
+    blocks are scaled with TRSM, and the diagonal blocks are factorized with
+    a dense LU without pivoting. All blocks are updated in parallel in every
+    one of the precond->sweeps asynchronous sweeps.
+
+    The block pattern contains the scalar pattern of A, the factors hence
+    keep all fill-in inside the dense blocks. With precond->pattern = 1 the
+    method is the scalar ParILU.
+
+    On output, precond->L (unit lower) and precond->U are in CSR and
+    located on the device, like for magma_zparilu_cpu.
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_z_matrix
+                input matrix A
+
+    @param[in]
+    b           magma_z_matrix
+                input RHS b
+
+    @param[in,out]
+    precond     magma_z_preconditioner*
+                preconditioner parameters
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_zgepr
+*******************************************************************************/
+
+extern "C"
+magma_int_t
+magma_zparilu_block_cpu(
+    magma_z_matrix A,
+    magma_z_matrix b,
+    magma_z_preconditioner *precond,
+    magma_queue_t queue)
+{
+    magma_int_t info = MAGMA_ERR_NOT_SUPPORTED;
+
+#ifdef _OPENMP
+    info = 0;
+
+    magma_z_matrix hAT={Magma_CSR}, hA={Magma_CSR}, hL={Magma_CSR},
+                   hU={Magma_CSR};
+
+    if (A.memory_location != Magma_CPU || A.storage_type != Magma_CSR) {
+        CHECK(magma_zmtransfer(A, &hAT, A.memory_location, Magma_CPU, queue));
+        CHECK(magma_zmconvert(hAT, &hA, hAT.storage_type, Magma_CSR, queue));
+        magma_zmfree(&hAT, queue);
+    } else {
+        CHECK(magma_zmtransfer(A, &hA, A.memory_location, Magma_CPU, queue));
+    }
+
+    CHECK(magma_zparilu_block_factors(hA, precond, &hL, &hU, queue));
+
+    CHECK(magma_zmtransfer(hL, &precond->L, Magma_CPU, Magma_DEV, queue));
+    CHECK(magma_zmtransfer(hU, &precond->U, Magma_CPU, Magma_DEV, queue));
+
+    if (precond->trisolver == 0 || precond->trisolver == Magma_CUSOLVE) {
+        CHECK(magma_zcumilugeneratesolverinfo(precond, queue));
+    } else {
+        //prepare for iterative solves
+
+        // extract the diagonal of L into precond->d
+        CHECK(magma_zjacobisetup_diagscal(precond->L, &precond->d, queue));
+        CHECK(magma_zvinit(&precond->work1, Magma_DEV, hA.num_rows, 1,
+            MAGMA_Z_ZERO, queue));
+
+        // extract the diagonal of U into precond->d2
+        CHECK(magma_zjacobisetup_diagscal(precond->U, &precond->d2, queue));
+        CHECK(magma_zvinit(&precond->work2, Magma_DEV, hA.num_rows, 1,
+            MAGMA_Z_ZERO, queue));
+    }
+
+cleanup:
+    magma_zmfree(&hAT, queue);
+    magma_zmfree(&hA, queue);
+    magma_zmfree(&hL, queue);
+    magma_zmfree(&hU, queue);
+#endif
+    return info;
+}
+
+
+/***************************************************************************//**
+    Purpose
+    -------
+
+    Generates the block ParILU preconditioner of magma_zparilu_block_cpu,
+    but keeps the incomplete factors in CPU memory, with the same layout as
+    in magma_zilusetup_cpu.
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_z_matrix
+                input matrix A
+
+    @param[in,out]
+    precond     magma_z_preconditioner*
+                preconditioner parameters
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_zgepr
+*******************************************************************************/
+
+extern "C"
+magma_int_t
+magma_zparilu_blocksetup_cpu(
+    magma_z_matrix A,
+    magma_z_preconditioner *precond,
+    magma_queue_t queue)
+{
+    magma_int_t info = MAGMA_ERR_NOT_SUPPORTED;
+
+#ifdef _OPENMP
+    info = 0;
+
+    magma_z_matrix hAT={Magma_CSR}, hA={Magma_CSR};
+
+    if (A.memory_location != Magma_CPU || A.storage_type != Magma_CSR) {
+        CHECK(magma_zmtransfer(A, &hAT, A.memory_location, Magma_CPU, queue));
+        CHECK(magma_zmconvert(hAT, &hA, hAT.storage_type, Magma_CSR, queue));
+        magma_zmfree(&hAT, queue);
+    } else {
+        CHECK(magma_zmtransfer(A, &hA, A.memory_location, Magma_CPU, queue));
+    }
+
+    CHECK(magma_zparilu_block_factors(hA, precond, &precond->L, &precond->U,
+                                      queue));
+
+cleanup:
+    magma_zmfree(&hAT, queue);
+    magma_zmfree(&hA, queue);
+#endif
+    return info;
+}
@@ -199,10 +199,10 @@ magma_zparilut(
         start = magma_sync_wtime( queue );
         magma_zmfree(&UT, queue );
         //magma_zmtransposestruct_cpu( U, &UT, queue );
-        magma_zcsrcoo_transpose( U, &UT, queue );
+        magma_zcsrcoo_transpose( U, &UT, NULL, queue );
         end = magma_sync_wtime( queue ); t_transpose1+=end-start;
         start = magma_sync_wtime( queue );
-        magma_zparilut_candidates( L0, U0, L, UT, &hL, &hU, queue );
+        magma_zparilut_candidates( L0, U0, L, UT, &hL, &hU, NULL, queue );
         end = magma_sync_wtime( queue ); t_cand=+end-start;
         
         if( precond->rtol == 1.0 ){
@@ -247,7 +247,7 @@ magma_zparilut(
                 for(magma_int_t z=0; z<hU.nnz; z++)
                     hU.val[z] = MAGMA_Z_ZERO;
             }
-            magma_zcsrcoo_transpose( hU, &oneU, queue );
+            magma_zcsrcoo_transpose( hU, &oneU, NULL, queue );
             end = magma_sync_wtime( queue ); t_transpose2+=end-start;
             magma_zmfree(&hU, queue );
             magma_zmfree(&UT, queue );
@@ -309,25 +309,18 @@ magma_zparilut(
                     }
                 //}
             }
-            magma_zparilut_thrsrm( 1, &oneL, &thrsL, queue );
-            magma_zparilut_thrsrm( 1, &oneU, &thrsU, queue );
+            magma_zparilut_thrsrm( 1, &oneL, &thrsL, NULL, queue );
+            magma_zparilut_thrsrm( 1, &oneU, &thrsU, NULL, queue );
             
         }
         
         end = magma_sync_wtime( queue ); t_selectadd+=end-start;
         
         start = magma_sync_wtime( queue );
-        #pragma omp parallel        
-        for(int row=0; row<hL.num_rows; row++){
-            magma_zindexsort( &hL.col[hL.row[row]], 0, hL.row[row+1]-hL.row[row]-1, queue );
-        }
-
-        #pragma omp parallel  
-        for(int row=0; row<hL.num_rows; row++){
-            magma_zindexsort( &hU.col[hU.row[row]], 0, hU.row[row+1]-hU.row[row]-1, queue );
-        }
-        CHECK( magma_zmatrix_cup(  L, oneL, &L_new, queue ) );   
-        CHECK( magma_zmatrix_cup(  U, oneU, &U_new, queue ) );
+        CHECK( magma_zsegsortval( hL.num_rows, hL.row, hL.col, hL.val, queue ));
+        CHECK( magma_zsegsortval( hU.num_rows, hU.row, hU.col, hU.val, queue ));
+        CHECK( magma_zmatrix_cup(  L, oneL, &L_new, NULL, queue ) );   
+        CHECK( magma_zmatrix_cup(  U, oneU, &U_new, NULL, queue ) );
         //magma_zmatrix_addrowindex( &U, queue );
         end = magma_sync_wtime( queue ); t_add=+end-start;
         magma_zmfree( &oneL, queue );
@@ -348,8 +341,8 @@ magma_zparilut(
         num_rmU = max( (U_new.nnz-U0nnz*(1+(precond->atol-1.)*(iters+1)/precond->sweeps)), 0 );
         start = magma_sync_wtime( queue );
         // pre-select: ignore the diagonal entries
-        magma_zparilut_preselect( 0, &L_new, &oneL, queue );
-        magma_zparilut_preselect( 0, &U_new, &oneU, queue );
+        magma_zparilut_preselect( 0, &L_new, &oneL, NULL, queue );
+        magma_zparilut_preselect( 0, &U_new, &oneU, NULL, queue );
         //#pragma omp parallel
         {
           //  magma_int_t id = omp_get_thread_num();
@@ -387,8 +380,8 @@ magma_zparilut(
         magma_zmfree( &oneU, queue );
         start = magma_sync_wtime( queue );
         
-        magma_zparilut_thrsrm( 1, &L_new, &thrsL, queue );//printf("done...");fflush(stdout);
-        magma_zparilut_thrsrm( 1, &U_new, &thrsU, queue );//printf("done...");fflush(stdout);
+        magma_zparilut_thrsrm( 1, &L_new, &thrsL, NULL, queue );//printf("done...");fflush(stdout);
+        magma_zparilut_thrsrm( 1, &U_new, &thrsU, NULL, queue );//printf("done...");fflush(stdout);
 
         
         // magma_zparilut_thrsrm_U( 1, L_new, &U_new, &thrsU, queue );
@@ -454,7 +447,7 @@ magma_zparilut(
 
     // for CUSPARSE
     CHECK( magma_zmtransfer( L, &precond->L, Magma_CPU, Magma_DEV , queue ));
-    magma_zcsrcoo_transpose( U, &UT, queue );
+    magma_zcsrcoo_transpose( U, &UT, NULL, queue );
     //magma_zmtranspose(U, &UT, queue );
     CHECK( magma_zmtransfer( UT, &precond->U, Magma_CPU, Magma_DEV , queue ));
 
@@ -18,6 +18,16 @@
 #define PRECISION_z
 
 
+// wall clock time for the performance report, only taken if it is collected
+static inline real_Double_t
+magma_zparilut_wtime(
+    magma_int_t timing,
+    magma_queue_t queue )
+{
+    return ( timing > 0 ) ? magma_sync_wtime( queue ) : 0.0;
+}
+
+
 /***************************************************************************//**
     Purpose
     -------
@@ -36,12 +46,24 @@
     This version uses the default setting which adds all candidates to the
     sparsity pattern.
 
+    All temporaries of the iterations are drawn from a magma_z_workspace, so
+    once the buffers have grown to the size of the factors, the iterations
+    do not allocate host memory.
+
+    The transpose of U used to find the candidates is not recomputed in
+    every iteration: it is updated with the added candidates and the removed
+    elements by magma_zparilut_transpose_update.
+
     This function requires OpenMP, and is only available if OpenMP is activated.
     
     The parameter list is:
     
     precond.sweeps : number of ParILUT steps
     precond.atol   : absolute fill ratio (1.0 keeps nnz count constant)
+    precond.report : performance report, filled in on every run. Timings are
+                     only taken for report.level > 0, and the iteration
+                     table is printed for report.level > 1. If report.json
+                     is set, the report is written to this file as JSON.
 
 
     Arguments
@@ -80,19 +102,23 @@ magma_zparilut_cpu(
     real_Double_t start, end;
     real_Double_t t_rm=0.0, t_add=0.0, t_res=0.0, t_sweep1=0.0, t_sweep2=0.0, 
         t_cand=0.0, t_sort=0.0, t_transpose1=0.0, t_transpose2=0.0, t_selectrm=0.0,
-        t_nrm=0.0, t_total = 0.0, accum=0.0;
+        t_nrm=0.0, t_total = 0.0, accum=0.0, t_sweeps=0.0, nnz_sweeps=0.0;
                     
-    double sum, sumL, sumU;
+    double sum = 0.0, sumL, sumU;
 
     magma_z_matrix hA={Magma_CSR}, hAT={Magma_CSR}, hL={Magma_CSR}, 
         hU={Magma_CSR}, oneL={Magma_CSR}, oneU={Magma_CSR},
         L={Magma_CSR}, U={Magma_CSR}, L_new={Magma_CSR}, U_new={Magma_CSR}, 
         UT={Magma_CSR}, L0={Magma_CSR}, U0={Magma_CSR};
-    magma_int_t num_rmL, num_rmU;
+    magma_index_t *Lmap = NULL, *Umap = NULL;
+    magma_z_workspace ws = {0};
+    magma_z_parilut_report report = {0};
+    magma_int_t num_rmL, num_rmU, nnz_old;
     double thrsL = 0.0;
     double thrsU = 0.0;
 
-    magma_int_t num_threads = 1, timing = 1; // print timing
+    magma_int_t num_threads = 1;
+    magma_int_t timing = precond->report.level; // 1: collect timings, 2: print
     magma_int_t L0nnz, U0nnz;
 
     #pragma omp parallel
@@ -100,18 +126,19 @@ magma_zparilut_cpu(
         num_threads = omp_get_max_threads();
     }
     
+    report.level = precond->report.level;
+    report.json = precond->report.json;
+    
     CHECK(magma_zmtransfer(A, &hA, A.memory_location, Magma_CPU, queue));
     
     // in case using fill-in
     if (precond->levels > 0) {
         CHECK(magma_zsymbilu(&hA, precond->levels, &hL, &hU , queue));
-        magma_zmfree(&hU, queue);
-        magma_zmfree(&hL, queue);
+        magma_zworkspace_mfree(&ws, &hU, queue);
+        magma_zworkspace_mfree(&ws, &hL, queue);
     }
-    CHECK(magma_zmatrix_tril(hA, &L0, queue));
-    CHECK(magma_zmatrix_triu(hA, &U0, queue));
-    magma_zmfree(&hU, queue);
-    magma_zmfree(&hL, queue);
+    CHECK(magma_zmatrix_split(hA, &L0, Magma_VALUE, &U0, Magma_VALUE, NULL, 
+        queue));
     CHECK(magma_zmatrix_tril(hA, &L, queue));
     CHECK(magma_zmtranspose(hA, &hAT, queue));
     CHECK(magma_zmatrix_tril(hAT, &U, queue));
@@ -121,8 +148,10 @@ magma_zparilut_cpu(
     U0nnz=U.nnz;
     oneL.memory_location = Magma_CPU;
     oneU.memory_location = Magma_CPU;
+    // the transpose of U is built once, and then updated along with U
+    CHECK(magma_zcsrcoo_transpose(U, &UT, &ws, queue));
         
-    if (timing == 1) {
+    if (timing > 1) {
         printf("ilut_fill_ratio = %.6f;\n\n", precond->atol);  
         printf("performance_%d = [\n%%iter      L.nnz      U.nnz    ILU-Norm    transp    candidat  resid     sort    transcand    add      sweep1   selectrm    remove    sweep2     total       accum\n", 
             (int) num_threads);
@@ -135,106 +164,135 @@ magma_zparilut_cpu(
         t_transpose1=0.0; t_transpose2=0.0;  t_selectrm=0.0; t_sort = 0;
         t_sort=0.0; t_nrm=0.0; t_total = 0.0;
      
-        // step 1: transpose U
-        start = magma_sync_wtime(queue);
-        magma_zmfree(&UT, queue);
-        CHECK(magma_zcsrcoo_transpose(U, &UT, queue));
-        end = magma_sync_wtime(queue); t_transpose1+=end-start;
-        
-        
-        // step 2: find candidates
-        start = magma_sync_wtime(queue);
-        CHECK(magma_zparilut_candidates(L0, U0, L, UT, &hL, &hU, queue));
-        end = magma_sync_wtime(queue); t_cand=+end-start;
+        // step 1: find candidates
+        start = magma_zparilut_wtime(timing, queue);
+        CHECK(magma_zparilut_candidates(L0, U0, L, UT, &hL, &hU, &ws, queue));
+        report.nnz_candidates += (int64_t) hL.nnz + hU.nnz;
+        end = magma_zparilut_wtime(timing, queue); t_cand=+end-start;
         
         
-        // step 3: compute residuals (optional when adding all candidates)
-        start = magma_sync_wtime(queue);
-        CHECK(magma_zparilut_residuals(hA, L, U, &hL, queue));
-        CHECK(magma_zparilut_residuals(hA, L, U, &hU, queue));
-        end = magma_sync_wtime(queue); t_res=+end-start;
-        start = magma_sync_wtime(queue);
+        // step 2: compute residuals (optional when adding all candidates)
+        start = magma_zparilut_wtime(timing, queue);
+        CHECK(magma_zparilut_amap(hA, hL, &Lmap, &ws, queue));
+        CHECK(magma_zparilut_amap(hA, hU, &Umap, &ws, queue));
+        CHECK(magma_zparilut_residuals_map(hA, L, U, Lmap, &hL, queue));
+        CHECK(magma_zparilut_residuals_map(hA, L, U, Umap, &hU, queue));
+        end = magma_zparilut_wtime(timing, queue); t_res=+end-start;
+        start = magma_zparilut_wtime(timing, queue);
         CHECK(magma_zmatrix_abssum(hL, &sumL, queue));
         CHECK(magma_zmatrix_abssum(hU, &sumU, queue));
         sum = sumL + sumU;
-        end = magma_sync_wtime(queue); t_nrm+=end-start;
+        end = magma_zparilut_wtime(timing, queue); t_nrm+=end-start;
         CHECK(magma_zmatrix_swap(&hL, &oneL, queue));
-        magma_zmfree(&hL, queue);
+        magma_zworkspace_mfree(&ws, &hL, queue);
         
         
-        // step 4: sort candidates
-        start = magma_sync_wtime(queue);
+        // step 3: sort candidates
+        start = magma_zparilut_wtime(timing, queue);
         CHECK(magma_zcsr_sort(&hL, queue));
         CHECK(magma_zcsr_sort(&hU, queue));
-        end = magma_sync_wtime(queue); t_sort+=end-start;
+        end = magma_zparilut_wtime(timing, queue); t_sort+=end-start;
         
         
-        // step 5: transpose candidates
-        start = magma_sync_wtime(queue);
-        magma_zcsrcoo_transpose(hU, &oneU, queue);
-        end = magma_sync_wtime(queue); t_transpose2+=end-start;
+        // step 4: transpose candidates
+        start = magma_zparilut_wtime(timing, queue);
+        magma_zcsrcoo_transpose(hU, &oneU, &ws, queue);
+        end = magma_zparilut_wtime(timing, queue); t_transpose2+=end-start;
         
         
-        // step 6: add candidates
-        start = magma_sync_wtime(queue);
-        CHECK(magma_zmatrix_cup(L, oneL, &L_new, queue));   
-        CHECK(magma_zmatrix_cup(U, oneU, &U_new, queue));
-        end = magma_sync_wtime(queue); t_add=+end-start;
-        magma_zmfree(&oneL, queue);
-        magma_zmfree(&oneU, queue);
+        // step 5: add candidates
+        start = magma_zparilut_wtime(timing, queue);
+        CHECK(magma_zmatrix_cup(L, oneL, &L_new, &ws, queue));   
+        CHECK(magma_zmatrix_cup(U, oneU, &U_new, &ws, queue));
+        report.nnz_max = max(report.nnz_max, (int64_t) L_new.nnz + U_new.nnz);
+        end = magma_zparilut_wtime(timing, queue); t_add=+end-start;
+        magma_zworkspace_mfree(&ws, &oneL, queue);
+        magma_zworkspace_mfree(&ws, &oneU, queue);
        
         
-        // step 7: sweep
-        start = magma_sync_wtime(queue);
-        CHECK(magma_zparilut_sweep_sync(&hA, &L_new, &U_new, queue));
-        end = magma_sync_wtime(queue); t_sweep1+=end-start;
+        // step 6: sweep
+        start = magma_zparilut_wtime(timing, queue);
+        CHECK(magma_zparilut_amap(hA, L_new, &Lmap, &ws, queue));
+        CHECK(magma_zparilut_amap(hAT, U_new, &Umap, &ws, queue));
+        CHECK(magma_zparilut_sweep_sync_map(&hA, &hAT, &L_new, &U_new, 
+            Lmap, Umap, &ws, queue));
+        end = magma_zparilut_wtime(timing, queue); t_sweep1+=end-start;
+        nnz_sweeps += L_new.nnz + U_new.nnz;
         
         
-        // step 8: select threshold to remove elements
-        start = magma_sync_wtime(queue);
+        // step 7: select threshold to remove elements
+        start = magma_zparilut_wtime(timing, queue);
         num_rmL = max((L_new.nnz-L0nnz*(1+(precond->atol-1.)
             *(iters+1)/precond->sweeps)), 0);
         num_rmU = max((U_new.nnz-U0nnz*(1+(precond->atol-1.)
             *(iters+1)/precond->sweeps)), 0);
         // pre-select: ignore the diagonal entries
-        CHECK(magma_zparilut_preselect(0, &L_new, &oneL, queue));
-        CHECK(magma_zparilut_preselect(0, &U_new, &oneU, queue));
+        CHECK(magma_zparilut_preselect(0, &L_new, &oneL, &ws, queue));
+        CHECK(magma_zparilut_preselect(0, &U_new, &oneU, &ws, queue));
         if (num_rmL>0) {
-            CHECK(magma_zparilut_set_thrs_randomselect_approx(num_rmL, 
-                &oneL, 0, &thrsL, queue));
+            CHECK(magma_zparilut_set_thrs_sampleselect(num_rmL, 
+                &oneL, 0, 0.0, &thrsL, NULL, &ws, queue));
         } else {
             thrsL = 0.0;
         }
         if (num_rmU>0) {
-            CHECK(magma_zparilut_set_thrs_randomselect_approx(num_rmU, 
-                &oneU, 0, &thrsU, queue));
+            CHECK(magma_zparilut_set_thrs_sampleselect(num_rmU, 
+                &oneU, 0, 0.0, &thrsU, NULL, &ws, queue));
         } else {
             thrsU = 0.0;
         }
-        magma_zmfree(&oneL, queue);
-        magma_zmfree(&oneU, queue);
-        end = magma_sync_wtime(queue); t_selectrm=end-start;
+        magma_zworkspace_mfree(&ws, &oneL, queue);
+        magma_zworkspace_mfree(&ws, &oneU, queue);
+        end = magma_zparilut_wtime(timing, queue); t_selectrm=end-start;
 
         
+        // step 8: update the transpose of U: the candidates hU are already
+        // in the layout of UT, the elements removed in step 9 are dropped
+        start = magma_zparilut_wtime(timing, queue);
+        CHECK(magma_zparilut_transpose_update(U_new, hU, thrsU, &UT, 
+            &ws, queue));
+        magma_zworkspace_mfree(&ws, &hU, queue);
+        end = magma_zparilut_wtime(timing, queue); t_transpose1+=end-start;
+        
+        
         // step 9: remove elements
-        start = magma_sync_wtime(queue);
-        CHECK(magma_zparilut_thrsrm(1, &L_new, &thrsL, queue));
-        CHECK(magma_zparilut_thrsrm(1, &U_new, &thrsU, queue));
+        start = magma_zparilut_wtime(timing, queue);
+        nnz_old = L_new.nnz + U_new.nnz;
+        CHECK(magma_zparilut_thrsrm(1, &L_new, &thrsL, &ws, queue));
+        CHECK(magma_zparilut_thrsrm(1, &U_new, &thrsU, &ws, queue));
         CHECK(magma_zmatrix_swap(&L_new, &L, queue));
         CHECK(magma_zmatrix_swap(&U_new, &U, queue));
-        magma_zmfree(&L_new, queue);
-        magma_zmfree(&U_new, queue);
-        end = magma_sync_wtime(queue); t_rm=end-start;
+        magma_zworkspace_mfree(&ws, &L_new, queue);
+        magma_zworkspace_mfree(&ws, &U_new, queue);
+        report.nnz_removed += nnz_old - L.nnz - U.nnz;
+        end = magma_zparilut_wtime(timing, queue); t_rm=end-start;
         
         
         // step 10: sweep
-        start = magma_sync_wtime(queue);
-        CHECK(magma_zparilut_sweep_sync(&hA, &L, &U, queue));
-        end = magma_sync_wtime(queue); t_sweep2+=end-start;
+        start = magma_zparilut_wtime(timing, queue);
+        CHECK(magma_zparilut_amap(hA, L, &Lmap, &ws, queue));
+        CHECK(magma_zparilut_amap(hAT, U, &Umap, &ws, queue));
+        CHECK(magma_zparilut_sweep_sync_map(&hA, &hAT, &L, &U, 
+            Lmap, Umap, &ws, queue));
+        end = magma_zparilut_wtime(timing, queue); t_sweep2+=end-start;
+        nnz_sweeps += L.nnz + U.nnz;
+        t_sweeps += t_sweep1 + t_sweep2;
+        t_total = t_transpose1+ t_cand+ t_res+ t_sort+ t_transpose2+ t_add+ t_sweep1+ t_selectrm+ t_rm+ t_sweep2;
+        accum = accum + t_total;
+        report.t_transpose += t_transpose1;
+        report.t_candidates += t_cand;
+        report.t_residuals += t_res;
+        report.t_norm += t_nrm;
+        report.t_sort += t_sort;
+        report.t_transpose_cand += t_transpose2;
+        report.t_add += t_add;
+        report.t_sweep1 += t_sweep1;
+        report.t_select += t_selectrm;
+        report.t_remove += t_rm;
+        report.t_sweep2 += t_sweep2;
+        report.iters++;
         
-        if (timing == 1) {
-            t_total = t_transpose1+ t_cand+ t_res+ t_sort+ t_transpose2+ t_add+ t_sweep1+ t_selectrm+ t_rm+ t_sweep2;
-            accum = accum + t_total;
+        if (timing > 1) {
             printf("%5lld %10lld %10lld  %.4e   %.2e  %.2e  %.2e  %.2e  %.2e  %.2e  %.2e  %.2e  %.2e  %.2e  %.2e      %.2e\n",
                 (long long) iters, (long long) L.nnz, (long long) U.nnz, 
                 (double) sum, 
@@ -243,15 +301,34 @@ magma_zparilut_cpu(
         }
     }
 
-    if (timing == 1) {
+    report.num_threads = num_threads;
+    report.nnz_A = hA.nnz;
+    report.nnz_L = L.nnz;
+    report.nnz_U = U.nnz;
+    report.nnz_swept = nnz_sweeps;
+    report.ilu_norm = sum;
+    report.num_alloc = ws.num_alloc;
+    report.bytes_alloc = ws.footprint;
+    report.t_total = accum;
+    precond->report = report;
+    if (report.json != NULL) {
+        CHECK(magma_zparilut_report_write(report, queue));
+    }
+
+    if (timing > 1) {
         printf("]; \n");
+        printf("%% sweep throughput: %.4e nonzeros/s\n", 
+            (t_sweeps > 0.0) ? nnz_sweeps/t_sweeps : 0.0);
+        printf("%% workspace: %lld host allocations, %.2f MB\n\n", 
+            (long long) ws.num_alloc, (double) ws.footprint/1.0e6);
         fflush(stdout);
     }
     //##########################################################################
 
     // for CUSPARSE
     CHECK(magma_zmtransfer(L, &precond->L, Magma_CPU, Magma_DEV , queue));
-    CHECK(magma_zcsrcoo_transpose(U, &UT, queue));
+    magma_zworkspace_mfree(&ws, &UT, queue);
+    CHECK(magma_zcsrcoo_transpose(U, &UT, &ws, queue));
     //magma_zmtranspose(U, &UT, queue);
     CHECK(magma_zmtransfer(UT, &precond->U, Magma_CPU, Magma_DEV , queue));
     
@@ -272,15 +349,365 @@ magma_zparilut_cpu(
 cleanup:
     magma_zmfree(&hA, queue);
     magma_zmfree(&hAT, queue);
-    magma_zmfree(&L, queue);
-    magma_zmfree(&U, queue);
-    magma_zmfree(&UT, queue);
     magma_zmfree(&L0, queue);
     magma_zmfree(&U0, queue);
-    magma_zmfree(&L_new, queue);
-    magma_zmfree(&U_new, queue);
-    magma_zmfree(&hL, queue);
-    magma_zmfree(&hU, queue);
+    // the factors and temporaries are recycled through the workspace
+    magma_zworkspace_mfree(&ws, &L, queue);
+    magma_zworkspace_mfree(&ws, &U, queue);
+    magma_zworkspace_mfree(&ws, &UT, queue);
+    magma_zworkspace_mfree(&ws, &L_new, queue);
+    magma_zworkspace_mfree(&ws, &U_new, queue);
+    magma_zworkspace_mfree(&ws, &hL, queue);
+    magma_zworkspace_mfree(&ws, &hU, queue);
+    magma_zworkspace_mfree(&ws, &oneL, queue);
+    magma_zworkspace_mfree(&ws, &oneU, queue);
+    magma_zworkspace_free(&ws, Lmap, queue);
+    magma_zworkspace_free(&ws, Umap, queue);
+    magma_zworkspace_destroy(&ws, queue);
+#endif
+    return info;
+}
+
+
+
+// one synchronous sweep on the pattern of L and U, returns the relative
+// change of the values, i.e. the residual of the fixed-point iteration
+static magma_int_t
+magma_zparilut_warm_sweep(
+    magma_z_matrix *hA,
+    magma_z_matrix *hAT,
+    magma_z_matrix *L,
+    magma_z_matrix *U,
+    magma_index_t *Lmap,
+    magma_index_t *Umap,
+    magmaDoubleComplex *Lold,
+    magmaDoubleComplex *Uold,
+    double *res,
+    magma_z_workspace *ws,
+    magma_queue_t queue )
+{
+    magma_int_t info = 0;
+    double diff = 0.0, nrm = 0.0;
+    
+    #pragma omp parallel for
+    for (magma_int_t e=0; e < L->nnz; e++) {
+        Lold[e] = L->val[e];
+    }
+    #pragma omp parallel for
+    for (magma_int_t e=0; e < U->nnz; e++) {
+        Uold[e] = U->val[e];
+    }
+    CHECK(magma_zparilut_sweep_sync_map(hA, hAT, L, U, Lmap, Umap, ws, queue));
+    #pragma omp parallel for reduction(+:diff, nrm)
+    for (magma_int_t e=0; e < L->nnz; e++) {
+        diff += MAGMA_Z_ABS(L->val[e] - Lold[e]);
+        nrm += MAGMA_Z_ABS(L->val[e]);
+    }
+    #pragma omp parallel for reduction(+:diff, nrm)
+    for (magma_int_t e=0; e < U->nnz; e++) {
+        diff += MAGMA_Z_ABS(U->val[e] - Uold[e]);
+        nrm += MAGMA_Z_ABS(U->val[e]);
+    }
+    *res = (nrm > 0.0) ? diff / nrm : diff;
+    
+cleanup:
+    return info;
+}
+
+
+/***************************************************************************//**
+    Purpose
+    -------
+
+    Generates an incomplete threshold LU preconditioner for a matrix A that
+    has the same size, and typically the same sparsity pattern, as the matrix
+    the preconditioner was generated for before, e.g., for the Jacobians of
+    a Newton iteration. Instead of restarting from tril(A) and triu(A), the
+    factors precond.L and precond.U of the previous ParILUT run are used as
+    initial guess. A few fixed-point sweeps adapt the values to the new 
+    matrix, and optionally ParILUT steps adapt the pattern, keeping the 
+    number of nonzeros of the factors constant.
+    
+    Convergence is monitored via the relative change of the factors in a
+    sweep. The warm start is accepted if this change is below
+    precond.warmstart_tol after the last sweep, or if it still decreases
+    over the sweeps. Otherwise, or if it is not finite, the factors are
+    recomputed by magma_zparilut_cpu. This is also done if no previous
+    factors of matching size are available.
+
+    This function requires OpenMP, and is only available if OpenMP is activated.
+    
+    The parameter list is:
+    
+    precond.L      : lower triangular factor of the previous run
+    precond.U      : upper triangular factor of the previous run
+    precond.sweeps : number of fixed-point sweeps (ParILUT steps for a 
+                     cold start)
+    precond.maxiter: number of ParILUT steps adapting the pattern after the 
+                     sweeps, 0 keeps the pattern of the previous factors
+    precond.warmstart_tol : relative change of the factors in the last
+                     sweep that is accepted without further decrease 
+                     (default 1e-2)
+    precond.atol   : absolute fill ratio for a cold start
+    precond.report : performance report, report.warm_start is -1 if the 
+                     warm start was rejected.
+
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_z_matrix
+                input matrix A
+
+    @param[in]
+    b           magma_z_matrix
+                input RHS b
+
+    @param[in,out]
+    precond     magma_z_preconditioner*
+                preconditioner parameters
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_zgepr
+*******************************************************************************/
+extern "C"
+magma_int_t
+magma_zparilut_warmstart_cpu(
+    magma_z_matrix A,
+    magma_z_matrix b,
+    magma_z_preconditioner *precond,
+    magma_queue_t queue)
+{
+    magma_int_t info = 0;
+    
+#ifdef _OPENMP
+
+    real_Double_t start, end;
+    double res = 0.0, res0 = 0.0, sumL, sumU;
+
+    magma_z_matrix hA={Magma_CSR}, hAT={Magma_CSR}, hL={Magma_CSR}, 
+        hU={Magma_CSR}, oneL={Magma_CSR}, oneU={Magma_CSR}, hUT={Magma_CSR},
+        L={Magma_CSR}, U={Magma_CSR}, L_new={Magma_CSR}, U_new={Magma_CSR}, 
+        UT={Magma_CSR}, L0={Magma_CSR}, U0={Magma_CSR};
+    magma_index_t *Lmap = NULL, *Umap = NULL;
+    magmaDoubleComplex *Lold = NULL, *Uold = NULL;
+    magma_z_workspace ws = {0};
+    magma_z_parilut_report report = {0};
+    magma_solver_type solver = precond->solver;
+    magma_int_t num_rmL, num_rmU, nnz_old, accept = 1;
+    double thrsL = 0.0;
+    double thrsU = 0.0;
+    magma_int_t timing = precond->report.level; // 1: collect timings, 2: print
+
+    // without previous factors, this is a cold start
+    if (precond->L.nnz == 0 || precond->U.nnz == 0 || 
+        precond->L.num_rows != A.num_rows || 
+        precond->U.num_rows != A.num_rows) {
+        info = magma_zparilut_cpu(A, b, precond, queue);
+        goto cleanup;
+    }
+    
+    #pragma omp parallel
+    {
+        report.num_threads = omp_get_max_threads();
+    }
+    report.level = precond->report.level;
+    report.json = precond->report.json;
+    report.warm_start = 1;
+    start = magma_zparilut_wtime(timing, queue);
+    
+    // initial guess: L in CSR, U in CSC (U^T in CSR) as in magma_zparilut_cpu
+    CHECK(magma_zmtransfer(precond->L, &L, precond->L.memory_location, 
+        Magma_CPU, queue));
+    CHECK(magma_zmtransfer(precond->U, &hUT, precond->U.memory_location, 
+        Magma_CPU, queue));
+    CHECK(magma_zmtranspose(hUT, &U, queue));
+    magma_zmfree(&hUT, queue);
+    CHECK(magma_zmatrix_addrowindex(&L, queue)); 
+    CHECK(magma_zmatrix_addrowindex(&U, queue)); 
+    // the previous preconditioner is replaced
+    magma_zprecondfree(precond, queue);
+    precond->solver = solver;
+    
+    CHECK(magma_zmtransfer(A, &hA, A.memory_location, Magma_CPU, queue));
+    CHECK(magma_zmtranspose(hA, &hAT, queue));
+    
+    // fixed-point sweeps on the previous pattern
+    CHECK(magma_zworkspace_malloc(&ws, (void**) &Lold, 
+        L.nnz*sizeof(magmaDoubleComplex), queue));
+    CHECK(magma_zworkspace_malloc(&ws, (void**) &Uold, 
+        U.nnz*sizeof(magmaDoubleComplex), queue));
+    CHECK(magma_zparilut_amap(hA, L, &Lmap, &ws, queue));
+    CHECK(magma_zparilut_amap(hAT, U, &Umap, &ws, queue));
+    for (magma_int_t i=0; i < precond->sweeps; i++) {
+        CHECK(magma_zparilut_warm_sweep(&hA, &hAT, &L, &U, Lmap, Umap, 
+            Lold, Uold, &res, &ws, queue));
+        res0 = (i == 0) ? res : res0;
+        report.nnz_swept += L.nnz + U.nnz;
+    }
+    end = magma_zparilut_wtime(timing, queue);
+    report.t_sweep1 = end - start;
+    
+    // a rejected warm start costs the sweeps, hence a slowly converging
+    // one is kept as long as it converges
+    if (magma_z_isnan_inf(MAGMA_Z_MAKE(res, 0.0)) 
+        || (res > precond->warmstart_tol && res >= res0)) {
+        accept = 0;
+    }
+    if (timing > 1) {
+        printf("%% warm start: %lld sweeps, relative change %.4e -> %.4e, %s\n",
+            (long long) precond->sweeps, res0, res, 
+            (accept == 1) ? "accepted" : "rejected");
+        fflush(stdout);
+    }
+    if (accept == 0) {
+        info = magma_zparilut_cpu(A, b, precond, queue);
+        precond->report.warm_start = -1;
+        if (info == 0 && precond->report.json != NULL) {
+            info = magma_zparilut_report_write(precond->report, queue);
+        }
+        goto cleanup;
+    }
+    
+    // pattern adaptation: ParILUT steps keeping nnz(L) and nnz(U) constant
+    if (precond->maxiter > 0) {
+        CHECK(magma_zmatrix_split(hA, &L0, Magma_VALUE, &U0, Magma_VALUE, NULL, 
+            queue));
+        CHECK(magma_zcsrcoo_transpose(U, &UT, &ws, queue));
+        oneL.memory_location = Magma_CPU;
+        oneU.memory_location = Magma_CPU;
+    }
+    for (magma_int_t iters=0; iters < precond->maxiter; iters++) {
+        start = magma_zparilut_wtime(timing, queue);
+        CHECK(magma_zparilut_candidates(L0, U0, L, UT, &hL, &hU, &ws, queue));
+        report.nnz_candidates += (int64_t) hL.nnz + hU.nnz;
+        CHECK(magma_zparilut_amap(hA, hL, &Lmap, &ws, queue));
+        CHECK(magma_zparilut_amap(hA, hU, &Umap, &ws, queue));
+        CHECK(magma_zparilut_residuals_map(hA, L, U, Lmap, &hL, queue));
+        CHECK(magma_zparilut_residuals_map(hA, L, U, Umap, &hU, queue));
+        CHECK(magma_zmatrix_abssum(hL, &sumL, queue));
+        CHECK(magma_zmatrix_abssum(hU, &sumU, queue));
+        report.ilu_norm = sumL + sumU;
+        CHECK(magma_zmatrix_swap(&hL, &oneL, queue));
+        magma_zworkspace_mfree(&ws, &hL, queue);
+        CHECK(magma_zcsr_sort(&hL, queue));
+        CHECK(magma_zcsr_sort(&hU, queue));
+        CHECK(magma_zcsrcoo_transpose(hU, &oneU, &ws, queue));
+        CHECK(magma_zmatrix_cup(L, oneL, &L_new, &ws, queue));   
+        CHECK(magma_zmatrix_cup(U, oneU, &U_new, &ws, queue));
+        report.nnz_max = max(report.nnz_max, (int64_t) L_new.nnz + U_new.nnz);
+        magma_zworkspace_mfree(&ws, &oneL, queue);
+        magma_zworkspace_mfree(&ws, &oneU, queue);
+        end = magma_zparilut_wtime(timing, queue);
+        report.t_add += end - start;
+        
+        start = magma_zparilut_wtime(timing, queue);
+        CHECK(magma_zparilut_amap(hA, L_new, &Lmap, &ws, queue));
+        CHECK(magma_zparilut_amap(hAT, U_new, &Umap, &ws, queue));
+        CHECK(magma_zparilut_sweep_sync_map(&hA, &hAT, &L_new, &U_new, 
+            Lmap, Umap, &ws, queue));
+        report.nnz_swept += L_new.nnz + U_new.nnz;
+        end = magma_zparilut_wtime(timing, queue);
+        report.t_sweep1 += end - start;
+        
+        start = magma_zparilut_wtime(timing, queue);
+        num_rmL = max(L_new.nnz - L.nnz, 0);
+        num_rmU = max(U_new.nnz - U.nnz, 0);
+        CHECK(magma_zparilut_preselect(0, &L_new, &oneL, &ws, queue));
+        CHECK(magma_zparilut_preselect(0, &U_new, &oneU, &ws, queue));
+        thrsL = 0.0;
+        thrsU = 0.0;
+        if (num_rmL > 0) {
+            CHECK(magma_zparilut_set_thrs_sampleselect(num_rmL, 
+                &oneL, 0, 0.0, &thrsL, NULL, &ws, queue));
+        }
+        if (num_rmU > 0) {
+            CHECK(magma_zparilut_set_thrs_sampleselect(num_rmU, 
+                &oneU, 0, 0.0, &thrsU, NULL, &ws, queue));
+        }
+        magma_zworkspace_mfree(&ws, &oneL, queue);
+        magma_zworkspace_mfree(&ws, &oneU, queue);
+        CHECK(magma_zparilut_transpose_update(U_new, hU, thrsU, &UT, 
+            &ws, queue));
+        magma_zworkspace_mfree(&ws, &hU, queue);
+        nnz_old = L_new.nnz + U_new.nnz;
+        CHECK(magma_zparilut_thrsrm(1, &L_new, &thrsL, &ws, queue));
+        CHECK(magma_zparilut_thrsrm(1, &U_new, &thrsU, &ws, queue));
+        CHECK(magma_zmatrix_swap(&L_new, &L, queue));
+        CHECK(magma_zmatrix_swap(&U_new, &U, queue));
+        magma_zworkspace_mfree(&ws, &L_new, queue);
+        magma_zworkspace_mfree(&ws, &U_new, queue);
+        report.nnz_removed += nnz_old - L.nnz - U.nnz;
+        end = magma_zparilut_wtime(timing, queue);
+        report.t_remove += end - start;
+        
+        start = magma_zparilut_wtime(timing, queue);
+        CHECK(magma_zparilut_amap(hA, L, &Lmap, &ws, queue));
+        CHECK(magma_zparilut_amap(hAT, U, &Umap, &ws, queue));
+        CHECK(magma_zparilut_sweep_sync_map(&hA, &hAT, &L, &U, 
+            Lmap, Umap, &ws, queue));
+        report.nnz_swept += L.nnz + U.nnz;
+        end = magma_zparilut_wtime(timing, queue);
+        report.t_sweep2 += end - start;
+        report.iters++;
+    }
+    
+    report.nnz_A = hA.nnz;
+    report.nnz_L = L.nnz;
+    report.nnz_U = U.nnz;
+    report.num_alloc = ws.num_alloc;
+    report.bytes_alloc = ws.footprint;
+    report.t_total = report.t_sweep1 + report.t_add + report.t_remove 
+        + report.t_sweep2;
+    precond->report = report;
+    if (report.json != NULL) {
+        CHECK(magma_zparilut_report_write(report, queue));
+    }
+
+    // for CUSPARSE
+    CHECK(magma_zmtransfer(L, &precond->L, Magma_CPU, Magma_DEV , queue));
+    magma_zworkspace_mfree(&ws, &UT, queue);
+    CHECK(magma_zcsrcoo_transpose(U, &UT, &ws, queue));
+    CHECK(magma_zmtransfer(UT, &precond->U, Magma_CPU, Magma_DEV , queue));
+    
+    if (precond->trisolver == 0 || precond->trisolver == Magma_CUSOLVE) {
+        CHECK(magma_zcumilugeneratesolverinfo(precond, queue));
+    } else {
+        //prepare for iterative solves
+        // extract the diagonal of L into precond->d
+        CHECK(magma_zjacobisetup_diagscal(precond->L, &precond->d, queue));
+        CHECK(magma_zvinit(&precond->work1, Magma_DEV, hA.num_rows, 1, 
+            MAGMA_Z_ZERO, queue));
+        // extract the diagonal of U into precond->d2
+        CHECK(magma_zjacobisetup_diagscal(precond->U, &precond->d2, queue));
+        CHECK(magma_zvinit(&precond->work2, Magma_DEV, hA.num_rows, 1, 
+            MAGMA_Z_ZERO, queue));
+    }
+
+cleanup:
+    magma_zmfree(&hA, queue);
+    magma_zmfree(&hAT, queue);
+    magma_zmfree(&hUT, queue);
+    magma_zmfree(&L0, queue);
+    magma_zmfree(&U0, queue);
+    magma_zworkspace_mfree(&ws, &L, queue);
+    magma_zworkspace_mfree(&ws, &U, queue);
+    magma_zworkspace_mfree(&ws, &UT, queue);
+    magma_zworkspace_mfree(&ws, &L_new, queue);
+    magma_zworkspace_mfree(&ws, &U_new, queue);
+    magma_zworkspace_mfree(&ws, &hL, queue);
+    magma_zworkspace_mfree(&ws, &hU, queue);
+    magma_zworkspace_mfree(&ws, &oneL, queue);
+    magma_zworkspace_mfree(&ws, &oneU, queue);
+    magma_zworkspace_free(&ws, Lmap, queue);
+    magma_zworkspace_free(&ws, Umap, queue);
+    magma_zworkspace_free(&ws, Lold, queue);
+    magma_zworkspace_free(&ws, Uold, queue);
+    magma_zworkspace_destroy(&ws, queue);
 #endif
     return info;
 }
@@ -103,8 +103,8 @@ magma_zparilut_gpu_nodp(
         magma_zmfree(&hL, queue);
     }
     CHECK(magma_zmtransfer(hA, &dA, Magma_CPU, Magma_DEV, queue));
-    CHECK(magma_zmatrix_tril(hA, &L0, queue));
-    CHECK(magma_zmatrix_triu(hA, &U0, queue));
+    CHECK(magma_zmatrix_split(hA, &L0, Magma_VALUE, &U0, Magma_VALUE, NULL, 
+        queue));
     CHECK(magma_zmtransfer(L0, &dL0, Magma_CPU, Magma_DEV, queue));
     CHECK(magma_zmtransfer(U0, &dU0, Magma_CPU, Magma_DEV, queue));
     magma_zmfree(&hU, queue);
@@ -0,0 +1,221 @@
+/*
+    -- MAGMA (version 2.6.2) --
+       Univ. of Tennessee, Knoxville
+       Univ. of California, Berkeley
+       Univ. of Colorado, Denver
+       @date April 2022
+
+       @author Hartwig Anzt
+
+       @precisions normal z -> s d c
+*/
+
+#include "magmasparse_internal.h"
+
+
+/*******************************************************************************
+    Purpose
+    -------
+
+    Solves a system of linear equations
+       A * X = B
+    where A is a complex Hermitian N-by-N positive definite matrix A.
+    This is a CPU implementation of the (preconditioned) Conjugate Gradient
+    method in variant, where multiple operations are merged into fused
+    OpenMP kernels: the SpMV is merged with the dot product, and the update
+    of iterate and residual with the residual norm. Compared to
+    magma_zpcg_cpu, this reduces the number of sweeps over the vectors per
+    iteration from eight to four (three without preconditioner).
+    A, b, and x are expected in CPU memory, the preconditioner has to be
+    generated via magma_z_precondsetup_cpu.
+    For precond_par->solver == Magma_NONE, this is the merged CG.
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_z_matrix
+                input matrix A
+
+    @param[in]
+    b           magma_z_matrix
+                RHS b
+
+    @param[in,out]
+    x           magma_z_matrix*
+                solution approximation
+
+    @param[in,out]
+    solver_par  magma_z_solver_par*
+                solver parameters
+
+    @param[in]
+    precond_par magma_z_preconditioner*
+                preconditioner
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_zposv
+*******************************************************************************/
+
+extern "C" magma_int_t
+magma_zpcg_merge_cpu(
+    magma_z_matrix A, magma_z_matrix b, magma_z_matrix *x,
+    magma_z_solver_par *solver_par,
+    magma_z_preconditioner *precond_par,
+    magma_queue_t queue )
+{
+    magma_int_t info = MAGMA_NOTCONVERGED;
+
+    magma_int_t precond = ( precond_par->solver != Magma_NONE );
+
+    // prepare solver feedback
+    solver_par->solver = ( precond ) ? Magma_PCGMERGE : Magma_CGMERGE;
+    solver_par->numiter = 0;
+    solver_par->spmv_count = 0;
+
+    // solver variables
+    magmaDoubleComplex alpha, beta, den, gammanew, gammaold = MAGMA_Z_ONE;
+    double nom0, nrm2, res=0.0, nomb;
+    // local variables
+    magmaDoubleComplex c_zero = MAGMA_Z_ZERO;
+
+    magma_int_t dofs = A.num_rows* b.num_cols;
+
+    // CPU workspace
+    magma_z_matrix r={Magma_CSR}, rt={Magma_CSR}, d={Magma_CSR}, z={Magma_CSR}, h={Magma_CSR};
+    CHECK( magma_zvinit( &r, Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+    CHECK( magma_zvinit( &d, Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+    CHECK( magma_zvinit( &z, Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+    if ( precond ) {
+        CHECK( magma_zvinit( &rt,Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+        CHECK( magma_zvinit( &h, Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+    }
+
+    // solver setup
+    CHECK(  magma_zresidualvec( A, b, *x, &r, &nom0, queue));
+    nrm2 = nom0 * nom0;
+    solver_par->init_res = nom0;
+
+    nomb = magma_dznrm2_cpu( dofs, b.val, 1, queue );
+    if ( nomb == 0.0 ){
+        nomb=1.0;
+    }
+    solver_par->final_res = solver_par->init_res;
+    solver_par->iter_res = solver_par->init_res;
+    if ( solver_par->verbose > 0 ) {
+        solver_par->res_vec[0] = (real_Double_t)nom0;
+        solver_par->timing[0] = 0.0;
+    }
+    if ( nom0 < solver_par->atol ||
+         nom0/nomb < solver_par->rtol ) {
+        info = MAGMA_SUCCESS;
+        goto cleanup;
+    }
+
+    //Chronometry
+    real_Double_t tempo1, tempo2;
+    tempo1 = magma_wtime();
+
+    solver_par->numiter = 0;
+    solver_par->spmv_count = 0;
+    // start iteration
+    do
+    {
+        solver_par->numiter++;
+
+        // preconditioner, gn = < r,h>
+        if ( precond ) {
+            CHECK( magma_z_applyprecond_left_cpu( MagmaNoTrans, A, r, &rt, precond_par, queue ));
+            CHECK( magma_z_applyprecond_right_cpu( MagmaNoTrans, A, rt, &h, precond_par, queue ));
+            CHECK( magma_zcgmerge_rh_cpu( dofs, r.val, h.val, &gammanew, queue ));
+        } else {
+            gammanew = MAGMA_Z_MAKE( nrm2, 0.0 );
+        }
+
+        // d = h + beta d
+        beta = ( solver_par->numiter == 1 ) ? c_zero : gammanew/gammaold;
+        CHECK( magma_zcgmerge_d_cpu( dofs, beta, ( precond ) ? h.val : r.val,
+                                     d.val, queue ));
+
+        // z = A d, den = d' z
+        CHECK( magma_zcgmerge_spmv1_cpu( A, d.val, z.val, &den, queue ));
+        solver_par->spmv_count++;
+        // check positive definite
+        if ( MAGMA_Z_ABS(den) <= 0.0 ) {
+            info = MAGMA_NONSPD;
+            break;
+        }
+
+        // x = x + alpha d, r = r - alpha z, nrm2 = r' r
+        alpha = gammanew / den;
+        CHECK( magma_zcgmerge_xr_cpu( dofs, alpha, d.val, z.val, x->val, r.val,
+                                      &nrm2, queue ));
+        gammaold = gammanew;
+
+        res = sqrt( nrm2 );
+        if ( solver_par->verbose > 0 ) {
+            tempo2 = magma_wtime();
+            if ( (solver_par->numiter)%solver_par->verbose == 0 ) {
+                solver_par->res_vec[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) res;
+                solver_par->timing[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) tempo2-tempo1;
+            }
+        }
+
+        if ( res/nomb <= solver_par->rtol || res <= solver_par->atol ){
+            break;
+        }
+    }
+    while ( solver_par->numiter+1 <= solver_par->maxiter );
+
+    tempo2 = magma_wtime();
+    solver_par->runtime = (real_Double_t) tempo2-tempo1;
+    double residual;
+    CHECK(  magma_zresidualvec( A, b, *x, &r, &residual, queue));
+    solver_par->iter_res = res;
+    solver_par->final_res = residual;
+
+    if ( info == MAGMA_NONSPD ) {
+        // keep the error code
+    } else if ( solver_par->numiter < solver_par->maxiter ) {
+        info = MAGMA_SUCCESS;
+    } else if ( solver_par->init_res > solver_par->final_res ) {
+        if ( solver_par->verbose > 0 ) {
+            if ( (solver_par->numiter)%solver_par->verbose == 0 ) {
+                solver_par->res_vec[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) res;
+                solver_par->timing[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) tempo2-tempo1;
+            }
+        }
+        info = MAGMA_SLOW_CONVERGENCE;
+        if( solver_par->iter_res < solver_par->rtol*nomb ||
+            solver_par->iter_res < solver_par->atol ) {
+            info = MAGMA_SUCCESS;
+        }
+    }
+    else {
+        if ( solver_par->verbose > 0 ) {
+            if ( (solver_par->numiter)%solver_par->verbose == 0 ) {
+                solver_par->res_vec[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) res;
+                solver_par->timing[(solver_par->numiter)/solver_par->verbose]
+                        = (real_Double_t) tempo2-tempo1;
+            }
+        }
+        info = MAGMA_DIVERGENCE;
+    }
+
+cleanup:
+    magma_zmfree(&r, queue );
+    magma_zmfree(&rt, queue );
+    magma_zmfree(&d, queue );
+    magma_zmfree(&z, queue );
+    magma_zmfree(&h, queue );
+
+    solver_par->info = info;
+    return info;
+}   /* magma_zpcg_merge_cpu */
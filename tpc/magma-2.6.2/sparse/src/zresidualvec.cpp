@@ -64,7 +64,11 @@ magma_zresidualvec(
                                             mone = MAGMA_Z_NEG_ONE;
     magma_int_t dofs = A.num_rows;
     
-    if ( A.num_rows == b.num_rows ) {
+    if ( A.num_rows == b.num_rows && A.memory_location == Magma_CPU ) {
+        CHECK( magma_z_spmv( mone, A, x, zero, *r, queue ));      // r = A x
+        magma_zaxpy_cpu( dofs, one, b.val, 1, r->val, 1, queue );     // r = r - b
+        *res =  magma_dznrm2_cpu( dofs, r->val, 1, queue );       // res = ||r||
+    } else if ( A.num_rows == b.num_rows ) {
         CHECK( magma_z_spmv( mone, A, x, zero, *r, queue ));      // r = A x
         magma_zaxpy( dofs, one, b.dval, 1, r->dval, 1, queue );          // r = r - b
         *res =  magma_dznrm2( dofs, r->dval, 1, queue );            // res = ||r||
@@ -0,0 +1,368 @@
+/*
+    -- MAGMA (version 2.6.2) --
+       Univ. of Tennessee, Knoxville
+       Univ. of California, Berkeley
+       Univ. of Colorado, Denver
+       @date April 2022
+
+       @author Hartwig Anzt
+
+       @precisions normal z -> s d c
+*/
+
+#include "magmasparse_internal.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// upper bound for s, the monomial basis degrades quickly for larger s
+#define SSTEPCG_SMAX 8
+
+
+/*******************************************************************************
+    Purpose
+    -------
+
+    Solves a system of linear equations
+       A * X = B
+    where A is a complex Hermitian N-by-N positive definite matrix A.
+    This is a CPU implementation of the s-step Conjugate Gradient method
+    (Chronopoulos and Gear): every outer step generates the Krylov basis
+    R = [r, A r, ..., A^{s-1} r] (scaled by 1/||A||_inf) and computes all
+    inner products needed for s CG steps in one fused reduction sweep:
+    R^H A R, (A P_old)^H R, R^H r and P_old^H r. The new search directions
+    P = R + P_old B are A-orthogonalized against the previous block, and the
+    iterate is updated with the Galerkin solution on span(P).
+    In exact arithmetic, one outer step is equivalent to s steps of CG, but
+    it needs only one global reduction instead of 2s.
+
+    The step size s is taken from solver_par->restart and limited to 8.
+    If the Gram matrix of the block loses definiteness (the basis became
+    numerically dependent), the outer step continues with the leading
+    columns only. The residual norm is available at the next outer step,
+    so the residual history is recorded once every s iterations.
+    The method is unpreconditioned.
+
+    Arguments
+    ---------
+
+    @param[in]
+    A           magma_z_matrix
+                input matrix A
+
+    @param[in]
+    b           magma_z_matrix
+                RHS b
+
+    @param[in,out]
+    x           magma_z_matrix*
+                solution approximation
+
+    @param[in,out]
+    solver_par  magma_z_solver_par*
+                solver parameters
+
+    @param[in]
+    queue       magma_queue_t
+                Queue to execute in.
+
+    @ingroup magmasparse_zposv
+*******************************************************************************/
+
+extern "C" magma_int_t
+magma_zsstepcg_cpu(
+    magma_z_matrix A, magma_z_matrix b, magma_z_matrix *x,
+    magma_z_solver_par *solver_par,
+    magma_queue_t queue )
+{
+    magma_int_t info = MAGMA_NOTCONVERGED;
+
+    // prepare solver feedback
+    solver_par->solver = Magma_SSTEPCG;
+    solver_par->numiter = 0;
+    solver_par->spmv_count = 0;
+
+    // solver variables
+    double nom0, nomb, res=0.0, sigma = 0.0;
+    magmaDoubleComplex c_zero = MAGMA_Z_ZERO, c_one = MAGMA_Z_ONE;
+    magma_int_t dofs = A.num_rows* b.num_cols;
+    magma_int_t s = max( 1, min( solver_par->restart, SSTEPCG_SMAX ) );
+    magma_int_t sp = 0;     // number of valid columns in Pold
+    magma_int_t num_threads = 1, nt = 1, lpart, lapack_info, k, ione = 1;
+    real_Double_t tempo1, tempo2;
+
+    magma_z_matrix r={Magma_CSR}, R={Magma_CSR}, AR={Magma_CSR},
+                   P={Magma_CSR}, AP={Magma_CSR}, Pold={Magma_CSR},
+                   APold={Magma_CSR}, tmp={Magma_CSR}, vx={Magma_CSR},
+                   vy={Magma_CSR};
+    magmaDoubleComplex *partial = NULL, *RAR = NULL, *G1 = NULL, *Rr = NULL,
+                       *Pr = NULL, *W = NULL, *Wold = NULL, *B = NULL,
+                       *a = NULL;
+
+    #ifdef _OPENMP
+    num_threads = omp_get_max_threads();
+    #endif
+    // per thread: RAR (s x s), G1 (s x s), Rr (s), Pr (s)
+    lpart = 2*s*s + 2*s;
+
+    // CPU workspace, the blocks are column-major with leading dimension dofs
+    CHECK( magma_zvinit( &r,    Magma_CPU, A.num_rows, b.num_cols, c_zero, queue ));
+    CHECK( magma_zvinit( &R,    Magma_CPU, dofs, s, c_zero, queue ));
+    CHECK( magma_zvinit( &AR,   Magma_CPU, dofs, s, c_zero, queue ));
+    CHECK( magma_zvinit( &P,    Magma_CPU, dofs, s, c_zero, queue ));
+    CHECK( magma_zvinit( &AP,   Magma_CPU, dofs, s, c_zero, queue ));
+    CHECK( magma_zvinit( &Pold, Magma_CPU, dofs, s, c_zero, queue ));
+    CHECK( magma_zvinit( &APold,Magma_CPU, dofs, s, c_zero, queue ));
+    CHECK( magma_zmalloc_cpu( &partial, lpart*num_threads ));
+    CHECK( magma_zmalloc_cpu( &RAR, s*s ));
+    CHECK( magma_zmalloc_cpu( &G1,  s*s ));
+    CHECK( magma_zmalloc_cpu( &W,   s*s ));
+    CHECK( magma_zmalloc_cpu( &Wold,s*s ));
+    CHECK( magma_zmalloc_cpu( &B,   s*s ));
+    CHECK( magma_zmalloc_cpu( &Rr,  s ));
+    CHECK( magma_zmalloc_cpu( &Pr,  s ));
+    CHECK( magma_zmalloc_cpu( &a,   s ));
+
+    // scaling of the monomial basis
+    if ( A.storage_type == Magma_CSR || A.storage_type == Magma_CUCSR ) {
+        #pragma omp parallel for reduction(max:sigma)
+        for( magma_int_t i=0; i<A.num_rows; i++ ){
+            double rowsum = 0.0;
+            for( magma_int_t j=A.row[i]; j<A.row[i+1]; j++ ){
+                rowsum += MAGMA_Z_ABS( A.val[j] );
+            }
+            sigma = max( sigma, rowsum );
+        }
+    }
+    if ( sigma == 0.0 ) {
+        sigma = 1.0;
+    }
+
+    // solver setup
+    CHECK(  magma_zresidualvec( A, b, *x, &r, &nom0, queue));
+    solver_par->init_res = nom0;
+
+    nomb = magma_dznrm2_cpu( dofs, b.val, 1, queue );
+    if ( nomb == 0.0 ){
+        nomb=1.0;
+    }
+    solver_par->final_res = solver_par->init_res;
+    solver_par->iter_res = solver_par->init_res;
+    if ( solver_par->verbose > 0 ) {
+        solver_par->res_vec[0] = (real_Double_t)nom0;
+        solver_par->timing[0] = 0.0;
+    }
+    if ( nom0 < solver_par->atol ||
+         nom0/nomb < solver_par->rtol ) {
+        info = MAGMA_SUCCESS;
+        goto cleanup;
+    }
+
+    //Chronometry
+    tempo1 = magma_wtime();
+
+    solver_par->numiter = 0;
+    solver_par->spmv_count = 0;
+    // start iteration
+    while( 1 )
+    {
+        // Krylov basis: R_0 = r, AR_j = A R_j, R_{j+1} = AR_j / sigma
+        magma_zcopy_cpu( dofs, r.val, 1, R.val, 1, queue );
+        for( magma_int_t j=0; j<s; j++ ){
+            CHECK( magma_zvset( dofs, 1, R.val+j*dofs, &vx, queue ));
+            CHECK( magma_zvset( dofs, 1, AR.val+j*dofs, &vy, queue ));
+            CHECK( magma_z_spmv( c_one, A, vx, c_zero, vy, queue ));
+            solver_par->spmv_count++;
+            if ( j < s-1 ) {
+                magma_zcopy_cpu( dofs, AR.val+j*dofs, 1, R.val+(j+1)*dofs, 1, queue );
+                magma_zscal_cpu( dofs, MAGMA_Z_MAKE( 1.0/sigma, 0.0 ),
+                                 R.val+(j+1)*dofs, 1, queue );
+            }
+        }
+
+        // one fused reduction sweep for all inner products of the block
+        #pragma omp parallel
+        {
+            magma_int_t tid = 0;
+            #ifdef _OPENMP
+            tid = omp_get_thread_num();
+            #pragma omp single
+            nt = omp_get_num_threads();
+            #endif
+            magmaDoubleComplex *lRAR = partial + tid*lpart;
+            magmaDoubleComplex *lG1  = lRAR + s*s;
+            magmaDoubleComplex *lRr  = lG1 + s*s;
+            magmaDoubleComplex *lPr  = lRr + s;
+            for( magma_int_t l=0; l<lpart; l++ ){
+                lRAR[l] = c_zero;
+            }
+            #pragma omp for schedule(static)
+            for( magma_int_t i=0; i<dofs; i++ ){
+                magmaDoubleComplex ri = r.val[i];
+                for( magma_int_t j=0; j<s; j++ ){
+                    magmaDoubleComplex Rij = MAGMA_Z_CONJ( R.val[i+j*dofs] );
+                    for( magma_int_t l=0; l<s; l++ ){
+                        lRAR[j+l*s] += Rij * AR.val[i+l*dofs];
+                    }
+                    lRr[j] += Rij * ri;
+                }
+                for( magma_int_t j=0; j<sp; j++ ){
+                    magmaDoubleComplex APij = MAGMA_Z_CONJ( APold.val[i+j*dofs] );
+                    for( magma_int_t l=0; l<s; l++ ){
+                        lG1[j+l*s] += APij * R.val[i+l*dofs];
+                    }
+                    lPr[j] += MAGMA_Z_CONJ( Pold.val[i+j*dofs] ) * ri;
+                }
+            }
+        }
+        // combine the partial sums in thread order
+        for( magma_int_t l=0; l<s*s; l++ ){
+            RAR[l] = c_zero;
+            G1[l] = c_zero;
+        }
+        for( magma_int_t l=0; l<s; l++ ){
+            Rr[l] = c_zero;
+            Pr[l] = c_zero;
+        }
+        for( magma_int_t t=0; t<nt; t++ ){
+            magmaDoubleComplex *lRAR = partial + t*lpart;
+            for( magma_int_t l=0; l<s*s; l++ ){
+                RAR[l] += lRAR[l];
+                G1[l]  += lRAR[s*s+l];
+            }
+            for( magma_int_t l=0; l<s; l++ ){
+                Rr[l] += lRAR[2*s*s+l];
+                Pr[l] += lRAR[2*s*s+s+l];
+            }
+        }
+
+        // R_0 = r, hence Rr[0] = r^H r
+        res = sqrt( MAGMA_Z_ABS( Rr[0] ));
+        if ( solver_par->numiter > 0 ) {
+            if ( solver_par->verbose > 0 ) {
+                tempo2 = magma_wtime();
+                for( magma_int_t it=solver_par->numiter-sp+1; it<=solver_par->numiter; it++ ){
+                    if ( it%solver_par->verbose == 0 ) {
+                        solver_par->res_vec[it/solver_par->verbose]
+                                = (real_Double_t) res;
+                        solver_par->timing[it/solver_par->verbose]
+                                = (real_Double_t) tempo2-tempo1;
+                    }
+                }
+            }
+            if ( res/nomb <= solver_par->rtol || res <= solver_par->atol ){
+                break;
+            }
+        }
+        if ( solver_par->numiter+1 > solver_par->maxiter ) {
+            break;
+        }
+
+        // W = P^H A P and Pr = P^H r for P = R + Pold B, B = -Wold^{-1} G1
+        lapackf77_zlacpy( "F", &s, &s, RAR, &s, W, &s );
+        if ( sp > 0 ) {
+            lapackf77_zlacpy( "F", &sp, &s, G1, &s, B, &s );
+            lapackf77_zpotrs( "L", &sp, &s, Wold, &s, B, &s, &lapack_info );
+            for( magma_int_t l=0; l<s*s; l++ ){
+                B[l] = -B[l];
+            }
+            blasf77_zgemm( "C", "N", &s, &s, &sp, &c_one, B, &s, G1, &s,
+                           &c_one, W, &s );
+            blasf77_zgemv( "C", &sp, &s, &c_one, B, &s, Pr, &ione,
+                           &c_one, Rr, &ione );
+        }
+        // enforce symmetry before the factorization
+        for( magma_int_t j=0; j<s; j++ ){
+            for( magma_int_t l=j+1; l<s; l++ ){
+                magmaDoubleComplex avg = ( W[l+j*s] + MAGMA_Z_CONJ( W[j+l*s] ) )
+                                            * MAGMA_Z_MAKE( 0.5, 0.0 );
+                W[l+j*s] = avg;
+                W[j+l*s] = MAGMA_Z_CONJ( avg );
+            }
+            W[j+j*s] = MAGMA_Z_MAKE( MAGMA_Z_REAL( W[j+j*s] ), 0.0 );
+        }
+        lapackf77_zpotrf( "L", &s, W, &s, &lapack_info );
+        // keep the leading columns with positive definite Gram matrix
+        k = ( lapack_info == 0 ) ? s : lapack_info-1;
+        if ( k == 0 ) {
+            info = MAGMA_NONSPD;
+            break;
+        }
+        // do not exceed the iteration limit
+        k = min( k, solver_par->maxiter - solver_par->numiter );
+
+        // a = W^{-1} P^H r
+        blasf77_zcopy( &k, Rr, &ione, a, &ione );
+        lapackf77_zpotrs( "L", &k, &ione, W, &s, a, &s, &lapack_info );
+
+        // P = R + Pold B, AP = AR + APold B, x = x + P a, r = r - AP a
+        #pragma omp parallel for schedule(static)
+        for( magma_int_t i=0; i<dofs; i++ ){
+            magmaDoubleComplex xi = c_zero, ri = c_zero;
+            for( magma_int_t l=0; l<k; l++ ){
+                magmaDoubleComplex pil = R.val[i+l*dofs];
+                magmaDoubleComplex apil = AR.val[i+l*dofs];
+                for( magma_int_t j=0; j<sp; j++ ){
+                    pil += Pold.val[i+j*dofs] * B[j+l*s];
+                    apil += APold.val[i+j*dofs] * B[j+l*s];
+                }
+                P.val[i+l*dofs] = pil;
+                AP.val[i+l*dofs] = apil;
+                xi += pil * a[l];
+                ri += apil * a[l];
+            }
+            x->val[i] = x->val[i] + xi;
+            r.val[i] = r.val[i] - ri;
+        }
+
+        // the new block becomes the previous one
+        tmp = Pold;   Pold = P;   P = tmp;
+        tmp = APold;  APold = AP; AP = tmp;
+        lapackf77_zlacpy( "F", &k, &k, W, &s, Wold, &s );
+        sp = k;
+        solver_par->numiter += k;
+    }
+
+    tempo2 = magma_wtime();
+    solver_par->runtime = (real_Double_t) tempo2-tempo1;
+    double residual;
+    CHECK(  magma_zresidualvec( A, b, *x, &r, &residual, queue));
+    solver_par->iter_res = res;
+    solver_par->final_res = residual;
+
+    if ( info == MAGMA_NONSPD ) {
+        // keep the error code
+    } else if ( solver_par->numiter < solver_par->maxiter ) {
+        info = MAGMA_SUCCESS;
+    } else if ( solver_par->init_res > solver_par->final_res ) {
+        info = MAGMA_SLOW_CONVERGENCE;
+        if( solver_par->iter_res < solver_par->rtol*nomb ||
+            solver_par->iter_res < solver_par->atol ) {
+            info = MAGMA_SUCCESS;
+        }
+    }
+    else {
+        info = MAGMA_DIVERGENCE;
+    }
+
+cleanup:
+    magma_zmfree(&r, queue );
+    magma_zmfree(&R, queue );
+    magma_zmfree(&AR, queue );
+    magma_zmfree(&P, queue );
+    magma_zmfree(&AP, queue );
+    magma_zmfree(&Pold, queue );
+    magma_zmfree(&APold, queue );
+    magma_free_cpu( partial );
+    magma_free_cpu( RAR );
+    magma_free_cpu( G1 );
+    magma_free_cpu( W );
+    magma_free_cpu( Wold );
+    magma_free_cpu( B );
+    magma_free_cpu( Rr );
+    magma_free_cpu( Pr );
+    magma_free_cpu( a );
+
+    solver_par->info = info;
+    return info;
+}   /* magma_zsstepcg_cpu */
@@ -0,0 +1,199 @@
+/*
+    -- MAGMA (version 2.6.2) --
+       Univ. of Tennessee, Knoxville
+       Univ. of California, Berkeley
+       Univ. of Colorado, Denver
+       @date April 2022
+
+       @generated from sparse/testing/testing_zparilut_warmstart.cpp, normal z -> c, Sun Oct 18 22:39:30 2026
+       @author Hartwig Anzt
+*/
+
+// includes, system
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+// includes, project
+#include "magma_v2.h"
+#include "magmasparse.h"
+#include "magma_operators.h"
+#include "testings.h"
+
+
+/*
+    Copies the factors of precond to the host and computes the nonlinear
+    ILU residual with respect to A.
+*/
+static void
+factor_residual(
+    magma_c_matrix A,
+    magma_c_preconditioner precond,
+    magma_c_matrix *L,
+    magma_c_matrix *U,
+    real_Double_t *nonlinres,
+    magma_queue_t queue )
+{
+    real_Double_t res = 0.0;
+    magma_c_matrix LU={Magma_CSR};
+
+    TESTING_CHECK( magma_cmtransfer( precond.L, L, precond.L.memory_location,
+        Magma_CPU, queue ));
+    TESTING_CHECK( magma_cmtransfer( precond.U, U, precond.U.memory_location,
+        Magma_CPU, queue ));
+    TESTING_CHECK( magma_cilures( A, *L, *U, &LU, &res, nonlinres, queue ));
+    magma_cmfree( &LU, queue );
+}
+
+
+/*
+    Relative difference of the values of two factors with the same pattern,
+    -1 if the patterns differ.
+*/
+static float
+factor_diff(
+    magma_c_matrix X,
+    magma_c_matrix Y )
+{
+    float diff = 0.0, nrm = 0.0;
+
+    if (X.num_rows != Y.num_rows || X.nnz != Y.nnz) {
+        return -1.0;
+    }
+    for (magma_int_t i=0; i <= X.num_rows; i++) {
+        if (X.row[i] != Y.row[i]) {
+            return -1.0;
+        }
+    }
+    for (magma_int_t i=0; i < X.nnz; i++) {
+        if (X.col[i] != Y.col[i]) {
+            return -1.0;
+        }
+        diff += MAGMA_C_ABS( X.val[i] - Y.val[i] );
+        nrm += MAGMA_C_ABS( Y.val[i] );
+    }
+    return ( nrm > 0.0 ) ? diff / nrm : diff;
+}
+
+
+/* ////////////////////////////////////////////////////////////////////////////
+   -- testing the ParILUT warm start against a cold start
+*/
+int main(  int argc, char** argv )
+{
+    magma_int_t info = 0;
+    /* Initialize */
+    TESTING_CHECK( magma_init() );
+    magma_print_environment();
+    magma_copts zopts;
+    magma_queue_t queue=NULL;
+    magma_queue_create( 0, &queue );
+
+    // the warm start may converge further than the cold start, but must not
+    // be significantly worse
+    const float tol = 1.1;
+    magma_int_t status = 0, failed;
+    magma_c_matrix A={Magma_CSR}, A2={Magma_CSR}, b={Magma_CSR};
+    magma_c_matrix Lc={Magma_CSR}, Uc={Magma_CSR}, Lw={Magma_CSR},
+        Uw={Magma_CSR};
+    magma_c_preconditioner cold, warm;
+    real_Double_t res_cold, res_warm;
+
+    int i=1;
+    TESTING_CHECK( magma_cparse_opts( argc, argv, &zopts, &i, queue ));
+    while( i < argc ) {
+        const char *name = argv[i];
+        if ( strcmp("LAPLACE2D", argv[i]) == 0 && i+1 < argc ) {   // Laplace test
+            i++;
+            magma_int_t laplace_size = atoi( argv[i] );
+            TESTING_CHECK( magma_cm_5stencil(  laplace_size, &A, queue ));
+        } else {                        // file-matrix test
+            TESTING_CHECK( magma_c_csr_mtx( &A,  argv[i], queue ));
+        }
+        TESTING_CHECK( magma_cmscale( &A, Magma_UNITDIAG, queue ));
+        failed = 0;
+        // name is "LAPLACE2D" and argv[i] its size for the Laplace test
+        printf( "\n%% matrix %s%s%s: %lld-by-%lld with %lld nonzeros\n\n",
+                name, (name != argv[i]) ? " " : "", (name != argv[i]) ? argv[i] : "",
+                (long long) A.num_rows, (long long) A.num_cols, (long long) A.nnz );
+
+        // cold start
+        cold = zopts.precond_par;
+        TESTING_CHECK( magma_cparilut_cpu( A, b, &cold, queue ));
+        factor_residual( A, cold, &Lc, &Uc, &res_cold, queue );
+
+        // warm start on the same matrix, keeping the pattern
+        warm = zopts.precond_par;
+        warm.maxiter = 0;
+        TESTING_CHECK( magma_cmtransfer( cold.L, &warm.L,
+            cold.L.memory_location, cold.L.memory_location, queue ));
+        TESTING_CHECK( magma_cmtransfer( cold.U, &warm.U,
+            cold.U.memory_location, cold.U.memory_location, queue ));
+        TESTING_CHECK( magma_cparilut_warmstart_cpu( A, b, &warm, queue ));
+        factor_residual( A, warm, &Lw, &Uw, &res_warm, queue );
+        printf("%% same matrix:  warm start %s, pattern %s, "
+               "difference L %.2e U %.2e, nonlinres cold %.4e warm %.4e\n",
+               (warm.report.warm_start == 1) ? "accepted" : "rejected",
+               (factor_diff( Lw, Lc ) >= 0.0 && factor_diff( Uw, Uc ) >= 0.0)
+                    ? "kept" : "changed",
+               factor_diff( Lw, Lc ), factor_diff( Uw, Uc ),
+               res_cold, res_warm );
+        if (warm.report.warm_start != 1
+            || factor_diff( Lw, Lc ) < 0.0 || factor_diff( Uw, Uc ) < 0.0
+            || res_warm > tol * res_cold) {
+            failed++;
+        }
+        magma_cmfree( &Lw, queue );
+        magma_cmfree( &Uw, queue );
+        magma_cprecondfree( &warm, queue );
+
+        // warm start on a perturbed matrix from the old factors,
+        // compared to a cold start on the perturbed matrix
+        TESTING_CHECK( magma_cmtransfer( A, &A2, Magma_CPU, Magma_CPU, queue ));
+        for (magma_int_t row=0; row < A2.num_rows; row++) {
+            for (magma_int_t j=A2.row[row]; j < A2.row[row+1]; j++) {
+                if (A2.col[j] == row) {
+                    A2.val[j] = A2.val[j] * MAGMA_C_MAKE( 1.05, 0.0 );
+                }
+            }
+        }
+        warm = zopts.precond_par;
+        TESTING_CHECK( magma_cmtransfer( cold.L, &warm.L,
+            cold.L.memory_location, cold.L.memory_location, queue ));
+        TESTING_CHECK( magma_cmtransfer( cold.U, &warm.U,
+            cold.U.memory_location, cold.U.memory_location, queue ));
+        TESTING_CHECK( magma_cparilut_warmstart_cpu( A2, b, &warm, queue ));
+        factor_residual( A2, warm, &Lw, &Uw, &res_warm, queue );
+        magma_cmfree( &Lc, queue );
+        magma_cmfree( &Uc, queue );
+        magma_cprecondfree( &cold, queue );
+        cold = zopts.precond_par;
+        TESTING_CHECK( magma_cparilut_cpu( A2, b, &cold, queue ));
+        factor_residual( A2, cold, &Lc, &Uc, &res_cold, queue );
+        printf("%% perturbed:    warm start %s, nnz cold %lld warm %lld, "
+               "nonlinres cold %.4e warm %.4e\n",
+               (warm.report.warm_start == 1) ? "accepted" : "rejected",
+               (long long) (Lc.nnz + Uc.nnz), (long long) (Lw.nnz + Uw.nnz),
+               res_cold, res_warm );
+        if (warm.report.warm_start != 1 || res_warm > tol * res_cold) {
+            failed++;
+        }
+        printf("%% warm start: %s\n", (failed == 0) ? "ok" : "failed");
+        status += failed;
+
+        magma_cmfree( &Lc, queue );
+        magma_cmfree( &Uc, queue );
+        magma_cmfree( &Lw, queue );
+        magma_cmfree( &Uw, queue );
+        magma_cprecondfree( &cold, queue );
+        magma_cprecondfree( &warm, queue );
+        magma_cmfree( &A2, queue );
+        magma_cmfree( &A, queue );
+        i++;
+    }
+
+    magma_queue_destroy( queue );
+    TESTING_CHECK( magma_finalize() );
+    return ( status == 0 ) ? info : -1;
+}
@@ -0,0 +1,166 @@
+/*
+    -- MAGMA (version 2.6.2) --
+       Univ. of Tennessee, Knoxville
+       Univ. of California, Berkeley
+       Univ. of Colorado, Denver
+       @date April 2022
+
+       @generated from sparse/testing/testing_zsymbilu.cpp, normal z -> c, Sun Oct 18 22:39:30 2026
+       @author Hartwig Anzt
+*/
+
+// includes, system
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <vector>
+
+// includes, project
+#include "magma_v2.h"
+#include "magmasparse.h"
+#include "testings.h"
+
+
+/*
+    Sequential reference for the ILU(levels) pattern: row i is merged with
+    the rows k < i of U in increasing order, keeping a dense level array
+    of length n. The level of a fill-in entry (i,j) is
+    min over k of lev(i,k) + lev(k,j) + 1.
+*/
+static void
+symbilu_reference(
+    magma_c_matrix A,
+    magma_int_t levels,
+    std::vector<magma_index_t> &lrow,
+    std::vector<magma_index_t> &lcol,
+    std::vector<magma_index_t> &urow,
+    std::vector<magma_index_t> &ucol )
+{
+    magma_int_t n = A.num_rows;
+    const magma_int_t unset = levels + 1;
+    std::vector<magma_int_t> lev( n, unset ), ulev;
+
+    lrow.assign( 1, 0 );
+    urow.assign( 1, 0 );
+    lcol.clear();
+    ucol.clear();
+    for (magma_int_t i=0; i < n; i++) {
+        for (magma_int_t j=A.row[i]; j < A.row[i+1]; j++) {
+            lev[ A.col[j] ] = 0;
+        }
+        for (magma_int_t k=0; k < i; k++) {
+            if (lev[k] > levels) {
+                continue;
+            }
+            // skip the diagonal of row k of U
+            for (magma_int_t j=urow[k]+1; j < urow[k+1]; j++) {
+                magma_int_t newlev = lev[k] + ulev[j] + 1;
+                if (newlev < lev[ ucol[j] ]) {
+                    lev[ ucol[j] ] = newlev;
+                }
+            }
+        }
+        for (magma_int_t j=0; j < n; j++) {
+            if (lev[j] <= levels) {
+                if (j < i) {
+                    lcol.push_back( j );
+                } else {
+                    ucol.push_back( j );
+                    ulev.push_back( lev[j] );
+                }
+            }
+            lev[j] = unset;
+        }
+        lrow.push_back( lcol.size() );
+        urow.push_back( ucol.size() );
+    }
+}
+
+
+/*
+    Returns 0 if the CSR pattern of X equals the reference pattern.
+*/
+static magma_int_t
+pattern_diff(
+    magma_c_matrix X,
+    const std::vector<magma_index_t> &row,
+    const std::vector<magma_index_t> &col )
+{
+    if (X.num_rows+1 != (magma_int_t) row.size()
+        || X.nnz != (magma_int_t) col.size()) {
+        return 1;
+    }
+    for (magma_int_t i=0; i <= X.num_rows; i++) {
+        if (X.row[i] != row[i]) {
+            return 1;
+        }
+    }
+    for (magma_int_t i=0; i < X.nnz; i++) {
+        if (X.col[i] != col[i]) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+
+/* ////////////////////////////////////////////////////////////////////////////
+   -- testing the parallel symbolic ILU(k) against a sequential reference
+*/
+int main(  int argc, char** argv )
+{
+    magma_int_t info = 0;
+    /* Initialize */
+    TESTING_CHECK( magma_init() );
+    magma_print_environment();
+    magma_copts zopts;
+    magma_queue_t queue=NULL;
+    magma_queue_create( 0, &queue );
+
+    const magma_int_t levels[] = { 0, 1, 2, 3, 5 };
+    magma_int_t status = 0;
+    magma_c_matrix A={Magma_CSR}, B={Magma_CSR}, L={Magma_CSR},
+        U={Magma_CSR};
+    std::vector<magma_index_t> lrow, lcol, urow, ucol;
+
+    int i=1;
+    TESTING_CHECK( magma_cparse_opts( argc, argv, &zopts, &i, queue ));
+    printf("symbilu = [\n");
+    printf("%%   size (n)   ||   nonzeros (nnz)   ||   levels   ||   nnz(L)   nnz(U)   ||   reference\n");
+    printf("%%==========================================================================================%%\n");
+    while( i < argc ) {
+        if ( strcmp("LAPLACE2D", argv[i]) == 0 && i+1 < argc ) {   // Laplace test
+            i++;
+            magma_int_t laplace_size = atoi( argv[i] );
+            TESTING_CHECK( magma_cm_5stencil(  laplace_size, &A, queue ));
+        } else {                        // file-matrix test
+            TESTING_CHECK( magma_c_csr_mtx( &A,  argv[i], queue ));
+        }
+
+        for (size_t l=0; l < sizeof(levels)/sizeof(levels[0]); l++) {
+            magma_int_t failed;
+            TESTING_CHECK( magma_cmtransfer( A, &B, Magma_CPU, Magma_CPU, queue ));
+            TESTING_CHECK( magma_csymbilu( &B, levels[l], &L, &U, queue ));
+            symbilu_reference( A, levels[l], lrow, lcol, urow, ucol );
+            failed = pattern_diff( L, lrow, lcol ) + pattern_diff( U, urow, ucol );
+            printf("   %10lld          %10lld          %6lld      %10lld %10lld      %s\n",
+                   (long long) A.num_rows, (long long) A.nnz, (long long) levels[l],
+                   (long long) L.nnz, (long long) U.nnz,
+                   (failed == 0) ? "ok" : "failed");
+            status += failed;
+            magma_cmfree( &L, queue );
+            magma_cmfree( &U, queue );
+            magma_cmfree( &B, queue );
+        }
+
+        magma_cmfree( &A, queue );
+        i++;
+    }
+    printf("%%==========================================================================================%%\n");
+    printf("];\n");
+
+    magma_queue_destroy( queue );
+    TESTING_CHECK( magma_finalize() );
+    return ( status == 0 ) ? info : -1;
+}
@@ -5,7 +5,7 @@
        Univ. of Colorado, Denver
        @date April 2022
 
-       @generated from sparse/testing/testing_zmatrixcapcup.cpp, normal z -> d, Wed Apr 20 17:38:07 2022
+       @generated from sparse/testing/testing_zmatrixcapcup.cpp, normal z -> d, Sun Oct 18 20:21:52 2026
        @author Hartwig Anzt
 */
 
@@ -69,7 +69,7 @@ int main(  int argc, char** argv )
         
         // now the negcap:
         printf("C = B cup B^T :\n");
-        TESTING_CHECK( magma_dmatrix_cup( Z1, Z2, &Z3, queue ));
+        TESTING_CHECK( magma_dmatrix_cup( Z1, Z2, &Z3, NULL, queue ));
         magma_dprint_matrix( Z3, queue );
         
         // now the negcap:
@@ -5,7 +5,7 @@
        Univ. of Colorado, Denver
        @date April 2022
 
-       @generated from sparse/testing/testing_zsort.cpp, normal z -> d, Wed Apr 20 17:38:07 2022
+       @generated from sparse/testing/testing_zsort.cpp, normal z -> d, Sun Oct 18 21:05:40 2026
        @author Hartwig Anzt
 */
 
@@ -88,6 +88,47 @@ int main(  int argc, char** argv )
 
     magma_free_cpu( y );
     
+    // benchmark on sorted, reverse sorted, random and duplicate-heavy input
+    printf("%%   n         input      indexsort (ms)  sort (ms)  check\n");
+    printf("%%============================================================\n");
+    const char *inputs[] = { "sorted", "reverse", "random", "duplicates" };
+    for( magma_int_t size = 1000; size <= 1000000; size *= 10 ){
+        TESTING_CHECK( magma_index_malloc_cpu( &x, size ));
+        TESTING_CHECK( magma_dmalloc_cpu( &y, size ));
+        for( magma_int_t in = 0; in < 4; in++ ){
+            for( i = 0; i < size; i++ ){
+                magma_index_t r;
+                if ( in == 0 )      r = i;
+                else if ( in == 1 ) r = size - i;
+                else if ( in == 2 ) r = rand() % size;
+                else                r = rand() % 16;
+                x[i] = r;
+                y[i] = MAGMA_D_MAKE( (double) r, 0.0 );
+                if (i % 5 == 0)
+                    y[i] = - y[i];
+            }
+            real_Double_t tindex = magma_wtime();
+            TESTING_CHECK( magma_dindexsort( x, 0, size-1, queue ));
+            tindex = magma_wtime() - tindex;
+            real_Double_t tsort = magma_wtime();
+            TESTING_CHECK( magma_dsort( y, 0, size-1, queue ));
+            tsort = magma_wtime() - tsort;
+            magma_int_t okay = 1;
+            for( i = 1; i < size; i++ ){
+                if ( x[i] < x[i-1] || MAGMA_D_ABS(y[i]) < MAGMA_D_ABS(y[i-1]) ) {
+                    okay = 0;
+                }
+            }
+            printf("%10lld  %-10s  %14.2f  %9.2f  %s\n",
+                    (long long) size, inputs[in], tindex*1000., tsort*1000.,
+                    (okay ? "ok" : "failed"));
+            info += (okay ? 0 : 1);
+        }
+        magma_free_cpu( x );
+        magma_free_cpu( y );
+    }
+    printf("\n");
+    
     i=1;
     while( i < argc ) {
         if ( strcmp("LAPLACE2D", argv[i]) == 0 && i+1 < argc ) {   // Laplace test
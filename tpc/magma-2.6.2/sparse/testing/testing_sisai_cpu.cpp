@@ -0,0 +1,197 @@
+/*
+    -- MAGMA (version 2.6.2) --
+       Univ. of Tennessee, Knoxville
+       Univ. of California, Berkeley
+       Univ. of Colorado, Denver
+       @date April 2022
+
+       @generated from sparse/testing/testing_zisai_cpu.cpp, normal z -> s, Sun Oct 18 22:39:30 2026
+       @author Hartwig Anzt
+*/
+
+// includes, system
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+// includes, project
+#include "magma_v2.h"
+#include "magmasparse.h"
+#include "magma_operators.h"
+#include "testings.h"
+
+
+/*
+    Extracts the lower or upper triangle of A, including the diagonal.
+*/
+static void
+triangle_part(
+    magma_s_matrix A,
+    magma_uplo_t uplotype,
+    magma_s_matrix *T )
+{
+    magma_int_t nnz = 0;
+
+    T->storage_type = Magma_CSR;
+    T->memory_location = Magma_CPU;
+    T->num_rows = A.num_rows;
+    T->num_cols = A.num_cols;
+    TESTING_CHECK( magma_index_malloc_cpu( &T->row, A.num_rows+1 ));
+    TESTING_CHECK( magma_index_malloc_cpu( &T->col, A.nnz ));
+    TESTING_CHECK( magma_smalloc_cpu( &T->val, A.nnz ));
+    T->row[0] = 0;
+    for (magma_int_t i=0; i < A.num_rows; i++) {
+        for (magma_int_t j=A.row[i]; j < A.row[i+1]; j++) {
+            if ((uplotype == MagmaLower) ? (A.col[j] <= i) : (A.col[j] >= i)) {
+                T->col[nnz] = A.col[j];
+                T->val[nnz] = A.val[j];
+                nnz++;
+            }
+        }
+        T->row[i+1] = nnz;
+    }
+    T->nnz = nnz;
+}
+
+
+/*
+    Generates the triangular band pattern with w diagonals: every column of
+    the ISAI is a local system of size up to w.
+*/
+static void
+band_pattern(
+    magma_int_t n,
+    magma_int_t w,
+    magma_uplo_t uplotype,
+    magma_s_matrix *S )
+{
+    magma_int_t nnz = 0;
+
+    S->storage_type = Magma_CSR;
+    S->memory_location = Magma_CPU;
+    S->num_rows = n;
+    S->num_cols = n;
+    TESTING_CHECK( magma_index_malloc_cpu( &S->row, n+1 ));
+    TESTING_CHECK( magma_index_malloc_cpu( &S->col, n*w ));
+    TESTING_CHECK( magma_smalloc_cpu( &S->val, n*w ));
+    S->row[0] = 0;
+    for (magma_int_t i=0; i < n; i++) {
+        magma_int_t first = (uplotype == MagmaLower) ? max( 0, i-w+1 ) : i;
+        magma_int_t last  = (uplotype == MagmaLower) ? i : min( n-1, i+w-1 );
+        for (magma_int_t j=first; j <= last; j++) {
+            S->col[nnz] = j;
+            S->val[nnz] = MAGMA_S_ONE;
+            nnz++;
+        }
+        S->row[i+1] = nnz;
+    }
+    S->nnz = nnz;
+}
+
+
+/*
+    Largest deviation of T * M from the identity on the pattern of M,
+    where the ISAI is exact.
+*/
+static float
+isai_error(
+    magma_s_matrix T,
+    magma_s_matrix M,
+    magma_queue_t queue )
+{
+    float err = 0.0;
+    magma_s_matrix R={Magma_CSR};
+
+    TESTING_CHECK( magma_sspgemm_cpu( MAGMA_S_ONE, T, M, &R, queue ));
+    for (magma_int_t i=0; i < M.num_rows; i++) {
+        magma_int_t k = R.row[i];
+        for (magma_int_t j=M.row[i]; j < M.row[i+1]; j++) {
+            float r = MAGMA_S_ZERO;
+            while (k < R.row[i+1] && R.col[k] < M.col[j]) {
+                k++;
+            }
+            if (k < R.row[i+1] && R.col[k] == M.col[j]) {
+                r = R.val[k];
+            }
+            if (M.col[j] == i) {
+                r = r - MAGMA_S_ONE;
+            }
+            if (MAGMA_S_ABS( r ) > err) {
+                err = MAGMA_S_ABS( r );
+            }
+        }
+    }
+    magma_smfree( &R, queue );
+    return err;
+}
+
+
+/* ////////////////////////////////////////////////////////////////////////////
+   -- testing the host ISAI on the packed variable-size systems
+*/
+int main(  int argc, char** argv )
+{
+    magma_int_t info = 0;
+    /* Initialize */
+    TESTING_CHECK( magma_init() );
+    magma_print_environment();
+    magma_sopts zopts;
+    magma_queue_t queue=NULL;
+    magma_queue_create( 0, &queue );
+
+    // band widths below the SIMD batch limit and above it, the latter
+    // solved blockwise
+    const magma_int_t widths[] = { 1, 5, 40, 100 };
+    const float tol = 1e3 * lapackf77_slamch("E");
+    magma_int_t status = 0;
+    magma_s_matrix A={Magma_CSR}, T={Magma_CSR}, S={Magma_CSR},
+        M={Magma_CSR};
+
+    int i=1;
+    TESTING_CHECK( magma_sparse_opts( argc, argv, &zopts, &i, queue ));
+
+    while( i < argc ) {
+        if ( strcmp("LAPLACE2D", argv[i]) == 0 && i+1 < argc ) {   // Laplace test
+            i++;
+            magma_int_t laplace_size = atoi( argv[i] );
+            TESTING_CHECK( magma_sm_5stencil(  laplace_size, &A, queue ));
+        } else {                        // file-matrix test
+            TESTING_CHECK( magma_s_csr_mtx( &A,  argv[i], queue ));
+        }
+        printf( "\n%% matrix info: %lld-by-%lld with %lld nonzeros\n\n",
+                (long long) A.num_rows, (long long) A.num_cols, (long long) A.nnz );
+
+        for (int u=0; u < 2; u++) {
+            magma_uplo_t uplotype = (u == 0) ? MagmaLower : MagmaUpper;
+            triangle_part( A, uplotype, &T );
+            for (size_t w=0; w < sizeof(widths)/sizeof(widths[0]); w++) {
+                float err;
+                band_pattern( A.num_rows, widths[w], uplotype, &S );
+                if (uplotype == MagmaLower) {
+                    TESTING_CHECK( magma_siluisaisetup_lower_cpu( T, S, &M, queue ));
+                } else {
+                    TESTING_CHECK( magma_siluisaisetup_upper_cpu( T, S, &M, queue ));
+                }
+                err = isai_error( T, M, queue );
+                printf("%% %s band %3lld: nnz %lld, error %.2e: %s\n",
+                       (uplotype == MagmaLower) ? "lower" : "upper",
+                       (long long) widths[w], (long long) M.nnz, err,
+                       (err < tol && M.nnz == S.nnz) ? "ok" : "failed");
+                if (err >= tol || M.nnz != S.nnz) {
+                    status++;
+                }
+                magma_smfree( &S, queue );
+                magma_smfree( &M, queue );
+            }
+            magma_smfree( &T, queue );
+        }
+
+        magma_smfree( &A, queue );
+        i++;
+    }
+
+    magma_queue_destroy( queue );
+    TESTING_CHECK( magma_finalize() );
+    return ( status == 0 ) ? info : -1;
+}
@@ -0,0 +1,99 @@
+/*
+    -- MAGMA (version 2.6.2) --
+       Univ. of Tennessee, Knoxville
+       Univ. of California, Berkeley
+       Univ. of Colorado, Denver
+       @date April 2022
+
+       @generated from sparse/testing/testing_zmreorder.cpp, normal z -> s, Sun Oct 18 19:54:33 2026
+       @author Hartwig Anzt
+*/
+
+// includes, system
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+// includes, project
+#include "magma_v2.h"
+#include "magmasparse.h"
+#include "magma_operators.h"
+#include "testings.h"
+
+
+/* ////////////////////////////////////////////////////////////////////////////
+   -- testing the RCM reordering
+*/
+int main(  int argc, char** argv )
+{
+    magma_int_t info = 0;
+    TESTING_CHECK( magma_init() );
+    magma_print_environment();
+
+    magma_sopts zopts;
+    magma_queue_t queue=NULL;
+    magma_queue_create( 0, &queue );
+
+    magma_s_matrix Z={Magma_CSR}, Zp={Magma_CSR}, Zb={Magma_CSR};
+    magma_s_matrix x={Magma_CSR}, xp={Magma_CSR}, xb={Magma_CSR};
+    magma_index_t *perm=NULL, *iperm=NULL;
+    real_Double_t start, end, res;
+
+    int i=1;
+    TESTING_CHECK( magma_sparse_opts( argc, argv, &zopts, &i, queue ));
+    printf("rcm = [\n");
+    printf("%%   size (n)   ||   nonzeros (nnz)   ||   bandwidth   ||   bandwidth RCM   ||   time RCM   ||   check\n");
+    printf("%%=========================================================================================================%%\n");
+    while( i < argc ) {
+        if ( strcmp("LAPLACE2D", argv[i]) == 0 && i+1 < argc ) {   // Laplace test
+            i++;
+            magma_int_t laplace_size = atoi( argv[i] );
+            TESTING_CHECK( magma_sm_5stencil(  laplace_size, &Z, queue ));
+        } else {                        // file-matrix test
+            TESTING_CHECK( magma_s_csr_mtx( &Z,  argv[i], queue ));
+        }
+        TESTING_CHECK( magma_sdiameter( &Z, queue ));
+
+        start = magma_sync_wtime( queue );
+        TESTING_CHECK( magma_srcm( Z, &perm, &iperm, queue ));
+        end = magma_sync_wtime( queue );
+        TESTING_CHECK( magma_smpermute( Z, &Zp, perm, iperm, queue ));
+        TESTING_CHECK( magma_sdiameter( &Zp, queue ));
+
+        // permuting back has to recover the original matrix and vector
+        TESTING_CHECK( magma_smpermute( Zp, &Zb, iperm, perm, queue ));
+        TESTING_CHECK( magma_smdiff( Z, Zb, &res, queue ));
+        TESTING_CHECK( magma_svinit( &x, Magma_CPU, Z.num_rows, 1, MAGMA_S_ZERO, queue ));
+        for( magma_int_t k=0; k<Z.num_rows; k++ ){
+            x.val[k] = MAGMA_S_MAKE( (float) k, 0.0 );
+        }
+        TESTING_CHECK( magma_svpermute( x, &xp, perm, queue ));
+        TESTING_CHECK( magma_svpermute( xp, &xb, iperm, queue ));
+        for( magma_int_t k=0; k<Z.num_rows; k++ ){
+            res += MAGMA_S_ABS( x.val[k] - xb.val[k] );
+        }
+
+        printf("   %10lld          %10lld          %10lld          %10lld          %.4f     %s\n",
+               (long long) Z.num_rows, (long long) Z.nnz,
+               (long long) Z.diameter, (long long) Zp.diameter,
+               end-start, ( res == 0.0 ) ? "ok" : "failed" );
+
+        magma_smfree(&Z, queue );
+        magma_smfree(&Zp, queue );
+        magma_smfree(&Zb, queue );
+        magma_smfree(&x, queue );
+        magma_smfree(&xp, queue );
+        magma_smfree(&xb, queue );
+        magma_free_cpu( perm );
+        magma_free_cpu( iperm );
+
+        i++;
+    }
+    printf("%%=========================================================================================================%%\n");
+    printf("];\n");
+
+    magma_queue_destroy( queue );
+    TESTING_CHECK( magma_finalize() );
+    return info;
+}
@@ -69,7 +69,7 @@ int main(  int argc, char** argv )
         
         // now the negcap:
         printf("C = B cup B^T :\n");
-        TESTING_CHECK( magma_zmatrix_cup( Z1, Z2, &Z3, queue ));
+        TESTING_CHECK( magma_zmatrix_cup( Z1, Z2, &Z3, NULL, queue ));
         magma_zprint_matrix( Z3, queue );
         
         // now the negcap:
@@ -0,0 +1,99 @@
+/*
+    -- MAGMA (version 2.6.2) --
+       Univ. of Tennessee, Knoxville
+       Univ. of California, Berkeley
+       Univ. of Colorado, Denver
+       @date April 2022
+
+       @precisions normal z -> c d s
+       @author Hartwig Anzt
+*/
+
+// includes, system
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+// includes, project
+#include "magma_v2.h"
+#include "magmasparse.h"
+#include "magma_operators.h"
+#include "testings.h"
+
+
+/* ////////////////////////////////////////////////////////////////////////////
+   -- testing the RCM reordering
+*/
+int main(  int argc, char** argv )
+{
+    magma_int_t info = 0;
+    TESTING_CHECK( magma_init() );
+    magma_print_environment();
+
+    magma_zopts zopts;
+    magma_queue_t queue=NULL;
+    magma_queue_create( 0, &queue );
+
+    magma_z_matrix Z={Magma_CSR}, Zp={Magma_CSR}, Zb={Magma_CSR};
+    magma_z_matrix x={Magma_CSR}, xp={Magma_CSR}, xb={Magma_CSR};
+    magma_index_t *perm=NULL, *iperm=NULL;
+    real_Double_t start, end, res;
+
+    int i=1;
+    TESTING_CHECK( magma_zparse_opts( argc, argv, &zopts, &i, queue ));
+    printf("rcm = [\n");
+    printf("%%   size (n)   ||   nonzeros (nnz)   ||   bandwidth   ||   bandwidth RCM   ||   time RCM   ||   check\n");
+    printf("%%=========================================================================================================%%\n");
+    while( i < argc ) {
+        if ( strcmp("LAPLACE2D", argv[i]) == 0 && i+1 < argc ) {   // Laplace test
+            i++;
+            magma_int_t laplace_size = atoi( argv[i] );
+            TESTING_CHECK( magma_zm_5stencil(  laplace_size, &Z, queue ));
+        } else {                        // file-matrix test
+            TESTING_CHECK( magma_z_csr_mtx( &Z,  argv[i], queue ));
+        }
+        TESTING_CHECK( magma_zdiameter( &Z, queue ));
+
+        start = magma_sync_wtime( queue );
+        TESTING_CHECK( magma_zrcm( Z, &perm, &iperm, queue ));
+        end = magma_sync_wtime( queue );
+        TESTING_CHECK( magma_zmpermute( Z, &Zp, perm, iperm, queue ));
+        TESTING_CHECK( magma_zdiameter( &Zp, queue ));
+
+        // permuting back has to recover the original matrix and vector
+        TESTING_CHECK( magma_zmpermute( Zp, &Zb, iperm, perm, queue ));
+        TESTING_CHECK( magma_zmdiff( Z, Zb, &res, queue ));
+        TESTING_CHECK( magma_zvinit( &x, Magma_CPU, Z.num_rows, 1, MAGMA_Z_ZERO, queue ));
+        for( magma_int_t k=0; k<Z.num_rows; k++ ){
+            x.val[k] = MAGMA_Z_MAKE( (double) k, 0.0 );
+        }
+        TESTING_CHECK( magma_zvpermute( x, &xp, perm, queue ));
+        TESTING_CHECK( magma_zvpermute( xp, &xb, iperm, queue ));
+        for( magma_int_t k=0; k<Z.num_rows; k++ ){
+            res += MAGMA_Z_ABS( x.val[k] - xb.val[k] );
+        }
+
+        printf("   %10lld          %10lld          %10lld          %10lld          %.4f     %s\n",
+               (long long) Z.num_rows, (long long) Z.nnz,
+               (long long) Z.diameter, (long long) Zp.diameter,
+               end-start, ( res == 0.0 ) ? "ok" : "failed" );
+
+        magma_zmfree(&Z, queue );
+        magma_zmfree(&Zp, queue );
+        magma_zmfree(&Zb, queue );
+        magma_zmfree(&x, queue );
+        magma_zmfree(&xp, queue );
+        magma_zmfree(&xb, queue );
+        magma_free_cpu( perm );
+        magma_free_cpu( iperm );
+
+        i++;
+    }
+    printf("%%=========================================================================================================%%\n");
+    printf("];\n");
+
+    magma_queue_destroy( queue );
+    TESTING_CHECK( magma_finalize() );
+    return info;
+}
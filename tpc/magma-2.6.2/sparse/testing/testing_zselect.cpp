@@ -31,6 +31,13 @@ void makeRandomArray(magmaDoubleComplex* a, int size) {
     }
 }
 
+// increasing magnitude, for the reference of the multi-select
+int compareMagnitude(const void* x, const void* y) {
+    double ax = MAGMA_Z_ABS( *(const magmaDoubleComplex*) x );
+    double ay = MAGMA_Z_ABS( *(const magmaDoubleComplex*) y );
+    return (ax > ay) - (ax < ay);
+}
+
 /* ////////////////////////////////////////////////////////////////////////////
    -- testing for the magma_zselect magma_zselectrandom magma_zselectsort functions
 */
@@ -43,7 +50,7 @@ int main(  int argc, char** argv )
     magma_queue_t queue=NULL;
     magma_queue_create( 0, &queue );
     // using std::swap;
-    real_Double_t start, end, t_select, t_selectrandom, t_selectbitonic;
+    real_Double_t start, end, t_select, t_selectrandom, t_selectbitonic, t_multiselect;
     
     int size = atoi(argv[1]);
     int selectset = atoi(argv[2]);
@@ -113,10 +120,51 @@ int main(  int argc, char** argv )
         printf(" Inconsistent result.\n");
     }
     
+    // the input of the multi-select is not modified; several ranks in one
+    // call, including a duplicate rank and both ends, are compared against
+    // a sorted copy, for distinct values and for many equal values
+    const magma_int_t num_k = 6;
+    magma_int_t ranks[ num_k ] = { selectset, size-1, 0, selectset, size/2,
+                                   (size > 1) ? 1 : 0 };
+    magmaDoubleComplex MultiResult[ num_k ];
+    magmaDoubleComplex* sorted = NULL;
+    TESTING_CHECK( magma_zmalloc_cpu( &sorted, size ) );
+    for (int equal=0; equal<2; equal++) {
+        makeRandomArray(a, size);
+        if (equal == 1) {
+            for (int i=0; i<size; i++) {
+                a[i] = MAGMA_Z_MAKE( floor( 8.0 * MAGMA_Z_REAL(a[i]) ), 0.0 );
+            }
+        }
+        for (int i=0; i<size; i++) {
+            sorted[i] = a[i];
+        }
+        qsort( sorted, size, sizeof(magmaDoubleComplex), compareMagnitude );
+        start = magma_sync_wtime( queue );
+        TESTING_CHECK( magma_zmultiselect(a, size, num_k, ranks, MultiResult, queue) );
+        end = magma_sync_wtime( queue );
+        if (equal == 0) {
+            t_multiselect = end-start;
+            printf("\n selected by multi-select: %.2f\n\n", MAGMA_Z_ABS(MultiResult[0]) );
+            if (!(MAGMA_Z_ABS(MultiResult[0]) == MAGMA_Z_ABS(selectRandomResult)) ){
+                printf(" Inconsistent result.\n");
+            }
+        }
+        for (int r=0; r<num_k; r++) {
+            if (!(MAGMA_Z_ABS(MultiResult[r]) == MAGMA_Z_ABS(sorted[ ranks[r] ])) ){
+                printf(" Multi-select: wrong element for rank %lld%s.\n",
+                       (long long) ranks[r], equal ? " (equal values)" : "" );
+                info = -1;
+            }
+        }
+    }
+    magma_free_cpu( sorted );
+    
     
     printf(" Select time (ms): %.4f\n", double(t_select)*1000 );
     printf(" Randomized select time (ms): %.4f\n", double(t_selectrandom)*1000 );
     printf(" Bitonicsort time (ms): %.4f\n", double(t_selectbitonic)*1000 );
+    printf(" Multi-select time (ms): %.4f\n", double(t_multiselect)*1000 );
 
     // magma_free_cpu( &a );
     
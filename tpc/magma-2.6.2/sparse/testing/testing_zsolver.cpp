@@ -62,7 +62,9 @@ int main(  int argc, char** argv )
         TESTING_CHECK( magma_zmscale( &A, zopts.scaling, queue ));
         
         // preconditioner
-        if ( zopts.solver_par.solver != Magma_ITERREF ) {
+        if ( zopts.compute_location == Magma_CPU ) {
+            TESTING_CHECK( magma_z_precondsetup_cpu( A, b, &zopts.solver_par, &zopts.precond_par, queue ) );
+        } else if ( zopts.solver_par.solver != Magma_ITERREF ) {
             TESTING_CHECK( magma_z_precondsetup( A, b, &zopts.solver_par, &zopts.precond_par, queue ) );
         }
 
@@ -80,14 +82,15 @@ int main(  int argc, char** argv )
         printf("%%============================================================================%%\n");
         printf("];\n");
 
-        TESTING_CHECK( magma_zmtransfer( B, &dB, Magma_CPU, Magma_DEV, queue ));
+        // for --location CPU, the system stays in host memory
+        TESTING_CHECK( magma_zmtransfer( B, &dB, Magma_CPU, zopts.compute_location, queue ));
 
         // vectors and initial guess
-        TESTING_CHECK( magma_zvinit_rand( &b, Magma_DEV, A.num_rows, 1, queue ));
+        TESTING_CHECK( magma_zvinit_rand( &b, zopts.compute_location, A.num_rows, 1, queue ));
         //magma_zvinit( &x, Magma_DEV, A.num_cols, 1, one, queue );
         //magma_z_spmv( one, dB, x, zero, b, queue );                 //  b = A x
         //magma_zmfree(&x, queue );
-        TESTING_CHECK( magma_zvinit_rand( &x, Magma_DEV, A.num_cols, 1, queue ));
+        TESTING_CHECK( magma_zvinit_rand( &x, zopts.compute_location, A.num_cols, 1, queue ));
         
         info = magma_z_solver( dB, b, &x, &zopts, queue );
         if( info != 0 ) {
@@ -624,6 +624,8 @@ subs = {
     ('stfqmr',         'dtfqmr',         'ctfqmr',         'ztfqmr'          ),
     ('sptfqmr',        'dptfqmr',        'cptfqmr',        'zptfqmr'         ),
     ('spcg',           'dpcg',           'cpcg',           'zpcg'            ),
+    ('spipecg',        'dpipecg',        'cpipecg',        'zpipecg'         ),
+    ('ssstepcg',       'dsstepcg',       'csstepcg',       'zsstepcg'        ),
     ('sbpcg',          'dbpcg',          'cbpcg',          'zbpcg'           ),
     ('spbicg',         'dpbicg',         'cpbicg',         'zpbicg'          ),
     ('spgmres',        'dpgmres',        'cpgmres',        'zpgmres'         ),